@@ -1,25 +1,12 @@
 package cgot
 
-import (
-	"bytes"
-	"io"
-	"path"
-	"testing"
-
-	"github.com/rokath/trice/internal/args"
-	"github.com/spf13/afero"
-	"github.com/tj/assert"
-)
+import "testing"
 
 func TestLogs(t *testing.T) {
 
-	// triceLog is the log function for executing the trice logging on binary log data in buffer as space separated numbers.
-	// It uses the inside fSys specified til.json and returns the log output.
-	triceLog := func(t *testing.T, fSys *afero.Afero, buffer string) string {
-		var o bytes.Buffer
-		assert.Nil(t, args.Handler(io.Writer(&o), fSys, []string{"trice", "log", "-i", path.Join(triceDir, "/test/testdata/til.json"), "-p=BUFFER", "-args", buffer, "-triceEndianness=bigEndian", "-hs=off", "-prefix=off", "-li=off", "-color=off", "-pw=MySecret", "-pf=COBS", "-d16", "-ts16", "time:    %04x", "-ts32", "time:%08x"}))
-		return o.String()
-	}
+	// triceLog is the log function for executing the trice logging on binary log data.
+	// It uses an in-process log session with the testdata til.json and returns the log output.
+	triceLog := newTriceLog(t, "-triceEndianness=bigEndian", "-hs=off", "-prefix=off", "-li=off", "-color=off", "-pw=MySecret", "-pf=COBS", "-d16", "-ts16", "time:    %04x", "-ts32", "time:%08x")
 
 	triceLogTest(t, triceLog, testLines)
 }
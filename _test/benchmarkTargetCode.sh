@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+
+# Run BenchmarkTargetCode in all cgo test packages and show the results as one table.
+# Like for the tests, this folder needs to be renamed into test. Arguments are passed to go test, like -benchtime=100000x.
+# ns/TRICE is the TRICE call duration, ns/trice includes TriceTransfer, B/trice are the encoded bytes per trice
+# and depthMax is the peak trice buffer depth in bytes from the target diagnostics values.
+
+cd "$(dirname "$0")" || exit 1
+
+go test -run '^$' -bench '^BenchmarkTargetCode$' "$@" ./... | awk '
+/^pkg: / { n = split($2, p, "/"); folder = p[n] }
+/^BenchmarkTargetCode/ {
+    split("", v)
+    for (i = 3; i < NF; i += 2) v[$(i + 1)] = $i
+    rows[++count] = sprintf("| %-44s | %9s | %9s | %8s | %8s |", folder, v["ns/TRICE"], v["ns/trice"], v["B/trice"], v["depthMax"])
+}
+/^(--- FAIL|FAIL)/ { print > "/dev/stderr" }
+END {
+    printf "| %-44s | %9s | %9s | %8s | %8s |\n", "configuration", "ns/TRICE", "ns/trice", "B/trice", "depthMax"
+    printf "|:%s|%s:|%s:|%s:|%s:|\n", "---------------------------------------------", "----------", "----------", "---------", "---------"
+    for (i = 1; i <= count; i++) print rows[i]
+}'
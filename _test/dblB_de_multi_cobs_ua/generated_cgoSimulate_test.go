@@ -0,0 +1,202 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+// Inside ./testdata this file is named cgoSimulate_test.go where it is maintained.
+// The test/updateTestData.sh script copies this file under the name generated_cgoSimulate_test.go into the
+// ringB_de_* and dblB_de_* package folders, so each deferred target code configuration can replay a trice sequence.
+package cgot
+
+import (
+	"encoding/csv"
+	"flag"
+	"fmt"
+	"os"
+	"sort"
+	"strconv"
+	"testing"
+	"time"
+
+	"github.com/tj/assert"
+)
+
+var (
+	simTrace  = flag.String("trace", "", `trice sequence CSV file written by "trice bandwidth -trace" for TestSimulateBuffer`)
+	simBaud   = flag.Int("baud", 115200, "simulated output link baud rate with 10 bits per byte")
+	simPeriod = flag.Duration("period", time.Millisecond, "simulated TriceTransfer call period")
+)
+
+// simEvent is one trice of a replayed sequence.
+type simEvent struct {
+	at        time.Duration // at is the TRICE call time.
+	id        int
+	stampSize int
+	params    int
+}
+
+// simResult is the outcome of a buffer simulation.
+type simResult struct {
+	trices    int
+	overflows int             // overflows are the trices dropped because of a full deferred buffer.
+	truncated int             // truncated are the trices shortened to TRICE_SINGLE_MAX_SIZE.
+	depthMax  int             // depthMax is the peak buffer depth from the target diagnostics values.
+	bytes     int             // bytes are the transferred bytes including the framing.
+	busy      time.Duration   // busy is the time the link was transferring.
+	end       time.Duration   // end is the time, when the last byte left the link.
+	latency   []time.Duration // latency are the durations from the TRICE calls until the trices left the link.
+}
+
+// readTrace returns the trice sequence inside the CSV file fn.
+// The times are made monotonic, because a trice cannot enter the buffer before its predecessor.
+func readTrace(t *testing.T, fn string) (events []simEvent) {
+	fh, err := os.Open(fn)
+	assert.Nil(t, err)
+	defer fh.Close()
+	records, err := csv.NewReader(fh).ReadAll()
+	assert.Nil(t, err)
+	assert.True(t, len(records) > 0 && records[0][0] == "time_us", "no trice sequence:", fn)
+	var last time.Duration
+	for _, r := range records[1:] {
+		var v [4]int
+		for i := range v {
+			v[i], err = strconv.Atoi(r[i])
+			assert.Nil(t, err, r)
+		}
+		at := time.Duration(v[0]) * time.Microsecond
+		if at < last {
+			at = last
+		}
+		last = at
+		events = append(events, simEvent{at, v[1], v[2], v[3]})
+	}
+	return
+}
+
+// simulate replays events through the compiled deferred buffer code.
+// Every period TriceTransfer is called, but only if the link is idle, like on a target, which checks TriceOutDepth first.
+// The link sends baud/10 bytes per second. Trices transferred together leave the link proportionally to their sizes.
+func simulate(events []simEvent, baud int, period time.Duration) (r simResult) {
+	mode := simMode()
+	out := make([]byte, 2*simBufferSize()+1024) // more than an encoded half buffer or ring buffer trice
+	setTriceBuffer(out)
+	triceClearOutBuffer()
+	triceClearDiagnostics()
+	overflows, truncated := simOverflowCount(), simTruncateCount()
+	byteTime := 10 * time.Second / time.Duration(baud)
+
+	type queued struct {
+		at   time.Duration
+		size int
+	}
+	var queue []queued // queue are the trices inside the deferred buffer.
+	var transfer, idle time.Duration
+	var i, stalled int
+	for (i < len(events) || len(queue) > 0) && stalled < 1000 {
+		if i < len(events) && events[i].at <= transfer {
+			e := events[i]
+			i++
+			o := simOverflowCount()
+			simTrice(e.id, e.stampSize, e.params)
+			if simOverflowCount() == o {
+				queue = append(queue, queued{e.at, 4 + e.stampSize + e.params})
+			}
+			continue
+		}
+		now := transfer
+		transfer += period
+		if len(queue) == 0 && i < len(events) && events[i].at > transfer { // skip idle periods
+			transfer += (events[i].at - transfer) / period * period
+		}
+		if now < idle { // link busy
+			continue
+		}
+		triceClearOutBuffer()
+		triceTransfer()
+		n := triceOutDepth()
+		count := len(queue)
+		if mode == 1 && count > 1 { // ring buffer
+			count = 1
+		}
+		if n == 0 || count == 0 {
+			stalled++ // protects against an endless loop on inconsistent buffer data
+			continue
+		}
+		stalled = 0
+		var total, done int
+		for _, q := range queue[:count] {
+			total += q.size
+		}
+		for _, q := range queue[:count] {
+			done += q.size
+			r.latency = append(r.latency, now+time.Duration(n*done/total)*byteTime-q.at)
+		}
+		queue = queue[count:]
+		idle = now + time.Duration(n)*byteTime
+		r.bytes += n
+		r.busy += time.Duration(n) * byteTime
+	}
+	triceClearOutBuffer()
+	r.trices = len(events)
+	r.overflows = simOverflowCount() - overflows
+	r.truncated = simTruncateCount() - truncated
+	r.depthMax = triceBufferDepthMax()
+	r.end = idle
+	return
+}
+
+// percentile returns the p-th percentile of the sorted durations d.
+func percentile(d []time.Duration, p float64) time.Duration {
+	if len(d) == 0 {
+		return 0
+	}
+	return d[int(p*float64(len(d)-1)+0.5)]
+}
+
+// TestSimulateBuffer replays the -trace trice sequence with -baud and -period and prints one result line.
+// The buffer size is TRICE_DEFERRED_BUFFER_SIZE, which ../simulateBuffer.sh sweeps with CGO_CFLAGS.
+func TestSimulateBuffer(t *testing.T) {
+	if *simTrace == "" {
+		t.Skip("needs -trace")
+	}
+	if simMode() == 0 {
+		t.Skip("no deferred only configuration with TRICE_PROTECT and TRICE_DIAGNOSTICS")
+	}
+	r := simulate(readTrace(t, *simTrace), *simBaud, *simPeriod)
+	sort.Slice(r.latency, func(i, j int) bool { return r.latency[i] < r.latency[j] })
+	var load float64
+	if r.end > 0 {
+		load = 100 * float64(r.busy) / float64(r.end)
+	}
+	us := func(d time.Duration) string { return strconv.FormatInt(d.Microseconds(), 10) }
+	fmt.Printf("simulate: size %d trices %d overflows %d truncated %d depthMax %d load%% %.1f p50us %s p90us %s p99us %s maxus %s\n",
+		simBufferSize(), r.trices, r.overflows, r.truncated, r.depthMax, load,
+		us(percentile(r.latency, 0.5)), us(percentile(r.latency, 0.9)), us(percentile(r.latency, 0.99)), us(percentile(r.latency, 1)))
+	assert.Equal(t, r.trices, len(r.latency)+r.overflows)
+}
+
+// TestSimulateBurst checks the simulation with a relaxed and with an overflowing trice sequence.
+func TestSimulateBurst(t *testing.T) {
+	if simMode() == 0 {
+		t.Skip("no deferred only configuration with TRICE_PROTECT and TRICE_DIAGNOSTICS")
+	}
+	var relaxed []simEvent
+	for i := 0; i < 100; i++ {
+		relaxed = append(relaxed, simEvent{time.Duration(i) * 10 * time.Millisecond, 16200 + i, 4, 8})
+	}
+	r := simulate(relaxed, 115200, time.Millisecond)
+	assert.Equal(t, 0, r.overflows)
+	assert.Equal(t, r.trices, len(r.latency))
+	for _, l := range r.latency {
+		assert.True(t, 0 < l && l < 10*time.Millisecond, l)
+	}
+	assert.True(t, 0 < r.depthMax && r.depthMax <= simBufferSize(), r.depthMax)
+
+	burst := make([]simEvent, simBufferSize()/4) // each trice needs at least 12 bytes
+	for i := range burst {
+		burst[i] = simEvent{0, 16200 + i%100, 2, 4}
+	}
+	r = simulate(burst, 115200, time.Millisecond)
+	assert.True(t, r.overflows > 0)
+	assert.Equal(t, r.trices, len(r.latency)+r.overflows)
+	assert.True(t, r.depthMax <= simBufferSize(), r.depthMax)
+	assert.True(t, r.end >= r.busy && r.busy > 0)
+}
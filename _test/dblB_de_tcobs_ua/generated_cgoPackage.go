@@ -18,6 +18,21 @@ package cgot
 // unsigned TriceOutDepth( void );
 // void CgoSetTriceBuffer( uint8_t* buf );
 // void CgoClearTriceBuffer( void );
+// unsigned CgoTriceBufferDepthMax( void );
+// void CgoClearTriceDiagnostics( void );
+// int CgoSimMode( void );
+// unsigned CgoSimBufferSize( void );
+// void CgoSimTrice( int tid, int stampSize, unsigned n );
+// unsigned CgoSimOverflowCount( void );
+// unsigned CgoSimTruncateCount( void );
+// void CgoSetCycleStep( uint32_t step );
+// int CgoTimingCount( int path, int bucket );
+// void CgoClearTiming( void );
+// void CgoTriceLogTiming( void );
+// void CgoTriceLogHealth( int reset );
+// void CgoSetSpanClock( uint32_t us );
+// void CgoSpanTree( uint32_t idle );
+// void CgoResetTriceCycle( void );
 // #cgo CFLAGS: -g -I../../src
 // #include "../../src/trice.c"
 // #include "../../src/trice8.c"
@@ -26,6 +41,7 @@ package cgot
 // #include "../../src/trice64.c"
 // #include "../../src/triceUart.c"
 // #include "../../src/triceAuxiliary.c"
+// #include "../../src/triceHealth.c"
 // #include "../../src/triceDoubleBuffer.c"
 // #include "../../src/triceRingBuffer.c"
 // #include "../../src/triceStackBuffer.c"
@@ -37,17 +53,24 @@ package cgot
 // #include "../../src/tcobsv1Encode.c"
 // #include "../testdata/triceCheck.c"
 // #include "../testdata/cgoTrice.c"
+// #include "../testdata/cgoSimulate.c"
+// #include "../testdata/cgoTiming.c"
+// #include "../../examples/exampleData/triceLogTiming.c"
+// #include "../testdata/cgoHealth.c"
+// #include "../testdata/cgoSpans.c"
 import "C"
 
 import (
 	"bufio"
 	"fmt"
+	"os"
 	"path"
 	"runtime"
 	"strings"
 	"testing"
 	"unsafe"
 
+	"github.com/rokath/trice/internal/args"
 	"github.com/rokath/trice/pkg/msg"
 	"github.com/spf13/afero"
 	"github.com/tj/assert"
@@ -92,6 +115,85 @@ func triceClearOutBuffer() {
 	C.CgoClearTriceBuffer()
 }
 
+// triceBufferDepthMax returns the peak trice buffer depth from the target diagnostics values.
+func triceBufferDepthMax() int {
+	return int(C.CgoTriceBufferDepthMax())
+}
+
+// triceClearDiagnostics resets the target diagnostics peak values.
+func triceClearDiagnostics() {
+	C.CgoClearTriceDiagnostics()
+}
+
+// simMode returns 1 for a ring buffer, 2 for a double buffer and 0, if the configuration is not usable for the buffer simulation.
+func simMode() int {
+	return int(C.CgoSimMode())
+}
+
+// simBufferSize returns the compiled deferred buffer size.
+func simBufferSize() int {
+	return int(C.CgoSimBufferSize())
+}
+
+// simTrice writes a trice with ID tid, stampSize stamp bytes and n parameter bytes.
+func simTrice(tid, stampSize, n int) {
+	C.CgoSimTrice(C.int(tid), C.int(stampSize), C.unsigned(n))
+}
+
+// simOverflowCount returns the count of dropped trices because of a full deferred buffer.
+func simOverflowCount() int {
+	return int(C.CgoSimOverflowCount())
+}
+
+// simTruncateCount returns the count of truncated parameter buffers.
+func simTruncateCount() int {
+	return int(C.CgoSimTruncateCount())
+}
+
+// setCycleStep sets the fake cycle counter increment per read.
+func setCycleStep(step int) {
+	C.CgoSetCycleStep(C.uint32_t(step))
+}
+
+// timingCount returns the count inside bucket of the path histogram or -1 without TRICE_TIMING.
+func timingCount(path, bucket int) int {
+	return int(C.CgoTimingCount(C.int(path), C.int(bucket)))
+}
+
+// clearTiming resets the TRICE_TIMING histograms.
+func clearTiming() {
+	C.CgoClearTiming()
+}
+
+// triceLogTiming emits the TRICE_TIMING histograms.
+func triceLogTiming() {
+	C.CgoTriceLogTiming()
+}
+
+// triceLogHealth emits the target health record and with reset restarts the diagnostics values.
+func triceLogHealth(reset bool) {
+	var r C.int
+	if reset {
+		r = 1
+	}
+	C.CgoTriceLogHealth(r)
+}
+
+// setSpanClock sets the fake microsecond clock of the span trices.
+func setSpanClock(us uint32) {
+	C.CgoSetSpanClock(C.uint32_t(us))
+}
+
+// resetTriceCycle sets the target trice cycle counter to its start value, which a new decoder expects.
+func resetTriceCycle() {
+	C.CgoResetTriceCycle()
+}
+
+// spanTree emits the span trices of a synthetic call tree with idle microseconds inside the main span.
+func spanTree(idle uint32) {
+	C.CgoSpanTree(C.uint32_t(idle))
+}
+
 // linesInFile does get the lines in a file and stores them in a string slice.
 func linesInFile(fh afero.File) []string { // https://www.dotnetperls.com/lines-file-go
 	// Create new Scanner.
@@ -135,13 +237,28 @@ func getExpectedResults(fSys *afero.Afero, filename string) (result []results) {
 	return
 }
 
-// logF is the log function type for executing the trice logging on binary log data in buffer as space separated numbers.
-// It uses the inside fSys specified til.json and returns the log output.
-type logF func(t *testing.T, fSys *afero.Afero, buffer string) string
+// logF is the log function type for executing the trice logging on the binary log data bin.
+// It returns the log output.
+type logF func(t *testing.T, bin []byte) string
+
+// newTriceLog returns a log function using an in-process log session with the "trice log" flags and the testdata til.json.
+// The session loads til.json only once and decodes each bin directly, instead of a "trice log -p BUFFER" Handler call per bin.
+// Like with the BUFFER port, each bin is decoded independently.
+func newTriceLog(t *testing.T, flags ...string) logF {
+	osFSys := &afero.Afero{Fs: afero.NewOsFs()}
+	s, err := args.NewSession(os.Stdout, osFSys, append([]string{"-i", path.Join(triceDir, "/test/testdata/til.json")}, flags...)...)
+	assert.Nil(t, err)
+	return func(t *testing.T, bin []byte) string {
+		act, err := s.Decode(bin)
+		assert.Nil(t, err)
+		assert.Nil(t, s.Reset()) // drop incomplete data, like padding bytes
+		return act
+	}
+}
 
 // triceLogTest creates a list of expected results from  path.Join(triceDir, "./test/testdata/triceCheck.c").
 // It loops over the result list and executes for each result the compiled C-code.
-// It passes the received binary data as buffer to the triceLog function of type logF.
+// It passes the received binary data to the triceLog function of type logF.
 // This function is test package specific defined. The file cgoPackage.go is
 // copied into all specific test packages and compiled there together with the
 // triceConfig.h, which holds the test package specific target code configuration.
@@ -175,10 +292,7 @@ func triceLogTest(t *testing.T, triceLog logF, limit int) {
 		length := triceOutDepth()
 		bin := out[:length] // bin contains the binary trice data of trice message i in r.line
 
-		buf := fmt.Sprint(bin)
-		buffer := buf[1 : len(buf)-1]
-
-		act := triceLog(t, osFSys, buffer)
+		act := triceLog(t, bin)
 		triceClearOutBuffer()
 
 		assert.Equal(t, r.exps, strings.TrimSuffix(act, "\n"))
@@ -210,10 +324,7 @@ func triceLogTest2(t *testing.T, triceLog0, triceLog1 logF, limit int) {
 			length := triceOutDepth()
 			bin := out[:length] // bin contains the binary trice data of trice message i
 
-			buf := fmt.Sprint(bin)
-			buffer := buf[1 : len(buf)-1]
-
-			act := triceLog0(t, osFSys, buffer)
+			act := triceLog0(t, bin)
 			triceClearOutBuffer()
 
 			assert.Equal(t, r.exps, strings.TrimSuffix(act, "\n"))
@@ -225,10 +336,7 @@ func triceLogTest2(t *testing.T, triceLog0, triceLog1 logF, limit int) {
 			length := triceOutDepth()
 			bin := out[:length] // bin contains the binary trice data of trice message i
 
-			buf := fmt.Sprint(bin)
-			buffer := buf[1 : len(buf)-1]
-
-			act := triceLog1(t, osFSys, buffer)
+			act := triceLog1(t, bin)
 			triceClearOutBuffer()
 
 			assert.Equal(t, r.exps, strings.TrimSuffix(act, "\n"))
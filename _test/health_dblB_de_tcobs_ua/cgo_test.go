@@ -0,0 +1,70 @@
+package cgot
+
+import (
+	"bytes"
+	"strings"
+	"sync"
+	"testing"
+
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/translator"
+	"github.com/rokath/trice/internal/trexDecoder"
+	"github.com/tj/assert"
+)
+
+// healthTransfer calls TriceTransfer and returns the decoded output.
+func healthTransfer(t *testing.T, triceLog logF, out []byte) string {
+	triceTransfer()
+	act := triceLog(t, out[:triceOutDepth()])
+	triceClearOutBuffer()
+	return act
+}
+
+// TestHealth checks the periodic health records with TRICE_HEALTH_PERIOD 4 and TRICE_HEALTH_RESET 1.
+func TestHealth(t *testing.T) {
+	triceLog := newTriceLog(t, "-hs=off", "-prefix=off", "-li=off", "-color=none", "-ts16", "time:    %04x", "-ts32", "time:%08x")
+	out := make([]byte, 32768)
+	setTriceBuffer(out)
+	triceClearOutBuffer()
+
+	var i int // sync with the TriceTransfer call counter
+	for ; i < 4 && !strings.Contains(healthTransfer(t, triceLog, out), "health seq="); i++ {
+	}
+	assert.True(t, i < 4)
+	records, h := trexDecoder.Health("")
+
+	simTrice(16200, 0, 200) // truncated
+	for i := 0; i < 100; i++ {
+		simTrice(16200, 0, 4) // overflows the 256 bytes half buffer
+	}
+	for i := 0; i < 3; i++ {
+		assert.False(t, strings.Contains(healthTransfer(t, triceLog, out), "health seq="))
+	}
+	act := healthTransfer(t, triceLog, out)
+	assert.True(t, strings.Contains(act, "health seq="), act)
+	n, v := trexDecoder.Health("")
+	assert.Equal(t, records+1, n)
+	assert.Equal(t, h[0]+1, v[0])    // sequence
+	assert.Equal(t, uint32(1), v[1]) // reset flag
+	assert.True(t, v[2] > 0 && v[2] <= v[3], v)
+	assert.Equal(t, uint32(256), v[7])
+	assert.True(t, v[6] > 0 && v[6] <= v[7], v)
+	assert.True(t, v[9] > 0, v)       // deferred overflows
+	assert.Equal(t, uint32(1), v[10]) // truncations
+	assert.True(t, strings.Contains(act, " truncations=1 errors=0 rtt=0/0 reset"), act)
+
+	var metrics bytes.Buffer // stats output
+	translator.WriteMetrics(&metrics, make(id.TriceIDLookUp), new(sync.RWMutex))
+	assert.True(t, strings.Contains(metrics.String(), `trice_target_health{device="",field="truncations"} 1`+"\n"), metrics.String())
+	assert.True(t, strings.Contains(metrics.String(), `trice_target_health_records_total{device=""} `), metrics.String())
+
+	for i := 0; i < 3; i++ { // The next period starts with reset values.
+		healthTransfer(t, triceLog, out)
+	}
+	act = healthTransfer(t, triceLog, out)
+	assert.True(t, strings.Contains(act, " directOverflows=0 deferredOverflows=0 truncations=0 errors=0 "), act)
+
+	triceLogHealth(false) // an explicit snapshot without reset
+	act = healthTransfer(t, triceLog, out)
+	assert.True(t, strings.HasSuffix(act, " rtt=0/0\n"), act)
+}
@@ -1,32 +1,21 @@
 package cgot
 
 import (
-	"bytes"
-	"fmt"
-	"io"
-	"path"
 	"strings"
 	"testing"
 
-	"github.com/rokath/trice/internal/args"
-	"github.com/spf13/afero"
 	"github.com/tj/assert"
 )
 
 func TestLogs(t *testing.T) {
-	// triceLog is the log function for executing the trice logging on binary log data in buffer as space separated numbers.
-	// It uses the inside fSys specified til.json and returns the log output.
-	triceLog := func(t *testing.T, fSys *afero.Afero, buffer string) string {
-		var o bytes.Buffer
-		assert.Nil(t, args.Handler(io.Writer(&o), fSys, []string{"trice", "log", "-i", path.Join(triceDir, "/test/testdata/til.json"), "-p=BUFFER", "-args", buffer, "-hs=off", "-prefix=off", "-li=off", "-color=none", "-ts16", "time:    %04x", "-ts32", "time:%08x"}))
-		return o.String()
-	}
+	// triceLog is the log function for executing the trice logging on binary log data.
+	// It uses an in-process log session with the testdata til.json and returns the log output.
+	triceLog := newTriceLog(t, "-hs=off", "-prefix=off", "-li=off", "-color=none", "-ts16", "time:    %04x", "-ts32", "time:%08x")
 	triceLogSpecialTest(t, triceLog)
 }
 
 // triceLogSpecialTest ...
 func triceLogSpecialTest(t *testing.T, triceLog logF) {
-	osFSys := &afero.Afero{Fs: afero.NewOsFs()}
 	out := make([]byte, 32768)
 	setTriceBuffer(out)
 
@@ -41,10 +30,7 @@ func triceLogSpecialTest(t *testing.T, triceLog logF) {
 	length := triceOutDepth()
 	bin := out[:length] // bin contains the binary trice data of trice message.
 
-	buf := fmt.Sprint(bin)
-	buffer := buf[1 : len(buf)-1]
-
-	act := triceLog(t, osFSys, buffer) // convert binary buffer into result string
+	act := triceLog(t, bin) // convert binary buffer into result string
 
 	triceClearOutBuffer()
 
@@ -0,0 +1,31 @@
+#!/usr/bin/env bash
+
+# Replay a trice sequence through the deferred target code of the ringB_de_* and dblB_de_* configurations for several buffer sizes
+# and show the results as one table. Like for the tests, this folder needs to be renamed into test.
+#
+# Usage: ./simulateBuffer.sh trace.csv ["sizes"] [test flags]
+#   trace.csv is written by "trice bandwidth -args capture.bin -trace trace.csv".
+#   sizes are TRICE_DEFERRED_BUFFER_SIZE values, default "256 512 1024 2048 4096".
+#   test flags are -baud=115200 and -period=1ms, for example.
+# The environment variable FOLDERS limits the configurations, like FOLDERS="ringB_de_tcobs_ua dblB_de_multi_tcobs_ua".
+# Additional compiler switches, like -DTRICE_SINGLE_MAX_SIZE=64, can be added with the environment variable SIMFLAGS.
+
+cd "$(dirname "$0")" || exit 1
+
+trace=$(realpath "$1") || exit 1
+sizes=${2:-"256 512 1024 2048 4096"}
+shift; [ $# -gt 0 ] && shift
+folders=${FOLDERS:-$(ls -d ringB_de_* dblB_de_*)}
+
+printf "| %-28s | %6s | %7s | %9s | %9s | %8s | %6s | %9s | %9s | %9s | %9s |\n" "configuration" "size" "trices" "overflows" "truncated" "depthMax" "load%" "p50 us" "p90 us" "p99 us" "max us"
+printf "|:%s|%s:|%s:|%s:|%s:|%s:|%s:|%s:|%s:|%s:|%s:|\n" "-----------------------------" "-------" "--------" "----------" "----------" "---------" "-------" "----------" "----------" "----------" "----------"
+for f in $folders; do
+    for s in $sizes; do
+        CGO_CFLAGS="-O2 -DTRICE_DEFERRED_BUFFER_SIZE=$s $SIMFLAGS" go test -count=1 -run '^TestSimulateBuffer$' -v "./$f" -args -trace="$trace" "$@" | awk -v folder="$f" '
+/^simulate: / {
+    for (i = 2; i < NF; i += 2) v[$i] = $(i + 1)
+    printf "| %-28s | %6s | %7s | %9s | %9s | %8s | %6s | %9s | %9s | %9s | %9s |\n", folder, v["size"], v["trices"], v["overflows"], v["truncated"], v["depthMax"], v["load%"], v["p50us"], v["p90us"], v["p99us"], v["maxus"]
+}
+/^(--- FAIL|FAIL|--- SKIP)/ { print folder ": " $0 > "/dev/stderr" }'
+    done
+done
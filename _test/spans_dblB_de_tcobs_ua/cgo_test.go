@@ -0,0 +1,168 @@
+package cgot
+
+import (
+	"bytes"
+	"encoding/json"
+	"io"
+	"path"
+	"strings"
+	"sync"
+	"testing"
+
+	"github.com/rokath/trice/internal/decoder"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/rokath/trice/internal/translator"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// spanEvent is a decoded Chrome Trace Event.
+type spanEvent struct {
+	Name string
+	Ph   string
+	Ts   float64
+	Dur  float64
+	Tid  int
+	Args map[string]string
+}
+
+// spansTransfer calls TriceTransfer until the deferred buffer is empty and appends the output to bin.
+func spansTransfer(bin, out []byte) []byte {
+	for i := 0; i < 4; i++ {
+		triceTransfer()
+		n := triceOutDepth()
+		bin = append(bin, out[:n]...)
+		triceClearOutBuffer()
+		if n == 0 {
+			break
+		}
+	}
+	return bin
+}
+
+// spansProfile runs "trice spans" on bin and returns the report and the span events.
+func spansProfile(t *testing.T, bin []byte) (report string, events []spanEvent) {
+	defer func(enc, framing, fn string) {
+		translator.Encoding, decoder.PackageFraming, translator.SpansFileName = enc, framing, fn
+	}(translator.Encoding, decoder.PackageFraming, translator.SpansFileName)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	assert.Nil(t, fSys.WriteFile("spans.bin", bin, 0644))
+	lut := id.NewLut(io.Discard, &afero.Afero{Fs: afero.NewOsFs()}, path.Join(triceDir, "test/testdata/til.json"))
+	translator.Encoding, decoder.PackageFraming, translator.SpansFileName = "TREX", "TCOBSv1", "trace.json"
+	rwc, err := receiver.NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", "spans.bin")
+	assert.Nil(t, err)
+	defer rwc.Close()
+	var w bytes.Buffer
+	assert.Equal(t, io.EOF, translator.Spans(&w, fSys, lut, new(sync.RWMutex), rwc))
+	b, err := fSys.ReadFile("trace.json")
+	assert.Nil(t, err)
+	var trace struct{ TraceEvents []spanEvent }
+	assert.Nil(t, json.Unmarshal(b, &trace), string(b))
+	for _, e := range trace.TraceEvents {
+		if e.Ph == "X" {
+			events = append(events, e)
+		}
+	}
+	return w.String(), events
+}
+
+// spansReset starts the target like after a reset, so a new decoder sees no cycle gap, also on repeated test runs.
+func spansReset(out []byte) {
+	setTriceBuffer(out)
+	triceClearOutBuffer()
+	resetTriceCycle()
+}
+
+// TestSpans profiles a synthetic call tree with 16-bit stamp wraps and with main spans longer than the 16-bit stamp period.
+// The main spans have 32-bit stamps and the filter and leaf spans 16-bit stamps, so they are on separate tracks.
+func TestSpans(t *testing.T) {
+	out := make([]byte, 32768)
+	spansReset(out)
+	var bin []byte
+	setSpanClock(0x1fff0)
+	for i := 0; i < 4; i++ {
+		spanTree(70000)
+		bin = spansTransfer(bin, out)
+	}
+	report, events := spansProfile(t, bin)
+	assert.True(t, strings.Contains(report, "40 spans of 80 trices, 0 missing exits, 0 exits without enter, 0 trice losses"), report)
+
+	calls := make(map[string]int)
+	var mains []spanEvent
+	for _, e := range events {
+		calls[e.Name]++
+		assert.Nil(t, e.Args, e)
+		switch e.Name {
+		case "leaf":
+			assert.Equal(t, 10.0, e.Dur, e)
+			assert.Equal(t, 2, e.Tid, e)
+		case "filter":
+			assert.Equal(t, 30.0, e.Dur, e)
+			assert.Equal(t, 2, e.Tid, e)
+		case "main":
+			assert.Equal(t, 70094.0, e.Dur, e)
+			assert.Equal(t, 1, e.Tid, e)
+			mains = append(mains, e)
+		}
+	}
+	assert.Equal(t, map[string]int{"main": 4, "filter": 12, "leaf": 24}, calls)
+	for i, e := range mains {
+		assert.Equal(t, float64(i*70094), e.Ts)
+	}
+	for _, e := range events { // Each leaf is nested inside a filter on the 16-bit track.
+		if e.Name != "leaf" {
+			continue
+		}
+		var nested bool
+		for _, p := range events {
+			nested = nested || p.Name == "filter" && p.Ts <= e.Ts && e.Ts+e.Dur <= p.Ts+p.Dur
+		}
+		assert.True(t, nested, e)
+	}
+	lines := strings.Split(report, "\n")
+	assert.True(t, strings.HasPrefix(lines[1], "main "), report)
+	assert.Equal(t, []string{"filter", "12", "0", "360µs", "120µs", "30µs", "30µs"}, strings.Fields(lines[3]), report)
+
+	triceLog := newTriceLog(t, "-hs=off", "-prefix=off", "-li=off", "-color=none", "-ts16", "time:    %04x", "-ts32", "time:%08x")
+	spanTree(0)
+	act := triceLog(t, spansTransfer(nil, out))
+	assert.True(t, strings.Contains(act, ">filter\n"), act)
+	assert.True(t, strings.Contains(act, "<main\n"), act)
+}
+
+// TestSpansOverflow profiles call trees, which overflow the deferred buffer. The spans with lost exit trices end as missing.
+func TestSpansOverflow(t *testing.T) {
+	out := make([]byte, 32768)
+	spansReset(out)
+	var bin []byte
+	setSpanClock(0)
+	for i := 0; i < 20; i++ { // more than a half buffer
+		spanTree(0)
+	}
+	bin = spansTransfer(bin, out)
+	spanTree(0)
+	bin = spansTransfer(bin, out)
+	report, events := spansProfile(t, bin)
+	assert.True(t, strings.Contains(report, " trice losses"), report)
+	assert.False(t, strings.Contains(report, " 0 trice losses"), report)
+
+	var missing, mains int
+	for _, e := range events {
+		if e.Args["exit"] == "missing" {
+			missing++
+			continue
+		}
+		switch e.Name {
+		case "leaf":
+			assert.Equal(t, 10.0, e.Dur, e)
+		case "filter":
+			assert.Equal(t, 30.0, e.Dur, e)
+		case "main":
+			assert.Equal(t, 94.0, e.Dur, e)
+			mains++
+		}
+	}
+	assert.True(t, missing > 0, report)
+	assert.True(t, mains > 0, report) // at least the call tree after the overflow
+}
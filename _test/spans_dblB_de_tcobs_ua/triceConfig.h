@@ -0,0 +1,28 @@
+/*! \file triceConfig.h
+\author Thomas.Hoehenleitner [at] seerose.net
+*******************************************************************************/
+
+#ifndef TRICE_CONFIG_H_
+#define TRICE_CONFIG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRICE_DEFERRED_OUTPUT 1
+#define TRICE_DEFERRED_UARTA 1
+#define TRICE_UARTA
+
+#define TRICE_CGO 1
+#define TRICE_CYCLE_COUNTER 1 // shows lost span trices
+#define TRICE_CONFIG_WARNINGS 0
+
+extern uint32_t CgoSpanClock; // fake microsecond clock in ../testdata/cgoSpans.c
+#define TriceStamp16 ((uint16_t)CgoSpanClock)
+#define TriceStamp32 CgoSpanClock
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRICE_CONFIG_H_ */
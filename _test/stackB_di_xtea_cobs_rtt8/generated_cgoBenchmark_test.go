@@ -0,0 +1,67 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+// Inside ./testdata this file is named cgoBenchmark_test.go where it is maintained.
+// The test/updateTestData.sh script copies this file under the name generated_cgoBenchmark_test.go into the
+// same package folders as cgoPackage.go, so each target code configuration gets the same benchmark.
+package cgot
+
+import (
+	"path"
+	"testing"
+	"time"
+
+	"github.com/spf13/afero"
+)
+
+// BenchmarkTargetCode measures the host-side costs of the target code compiled with the triceConfig.h of this folder.
+// The trice mix are all lines with expected results in triceCheck.c, executed one after the other like in triceLogTest.
+// Besides ns/op it reports:
+//   - ns/TRICE: the TRICE call duration including the direct output, if configured
+//   - ns/trice: the TRICE call and TriceTransfer duration, so deferred trices include their encoding
+//   - B/trice: the encoded bytes per trice
+//   - depthMax: the peak trice buffer depth in bytes from the diagnostics values
+//
+// The durations are without the Go to C transitions. The script ../benchmarkTargetCode.sh shows all folders in one table.
+func BenchmarkTargetCode(b *testing.B) {
+	transition := cgoTransition()
+	osFSys := &afero.Afero{Fs: afero.NewOsFs()}
+	result := getExpectedResults(osFSys, path.Join(triceDir, "./test/testdata/triceCheck.c"))
+	out := make([]byte, 32768)
+	setTriceBuffer(out)
+	triceClearOutBuffer()
+	triceClearDiagnostics()
+
+	var call, callAndTransfer time.Duration
+	var size int
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		line := result[i%len(result)].line
+		start := time.Now()
+		triceCheck(line)
+		called := time.Now()
+		triceTransfer()
+		transferred := time.Now()
+		call += called.Sub(start)
+		callAndTransfer += transferred.Sub(start)
+		size += triceOutDepth()
+		triceClearOutBuffer()
+	}
+	b.StopTimer()
+	b.ReportMetric(float64(call.Nanoseconds())/float64(b.N)-transition, "ns/TRICE")
+	b.ReportMetric(float64(callAndTransfer.Nanoseconds())/float64(b.N)-2*transition, "ns/trice")
+	b.ReportMetric(float64(size)/float64(b.N), "B/trice")
+	b.ReportMetric(float64(triceBufferDepthMax()), "depthMax")
+}
+
+// cgoTransition returns the mean duration in ns of a trivial C function call together with the time measurement.
+func cgoTransition() float64 {
+	const count = 10000
+	var d time.Duration
+	for i := 0; i < count; i++ {
+		start := time.Now()
+		triceOutDepth()
+		d += time.Since(start)
+	}
+	return float64(d.Nanoseconds()) / count
+}
@@ -0,0 +1,14 @@
+/*! \file cgoHealth.c
+\brief target code wrapper for the health record tests
+\author thomas.hoehenleitner [at] seerose.net
+*******************************************************************************/
+#include "trice.h"
+
+//! CgoTriceLogHealth emits the health record and with reset != 0 restarts the diagnostics values.
+void CgoTriceLogHealth(int reset) {
+#if TRICE_DIAGNOSTICS == 1
+	TriceLogHealth(reset);
+#else
+	TRICE_UNUSED(reset)
+#endif
+}
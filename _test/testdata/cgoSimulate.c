@@ -0,0 +1,61 @@
+/*! \file cgoSimulate.c
+\brief target code wrapper for the buffer simulation in cgoSimulate_test.go
+\author thomas.hoehenleitner [at] seerose.net
+*******************************************************************************/
+#include <stdint.h>
+#include "trice.h"
+
+//! CgoSimMode tells, how the buffer simulation can use this configuration.
+//! \retval 1 for a ring buffer, where each TriceTransfer call transfers one trice
+//! \retval 2 for a double buffer, where a TriceTransfer call transfers all trices of a half buffer
+//! \retval 0 for configurations with direct output, without TRICE_PROTECT and TRICE_DIAGNOSTICS or with periodic health records, which are not usable for the simulation
+int CgoSimMode(void) {
+#if TRICE_DIRECT_OUTPUT == 1 || TRICE_DEFERRED_OUTPUT == 0 || TRICE_PROTECT == 0 || TRICE_DIAGNOSTICS == 0 || TRICE_HEALTH_PERIOD > 0
+	return 0;
+#elif TRICE_BUFFER == TRICE_RING_BUFFER
+	return 1;
+#elif TRICE_BUFFER == TRICE_DOUBLE_BUFFER
+	return 2;
+#else
+	return 0;
+#endif
+}
+
+//! CgoSimBufferSize returns the compiled TRICE_DEFERRED_BUFFER_SIZE.
+unsigned CgoSimBufferSize(void) {
+	return TRICE_DEFERRED_BUFFER_SIZE;
+}
+
+//! CgoSimTrice writes a trice with ID tid, a stamp with stampSize bytes and n parameter bytes, like a recorded one.
+//! The TRICE_N functions accept any ID and parameter count and give the same trice size.
+void CgoSimTrice(int tid, int stampSize, unsigned n) {
+	static uint8_t params[TRICE_SINGLE_MAX_SIZE]; // TRICE_N truncates n to less than TRICE_SINGLE_MAX_SIZE
+	switch (stampSize) {
+	case 4:
+		TRiceN(tid, "", params, n);
+		break;
+	case 2:
+		TriceN(tid, "", params, n);
+		break;
+	default:
+		triceN(tid, "", params, n);
+	}
+}
+
+//! CgoSimOverflowCount returns the count of trices dropped because of a full deferred buffer.
+unsigned CgoSimOverflowCount(void) {
+#if TRICE_DIAGNOSTICS == 1 && TRICE_PROTECT == 1
+	return TriceDeferredOverflowCount;
+#else
+	return 0;
+#endif
+}
+
+//! CgoSimTruncateCount returns the count of truncated parameter buffers because of TRICE_SINGLE_MAX_SIZE.
+unsigned CgoSimTruncateCount(void) {
+#if TRICE_DIAGNOSTICS == 1
+	return TriceDynBufTruncateCount;
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,50 @@
+/*! \file cgoSpans.c
+\brief synthetic call tree with span trices for the function profiling tests
+\author thomas.hoehenleitner [at] seerose.net
+*******************************************************************************/
+#include <stdint.h>
+#include "trice.h"
+
+//! CgoSpanClock is a fake microsecond clock usable for TriceStamp16 and TriceStamp32.
+uint32_t CgoSpanClock = 0;
+
+//! CgoSetSpanClock sets the fake microsecond clock.
+void CgoSetSpanClock(uint32_t us) {
+	CgoSpanClock = us;
+}
+
+//! CgoResetTriceCycle sets the trice cycle counter to its start value like a target reset.
+void CgoResetTriceCycle(void) {
+#if TRICE_CYCLE_COUNTER == 1
+	TriceCycle = 0xc0;
+#endif
+}
+
+//! cgoSpanLeaf is a 10 us leaf function.
+static void cgoSpanLeaf(void) {
+	TriceSpanEnter(iD(16360), "leaf");
+	CgoSpanClock += 10;
+	TriceSpanExit(iD(16359), "leaf");
+}
+
+//! cgoSpanFilter calls cgoSpanLeaf twice and needs 10 us itself.
+static void cgoSpanFilter(void) {
+	TriceSpanEnter(iD(16362), "filter");
+	CgoSpanClock += 5;
+	cgoSpanLeaf();
+	cgoSpanLeaf();
+	CgoSpanClock += 5;
+	TriceSpanExit(iD(16361), "filter");
+}
+
+//! CgoSpanTree emits the span trices of a synthetic call tree: main calls filter 3 times and each filter calls leaf twice.
+//! main needs 4 us plus idle us itself. Its spans are 32-bit stamped, so idle can exceed the 16-bit stamp period.
+void CgoSpanTree(uint32_t idle) {
+	TRiceSpanEnter(iD(16364), "main");
+	CgoSpanClock += 2;
+	for (int i = 0; i < 3; i++) {
+		cgoSpanFilter();
+	}
+	CgoSpanClock += 2 + idle;
+	TRiceSpanExit(iD(16363), "main");
+}
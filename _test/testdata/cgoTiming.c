@@ -0,0 +1,48 @@
+/*! \file cgoTiming.c
+\brief target code wrapper for the TRICE_TIMING instrumentation tests
+\author thomas.hoehenleitner [at] seerose.net
+*******************************************************************************/
+#include <stdint.h>
+#include "trice.h"
+
+//! cgoCycles is the fake cycle counter value.
+static uint32_t cgoCycles = 0;
+
+//! cgoCycleStep is the fake cycle counter increment per read.
+static uint32_t cgoCycleStep = 0;
+
+//! CgoCycles is a fake cycle counter usable as TRICE_TIMING_CYCLES. Each read advances it by cgoCycleStep.
+uint32_t CgoCycles(void) {
+	cgoCycles += cgoCycleStep;
+	return cgoCycles;
+}
+
+//! CgoSetCycleStep sets the fake cycle counter increment per read.
+void CgoSetCycleStep(uint32_t step) {
+	cgoCycleStep = step;
+}
+
+//! CgoTimingCount returns the count inside bucket of the path histogram or -1 without TRICE_TIMING.
+int CgoTimingCount(int path, int bucket) {
+#if TRICE_TIMING == 1
+	return TriceTimingHistogram[path][bucket];
+#else
+	TRICE_UNUSED(path)
+	TRICE_UNUSED(bucket)
+	return -1;
+#endif
+}
+
+//! CgoClearTiming resets all TRICE_TIMING histograms.
+void CgoClearTiming(void) {
+#if TRICE_TIMING == 1
+	memset(TriceTimingHistogram, 0, sizeof(TriceTimingHistogram));
+#endif
+}
+
+//! CgoTriceLogTiming emits the TRICE_TIMING histograms.
+void CgoTriceLogTiming(void) {
+#if TRICE_TIMING == 1
+	TriceLogTiming();
+#endif
+}
@@ -34,3 +34,32 @@ void TriceWriteDeviceCgo(const void* buf, unsigned len) {
 	memcpy(cgoTriceBuffer + cgoTriceBufferDepth, buf, len);
 	cgoTriceBufferDepth += len;
 }
+
+//! CgoTriceBufferDepthMax returns the peak trice buffer depth in bytes from the diagnostics values.
+//! It is the ring buffer or half buffer depth in deferred modes and the single trice size otherwise.
+//! Without diagnostics the return value is 0.
+unsigned CgoTriceBufferDepthMax(void) {
+#if TRICE_DIAGNOSTICS == 1 && TRICE_BUFFER == TRICE_RING_BUFFER
+	return TriceRingBufferDepthMax;
+#elif TRICE_DIAGNOSTICS == 1 && TRICE_BUFFER == TRICE_DOUBLE_BUFFER
+	return TriceHalfBufferDepthMax;
+#elif TRICE_DIAGNOSTICS == 1
+	return TriceSingleMaxWordCount << 2;
+#else
+	return 0;
+#endif
+}
+
+//! CgoClearTriceDiagnostics resets the peak values for a next measurement.
+void CgoClearTriceDiagnostics(void) {
+#if TRICE_DIAGNOSTICS == 1
+#if TRICE_BUFFER == TRICE_RING_BUFFER
+	TriceRingBufferDepthMax = 0;
+#endif
+#if TRICE_BUFFER == TRICE_DOUBLE_BUFFER
+	TriceHalfBufferDepthMax = 0;
+#endif
+	TriceSingleMaxWordCount = 0;
+	TriceDataOffsetDepthMax = 0;
+#endif
+}
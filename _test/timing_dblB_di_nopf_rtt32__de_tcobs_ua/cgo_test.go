@@ -0,0 +1,65 @@
+package cgot
+
+import (
+	"strings"
+	"testing"
+
+	"github.com/tj/assert"
+)
+
+func TestLogs(t *testing.T) {
+
+	// triceLog is the log function for executing the trice logging on binary log data.
+	// It uses an in-process log session with the testdata til.json and returns the log output.
+	// Default CLI switch values are not working in combined mode, set them explicit!
+	triceLog0 := newTriceLog(t, "-hs=off", "-prefix=off", "-li=off", "-color=off", "-pf=NONE", "-d16", "-ts16", "time:    %04x", "-ts32", "time:%08x")
+
+	// triceLog is the log function for executing the trice logging on binary log data.
+	// It uses an in-process log session with the testdata til.json and returns the log output.
+	// Default CLI switch values are not working in combined mode, set them explicit!
+	triceLog1 := newTriceLog(t, "-hs=off", "-prefix=off", "-li=off", "-color=off", "-pf=TCOBS", "-d16=false", "-ts16", "time:    %04x", "-ts32", "time:%08x")
+
+	triceLogTest2(t, triceLog0, triceLog1, testLines)
+}
+
+// TestTiming checks the TRICE_TIMING histograms with a fake cycle counter advancing by 100 cycles on each read.
+// A TRICE macro reads the counter 5 times: before and after TRICE_ENTER_CRITICAL_SECTION, around the direct output and before leaving.
+func TestTiming(t *testing.T) {
+	const macro, critical, direct, transfer = 0, 1, 2, 3 // enum TriceTimingPath
+	triceLog0 := newTriceLog(t, "-hs=off", "-prefix=off", "-li=off", "-color=off", "-pf=NONE", "-d16")
+	out := make([]byte, 32768)
+	setTriceBuffer(out)
+	triceClearOutBuffer()
+	clearTiming()
+	setCycleStep(100)
+	defer setCycleStep(0)
+
+	for i := 0; i < 10; i++ {
+		simTrice(16200, 0, 4)
+	}
+	triceClearOutBuffer() // drop the direct output, because TriceTransfer waits for an empty output
+	triceTransfer()
+	triceClearOutBuffer()
+	assert.Equal(t, 10, timingCount(macro, 8))    // 400 cycles
+	assert.Equal(t, 10, timingCount(critical, 6)) // 100 cycles
+	assert.Equal(t, 10, timingCount(direct, 6))   // 100 cycles
+	assert.Equal(t, 1, timingCount(transfer, 6))  // 100 cycles
+
+	triceLogTiming()
+	act := triceLog0(t, out[:triceOutDepth()])
+	triceClearOutBuffer()
+	exp := []string{
+		"time:            default: timing:TRICE cycles n=10 p50<512 p90<512 p99<512 max<512 256..511:█",
+		"time:            default: timing:critical section cycles n=10 p50<128 p90<128 p99<128 max<128 64..127:█",
+		"time:            default: timing:direct output cycles n=10 p50<128 p90<128 p99<128 max<128 64..127:█",
+		"time:            default: timing:TriceTransfer cycles n=1 p50<128 p90<128 p99<128 max<128 64..127:█",
+	}
+	assert.Equal(t, strings.Join(exp, "\n"), strings.TrimSuffix(act, "\n"))
+
+	// The histograms restart with the 4 emitting trices.
+	assert.Equal(t, 4, timingCount(macro, 8))
+	assert.Equal(t, 0, timingCount(transfer, 6))
+	triceTransfer() // drop the deferred copies
+	triceClearOutBuffer()
+	clearTiming()
+}
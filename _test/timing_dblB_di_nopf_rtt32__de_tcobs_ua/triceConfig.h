@@ -0,0 +1,30 @@
+/*! \file triceConfig.h
+\author Thomas.Hoehenleitner [at] seerose.net
+*******************************************************************************/
+
+#ifndef TRICE_CONFIG_H_
+#define TRICE_CONFIG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRICE_DIRECT_OUTPUT 1
+#define TRICE_DIRECT_SEGGER_RTT_32BIT_WRITE 1
+
+#define TRICE_DEFERRED_OUTPUT 1
+#define TRICE_DEFERRED_UARTA 1
+#define TRICE_UARTA
+
+#define TRICE_CGO 1
+#define TRICE_CYCLE_COUNTER 0
+
+#define TRICE_TIMING 1
+uint32_t CgoCycles(void); // fake cycle counter in ../testdata/cgoTiming.c
+#define TRICE_TIMING_CYCLES CgoCycles()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRICE_CONFIG_H_ */
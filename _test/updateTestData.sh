@@ -3,16 +3,17 @@
 # clean history
 rm -f ./testdata/til.json ./testdata/li.json ../examples/F030R8_inst/til.json ../examples/F030R8_inst/li.json ../examples/G0B1_inst/til.json ../examples/G0B1_inst/li.json ../examples/L432KC_gen_ad_toClang_ed_instr/til.json ../examples/L432KC_gen_ad_toClang_ed_instr/li.json
 touch ./testdata/til.json ./testdata/li.json ../examples/F030R8_inst/til.json ../examples/F030R8_inst/li.json ../examples/G0B1_inst/til.json ../examples/G0B1_inst/li.json ../examples/L432KC_gen_ad_toClang_ed_instr/til.json ../examples/L432KC_gen_ad_toClang_ed_instr/li.json
-trice clean -src ./ -src ../examples/exampleData -i ./testdata/til.json -li ./testdata/li.json
+trice clean -src ./ -src ../examples/exampleData -src ../src/triceHealth.c -i ./testdata/til.json -li ./testdata/li.json
 
 #  insert IDs into source code 
 rm -f ./testdata/til.json ./testdata/li.json ../examples/F030R8_inst/til.json ../examples/F030R8_inst/li.json ../examples/G0B1_inst/til.json ../examples/G0B1_inst/li.json ../examples/L432KC_gen_ad_toClang_ed_instr/til.json ../examples/L432KC_gen_ad_toClang_ed_instr/li.json
 touch ./testdata/til.json ./testdata/li.json ../examples/F030R8_inst/til.json ../examples/F030R8_inst/li.json ../examples/G0B1_inst/til.json ../examples/G0B1_inst/li.json ../examples/L432KC_gen_ad_toClang_ed_instr/til.json ../examples/L432KC_gen_ad_toClang_ed_instr/li.json
 trice insert -src ./testdata/triceCheck.c -i ./testdata/til.json -li ./testdata/li.json -IDMin 14000 -IDMax 16199 -IDMethod upward   # This should restore triceCheck.c.
-trice insert -src ../examples/exampleData -i ./testdata/til.json -li ./testdata/li.json              -IDMax 16383 -IDMethod downward # This should restore triceLogSiagData.c.
+trice insert -src ../examples/exampleData -src ../src/triceHealth.c -i ./testdata/til.json -li ./testdata/li.json              -IDMax 16383 -IDMethod downward # This should restore triceLogSiagData.c and triceHealth.c.
 trice insert -src ./                      -i ./testdata/til.json -li ./testdata/li.json -IDMin 16200 -IDMax 16383 -IDMethod upward   # This schoud restore tests and extend til.json.
 
-# The file cgoPackage.go is the same in all cgo test packages, but must be inside the folders.
+# The files cgoPackage.go and cgoBenchmark_test.go are the same in all cgo test packages, but must be inside the folders.
+# The file cgoSimulate_test.go is needed only in the ringB_de_* and dblB_de_* folders.
 # os agnostic links would be better.
 CGOTESTDIRS="
     be_dblB_de_tcobs_ua/
@@ -40,6 +41,7 @@ CGOTESTDIRS="
     dblB_di_nopf_rtt8__de_multi_cobs_ua/
     dblB_di_nopf_rtt8__de_multi_tcobs_ua/
     dblB_di_nopf_rtt8__de_tcobs_ua/
+    protect_dblB_de_tcobs_ua/
     ringB_de_cobs_ua/
     ringB_de_nopf_ua/
     ringB_de_tcobs_ua/
@@ -52,6 +54,7 @@ CGOTESTDIRS="
     ringB_di_nopf_rtt8__de_tcobs_ua/
     ringB_di_tcobs_rtt32__de_tcobs_ua/
     ringB_di_xtea_cobs_rtt32__de_xtea_cobs_ua/
+    ringB_protect_de_tcobs_ua/
     stackB_di_nopf_aux32/
     stackB_di_nopf_aux8/
     stackB_di_nopf_rtt32/
@@ -64,11 +67,19 @@ CGOTESTDIRS="
     staticB_di_tcobs_rtt32/
     staticB_di_tcobs_rtt8/
     staticB_di_xtea_cobs_rtt32/
+    timing_dblB_di_nopf_rtt32__de_tcobs_ua/
+    health_dblB_de_tcobs_ua/
+    spans_dblB_de_tcobs_ua/
 "
 
 for d in $CGOTESTDIRS
 do
     cp ./testdata/cgoPackage.go ./$d/generated_cgoPackage.go
+    cp ./testdata/cgoBenchmark_test.go ./$d/generated_cgoBenchmark_test.go
+    case $d in
+        ringB_de_*|dblB_de_*) # Only the deferred configurations simulateBuffer.sh replays.
+            cp ./testdata/cgoSimulate_test.go ./$d/generated_cgoSimulate_test.go;;
+    esac
 done
 
 go clean -cache
@@ -0,0 +1,115 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package main
+
+import (
+	"bytes"
+	"encoding/binary"
+	"fmt"
+	"net"
+	"strings"
+	"testing"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/rokath/trice/internal/args"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// multiDeviceTrices returns count COBS framed trices with 32-bit target stamps for device dev.
+// Each device has its own cycle counter and time base. If gapAt is > 0, the cycle counter jumps there once.
+func multiDeviceTrices(dev, count, gapAt int) []byte {
+	var out []byte
+	cycle := uint8(0xc0)
+	for seq := 0; seq < count; seq++ {
+		if seq == gapAt && gapAt > 0 {
+			cycle++ // a lost trice
+		}
+		pkg := binary.LittleEndian.AppendUint16(nil, 3<<14|16000)               // 32-bit stamp, ID 16000
+		pkg = binary.LittleEndian.AppendUint32(pkg, multiDeviceStamp(dev, seq)) // target stamp
+		pkg = binary.LittleEndian.AppendUint16(pkg, 8<<8|uint16(cycle))         // 8 parameter bytes and cycle
+		pkg = binary.LittleEndian.AppendUint32(pkg, uint32(dev))
+		pkg = binary.LittleEndian.AppendUint32(pkg, uint32(seq))
+		frame := make([]byte, len(pkg)+2)
+		n := cobs.Encode(frame, pkg)
+		out = append(out, frame[:n]...)
+		out = append(out, 0)
+		cycle++
+		if cycle == 0 {
+			cycle = 0xc0 // the target cycle counter wraps at 0xbf
+		}
+	}
+	return out
+}
+
+// multiDeviceStamp is the target stamp of trice seq from device dev.
+func multiDeviceStamp(dev, seq int) uint32 {
+	return uint32(1000000*(dev+1) + 10*seq)
+}
+
+// TestMultiDevice logs two files and a TCP4 connection in parallel and checks, that each output line carries
+// the prefix, target stamp and cycle check result of its own device. Run it with -race for detecting shared decoder state.
+func TestMultiDevice(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer setupTest(t, fSys)()
+	defer args.FlagsInit() // clearance of the passed flags for following tests (global vars)
+	til := `{
+	"16000": {
+		"Type": "TRice",
+		"Strg": "msg:dev %d seq %d\\n"
+	}
+}`
+	assert.Nil(t, fSys.WriteFile("til.json", []byte(til), 0777))
+
+	const count = 300
+	assert.Nil(t, fSys.WriteFile("dev0.bin", multiDeviceTrices(0, count, 0), 0777))
+	assert.Nil(t, fSys.WriteFile("dev1.bin", multiDeviceTrices(1, count, 100), 0777))
+
+	ln, err := net.Listen("tcp4", "localhost:0")
+	assert.Nil(t, err)
+	defer ln.Close()
+	go func() {
+		conn, err := ln.Accept()
+		if err != nil {
+			return
+		}
+		defer conn.Close()
+		conn.Write(multiDeviceTrices(2, count, 0))
+	}()
+
+	input := []string{"trice", "log",
+		"-port", "FILEBUFFER", "-args", "dev0.bin",
+		"-port", "FILEBUFFER", "-args", "dev1.bin",
+		"-port", "TCP4BUFFER", "-args", ln.Addr().String(),
+		"-pw", "", "-pf", "cobs", "-li", "off", "-hs", "off", "-color", "none", "-prefix", "source: ", "-ts32", "@%d", "-tcp", "", "-blf", "off",
+	}
+	var out bytes.Buffer
+	assert.Nil(t, args.Handler(&out, fSys, input))
+
+	labels := []string{"FILEBUFFER@dev0.bin: ", "FILEBUFFER@dev1.bin: ", "TCP4BUFFER: "}
+	seqs := make([]int, len(labels))
+	var cycleErrors int
+	for _, line := range strings.Split(strings.TrimSpace(out.String()), "\n") {
+		dev := -1
+		for i, label := range labels {
+			if strings.HasPrefix(line, label) {
+				dev = i
+			}
+		}
+		if !assert.True(t, dev >= 0, line) {
+			continue
+		}
+		s := strings.TrimPrefix(line, labels[dev])
+		if i := strings.Index(s, "CYCLE:"); i >= 0 { // "@2001000 CYCLE:\a229!=228 # 1 # msg:dev 1 seq 100"
+			cycleErrors++
+			assert.Equal(t, 1, dev, "cycle error from wrong device:", line)
+			s = s[:i] + strings.TrimPrefix(s[strings.LastIndex(s, "# ")+2:], "msg:")
+		}
+		exp := fmt.Sprintf("@%d dev %d seq %d", multiDeviceStamp(dev, seqs[dev]), dev, seqs[dev])
+		assert.Equal(t, exp, strings.Join(strings.Fields(s), " "))
+		seqs[dev]++
+	}
+	assert.Equal(t, []int{count, count, count}, seqs)
+	assert.Equal(t, 1, cycleErrors)
+}
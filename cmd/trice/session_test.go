@@ -0,0 +1,64 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package main
+
+import (
+	"bytes"
+	"fmt"
+	"io"
+	"strings"
+	"testing"
+
+	"github.com/rokath/trice/internal/args"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// TestSession checks, that a session decodes data fed in pieces like the BUFFER port and that sessions with different flags
+// can alternate with each other and with Handler calls.
+func TestSession(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer setupTest(t, fSys)()
+
+	til := `{
+	"16201": {
+		"Type": "TRice",
+		"Strg": "w: Hello! 👋🙂\\n"
+	}
+}`
+	assert.Nil(t, fSys.WriteFile("til.json", []byte(til), 0777))
+	encrypted := []byte{0x09, 0x92, 0x19, 0x06, 0x45, 0x0b, 0x10, 0x56, 0x3a, 0x00} // see handleConnection
+	plain := []byte{0x03, 0x49, 0xff, 0x01, 0x01, 0x01, 0x02, 0xc0, 0x01, 0x00}     // the same trice COBS encoded without padding
+	encFlags := []string{"-pw", "MySecret", "-pf", "cobs", "-li", "off", "-hs", "off", "-color", "none", "-prefix", "off", "-ts", "off"}
+	decFlags := []string{"-pw", "", "-pf", "cobs", "-li", "off", "-hs", "off", "-color", "none", "-prefix", "off", "-ts", "off"}
+	handler := func(flags []string, b []byte) string { // handler logs b with a -p BUFFER Handler call.
+		var out bytes.Buffer
+		buf := fmt.Sprint(b)
+		assert.Nil(t, args.Handler(&out, fSys, append([]string{"trice", "log", "-p", "BUFFER", "-args", buf[1 : len(buf)-1]}, flags...)))
+		return out.String()
+	}
+	expect := handler(encFlags, encrypted)
+	assert.True(t, strings.HasSuffix(expect, "Hello! 👋🙂\n"), expect)
+	expectPlain := handler(decFlags, plain)
+	assert.True(t, strings.HasSuffix(expectPlain, "Hello! 👋🙂\n"), expectPlain)
+
+	enc, err := args.NewSession(io.Discard, fSys, encFlags...)
+	assert.Nil(t, err)
+	dec, err := args.NewSession(io.Discard, fSys, decFlags...)
+	assert.Nil(t, err)
+
+	act, err := enc.Decode(encrypted[:4])
+	assert.Nil(t, err)
+	assert.Equal(t, "", act, "incomplete package")
+	act, err = dec.Decode(plain)
+	assert.Nil(t, err)
+	assert.Equal(t, expectPlain, act)
+	act, err = enc.Decode(encrypted[4:])
+	assert.Nil(t, err)
+	assert.Equal(t, expect, act, "package completed")
+	assert.Equal(t, expectPlain, handler(decFlags, plain))
+	act, err = enc.Decode(append(encrypted, encrypted...))
+	assert.Nil(t, err)
+	assert.Equal(t, expect+expect, act)
+}
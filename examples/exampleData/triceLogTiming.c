@@ -0,0 +1,31 @@
+/*! \file triceLogTiming.c
+\author Thomas.Hoehenleitner [at] seerose.net
+*******************************************************************************/
+
+#include "trice.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if TRICE_TIMING == 1
+
+//! TriceLogTiming emits the cycle histograms of the TRICE_TIMING instrumentation and clears them.
+//! The histograms are copied first, because the emitting trices are measured as well.
+void TriceLogTiming(void) {
+	uint16_t histogram[TriceTimingPaths][TRICE_TIMING_BUCKETS];
+	TRICE_ENTER_CRITICAL_SECTION
+	memcpy(histogram, TriceTimingHistogram, sizeof(histogram));
+	memset(TriceTimingHistogram, 0, sizeof(histogram));
+	TRICE_LEAVE_CRITICAL_SECTION
+	trice16B(iD(16369), "timing:TRICE cycles %u\n", histogram[TriceTimingMacro], TRICE_TIMING_BUCKETS);
+	trice16B(iD(16368), "timing:critical section cycles %u\n", histogram[TriceTimingCritical], TRICE_TIMING_BUCKETS);
+#if TRICE_DIRECT_OUTPUT == 1
+	trice16B(iD(16367), "timing:direct output cycles %u\n", histogram[TriceTimingDirect], TRICE_TIMING_BUCKETS);
+#endif
+#if TRICE_DEFERRED_OUTPUT == 1
+	trice16B(iD(16366), "timing:TriceTransfer cycles %u\n", histogram[TriceTimingTransfer], TRICE_TIMING_BUCKETS);
+#endif
+}
+
+#endif // #if TRICE_TIMING == 1
@@ -215,7 +215,7 @@ func (p *cobsDec) Read(b []byte) (n int, err error) {
 	}
 	if cycle != 0xc0 { // with cycle counter and s.th. lost
 		if cycle != p.cycle { // no cycle check for 0xc0 to avoid messages on every target reset and when no cycle counter is active
-			n += copy(b[n:], fmt.Sprint("CYCLE:", cycle, "!=", p.cycle, "- adjusting. Now", emitter.ColorChannelEvents("CYCLE")+1, "CycleEvents\a"))
+			n += copy(b[n:], fmt.Sprint("CYCLE:", cycle, "!=", p.cycle, "- adjusting. Now", emitter.ColorChannelEvents("", "CYCLE")+1, "CycleEvents\a"))
 			p.cycle = cycle // adjust cycle
 		}
 		decoder.InitialCycle = false
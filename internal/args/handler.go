@@ -11,6 +11,7 @@ import (
 	"io"
 	"os"
 	"runtime/debug"
+	"strings"
 	"sync"
 	"time"
 
@@ -20,8 +21,10 @@ import (
 	"github.com/rokath/trice/internal/do"
 	"github.com/rokath/trice/internal/emitter"
 	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/profile"
 	"github.com/rokath/trice/internal/receiver"
 	"github.com/rokath/trice/internal/translator"
+	"github.com/rokath/trice/internal/trexDecoder"
 	"github.com/rokath/trice/pkg/cipher"
 	"github.com/rokath/trice/pkg/msg"
 	"github.com/spf13/afero"
@@ -30,6 +33,8 @@ import (
 // Handler is called in main, evaluates args and calls the appropriate functions.
 // It returns for program exit.
 func Handler(w io.Writer, fSys *afero.Afero, args []string) error {
+	defer emitter.CloseFanOuts() // write the queued output of all sub-commands
+	defer profile.Stop()         // write the profiles and the stage summary before the queued output
 
 	if Date == "" { // goreleaser will set Date, otherwise use file info.
 		path, err := os.Executable()
@@ -123,19 +128,42 @@ func Handler(w io.Writer, fSys *afero.Afero, args []string) error {
 		msg.OnErr(fsScSv.Parse(subArgs))
 		w = do.DistributeArgs(w, fSys, LogfileName, Verbose)
 		return emitter.ScDisplayServer(w) // endless loop
+	case "ix", "index":
+		msg.OnErr(fsScIndex.Parse(subArgs))
+		w = do.DistributeArgs(w, fSys, LogfileName, Verbose)
+		return scIndex(w, fSys)
+	case "bw", "bandwidth":
+		msg.OnErr(fsScBandwidth.Parse(subArgs))
+		w = do.DistributeArgs(w, fSys, LogfileName, Verbose)
+		return scBandwidth(w, fSys)
+	case "sp", "spans":
+		msg.OnErr(fsScSpans.Parse(subArgs))
+		w = do.DistributeArgs(w, fSys, LogfileName, Verbose)
+		return scSpans(w, fSys)
 	case "l", "log":
-		id.Logging = true
-		msg.OnErr(fsScLog.Parse(subArgs))
-		decoder.TargetTimeStampUnitPassed = isLogFlagPassed("ts")
-		decoder.ShowTargetStamp32Passed = isLogFlagPassed("ts32")
-		decoder.ShowTargetStamp16Passed = isLogFlagPassed("ts16")
-		decoder.ShowTargetStamp0Passed = isLogFlagPassed("ts0")
+		msg.OnErr(parseLogFlags(subArgs))
 		w = do.DistributeArgs(w, fSys, LogfileName, Verbose)
+		if err := profile.Start(w, fSys); err != nil {
+			return err
+		}
 		logLoop(w, fSys) // endless loop
 		return nil
 	}
 }
 
+// parseLogFlags sets the log sub-command flags from subArgs.
+func parseLogFlags(subArgs []string) error {
+	id.Logging = true
+	logPorts, logArgs = nil, nil
+	activeSession = nil // the flags of a session are changed now
+	err := fsScLog.Parse(subArgs)
+	decoder.TargetTimeStampUnitPassed = isLogFlagPassed("ts")
+	decoder.ShowTargetStamp32Passed = isLogFlagPassed("ts32")
+	decoder.ShowTargetStamp16Passed = isLogFlagPassed("ts16")
+	decoder.ShowTargetStamp0Passed = isLogFlagPassed("ts0")
+	return err
+}
+
 // https://stackoverflow.com/questions/35809252/check-if-flag-was-provided-in-go
 func isLogFlagPassed(name string) bool {
 	found := false
@@ -154,6 +182,71 @@ type selector struct {
 
 // logLoop prepares writing and lut and provides a retry mechanism for unplugged UART.
 func logLoop(w io.Writer, fSys *afero.Afero) {
+	setupLog(w)
+	ilu, m, li := loadLogLuts(w, fSys)
+	if translator.MetricsAddress != "off" && translator.MetricsAddress != "none" {
+		ln, err := translator.ServeMetrics(w, translator.MetricsAddress, ilu, m)
+		if err != nil {
+			fmt.Fprintln(w, err)
+			return
+		}
+		defer ln.Close()
+	}
+
+	exporting := translator.ExportFileName != "off" && translator.ExportFileName != "none"
+	if exporting && (len(logPorts) > 1 || strings.ToUpper(receiver.Port) == "TCP4SERVER") {
+		fmt.Fprintln(w, "-export needs a single port other than TCP4SERVER")
+		return
+	}
+	if len(logPorts) > 1 {
+		logDevices(w, fSys, ilu, m, li)
+		return
+	}
+	if strings.ToUpper(receiver.Port) == "TCP4SERVER" {
+		logTCP4Server(w, ilu, m, li)
+		return
+	}
+
+	sw := emitter.New(w)
+	var interrupted bool
+	var counter int
+
+	for {
+		rwc, e := receiver.NewReadWriteCloser(w, fSys, Verbose, receiver.Port, receiver.PortArguments)
+		if e != nil {
+			fmt.Fprintln(w, e)
+			if !interrupted {
+				return // hopeless
+			}
+			time.Sleep(1000 * time.Millisecond) // retry interval
+			fmt.Fprintf(w, "\rsig:(re-)setup input port...%d", counter)
+			counter++
+			continue
+		}
+		defer func(c io.Closer) { msg.OnErr(c.Close()) }(rwc)
+		interrupted = true
+		if receiver.ShowInputBytes {
+			rwc = receiver.NewBytesViewer(w, rwc)
+		}
+		if receiver.BinaryLogfileName != "off" && receiver.BinaryLogfileName != "none" {
+			rwc = receiver.NewBinaryLogger(w, fSys, rwc)
+			defer func(c io.Closer) { msg.OnErr(c.Close()) }(rwc) // flush the binary logfile
+		}
+		if exporting {
+			if e = translator.Export(w, fSys, ilu, m, rwc, translator.ExportFileName); e != io.EOF {
+				fmt.Fprintln(w, e)
+			}
+			return
+		}
+		e = translator.Translate(w, sw, ilu, m, li, rwc)
+		if io.EOF == e {
+			return // end of predefined buffer
+		}
+	}
+}
+
+// setupLog applies the log settings depending on other settings.
+func setupLog(w io.Writer) {
 	msg.FatalOnErr(cipher.SetUp(w)) // does nothing when -password is ""
 	if decoder.TestTableMode {
 		// set switches if they not set already
@@ -172,14 +265,16 @@ func logLoop(w io.Writer, fSys *afero.Afero) {
 		}
 		decoder.TargetStamp32 = "" // todo: justify this line
 	}
+}
 
-	var ilu id.TriceIDLookUp
+// loadLogLuts loads the ID list and the location information according to the log settings.
+func loadLogLuts(w io.Writer, fSys *afero.Afero) (ilu id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUpLI) {
 	if id.FnJSON == "emptyFile" { // reserved name for tests only
 		ilu = make(id.TriceIDLookUp)
 	} else {
 		ilu = id.NewLut(w, fSys, id.FnJSON) // lut is a map, that means a pointer
 	}
-	m := new(sync.RWMutex) // m is a pointer to a read write mutex for lu
+	m = new(sync.RWMutex) // m is a pointer to a read write mutex for lu
 	m.Lock()
 	ilu.AddFmtCount(w)
 	m.Unlock()
@@ -187,8 +282,6 @@ func logLoop(w io.Writer, fSys *afero.Afero) {
 	// This way trice needs NOT to be restarted during development process.
 	////////////////////////////////////////// go ilu.FileWatcher(w, fSys, m)
 
-	var li id.TriceIDLookUpLI // nil
-
 	if id.LIFnJSON == "emptyFile" { // reserved name for tests only
 		li = make(id.TriceIDLookUpLI) // li is not nil, but empty
 	} else {
@@ -206,36 +299,134 @@ func logLoop(w io.Writer, fSys *afero.Afero) {
 			/////////////////////////////////////////////////go li.FileWatcher(w, fSys)
 		}
 	}
+	return
+}
 
-	sw := emitter.New(w)
-	var interrupted bool
-	var counter int
-
-	for {
-		rwc, e := receiver.NewReadWriteCloser(w, fSys, Verbose, receiver.Port, receiver.PortArguments)
+// logDevices logs all -port and -args pairs in parallel.
+// A port without -args uses "default". Not openable devices are reported and skipped.
+func logDevices(w io.Writer, fSys *afero.Afero, ilu id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUpLI) {
+	labels := deviceLabels(logPorts, logArgs)
+	composers := emitter.NewDevices(w, labels)
+	var devices []translator.Device
+	for i, port := range logPorts {
+		portArgs := "default"
+		if i < len(logArgs) {
+			portArgs = logArgs[i]
+		}
+		rwc, e := receiver.NewReadWriteCloser(w, fSys, Verbose, port, portArgs)
 		if e != nil {
 			fmt.Fprintln(w, e)
-			if !interrupted {
-				return // hopeless
-			}
-			time.Sleep(1000 * time.Millisecond) // retry interval
-			fmt.Fprintf(w, "\rsig:(re-)setup input port...%d", counter)
-			counter++
 			continue
 		}
-		defer func() { msg.OnErr(rwc.Close()) }()
-		interrupted = true
+		defer func(c io.Closer) { msg.OnErr(c.Close()) }(rwc)
 		if receiver.ShowInputBytes {
 			rwc = receiver.NewBytesViewer(w, rwc)
 		}
 		if receiver.BinaryLogfileName != "off" && receiver.BinaryLogfileName != "none" {
-			rwc = receiver.NewBinaryLogger(w, fSys, rwc)
+			rwc = receiver.NewDeviceBinaryLogger(w, fSys, rwc, labels[i])
+			defer func(c io.Closer) { msg.OnErr(c.Close()) }(rwc) // flush the binary logfile
 		}
-		e = translator.Translate(w, sw, ilu, m, li, rwc)
-		if io.EOF == e {
-			return // end of predefined buffer
+		devices = append(devices, translator.Device{Port: strings.ToUpper(port), Label: labels[i], RWC: rwc, SW: composers[i]})
+	}
+	if len(devices) == 0 {
+		return
+	}
+	e := translator.TranslateDevices(w, ilu, m, li, devices)
+	if e != io.EOF {
+		fmt.Fprintln(w, e)
+	}
+}
+
+// logTCP4Server logs all clients connecting to the TCP4SERVER port.
+func logTCP4Server(w io.Writer, ilu id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUpLI) {
+	address := receiver.PortArguments
+	if address == "default" {
+		address = receiver.DefaultTCP4ServerArgs
+	}
+	srv, e := receiver.NewTCP4Server(w, address)
+	if e != nil {
+		fmt.Fprintln(w, e)
+		return
+	}
+	msg.OnErr(translator.TranslateTCP4Server(w, emitter.NewDeviceOutput(w), ilu, m, li, srv))
+}
+
+// deviceLabels returns the port names as device labels. Ports used several times get their args appended.
+func deviceLabels(ports, portArgs []string) []string {
+	count := make(map[string]int)
+	for _, port := range ports {
+		count[strings.ToUpper(port)]++
+	}
+	labels := make([]string, len(ports))
+	for i, port := range ports {
+		labels[i] = port
+		if count[strings.ToUpper(port)] > 1 && i < len(portArgs) {
+			labels[i] = port + "@" + portArgs[i]
 		}
 	}
+	return labels
+}
+
+// scIndex is sub-command 'index'. It writes the index of the binary logfile indexArgs.
+func scIndex(w io.Writer, fSys *afero.Afero) error {
+	f := receiver.IndexFormat{
+		Framing:        decoder.PackageFraming,
+		IDBits:         decoder.IDBits,
+		BigEndian:      translator.TriceEndianness == "bigEndian",
+		Doubled16BitID: trexDecoder.Doubled16BitID,
+	}
+	start := time.Now()
+	idx, err := receiver.BuildIndex(fSys, indexArgs, f)
+	if err != nil {
+		return err
+	}
+	if indexList {
+		idx.List(w)
+	}
+	fmt.Fprintln(w, "Indexed", idx.Size, "bytes in", len(idx.Blocks), "blocks into", receiver.IndexFileName(indexArgs), "in", time.Since(start).Round(time.Millisecond))
+	return nil
+}
+
+// scBandwidth is sub-command 'bandwidth'. It reports the bandwidth cost of each ID and channel in a binary logfile.
+func scBandwidth(w io.Writer, fSys *afero.Afero) error {
+	if err := cipher.SetUp(w); err != nil { // does nothing when -password is ""
+		return err
+	}
+	lut := id.NewLut(w, fSys, id.FnJSON)
+	rwc, err := receiver.NewReadWriteCloser(w, fSys, Verbose, "FILEBUFFER", bandwidthArgs)
+	if err != nil {
+		return err
+	}
+	defer rwc.Close()
+	start := time.Now()
+	if err = translator.Bandwidth(w, fSys, lut, new(sync.RWMutex), rwc); err != io.EOF {
+		return err
+	}
+	if Verbose {
+		fmt.Fprintln(w, "Scanned", bandwidthArgs, "in", time.Since(start).Round(time.Millisecond))
+	}
+	return nil
+}
+
+// scSpans is sub-command 'spans'. It writes the span trices in a binary logfile as Chrome Trace Event JSON and reports the span statistics.
+func scSpans(w io.Writer, fSys *afero.Afero) error {
+	if err := cipher.SetUp(w); err != nil { // does nothing when -password is ""
+		return err
+	}
+	lut := id.NewLut(w, fSys, id.FnJSON)
+	rwc, err := receiver.NewReadWriteCloser(w, fSys, Verbose, "FILEBUFFER", spansArgs)
+	if err != nil {
+		return err
+	}
+	defer rwc.Close()
+	start := time.Now()
+	if err = translator.Spans(w, fSys, lut, new(sync.RWMutex), rwc); err != io.EOF {
+		return err
+	}
+	if Verbose {
+		fmt.Fprintln(w, "Scanned", spansArgs, "in", time.Since(start).Round(time.Millisecond))
+	}
+	return nil
 }
 
 // scVersion is sub-command 'version'. It prints version information.
@@ -32,6 +32,9 @@ func scHelp(w io.Writer) error {
 		{allHelp || insertIDsHelp, insertIDsInfo},
 		//{allHelp || zeroIDsHelp, zeroIDsInfo},
 		{allHelp || cleanIDsHelp, cleanIDsInfo},
+		{allHelp || indexHelp, indexInfo},
+		{allHelp || bandwidthHelp, bandwidthInfo},
+		{allHelp || spansHelp, spansInfo},
 	}
 	for _, z := range x {
 		if z.flag {
@@ -74,6 +77,38 @@ func logInfo(w io.Writer) error {
 	return e
 }
 
+func indexInfo(w io.Writer) error {
+	_, e := fmt.Fprintln(w, `sub-command 'ix|index': Builds an index for a binary logfile to decode only parts of it.
+#	The index records per block the byte offset, the target stamp range, the first cycle counter and the contained IDs.
+#	"trice log -p FILEBUFFER" uses the index with the switches -queryOffset, -queryStamps and -queryIDs.
+#	Example: 'trice ix -args trice.bin': Write the index trice.bin.tix.
+#	Example: 'trice l -p FILEBUFFER -args trice.bin -queryIDs 12,100-199': Decode only the index blocks containing these IDs.`)
+	fsScIndex.SetOutput(w)
+	fsScIndex.PrintDefaults()
+	return e
+}
+
+func bandwidthInfo(w io.Writer) error {
+	_, e := fmt.Fprintln(w, `sub-command 'bw|bandwidth': Reports the link bandwidth cost of each trice ID and channel in a binary logfile.
+#	The trices are decoded without formatting. The report is sorted by the framed bytes, which include the package share of the framing, padding and encryption.
+#	Example: 'trice bw -args trice.bin -pf COBS': Show count, bytes, average size, share of the total bandwidth and rates of each ID and channel.
+#	Example: 'trice bw -args trice.bin -csv cost.csv': Write the report additionally into cost.csv.`)
+	fsScBandwidth.SetOutput(w)
+	fsScBandwidth.PrintDefaults()
+	return e
+}
+
+func spansInfo(w io.Writer) error {
+	_, e := fmt.Fprintln(w, `sub-command 'sp|spans': Profiles the firmware functions marked with span trices in a binary logfile.
+#	The span trices TriceSpanEnter and TriceSpanExit are paired to nested spans, which are written as Chrome Trace Event JSON.
+#	The calls, total and self time of each span name are reported. Spans with lost exit trices are marked as missing exits.
+#	Example: 'trice sp -args trice.bin -o trace.json': Write trace.json, viewable with chrome://tracing or https://ui.perfetto.dev.
+#	Example: 'trice sp -args trice.bin -tick32 100ns -csv spans.csv': Use 10 MHz 32-bit target stamps and write the statistics additionally into spans.csv.`)
+	fsScSpans.SetOutput(w)
+	fsScSpans.PrintDefaults()
+	return e
+}
+
 func scanInfo(w io.Writer) error {
 	_, e := fmt.Fprintln(w, `sub-command 's|scan': Shows available serial ports)
 #	Example: 'trice s': Show COM ports.`)
@@ -12,6 +12,7 @@ import (
 	"github.com/rokath/trice/internal/do"
 	"github.com/rokath/trice/internal/emitter"
 	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/profile"
 	"github.com/rokath/trice/internal/receiver"
 	"github.com/rokath/trice/internal/translator"
 	"github.com/rokath/trice/internal/trexDecoder"
@@ -52,6 +53,9 @@ func FlagsInit() {
 	dsInit()
 	scanInit()
 	sdInit()
+	indexInit()
+	bandwidthInit()
+	spansInit()
 }
 
 func helpInit() {
@@ -79,6 +83,12 @@ func helpInit() {
 	//  fsScHelp.BoolVar(&zeroIDsHelp, "z", false, "Show zeroSourceTreeIds specific help.")
 	fsScHelp.BoolVar(&cleanIDsHelp, "clean", false, "Show c|clean specific help.")
 	fsScHelp.BoolVar(&cleanIDsHelp, "c", false, "Show c|clean specific help.")
+	fsScHelp.BoolVar(&indexHelp, "index", false, "Show ix|index specific help.")
+	fsScHelp.BoolVar(&indexHelp, "ix", false, "Show ix|index specific help.")
+	fsScHelp.BoolVar(&bandwidthHelp, "bandwidth", false, "Show bw|bandwidth specific help.")
+	fsScHelp.BoolVar(&bandwidthHelp, "bw", false, "Show bw|bandwidth specific help.")
+	fsScHelp.BoolVar(&spansHelp, "spans", false, "Show sp|spans specific help.")
+	fsScHelp.BoolVar(&spansHelp, "sp", false, "Show sp|spans specific help.")
 	flagLogfile(fsScHelp)
 	flagVerbosity(fsScHelp)
 }
@@ -121,12 +131,15 @@ This timestamp switch generates the timestamps on the PC only (reception time),
 	fsScLog.StringVar(&emitter.Prefix, "prefix", defaultPrefix, "Line prefix, options: any string or 'off|none' or 'source:' followed by 0-12 spaces, 'source:' will be replaced by source value e.g., 'COM17:'.") // flag
 	fsScLog.StringVar(&emitter.Suffix, "suffix", "", "Append suffix to all lines, options: any string.")                                                                                                           // flag
 
-	info := `Case insensitive receiver device name: 'serial name|JLINK|STLINK|FILE|FILEBUFFER|TCP4|TCP4BUFFER|DEC|BUFFER|HEX|DUMP. 
+	info := `Case insensitive receiver device name: 'serial name|JLINK|STLINK|FILE|FILEBUFFER|TCP4|TCP4BUFFER|TCP4SERVER|UDP4|UNIX|STDIN|DEC|BUFFER|HEX|DUMP. 
 The serial name is like 'COM12' for Windows or a Linux name like '/dev/tty/usb12'. 
 Using a virtual serial COM port on the PC over a FTDI USB adapter is a most likely variant.
+Use several -port switches to log several devices in parallel into one output. The n-th -args belongs to the n-th -port.
+The 'source:' prefix is then replaced by the device name.
 `
-	fsScLog.StringVar(&receiver.Port, "port", "J-LINK", info)           // flag
-	fsScLog.StringVar(&receiver.Port, "p", "J-LINK", "short for -port") // short flag
+	receiver.Port = "J-LINK"
+	fsScLog.Var(repeatableString{&receiver.Port, &logPorts}, "port", info)           // multi flag
+	fsScLog.Var(repeatableString{&receiver.Port, &logPorts}, "p", "short for -port") // short multi flag
 	fsScLog.IntVar(&com.BaudRate, "baud", 115200, `Set the serial port baudrate.
 It is the only setup parameter. The other values default to 8N1 (8 data bits, no parity, one stopbit).
 `)
@@ -145,17 +158,29 @@ port "FILE": default="`, receiver.DefaultFileArgs, `", Option for args is any fi
 port "FILEBUFFER": default="`, receiver.DefaultFileArgs, `", Option for args is any file name for binary log data like written []byte{115, 111, 109, 101, 10}. Trice stops on EOF.
 port "TCP4": default="`, receiver.DefaultTCP4Args, `", use any IP:port endpoint like "127.0.0.1:19021". This port is usable for reading, when the Trice logs go into a TCP server.
 port "TCP4BUFFER": default="`, receiver.DefaultTCP4Args, `". This port is used for "-port TCP4" testing, to shutdown the Trice tool automatically.
+port "TCP4SERVER": default="`, receiver.DefaultTCP4ServerArgs, `", use any local IP:port endpoint to listen on. Many clients can push their trice streams in parallel.
+	Each client output line is tagged with its remote address or with the device name announced in a first line like "#device:board17\n".
+port "UDP4": default="`, receiver.DefaultUDP4Args, `", use any local IP:port endpoint to listen on. Each datagram carries one or more complete trice packages. Lost datagrams are shown as CYCLE errors.
+port "UNIX": default="`, receiver.DefaultUNIXArgs, `", use any Unix domain stream socket path, where for example a target simulator serves its trice output.
+port "STDIN": args are ignored. Usable like "simulator | trice log -p STDIN". Trice stops at the end of the input.
 port "DEC" or "BUFFER": default="`, receiver.DefaultBUFFERArgs, `", Option for args is any space separated decimal number byte sequence. Example -p BUFFER -args "7 123 44".
 port "HEX" or "DUMP": default="`, receiver.DefaultDumpArgs, `", Option for args is any space or comma separated byte sequence in hex. Example: -p DUMP -args "7B 1A ee,88, 5a".
 `)
 
 	execInfo := `Use to pass an additional command line for port TCP4 (like gdbserver start).`
 
-	fsScLog.StringVar(&receiver.PortArguments, "args", "default", argsInfo)
+	receiver.PortArguments = "default"
+	fsScLog.Var(repeatableString{&receiver.PortArguments, &logArgs}, "args", argsInfo) // multi flag
 	fsScLog.StringVar(&do.TCPOutAddr, "tcp", "", `TCP address for an external log receiver like Putty. Example: 1st: "trice log -p COM1 -tcp localhost:64000", 2nd "putty". In "Terminal" enable "Implicit CR in every LF", In "Session" Connection type:"Other:Telnet", specify "hostname:port" here like "localhost:64000".`)
+	fsScLog.StringVar(&emitter.OutputPolicy, "outPolicy", emitter.OutputPolicy, `Queue full policy of the outputs "terminal", "logfile" and "tcp" as comma separated list. Options are 'block|dropNewest|dropOldest'.
+With a logfile or TCP output, each output gets its own queue, so a slow output does not stall the others, unless its policy is "block".
+Dropped writes are counted and reported at the end.`)
+	fsScLog.IntVar(&emitter.OutputQueue, "outQueue", emitter.OutputQueue, `Count of writes each output queue can hold. See "-outPolicy".`)
 	fsScLog.BoolVar(&emitter.DisplayRemote, "displayserver", false, `Send trice lines to displayserver @ ipa:ipp.
 Example: "trice l -port COM38 -ds -ipa 192.168.178.44" sends trice output to a previously started display server in the same network.`)
 	fsScLog.BoolVar(&emitter.DisplayRemote, "ds", false, "Short for '-displayserver'.")
+	fsScLog.IntVar(&emitter.DisplayServerBatch, "dsBatch", 256, `Maximum count of trice lines sent together to the displayserver. Lines wait at most 20 ms for a batch.
+If the displayserver cannot keep up, lines are dropped and counted. Use 0 for one synchronous call per line without drops.`)
 	fsScLog.BoolVar(&trexDecoder.Doubled16BitID, "doubled16BitID", false, `Tells, that 16-bit IDs are doubled. That switch is needed when un-routed direct output is used like (TRICE_DIRECT_SEGGER_RTT_32BIT_WRITE == 1), but also with double buffer in (TRICE_DEFERRED_TRANSFER_MODE==TRICE_MULTI_PACK_MODE) and XTEA encryption. Read the user guide for more details.`)
 	fsScLog.BoolVar(&trexDecoder.Doubled16BitID, "d16", false, "Short for '-Doubled16BitID'.")
 
@@ -175,6 +200,17 @@ Example: "trice l -port COM38 -ds -ipa 192.168.178.44" sends trice output to a p
 	fsScLog.BoolVar(&decoder.TestTableMode, "testTable", false, `Generate testTable output and ignore -prefix, -suffix, -ts, -color. `+boolInfo)
 	flagLogfile(fsScLog)
 	flagBinaryLogfile(fsScLog)
+	flagIndexQuery(fsScLog)
+	fsScLog.StringVar(&translator.ExportFileName, "export", "off", `Write the numeric trice parameters into this columnar file instead of displaying trice lines. Options are 'off|filename'.
+Each trice ID gets a column group with a stamp column and one typed column per parameter. The schema is derived from the til.json file.
+String and buffer trices are not exported. Needs "-encoding TREX" and a single port. Use package "pkg/columnar" to read the file.`)
+	fsScLog.StringVar(&translator.MetricsAddress, "metrics", "off", `Serve decoder counters in the Prometheus text format on http://address/metrics. Options are 'off|address'. Example: "-metrics :9464" listens on localhost:9464.
+The counters are received bytes, packages, framing errors, cycle gaps, decode errors, unknown IDs, trices and bytes per ID and per channel, filtered trices and dropped output writes.`)
+	fsScLog.StringVar(&profile.CPUFileName, "cpuProfile", "off", `Write a pprof CPU profile of the log processing into this file. Options are 'off|filename'. Inspect it with "go tool pprof trice filename".`)
+	fsScLog.StringVar(&profile.MemFileName, "memProfile", "off", `Write a pprof heap profile at the log end into this file. Options are 'off|filename'.`)
+	fsScLog.StringVar(&profile.TraceFileName, "traceProfile", "off", `Write a runtime execution trace of the log processing into this file. Options are 'off|filename'. Inspect it with "go tool trace filename".`)
+	fsScLog.StringVar(&profile.Stages, "stages", "off", `Count items, bytes, time and queue waits of the receive, deframe, decode, format, compose and output stages. Options are 'off|exit|duration'.
+With "exit" a summary is displayed at the log end, with a duration like "10s" additionally periodically. The counting costs a few percent throughput.`)
 	flagVerbosity(fsScLog)
 	flagIDList(fsScLog)
 	flagLIList(fsScLog)
@@ -214,6 +250,13 @@ func insertIDsInit() {
 	fsScInsert.BoolVar(&id.ExtendMacrosWithParamCount, "addParamCount", false, "Extend TRICE macro names with the parameter count _n to enable compile time checks.")
 	fsScInsert.BoolVar(&id.TriceCacheEnabled, "cache", false, `Use "~/.trice/cache/" for fast ID insert (EXPERIMENTAL!). The folder must exist.`)
 	fsScInsert.BoolVar(&id.SpaceAfterTriceOpeningBrace, "spacing", false, "Add space between Trice opening brace and ID name. Use this if your default code auto-formatting is with space after opening brace.")
+	fsScInsert.StringVar(&id.StripHeaderFn, "stripHeader", "off", `Generate a C header defining TRICE_ID_ENABLE_n for each ID n, like "triceStrip.h". Options are: 'off|none|filename'.
+Included in triceConfig.h, the trice macros of IDs disabled with -stripChannels compile to nothing. The header is written only, when its content changed.
+`)
+	fsScInsert.Var(&id.StripChannels, "stripChannels", `Channel(s) to disable inside the -stripHeader file. This is a multi-flag switch with colon separated channel descriptors.
+Example: "-stripChannels dbg:diag" disables all trices with format strings starting with "dbg:" or "diag:". The case is ignored, other variants like "debug" need to be listed too.
+`)
+	fsScInsert.BoolVar(&id.Watch, "watch", false, `Keep running after the insert and insert IDs into each source file as soon as it is saved. til.json and li.json are updated immediately. Stop with Ctrl-C.`)
 }
 
 //  func zeroInit() {
@@ -249,6 +292,61 @@ func sdInit() {
 	flagIPAddress(fsScSdSv)
 }
 
+func indexInit() {
+	fsScIndex = flag.NewFlagSet("index", flag.ContinueOnError) // sub-command
+	fsScIndex.StringVar(&indexArgs, "args", receiver.DefaultFileArgs, `The binary logfile to index. The index is written into the same name with ".tix" appended.
+Timed and compressed binary logfiles cannot be indexed.`)
+	fsScIndex.IntVar(&receiver.IndexBlockSize, "blockSize", receiver.IndexBlockSize, `Approximate byte count of an indexed block. Smaller blocks make queries more selective and the index bigger.`)
+	fsScIndex.BoolVar(&indexList, "list", false, `List the index blocks with offset, size, target stamp range, first cycle counter and ID count. `+boolInfo)
+	fsScIndex.StringVar(&decoder.PackageFraming, "packageFraming", "TCOBSv1", `Use "COBS" as alternative. Framing "none" cannot be indexed.`)
+	fsScIndex.StringVar(&decoder.PackageFraming, "pf", "TCOBSv1", "Short for '-packageFraming'.")
+	fsScIndex.StringVar(&translator.TriceEndianness, "triceEndianness", "littleEndian", `Target endianness trice data stream. Option: "bigEndian".`)
+	fsScIndex.BoolVar(&trexDecoder.Doubled16BitID, "doubled16BitID", false, `Tells, that 16-bit IDs are doubled, see "trice h -log".`)
+	fsScIndex.BoolVar(&trexDecoder.Doubled16BitID, "d16", false, "Short for '-Doubled16BitID'.")
+	flagLogfile(fsScIndex)
+	flagVerbosity(fsScIndex)
+}
+
+func bandwidthInit() {
+	fsScBandwidth = flag.NewFlagSet("bandwidth", flag.ContinueOnError) // sub-command
+	fsScBandwidth.StringVar(&bandwidthArgs, "args", receiver.DefaultFileArgs, `The binary logfile to scan. Timed and compressed binary logfiles are possible.`)
+	fsScBandwidth.StringVar(&translator.BandwidthCSV, "csv", "off", `Write the report additionally into this CSV file. Options are 'off|filename'.`)
+	fsScBandwidth.DurationVar(&translator.BandwidthInterval, "interval", translator.BandwidthInterval, `Time window for the peak rates.`)
+	fsScBandwidth.StringVar(&translator.BandwidthStampUnit, "stampUnit", "us", `Unit of the 32-bit target stamps, options: 'us|ms'. The rates use the host timestamps of timed binary logfiles or else the 32-bit target stamps.`)
+	fsScBandwidth.StringVar(&translator.BandwidthTrace, "trace", "off", `Write the trice sequence into this CSV file. Options are 'off|filename'.
+Each row has the target time in us since the first 32-bit stamp, the ID, the stamp size and the parameter byte count.
+It is the input for the target buffer simulation, see _test/ReadMe.md.`)
+	fsScBandwidth.StringVar(&decoder.PackageFraming, "packageFraming", "TCOBSv1", `Use "none" or "COBS" as alternative.`)
+	fsScBandwidth.StringVar(&decoder.PackageFraming, "pf", "TCOBSv1", "Short for '-packageFraming'.")
+	fsScBandwidth.StringVar(&cipher.Password, "password", "", `The decrypt passphrase, see "trice h -log".`)
+	fsScBandwidth.StringVar(&cipher.Password, "pw", "", "Short for -password.")
+	fsScBandwidth.StringVar(&translator.TriceEndianness, "triceEndianness", "littleEndian", `Target endianness trice data stream. Option: "bigEndian".`)
+	fsScBandwidth.BoolVar(&trexDecoder.Doubled16BitID, "doubled16BitID", false, `Tells, that 16-bit IDs are doubled, see "trice h -log".`)
+	fsScBandwidth.BoolVar(&trexDecoder.Doubled16BitID, "d16", false, "Short for '-Doubled16BitID'.")
+	flagIDList(fsScBandwidth)
+	flagLogfile(fsScBandwidth)
+	flagVerbosity(fsScBandwidth)
+}
+
+func spansInit() {
+	fsScSpans = flag.NewFlagSet("spans", flag.ContinueOnError) // sub-command
+	fsScSpans.StringVar(&spansArgs, "args", receiver.DefaultFileArgs, `The binary logfile to scan. Timed and compressed binary logfiles are possible.`)
+	fsScSpans.StringVar(&translator.SpansFileName, "o", translator.SpansFileName, `The Chrome Trace Event JSON file for the spans.`)
+	fsScSpans.StringVar(&translator.SpansCSV, "csv", "off", `Write the span statistics additionally into this CSV file. Options are 'off|filename'.`)
+	fsScSpans.DurationVar(&translator.SpansTick16, "tick16", translator.SpansTick16, `Duration of one 16-bit target stamp tick.`)
+	fsScSpans.DurationVar(&translator.SpansTick32, "tick32", translator.SpansTick32, `Duration of one 32-bit target stamp tick.`)
+	fsScSpans.StringVar(&decoder.PackageFraming, "packageFraming", "TCOBSv1", `Use "none" or "COBS" as alternative.`)
+	fsScSpans.StringVar(&decoder.PackageFraming, "pf", "TCOBSv1", "Short for '-packageFraming'.")
+	fsScSpans.StringVar(&cipher.Password, "password", "", `The decrypt passphrase, see "trice h -log".`)
+	fsScSpans.StringVar(&cipher.Password, "pw", "", "Short for -password.")
+	fsScSpans.StringVar(&translator.TriceEndianness, "triceEndianness", "littleEndian", `Target endianness trice data stream. Option: "bigEndian".`)
+	fsScSpans.BoolVar(&trexDecoder.Doubled16BitID, "doubled16BitID", false, `Tells, that 16-bit IDs are doubled, see "trice h -log".`)
+	fsScSpans.BoolVar(&trexDecoder.Doubled16BitID, "d16", false, "Short for '-Doubled16BitID'.")
+	flagIDList(fsScSpans)
+	flagLogfile(fsScSpans)
+	flagVerbosity(fsScSpans)
+}
+
 func flagsRefreshAndUpdate(p *flag.FlagSet) {
 	flagDryRun(p)
 	flagSrcs(p)
@@ -256,6 +354,9 @@ func flagsRefreshAndUpdate(p *flag.FlagSet) {
 	flagIDList(p)
 	flagLIList(p)
 	flagSkipAdditionalChecks(p)
+	flagSidecar(p)
+	flagJournal(p)
+	flagCFmtList(p)
 }
 
 func flagBinaryLogfile(p *flag.FlagSet) {
@@ -268,6 +369,21 @@ All trice output of the appropriate subcommands is appended per default into the
 Change the filename with "-binaryLogfile myName.bin" or switch logging off with "-binaryLogfile none".
 `)
 	p.StringVar(&receiver.BinaryLogfileName, "blf", "off", "Short for binaryLogfile")
+	p.StringVar(&receiver.BinaryLogRotate, "blfRotate", "off", `Rotate the binary logfile by size like "64MB" or by time like "1h". Options are 'off|size|duration'.
+The full logfile is renamed into the next segment, like "trice_0001.bin" for "trice.bin". A time based rotation happens with the first data after the interval.`)
+	p.BoolVar(&receiver.BinaryLogTimed, "blfTimed", false, `Record the host reception time of each received chunk in the binary logfile. A replay with "-p FILEBUFFER" reproduces the timing
+and displays the original host timestamps. Use a new binary logfile name, because an existing untimed logfile is not converted.`)
+	p.Float64Var(&receiver.ReplaySpeed, "replaySpeed", 1.0, `Replay speed of timed binary logfiles: 1 is the original speed, 10 is ten times faster and 0 is as fast as possible.`)
+	p.BoolVar(&receiver.BinaryLogCompress, "blfCompress", false, `Gzip compress rotated binary logfile segments into files like "trice_0001.bin.gz". Use "-p FILE -args trice_0001.bin.gz" for a replay.`)
+}
+
+func flagIndexQuery(p *flag.FlagSet) {
+	p.Int64Var(&receiver.QueryOffset, "queryOffset", -1, `With "-p FILE|FILEBUFFER" decode an indexed binary logfile from the block containing this byte offset on. -1 means off.
+Build the index before with "trice index -args filename". All query switches can be combined.`)
+	p.StringVar(&receiver.QueryStamps, "queryStamps", "", `With "-p FILE|FILEBUFFER" decode only trices with target stamps in the range "from:to" from an indexed binary logfile.
+The values are raw target stamp ticks, like "1000000:2000000". Only the index blocks overlapping the range are read.`)
+	p.StringVar(&receiver.QueryIDs, "queryIDs", "", `With "-p FILE|FILEBUFFER" decode only trices with the listed IDs from an indexed binary logfile, like "12,100-199".
+Only the index blocks containing at least one of the IDs are read.`)
 }
 
 func flagLogfile(p *flag.FlagSet) {
@@ -313,6 +429,30 @@ Add this flag for script speed-up, when not editing the sources. Alternatively c
 	p.BoolVar(&id.SkipAdditionalChecks, "skip", false, "short for skipAdditionalChecks") // flag
 }
 
+func flagSidecar(p *flag.FlagSet) {
+	p.BoolVar(&id.WriteSidecars, "sidecar", false, `Write compact binary copies of the ID list and location information files next to them (til.json.bin, li.json.bin).
+"trice log" uses them automatically instead of parsing the JSON files, as long as they match the JSON files. This speeds up the trice log start with big lists.
+The sidecars are derived data and should not be under version control.
+`+boolInfo) // flag
+}
+
+func flagCFmtList(p *flag.FlagSet) {
+	p.StringVar(&id.CFmtListFn, "cFmtList", "off", `Generate a C file with all format strings and parameter information for targets decoding trices themselves, like "til.c".
+The header file gets the same name with ".h". The generated function triceFormatStringListLookup finds an ID in constant time.
+The files are written only, when their content changed. Options are: 'off|none|filename'.
+`)
+}
+
+func flagJournal(p *flag.FlagSet) {
+	p.BoolVar(&id.Journal, "journal", false, `Append new or changed ID list and location information elements to small journal files (til.json.journal, li.json.journal)
+instead of rewriting the complete lists. The lists are locked during the run, so parallel runs on the same lists are safe.
+"trice log" and all other sub-commands read the journals transparently. See also -compact and -journalLimit.
+`+boolInfo) // flag
+	p.BoolVar(&id.JournalCompact, "compact", false, `Merge the journal files into the ID list and location information files and remove them. Used together with -journal.
+`+boolInfo) // flag
+	p.IntVar(&id.JournalLimit, "journalLimit", id.JournalLimit, `Journal file size in bytes, which triggers an automatic -compact.`) // flag
+}
+
 func flagIDList(p *flag.FlagSet) {
 	p.StringVar(&id.FnJSON, "idlist", id.FnJSON, `The trice ID list file.
 The specified JSON file is needed to display the ID coded trices during runtime and should be under version control.
@@ -348,3 +488,22 @@ You can specify this switch if you intend to use the remote display option to sh
 You can specify this switch if you want to change the used port number for the remote display functionality.
 `) // flag
 }
+
+// repeatableString is a flag value setting a string and collecting all passed values in command line order.
+type repeatableString struct {
+	s    *string
+	list *[]string
+}
+
+func (p repeatableString) String() string {
+	if p.s == nil {
+		return ""
+	}
+	return *p.s
+}
+
+func (p repeatableString) Set(value string) error {
+	*p.s = value
+	*p.list = append(*p.list, value)
+	return nil
+}
@@ -0,0 +1,65 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package args
+
+import (
+	"io"
+
+	"github.com/rokath/trice/internal/translator"
+	"github.com/spf13/afero"
+)
+
+// activeSession is the session, whose flags are set.
+var activeSession *Session
+
+// Session decodes binary trice data in-process like "trice log -p BUFFER", but without re-parsing the flags
+// and re-loading the ID list for each buffer. It is meant for tests executing the target code in-process.
+type Session struct {
+	w       io.Writer
+	logArgs []string
+	s       *translator.Session
+}
+
+// NewSession parses the "trice log" flags logArgs and loads the ID list and location information once.
+// Port flags are ignored and no output files are written. Messages, like the ID list loading, are written to w.
+func NewSession(w io.Writer, fSys *afero.Afero, logArgs ...string) (*Session, error) {
+	p := &Session{w: w, logArgs: logArgs}
+	if err := p.activate(); err != nil {
+		return nil, err
+	}
+	ilu, m, li := loadLogLuts(w, fSys)
+	p.s = translator.NewSession(ilu, m, li)
+	return p, nil
+}
+
+// activate sets the flags of p, because the flags are global and several sessions can be used alternately.
+func (p *Session) activate() error {
+	if err := parseLogFlags(p.logArgs); err != nil {
+		return err
+	}
+	setupLog(p.w)
+	activeSession = p
+	return nil
+}
+
+// Decode decodes b together with the incomplete trice data of the previous calls and returns the log lines.
+func (p *Session) Decode(b []byte) (string, error) {
+	if activeSession != p {
+		if err := p.activate(); err != nil {
+			return "", err
+		}
+	}
+	return p.s.Decode(b), nil
+}
+
+// Reset drops incomplete trice data and the decoder state, so that the next Decode starts like with a new port.
+func (p *Session) Reset() error {
+	if activeSession != p {
+		if err := p.activate(); err != nil {
+			return err
+		}
+	}
+	p.s.Reset()
+	return nil
+}
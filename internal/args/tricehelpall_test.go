@@ -53,6 +53,10 @@ sub-command 'h|help': For command line usage.
     	Show a|add specific help.
   -all
     	Show all help.
+  -bandwidth
+    	Show bw|bandwidth specific help.
+  -bw
+    	Show bw|bandwidth specific help.
   -c	Show c|clean specific help.
   -clean
     	Show c|clean specific help.
@@ -64,8 +68,12 @@ sub-command 'h|help': For command line usage.
   -help
     	Show h|help specific help.
   -i	Show i|insert specific help.
+  -index
+    	Show ix|index specific help.
   -insert
     	Show i|insert specific help.
+  -ix
+    	Show ix|index specific help.
   -l	Show l|log specific help.
   -lf string
     	Short for logfile (default "off")
@@ -87,6 +95,10 @@ sub-command 'h|help': For command line usage.
     	Show sd|shutdown specific help.
   -shutdown
     	Show sd|shutdown specific help.
+  -sp
+    	Show sp|spans specific help.
+  -spans
+    	Show sp|spans specific help.
   -v	short for verbose
   -ver
     	Show ver|version specific help.
@@ -102,7 +114,7 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
 #	Example: 'trice l -port ST-LINK -v -s': Shows verbose version information and also the received raw bytes.
   -addNL
     	Add a newline char at trice messages end to use for example "hi" instead of "hi\n" in source code.
-  -args string
+  -args value
     	Use to pass port specific parameters. The "default" value depends on the used port:
     	port "COMn": default="-baud 115200", Unused option for a different driver. (For baud rate settings see -baud.)
     	port "J-LINK": default="-Device STM32F030R8 -if SWD -Speed 4000 -RTTChannel 0 -RTTSearchRanges 0x20000000_0x1000", 
@@ -115,9 +127,14 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
     	port "FILEBUFFER": default="trices.raw", Option for args is any file name for binary log data like written []byte{115, 111, 109, 101, 10}. Trice stops on EOF.
     	port "TCP4": default="localhost:17001", use any IP:port endpoint like "127.0.0.1:19021". This port is usable for reading, when the Trice logs go into a TCP server.
     	port "TCP4BUFFER": default="localhost:17001". This port is used for "-port TCP4" testing, to shutdown the Trice tool automatically.
+    	port "TCP4SERVER": default=":17005", use any local IP:port endpoint to listen on. Many clients can push their trice streams in parallel.
+    		Each client output line is tagged with its remote address or with the device name announced in a first line like "#device:board17\n".
+    	port "UDP4": default=":17006", use any local IP:port endpoint to listen on. Each datagram carries one or more complete trice packages. Lost datagrams are shown as CYCLE errors.
+    	port "UNIX": default="trice.sock", use any Unix domain stream socket path, where for example a target simulator serves its trice output.
+    	port "STDIN": args are ignored. Usable like "simulator | trice log -p STDIN". Trice stops at the end of the input.
     	port "DEC" or "BUFFER": default="0 0 0 0", Option for args is any space separated decimal number byte sequence. Example -p BUFFER -args "7 123 44".
     	port "HEX" or "DUMP": default="", Option for args is any space or comma separated byte sequence in hex. Example: -p DUMP -args "7B 1A ee,88, 5a".
-    	 (default "default")
+    	 (default default)
   -ban value
     	Channel(s) to ignore. This is a multi-flag switch. It can be used several times with a colon separated list of channel descriptors not to display.
     	Example: "-ban dbg:wrn -ban diag" results in suppressing all as debug, diag and warning tagged messages. Not usable in conjunction with "-pick". See also "-logLevel".
@@ -136,6 +153,14 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
     	 (default "off")
   -blf string
     	Short for binaryLogfile (default "off")
+  -blfCompress
+    	Gzip compress rotated binary logfile segments into files like "trice_0001.bin.gz". Use "-p FILE -args trice_0001.bin.gz" for a replay.
+  -blfRotate string
+    	Rotate the binary logfile by size like "64MB" or by time like "1h". Options are 'off|size|duration'.
+    	The full logfile is renamed into the next segment, like "trice_0001.bin" for "trice.bin". A time based rotation happens with the first data after the interval. (default "off")
+  -blfTimed
+    	Record the host reception time of each received chunk in the binary logfile. A replay with "-p FILEBUFFER" reproduces the timing
+    	and displays the original host timestamps. Use a new binary logfile name, because an existing untimed logfile is not converted.
   -color string
     	The format strings can start with a lower or upper case channel information.
     	See https://github.com/rokath/trice/blob/master/pkg/src/triceCheck.c for examples. Color options: 
@@ -143,6 +168,8 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
     	"none": Disable ANSI color. The lower case channel information is removed: "w:x"-> "x"
     	"default|color": Use ANSI color codes for known upper and lower case channel info are inserted and lower case channel information is removed.
     	 (default "default")
+  -cpuProfile string
+    	Write a pprof CPU profile of the log processing into this file. Options are 'off|filename'. Inspect it with "go tool pprof trice filename". (default "off")
   -d16
     	Short for '-Doubled16BitID'.
   -databits int
@@ -160,6 +187,9 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
     	Tells, that 16-bit IDs are doubled. That switch is needed when un-routed direct output is used like (TRICE_DIRECT_SEGGER_RTT_32BIT_WRITE == 1), but also with double buffer in (TRICE_DEFERRED_TRANSFER_MODE==TRICE_MULTI_PACK_MODE) and XTEA encryption. Read the user guide for more details.
   -ds
     	Short for '-displayserver'.
+  -dsBatch int
+    	Maximum count of trice lines sent together to the displayserver. Lines wait at most 20 ms for a batch.
+    	If the displayserver cannot keep up, lines are dropped and counted. Use 0 for one synchronous call per line without drops. (default 256)
   -e string
     	Short for -encoding. (default "TREX")
   -encoding string
@@ -170,6 +200,10 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
     	 (default "TREX")
   -exec string
     	Use to pass an additional command line for port TCP4 (like gdbserver start).
+  -export string
+    	Write the numeric trice parameters into this columnar file instead of displaying trice lines. Options are 'off|filename'.
+    	Each trice ID gets a column group with a stamp column and one typed column per parameter. The schema is derived from the til.json file.
+    	String and buffer trices are not exported. Needs "-encoding TREX" and a single port. Use package "pkg/columnar" to read the file. (default "off")
   -hs string
     	PC timestamp for logs and logfile name, options: 'off|none|UTCmicro|zero'
     	This timestamp switch generates the timestamps on the PC only (reception time), what is good enough for many cases. 
@@ -223,10 +257,21 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
     	All trice output of the appropriate subcommands is appended per default into the logfile additionally to the normal output.
     	Change the filename with "-logfile myName.txt" or switch logging off with "-logfile none".
     	 (default "off")
+  -memProfile string
+    	Write a pprof heap profile at the log end into this file. Options are 'off|filename'. (default "off")
+  -metrics string
+    	Serve decoder counters in the Prometheus text format on http://address/metrics. Options are 'off|address'. Example: "-metrics :9464" listens on localhost:9464.
+    	The counters are received bytes, packages, framing errors, cycle gaps, decode errors, unknown IDs, trices and bytes per ID and per channel, filtered trices and dropped output writes. (default "off")
   -newlineIndent int
     	Force newline offset for trice format strings with line breaks before end. -1=auto sense (default -1)
-  -p string
-    	short for -port (default "J-LINK")
+  -outPolicy string
+    	Queue full policy of the outputs "terminal", "logfile" and "tcp" as comma separated list. Options are 'block|dropNewest|dropOldest'.
+    	With a logfile or TCP output, each output gets its own queue, so a slow output does not stall the others, unless its policy is "block".
+    	Dropped writes are counted and reported at the end. (default "terminal:block,logfile:block,tcp:dropNewest")
+  -outQueue int
+    	Count of writes each output queue can hold. See "-outPolicy". (default 1024)
+  -p value
+    	short for -port (default J-LINK)
   -packageFraming string
     	Use "none" or "COBS" as alternative. "COBS" needs "#define TRICE_FRAMING TRICE_FRAMING_COBS" inside "triceConfig.h". (default "TCOBSv1")
   -parity string
@@ -239,15 +284,28 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
   -pick value
     	Channel(s) to display. This is a multi-flag switch. It can be used several times with a colon separated list of channel descriptors only to display.
     	Example: "-pick err:wrn -pick default" results in suppressing all messages despite of as error, warning and default tagged messages. Not usable in conjunction with "-ban". See also "-logLevel".
-  -port string
-    	Case insensitive receiver device name: 'serial name|JLINK|STLINK|FILE|FILEBUFFER|TCP4|TCP4BUFFER|DEC|BUFFER|HEX|DUMP. 
+  -port value
+    	Case insensitive receiver device name: 'serial name|JLINK|STLINK|FILE|FILEBUFFER|TCP4|TCP4BUFFER|TCP4SERVER|UDP4|UNIX|STDIN|DEC|BUFFER|HEX|DUMP. 
     	The serial name is like 'COM12' for Windows or a Linux name like '/dev/tty/usb12'. 
     	Using a virtual serial COM port on the PC over a FTDI USB adapter is a most likely variant.
-    	 (default "J-LINK")
+    	Use several -port switches to log several devices in parallel into one output. The n-th -args belongs to the n-th -port.
+    	The 'source:' prefix is then replaced by the device name.
+    	 (default J-LINK)
   -prefix string
     	Line prefix, options: any string or 'off|none' or 'source:' followed by 0-12 spaces, 'source:' will be replaced by source value e.g., 'COM17:'. (default "source: ")
   -pw string
     	Short for -password.
+  -queryIDs string
+    	With "-p FILE|FILEBUFFER" decode only trices with the listed IDs from an indexed binary logfile, like "12,100-199".
+    	Only the index blocks containing at least one of the IDs are read.
+  -queryOffset int
+    	With "-p FILE|FILEBUFFER" decode an indexed binary logfile from the block containing this byte offset on. -1 means off.
+    	Build the index before with "trice index -args filename". All query switches can be combined. (default -1)
+  -queryStamps string
+    	With "-p FILE|FILEBUFFER" decode only trices with target stamps in the range "from:to" from an indexed binary logfile.
+    	The values are raw target stamp ticks, like "1000000:2000000". Only the index blocks overlapping the range are read.
+  -replaySpeed float
+    	Replay speed of timed binary logfiles: 1 is the original speed, 10 is ten times faster and 0 is as fast as possible. (default 1)
   -s	Short for '-showInputBytes'.
   -showID string
     	Format string for displaying first trice ID at start of each line. Example: "debug:%7d ". Default is "". If several trices form a log line only the first trice ID ist displayed.
@@ -258,6 +316,9 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
     	Show encryption key. Use this switch for creating your own password keys. If applied together with "-password MySecret" it shows the encryption key.
     	Simply copy this key than into the line "#define ENCRYPT XTEA_KEY( ea, bb, ec, 6f, 31, 80, 4e, b9, 68, e2, fa, ea, ae, f1, 50, 54 ); //!< -password MySecret" inside triceConfig.h.
     	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+  -stages string
+    	Count items, bytes, time and queue waits of the receive, deframe, decode, format, compose and output stages. Options are 'off|exit|duration'.
+    	With "exit" a summary is displayed at the log end, with a duration like "10s" additionally periodically. The counting costs a few percent throughput. (default "off")
   -stopbits string
     	Serial port stopbit, options: 1.5, 2 (default "1")
   -suffix string
@@ -269,6 +330,8 @@ sub-command 'l|log': For displaying trice logs coming from port. With "trice log
   -til string
     	Short for '-idlist'.
     	 (default "til.json")
+  -traceProfile string
+    	Write a runtime execution trace of the log processing into this file. Options are 'off|filename'. Inspect it with "go tool trace filename". (default "off")
   -triceEndianness string
     	Target endianness trice data stream. Option: "bigEndian". (default "littleEndian")
   -ts string
@@ -296,6 +359,14 @@ sub-command 'a|add': Use for adding library source files containing already tric
 #	in a project file, it will get a different ID in your project file because of the used location information.
 #	The "add" sub-command has no mandatory switches. Omitted optional switches are used with their default parameters.
 #	Example: 'trice add': Update ID list from source tree.
+  -cFmtList string
+    	Generate a C file with all format strings and parameter information for targets decoding trices themselves, like "til.c".
+    	The header file gets the same name with ".h". The generated function triceFormatStringListLookup finds an ID in constant time.
+    	The files are written only, when their content changed. Options are: 'off|none|filename'.
+    	 (default "off")
+  -compact
+    	Merge the journal files into the ID list and location information files and remove them. Used together with -journal.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
   -dry-run
     	No changes applied but output shows what would happen.
     	"trice add -dry-run" will change nothing but show changes it would perform without the "-dry-run" switch.
@@ -310,6 +381,13 @@ sub-command 'a|add': Use for adding library source files containing already tric
     	The trice ID list file.
     	The specified JSON file is needed to display the ID coded trices during runtime and should be under version control.
     	 (default "til.json")
+  -journal
+    	Append new or changed ID list and location information elements to small journal files (til.json.journal, li.json.journal)
+    	instead of rewriting the complete lists. The lists are locked during the run, so parallel runs on the same lists are safe.
+    	"trice log" and all other sub-commands read the journals transparently. See also -compact and -journalLimit.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+  -journalLimit int
+    	Journal file size in bytes, which triggers an automatic -compact. (default 65536)
   -li string
     	Short for '-locationInformation'.
     	 (default "li.json")
@@ -326,6 +404,11 @@ sub-command 'a|add': Use for adding library source files containing already tric
     	 (default "li.json")
   -s value
     	Short for src.
+  -sidecar
+    	Write compact binary copies of the ID list and location information files next to them (til.json.bin, li.json.bin).
+    	"trice log" uses them automatically instead of parsing the JSON files, as long as they match the JSON files. This speeds up the trice log start with big lists.
+    	The sidecars are derived data and should not be under version control.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
   -skip
     	short for skipAdditionalChecks
   -skipAdditionalChecks
@@ -398,8 +481,16 @@ sub-command 'i|insert': For updating til.json and inserting IDs into source file
     	Lower end of ID range for normal trices. (default 1000)
   -addParamCount
     	Extend TRICE macro names with the parameter count _n to enable compile time checks.
+  -cFmtList string
+    	Generate a C file with all format strings and parameter information for targets decoding trices themselves, like "til.c".
+    	The header file gets the same name with ".h". The generated function triceFormatStringListLookup finds an ID in constant time.
+    	The files are written only, when their content changed. Options are: 'off|none|filename'.
+    	 (default "off")
   -cache
     	Use "~/.trice/cache/" for fast ID insert (EXPERIMENTAL!). The folder must exist.
+  -compact
+    	Merge the journal files into the ID list and location information files and remove them. Used together with -journal.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
   -defaultStampSize int
     	Default stamp size for written TRICE macros without id(0), Id(0 or ID(0). Valid values are 0, 16 or 32. (default 32)
   -dry-run
@@ -416,6 +507,13 @@ sub-command 'i|insert': For updating til.json and inserting IDs into source file
     	The trice ID list file.
     	The specified JSON file is needed to display the ID coded trices during runtime and should be under version control.
     	 (default "til.json")
+  -journal
+    	Append new or changed ID list and location information elements to small journal files (til.json.journal, li.json.journal)
+    	instead of rewriting the complete lists. The lists are locked during the run, so parallel runs on the same lists are safe.
+    	"trice log" and all other sub-commands read the journals transparently. See also -compact and -journalLimit.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+  -journalLimit int
+    	Journal file size in bytes, which triggers an automatic -compact. (default 65536)
   -li string
     	Short for '-locationInformation'.
     	 (default "li.json")
@@ -432,6 +530,11 @@ sub-command 'i|insert': For updating til.json and inserting IDs into source file
     	 (default "li.json")
   -s value
     	Short for src.
+  -sidecar
+    	Write compact binary copies of the ID list and location information files next to them (til.json.bin, li.json.bin).
+    	"trice log" uses them automatically instead of parsing the JSON files, as long as they match the JSON files. This speeds up the trice log start with big lists.
+    	The sidecars are derived data and should not be under version control.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
   -skip
     	short for skipAdditionalChecks
   -skipAdditionalChecks
@@ -448,6 +551,14 @@ sub-command 'i|insert': For updating til.json and inserting IDs into source file
     	source code files inside directory ./test and scan also file trice.h inside pkg/src directory. 
     	Without the "-dry-run" switch it would create|extend a list file til.json in the current directory.
     	 (default "./")
+  -stripChannels value
+    	Channel(s) to disable inside the -stripHeader file. This is a multi-flag switch with colon separated channel descriptors.
+    	Example: "-stripChannels dbg:diag" disables all trices with format strings starting with "dbg:" or "diag:". The case is ignored, other variants like "debug" need to be listed too.
+    	
+  -stripHeader string
+    	Generate a C header defining TRICE_ID_ENABLE_n for each ID n, like "triceStrip.h". Options are: 'off|none|filename'.
+    	Included in triceConfig.h, the trice macros of IDs disabled with -stripChannels compile to nothing. The header is written only, when its content changed.
+    	 (default "off")
   -til string
     	Short for '-idlist'.
     	 (default "til.json")
@@ -456,6 +567,8 @@ sub-command 'i|insert': For updating til.json and inserting IDs into source file
     	Gives more informal output if used. Can be helpful during setup.
     	For example "trice u -dry-run -v" is the same as "trice u -dry-run" but with more descriptive output.
     	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+  -watch
+    	Keep running after the insert and insert IDs into each source file as soon as it is saved. til.json and li.json are updated immediately. Stop with Ctrl-C.
 sub-command 'c|clean': Set all [id|Id|ID](n) inside source tree dir to [id|Id|ID](0). Remove all iD(n).
 #	All in source code found IDs are added to til.json if not already there. Inside til.json differently used IDs are 
 #	reported and just cleaned inside the source files. The existing li.json is updated/extended. 
@@ -465,8 +578,16 @@ sub-command 'c|clean': Set all [id|Id|ID](n) inside source tree dir to [id|Id|ID
 #	EXPERIMENTAL! With "#define TRICE_CLEAN 1" inside "triceConfig.h" these displayed "errors" are suppressed.
 #	EXPERIMENTAL! All files including trice.h are re-compiled then on the next compiler run, what could be time-consuming.
 #	In difference to "trice zero", Trice function calls get iD(n) removed. Example: "TRice( iD(88), "hi);" -> "TRice("hi);"
+  -cFmtList string
+    	Generate a C file with all format strings and parameter information for targets decoding trices themselves, like "til.c".
+    	The header file gets the same name with ".h". The generated function triceFormatStringListLookup finds an ID in constant time.
+    	The files are written only, when their content changed. Options are: 'off|none|filename'.
+    	 (default "off")
   -cache
     	Use "~/.trice/cache/" for fast ID clean (EXPERIMENTAL!). The folder must exist.
+  -compact
+    	Merge the journal files into the ID list and location information files and remove them. Used together with -journal.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
   -dry-run
     	No changes applied but output shows what would happen.
     	"trice clean -dry-run" will change nothing but show changes it would perform without the "-dry-run" switch.
@@ -481,6 +602,13 @@ sub-command 'c|clean': Set all [id|Id|ID](n) inside source tree dir to [id|Id|ID
     	The trice ID list file.
     	The specified JSON file is needed to display the ID coded trices during runtime and should be under version control.
     	 (default "til.json")
+  -journal
+    	Append new or changed ID list and location information elements to small journal files (til.json.journal, li.json.journal)
+    	instead of rewriting the complete lists. The lists are locked during the run, so parallel runs on the same lists are safe.
+    	"trice log" and all other sub-commands read the journals transparently. See also -compact and -journalLimit.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+  -journalLimit int
+    	Journal file size in bytes, which triggers an automatic -compact. (default 65536)
   -li string
     	Short for '-locationInformation'.
     	 (default "li.json")
@@ -497,6 +625,11 @@ sub-command 'c|clean': Set all [id|Id|ID](n) inside source tree dir to [id|Id|ID
     	 (default "li.json")
   -s value
     	Short for src.
+  -sidecar
+    	Write compact binary copies of the ID list and location information files next to them (til.json.bin, li.json.bin).
+    	"trice log" uses them automatically instead of parsing the JSON files, as long as they match the JSON files. This speeds up the trice log start with big lists.
+    	The sidecars are derived data and should not be under version control.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
   -skip
     	short for skipAdditionalChecks
   -skipAdditionalChecks
@@ -519,6 +652,161 @@ sub-command 'c|clean': Set all [id|Id|ID](n) inside source tree dir to [id|Id|ID
     	Gives more informal output if used. Can be helpful during setup.
     	For example "trice u -dry-run -v" is the same as "trice u -dry-run" but with more descriptive output.
     	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+sub-command 'ix|index': Builds an index for a binary logfile to decode only parts of it.
+#	The index records per block the byte offset, the target stamp range, the first cycle counter and the contained IDs.
+#	"trice log -p FILEBUFFER" uses the index with the switches -queryOffset, -queryStamps and -queryIDs.
+#	Example: 'trice ix -args trice.bin': Write the index trice.bin.tix.
+#	Example: 'trice l -p FILEBUFFER -args trice.bin -queryIDs 12,100-199': Decode only the index blocks containing these IDs.
+  -args string
+    	The binary logfile to index. The index is written into the same name with ".tix" appended.
+    	Timed and compressed binary logfiles cannot be indexed. (default "trices.raw")
+  -blockSize int
+    	Approximate byte count of an indexed block. Smaller blocks make queries more selective and the index bigger. (default 65536)
+  -d16
+    	Short for '-Doubled16BitID'.
+  -doubled16BitID
+    	Tells, that 16-bit IDs are doubled, see "trice h -log".
+  -lf string
+    	Short for logfile (default "off")
+  -list
+    	List the index blocks with offset, size, target stamp range, first cycle counter and ID count. This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+  -logfile string
+    	Append all output to logfile. Options are: 'off|none|filename|auto':
+    	"off": no logfile (same as "none")
+    	"none": no logfile (same as "off")
+    	"my/path/auto": Use as logfile name "my/path/2006-01-02_1504-05_trice.log" with actual time. "my/path/" must exist.
+    	"filename": Any other string than "auto", "none" or "off" is treated as a filename. If the file exists, logs are appended.
+    	All trice output of the appropriate subcommands is appended per default into the logfile additionally to the normal output.
+    	Change the filename with "-logfile myName.txt" or switch logging off with "-logfile none".
+    	 (default "off")
+  -packageFraming string
+    	Use "COBS" as alternative. Framing "none" cannot be indexed. (default "TCOBSv1")
+  -pf string
+    	Short for '-packageFraming'. (default "TCOBSv1")
+  -triceEndianness string
+    	Target endianness trice data stream. Option: "bigEndian". (default "littleEndian")
+  -v	short for verbose
+  -verbose
+    	Gives more informal output if used. Can be helpful during setup.
+    	For example "trice u -dry-run -v" is the same as "trice u -dry-run" but with more descriptive output.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+sub-command 'bw|bandwidth': Reports the link bandwidth cost of each trice ID and channel in a binary logfile.
+#	The trices are decoded without formatting. The report is sorted by the framed bytes, which include the package share of the framing, padding and encryption.
+#	Example: 'trice bw -args trice.bin -pf COBS': Show count, bytes, average size, share of the total bandwidth and rates of each ID and channel.
+#	Example: 'trice bw -args trice.bin -csv cost.csv': Write the report additionally into cost.csv.
+  -args string
+    	The binary logfile to scan. Timed and compressed binary logfiles are possible. (default "trices.raw")
+  -csv string
+    	Write the report additionally into this CSV file. Options are 'off|filename'. (default "off")
+  -d16
+    	Short for '-Doubled16BitID'.
+  -doubled16BitID
+    	Tells, that 16-bit IDs are doubled, see "trice h -log".
+  -i string
+    	Short for '-idlist'.
+    	 (default "til.json")
+  -idList string
+    	Alternate for '-idlist'.
+    	 (default "til.json")
+  -idlist string
+    	The trice ID list file.
+    	The specified JSON file is needed to display the ID coded trices during runtime and should be under version control.
+    	 (default "til.json")
+  -interval duration
+    	Time window for the peak rates. (default 1s)
+  -lf string
+    	Short for logfile (default "off")
+  -logfile string
+    	Append all output to logfile. Options are: 'off|none|filename|auto':
+    	"off": no logfile (same as "none")
+    	"none": no logfile (same as "off")
+    	"my/path/auto": Use as logfile name "my/path/2006-01-02_1504-05_trice.log" with actual time. "my/path/" must exist.
+    	"filename": Any other string than "auto", "none" or "off" is treated as a filename. If the file exists, logs are appended.
+    	All trice output of the appropriate subcommands is appended per default into the logfile additionally to the normal output.
+    	Change the filename with "-logfile myName.txt" or switch logging off with "-logfile none".
+    	 (default "off")
+  -packageFraming string
+    	Use "none" or "COBS" as alternative. (default "TCOBSv1")
+  -password string
+    	The decrypt passphrase, see "trice h -log".
+  -pf string
+    	Short for '-packageFraming'. (default "TCOBSv1")
+  -pw string
+    	Short for -password.
+  -stampUnit string
+    	Unit of the 32-bit target stamps, options: 'us|ms'. The rates use the host timestamps of timed binary logfiles or else the 32-bit target stamps. (default "us")
+  -til string
+    	Short for '-idlist'.
+    	 (default "til.json")
+  -trace string
+    	Write the trice sequence into this CSV file. Options are 'off|filename'.
+    	Each row has the target time in us since the first 32-bit stamp, the ID, the stamp size and the parameter byte count.
+    	It is the input for the target buffer simulation, see _test/ReadMe.md. (default "off")
+  -triceEndianness string
+    	Target endianness trice data stream. Option: "bigEndian". (default "littleEndian")
+  -v	short for verbose
+  -verbose
+    	Gives more informal output if used. Can be helpful during setup.
+    	For example "trice u -dry-run -v" is the same as "trice u -dry-run" but with more descriptive output.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
+sub-command 'sp|spans': Profiles the firmware functions marked with span trices in a binary logfile.
+#	The span trices TriceSpanEnter and TriceSpanExit are paired to nested spans, which are written as Chrome Trace Event JSON.
+#	The calls, total and self time of each span name are reported. Spans with lost exit trices are marked as missing exits.
+#	Example: 'trice sp -args trice.bin -o trace.json': Write trace.json, viewable with chrome://tracing or https://ui.perfetto.dev.
+#	Example: 'trice sp -args trice.bin -tick32 100ns -csv spans.csv': Use 10 MHz 32-bit target stamps and write the statistics additionally into spans.csv.
+  -args string
+    	The binary logfile to scan. Timed and compressed binary logfiles are possible. (default "trices.raw")
+  -csv string
+    	Write the span statistics additionally into this CSV file. Options are 'off|filename'. (default "off")
+  -d16
+    	Short for '-Doubled16BitID'.
+  -doubled16BitID
+    	Tells, that 16-bit IDs are doubled, see "trice h -log".
+  -i string
+    	Short for '-idlist'.
+    	 (default "til.json")
+  -idList string
+    	Alternate for '-idlist'.
+    	 (default "til.json")
+  -idlist string
+    	The trice ID list file.
+    	The specified JSON file is needed to display the ID coded trices during runtime and should be under version control.
+    	 (default "til.json")
+  -lf string
+    	Short for logfile (default "off")
+  -logfile string
+    	Append all output to logfile. Options are: 'off|none|filename|auto':
+    	"off": no logfile (same as "none")
+    	"none": no logfile (same as "off")
+    	"my/path/auto": Use as logfile name "my/path/2006-01-02_1504-05_trice.log" with actual time. "my/path/" must exist.
+    	"filename": Any other string than "auto", "none" or "off" is treated as a filename. If the file exists, logs are appended.
+    	All trice output of the appropriate subcommands is appended per default into the logfile additionally to the normal output.
+    	Change the filename with "-logfile myName.txt" or switch logging off with "-logfile none".
+    	 (default "off")
+  -o string
+    	The Chrome Trace Event JSON file for the spans. (default "trace.json")
+  -packageFraming string
+    	Use "none" or "COBS" as alternative. (default "TCOBSv1")
+  -password string
+    	The decrypt passphrase, see "trice h -log".
+  -pf string
+    	Short for '-packageFraming'. (default "TCOBSv1")
+  -pw string
+    	Short for -password.
+  -tick16 duration
+    	Duration of one 16-bit target stamp tick. (default 1µs)
+  -tick32 duration
+    	Duration of one 32-bit target stamp tick. (default 1µs)
+  -til string
+    	Short for '-idlist'.
+    	 (default "til.json")
+  -triceEndianness string
+    	Target endianness trice data stream. Option: "bigEndian". (default "littleEndian")
+  -v	short for verbose
+  -verbose
+    	Gives more informal output if used. Can be helpful during setup.
+    	For example "trice u -dry-run -v" is the same as "trice u -dry-run" but with more descriptive output.
+    	This is a bool switch. It has no parameters. Its default value is false. If the switch is applied its value is true. You can also set it explicit: =false or =true.
 `
 	id.FnJSON = "til.json"
 	execHelper(t, input, expect)
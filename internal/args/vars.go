@@ -55,6 +55,30 @@ var (
 	// fsScClean is flag set for sub command 'clean' for clearing IDs in source tree.
 	fsScClean *flag.FlagSet
 
+	// fsScIndex is flag set for sub command 'index' for binary logfile indexing.
+	fsScIndex *flag.FlagSet
+
+	// indexArgs is the binary logfile name for sub command 'index'.
+	indexArgs string
+
+	// indexList enables the block list output of sub command 'index'.
+	indexList bool
+
+	// fsScBandwidth is flag set for sub command 'bandwidth' for the bandwidth cost of each ID in a binary logfile.
+	fsScBandwidth *flag.FlagSet
+
+	// bandwidthArgs is the binary logfile name for sub command 'bandwidth'.
+	bandwidthArgs string
+
+	// fsScSpans is flag set for sub command 'spans' for the function profile of the span trices in a binary logfile.
+	fsScSpans *flag.FlagSet
+
+	// spansArgs is the binary logfile name for sub command 'spans'.
+	spansArgs string
+
+	// logPorts and logArgs collect all -port and -args values in command line order for logging several devices in parallel.
+	logPorts, logArgs []string
+
 	// pSrcZ is a string pointer to the safety string for scZero.
 	// pSrcZ *string
 
@@ -69,5 +93,8 @@ var (
 	insertIDsHelp bool // flag for partial help
 	versionHelp   bool // flag for partial help
 	//zeroIDsHelp       bool // flag for partial help
-	cleanIDsHelp bool // flag for partial help
+	cleanIDsHelp  bool // flag for partial help
+	indexHelp     bool // flag for partial help
+	bandwidthHelp bool // flag for partial help
+	spansHelp     bool // flag for partial help
 )
@@ -37,7 +37,7 @@ func doCHARableTest(t *testing.T, out io.Writer, f decoder.New, endianness bool,
 				break
 			}
 			if decoder.ShowID != "" && lineStart {
-				act += fmt.Sprintf(decoder.ShowID, decoder.LastTriceID)
+				act += fmt.Sprintf(decoder.ShowID, dec.LastID())
 			}
 			act += fmt.Sprint(string(buf[:n]))
 			lineStart = false
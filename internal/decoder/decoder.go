@@ -90,9 +90,6 @@ var (
 	// ShowID is used as format string for displaying the first trice ID at the start of each line if not "".
 	ShowID string
 
-	// decoder.LastTriceID is last decoded ID. It is used for switch -showID.
-	LastTriceID id.TriceID
-
 	// TestTableMode is a special option for easy decoder test table generation.
 	TestTableMode bool
 
@@ -109,8 +106,6 @@ var (
 
 	DebugOut                        = false // DebugOut enables debug information.
 	DumpLineByteCount               int     // DumpLineByteCount is the bytes per line for the dumpDec decoder.
-	InitialCycle                    = true  // InitialCycle is a helper for the cycle counter automatic.
-	TargetTimestamp                 uint64  // targetTimestamp contains target specific timestamp value.
 	TargetLocation                  uint32  // targetLocation contains 16 bit file id in high and 16 bit line number in low part.
 	TargetStamp                     string  // TargetTimeStampUnit is the target timestamps time base for default formatting.
 	TargetStamp32                   string  // ShowTargetStamp32 is the format string for target timestamps.
@@ -121,7 +116,6 @@ var (
 	ShowTargetStamp16Passed         bool    // ShowTargetStamp16Passed is true when flag was TargetTimeStamp16 passed.
 	ShowTargetStamp0Passed          bool    // ShowTargetStamp0Passed is true when flag was TargetTimeStamp0 passed.
 	LocationInformationFormatString string  // LocationInformationFormatString is the format string for target location: line number and file name.
-	TargetTimestampSize             int     // TargetTimestampSize is set in dependence of trice type.
 	TargetLocationExists            bool    // TargetLocationExists is set in dependence of p.COBSModeDescriptor. (obsolete)
 
 	PackageFraming string // Framing is used for packing. Valid values COBS, TCOBS, TCOBSv1 (same as TCOBS)
@@ -134,9 +128,35 @@ type New func(out io.Writer, lut id.TriceIDLookUp, m *sync.RWMutex, li id.TriceI
 
 // Decoder is providing a byte reader returning decoded trice's.
 // SetInput allows switching the input stream to a different source.
+// LastID and TargetStamp return the ID and the target timestamp of the last decoded trice.
+// They are per decoder instance, so several decoders can run in parallel.
 type Decoder interface {
 	io.Reader
 	SetInput(io.Reader)
+	Reset(io.Reader)
+	SetDevice(label string)
+	LastID() id.TriceID
+	TargetStamp() (stamp uint64, size int)
+}
+
+// Exporter gets the raw parameters of each decoded trice instead of a formatted string.
+// params are in target endianness and valid only during the Export call.
+type Exporter interface {
+	Export(tid id.TriceID, stamp uint64, stampSize int, params []byte)
+}
+
+// PackageExporter is an Exporter, which gets additionally the framed size of each package before its trices are exported.
+// The size includes the package delimiter. Without package framing there are no packages.
+type PackageExporter interface {
+	Exporter
+	ExportPackage(size int)
+}
+
+// GapExporter is an Exporter, which gets additionally notified, when the cycle counter shows lost trices.
+// ExportGap is called before the first trice after the gap is exported.
+type GapExporter interface {
+	Exporter
+	ExportGap()
 }
 
 // DecoderData is the common data struct for all decoders.
@@ -155,6 +175,23 @@ type DecoderData struct {
 	LutMutex    *sync.RWMutex      // to avoid concurrent map read and map write during map refresh triggered by filewatcher
 	Li          id.TriceIDLookUpLI // location information map
 	Trice       id.TriceFmt        // id.TriceFmt // received trice
+
+	LastTriceID         id.TriceID // LastTriceID is last decoded ID. It is used for switch -showID.
+	TargetTimestamp     uint64     // TargetTimestamp contains target specific timestamp value.
+	TargetTimestampSize int        // TargetTimestampSize is set in dependence of trice type.
+
+	Exporter Exporter // Exporter, if not nil, gets the trice parameters and no trice strings are generated.
+	Device   string   // Device is the label of the trice source, when several devices are logged in parallel.
+}
+
+// LastID returns the last decoded trice ID.
+func (p *DecoderData) LastID() id.TriceID {
+	return p.LastTriceID
+}
+
+// TargetStamp returns the target timestamp of the last decoded trice and its size in bytes.
+func (p *DecoderData) TargetStamp() (stamp uint64, size int) {
+	return p.TargetTimestamp, p.TargetTimestampSize
 }
 
 // SetInput allows switching the input stream to a different source.
@@ -164,6 +201,26 @@ func (p *DecoderData) SetInput(r io.Reader) {
 	p.In = r
 }
 
+// Reset switches the input stream to r and discards all not yet decoded bytes of the previous input.
+//
+// A reconnected device starts with a new package, so a package cut off by the disconnect must not be continued.
+func (p *DecoderData) Reset(r io.Reader) {
+	p.In = r
+	p.IBuf = p.IBuf[:0]
+	p.B = p.B[:0]
+}
+
+// SetExporter lets the decoder pass the trice parameters to e instead of generating trice strings.
+// Only the TREX decoder supports an exporter.
+func (p *DecoderData) SetExporter(e Exporter) {
+	p.Exporter = e
+}
+
+// SetDevice sets the label of the trice source. Per device state, like the target health record, is kept under this label.
+func (p *DecoderData) SetDevice(label string) {
+	p.Device = label
+}
+
 // ReadU16 returns the 2 b bytes as uint16 according the specified endianness
 func (p *DecoderData) ReadU16(b []byte) uint16 {
 	if p.Endian {
@@ -58,15 +58,19 @@ func DistributeArgs(w io.Writer, fSys *afero.Afero, logfileName string, verbose
 }
 
 // triceOutput returns w as a a optional combined io.Writer. If fileName is given the returned io.Writer write a copy into the given file.
+// With additional outputs, each output gets its own queue according emitter.OutputPolicy, so a slow output does not stall the others.
 func triceOutput(w io.Writer, fSys *afero.Afero, fileName string, verbose bool) io.Writer {
-	ioWriter := tcpWriter()
+	sinks := []emitter.Sink{{Name: "terminal", W: w}}
+	if TCPOutAddr != "" {
+		sinks = append(sinks, emitter.Sink{Name: "tcp", W: tcpWriter()})
+	}
 
 	// start logging only if fn not "none" or "off"
 	if fileName == "none" || fileName == "off" {
 		if verbose {
 			fmt.Println("No logfile writing...")
 		}
-		return io.MultiWriter(w, ioWriter)
+		return fanOut(w, sinks)
 	}
 
 	if filepath.Base(fileName) == "auto" { // "2006-01-02_1504-05_trice.log" is the pattern for default logfile name. The timestamp is replaced with the actual time.
@@ -83,7 +87,20 @@ func triceOutput(w io.Writer, fSys *afero.Afero, fileName string, verbose bool)
 		fmt.Printf("Writing to logfile %s...\n", fileName)
 	}
 
-	return io.MultiWriter(w, ioWriter, lfHandle)
+	return fanOut(w, append(sinks, emitter.Sink{Name: "logfile", W: lfHandle}))
+}
+
+// fanOut returns w for a single sink or a fan-out feeding each sink from its own queue.
+func fanOut(w io.Writer, sinks []emitter.Sink) io.Writer {
+	if len(sinks) == 1 {
+		return w
+	}
+	policies, err := emitter.ParseOutputPolicies(emitter.OutputPolicy)
+	msg.FatalOnErr(err)
+	for i := range sinks {
+		sinks[i].Policy = policies[sinks[i].Name]
+	}
+	return emitter.NewFanOut(w, emitter.OutputQueue, sinks...)
 }
 
 // evaluateColorPalette
@@ -98,9 +115,6 @@ func evaluateColorPalette(w io.Writer) {
 }
 
 func tcpWriter() io.Writer {
-	if TCPOutAddr == "" {
-		return io.Discard
-	}
 	// The net.Listen() function makes the program a TCP server. This functions returns a Listener variable, which is a generic network listener for stream-oriented protocols.
 	fmt.Println("Listening on " + TCPOutAddr + "...")
 	listen, err := net.Listen("tcp", TCPOutAddr)
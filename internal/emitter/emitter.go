@@ -9,6 +9,7 @@ import (
 	"io"
 	"os"
 	"strings"
+	"sync"
 
 	"github.com/rokath/trice/internal/receiver"
 	"github.com/rokath/trice/pkg/msg"
@@ -113,7 +114,8 @@ type LineWriter interface {
 //  }
 
 // newLineWriter provides a lineWriter which can be a remote Display or the local console.
-func newLineWriter(w io.Writer) (lwD LineWriter) {
+// label is the device output name for the channel event counters, "" for a single device.
+func newLineWriter(w io.Writer, label string) (lwD LineWriter) {
 	if DisplayRemote {
 		//var p *RemoteDisplay
 		//  var args []string
@@ -127,7 +129,7 @@ func newLineWriter(w io.Writer) (lwD LineWriter) {
 		msg.FatalOnErr(p.Err)
 		lwD = p
 	} else {
-		lwD = newColorDisplay(w, ColorPalette)
+		lwD = newColorDisplay(w, ColorPalette, label)
 	}
 	return
 }
@@ -139,17 +141,66 @@ func New(w io.Writer) *TriceLineComposer {
 	}
 	// lineComposer implements the io.StringWriter interface and uses the line writer provided.
 	// The line composer scans the trice strings and composes lines out of them according to its properties.
-	return newLineComposer(newLineWriter(w))
+	return newLineComposer(newLineWriter(w, ""))
+}
+
+// NewDevices creates an emitter instance for each device label, all writing into w.
+// Whole lines of the different devices are written one after another into w. "source:" in Prefix is replaced
+// by the device label, so the merged lines stay distinguishable. The global Prefix is not changed.
+func NewDevices(w io.Writer, labels []string) []*TriceLineComposer {
+	out := NewDeviceOutput(w)
+	composers := make([]*TriceLineComposer, len(labels))
+	for i, label := range labels {
+		composers[i] = out.New(label)
+	}
+	return composers
+}
+
+// DeviceOutput merges the lines of several devices into one writer.
+type DeviceOutput struct {
+	sw *syncWriter
+}
+
+// NewDeviceOutput returns a DeviceOutput writing into w.
+func NewDeviceOutput(w io.Writer) *DeviceOutput {
+	return &DeviceOutput{&syncWriter{w: w}}
+}
+
+// New creates an emitter instance for the device label. It is safe for concurrent use.
+func (p *DeviceOutput) New(label string) *TriceLineComposer {
+	sw := newLineComposer(newLineWriter(p.sw, label))
+	if !TestTableMode {
+		sw.prefix = sourcePrefix(label)
+	}
+	return sw
+}
+
+// syncWriter serializes the writes of several line writers into w.
+type syncWriter struct {
+	mu sync.Mutex
+	w  io.Writer
+}
+
+func (p *syncWriter) Write(b []byte) (int, error) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.w.Write(b)
 }
 
 // setPrefix changes "source:" to e.g., "JLINK:".
 func setPrefix() {
+	Prefix = sourcePrefix(receiver.Port)
+}
+
+// sourcePrefix returns Prefix with "source:" replaced by source, e.g. "JLINK:".
+func sourcePrefix(source string) string {
 	defaultPrefix := "source:"
 	if strings.HasPrefix(Prefix, defaultPrefix) {
-		Prefix = receiver.Port + ":" + Prefix[len(defaultPrefix):]
+		return source + ":" + Prefix[len(defaultPrefix):]
 	} else if Prefix == "off" || Prefix == "none" {
-		Prefix = ""
+		return ""
 	}
+	return Prefix
 }
 
 // BanOrPickFilter returns len of b if b ist not filtered out, otherwise 0.
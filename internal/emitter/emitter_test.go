@@ -47,5 +47,5 @@ func TestNewLineWriter(t *testing.T) {
 	defer msg.OsExitAllow(o)
 	DisplayRemote = true
 	var out bytes.Buffer
-	_ = newLineWriter(&out)
+	_ = newLineWriter(&out, "")
 }
@@ -0,0 +1,253 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package emitter
+
+import (
+	"fmt"
+	"io"
+	"strings"
+	"sync"
+	"sync/atomic"
+
+	"github.com/rokath/trice/internal/profile"
+)
+
+var (
+	// OutputPolicy is the comma separated list of output sink policies, like "terminal:block,logfile:block,tcp:dropNewest".
+	// Sinks not in the list use "block".
+	OutputPolicy = "terminal:block,logfile:block,tcp:dropNewest"
+
+	// OutputQueue is the count of writes each output sink queue can hold.
+	OutputQueue = 1024
+
+	fanOutsMu sync.Mutex
+	fanOuts   []*FanOut // fanOuts are all not closed fan-outs for CloseFanOuts.
+)
+
+// Policy determines what happens, when a write finds the queue of an output sink full.
+type Policy int
+
+const (
+	Block      Policy = iota // Block waits until the sink has space, so a slow sink slows down all others.
+	DropNewest               // DropNewest discards the new data.
+	DropOldest               // DropOldest discards the oldest queued data to make space.
+)
+
+var policyNames = []string{"block", "dropNewest", "dropOldest"}
+
+func (p Policy) String() string {
+	return policyNames[p]
+}
+
+// ParseOutputPolicies returns the sink policies of a list like "terminal:block,tcp:dropOldest".
+func ParseOutputPolicies(s string) (map[string]Policy, error) {
+	m := make(map[string]Policy)
+	for _, item := range strings.Split(s, ",") {
+		if item = strings.TrimSpace(item); item == "" {
+			continue
+		}
+		name, policy, ok := strings.Cut(item, ":")
+		if !ok {
+			return nil, fmt.Errorf("invalid output policy %q, use sink:policy", item)
+		}
+		found := false
+		for i, pn := range policyNames {
+			if strings.EqualFold(policy, pn) {
+				m[name], found = Policy(i), true
+			}
+		}
+		if !found {
+			return nil, fmt.Errorf("unknown output policy %q, use block, dropNewest or dropOldest", policy)
+		}
+	}
+	return m, nil
+}
+
+// Sink is an output destination of a FanOut.
+type Sink struct {
+	Name   string // Name is used in the drop report, like "logfile".
+	W      io.Writer
+	Policy Policy
+}
+
+// sinkQueue feeds a sink from its own Go routine.
+type sinkQueue struct {
+	Sink
+	q       chan []byte
+	dropped atomic.Uint64
+	written atomic.Uint64 // written is the count of written bytes.
+	err     error         // err is the first write error.
+	done    chan struct{}
+}
+
+// put queues b according the sink policy.
+func (p *sinkQueue) put(b []byte) {
+	switch p.Policy {
+	case DropNewest:
+		select {
+		case p.q <- b:
+		default:
+			p.dropped.Add(1)
+		}
+	case DropOldest:
+		for {
+			select {
+			case p.q <- b:
+				return
+			default:
+			}
+			select {
+			case <-p.q:
+				p.dropped.Add(1)
+			default:
+			}
+		}
+	default:
+		start := profile.Now()
+		p.q <- b
+		profile.Output.Waited(start)
+	}
+}
+
+// loop writes the queued data. Data queued meanwhile are combined into one write.
+func (p *sinkQueue) loop() {
+	defer close(p.done)
+	var buf []byte
+	for b := range p.q {
+		buf = append(buf[:0], b...)
+	collect:
+		for len(buf) < 64*1024 {
+			select {
+			case b, ok := <-p.q:
+				if !ok {
+					break collect
+				}
+				buf = append(buf, b...)
+			default:
+				break collect
+			}
+		}
+		p.write(buf)
+	}
+}
+
+func (p *sinkQueue) write(b []byte) {
+	n, err := p.W.Write(b)
+	p.written.Add(uint64(n))
+	if err != nil && p.err == nil {
+		p.err = err
+	}
+}
+
+// FanOut writes into several sinks. Each sink has its own bounded queue and Go routine,
+// so a slow sink does not slow down the others, as long as its policy is not Block.
+type FanOut struct {
+	report io.Writer
+	sinks  []*sinkQueue
+	mu     sync.RWMutex // mu protects closed.
+	closed bool
+}
+
+// NewFanOut starts a Go routine with a queue of queueSize writes for each sink.
+// On Close, the dropped writes and write errors are reported into report.
+func NewFanOut(report io.Writer, queueSize int, sinks ...Sink) *FanOut {
+	p := &FanOut{report: report}
+	for _, s := range sinks {
+		sq := &sinkQueue{Sink: s, q: make(chan []byte, queueSize), done: make(chan struct{})}
+		p.sinks = append(p.sinks, sq)
+		go sq.loop()
+	}
+	fanOutsMu.Lock()
+	fanOuts = append(fanOuts, p)
+	fanOutsMu.Unlock()
+	return p
+}
+
+// Write queues a copy of b for each sink. After Close, b is written directly into each sink.
+func (p *FanOut) Write(b []byte) (int, error) {
+	p.mu.RLock()
+	defer p.mu.RUnlock()
+	if p.closed {
+		for _, s := range p.sinks {
+			s.write(b)
+		}
+		return len(b), nil
+	}
+	c := append([]byte(nil), b...) // The sinks share c read-only.
+	for _, s := range p.sinks {
+		s.put(c)
+	}
+	return len(b), nil
+}
+
+// Dropped returns the count of dropped writes of the sink name.
+func (p *FanOut) Dropped(name string) uint64 {
+	for _, s := range p.sinks {
+		if s.Name == name {
+			return s.dropped.Load()
+		}
+	}
+	return 0
+}
+
+// Close writes all queued data and reports the dropped writes and write errors of each sink.
+func (p *FanOut) Close() error {
+	p.mu.Lock()
+	if p.closed {
+		p.mu.Unlock()
+		return nil
+	}
+	p.closed = true
+	for _, s := range p.sinks {
+		close(s.q)
+	}
+	for _, s := range p.sinks {
+		<-s.done
+	}
+	p.mu.Unlock()
+	fanOutsMu.Lock()
+	for i, f := range fanOuts {
+		if f == p {
+			fanOuts = append(fanOuts[:i], fanOuts[i+1:]...)
+			break
+		}
+	}
+	fanOutsMu.Unlock()
+	var err error
+	for _, s := range p.sinks {
+		if n := s.dropped.Load(); n > 0 || Verbose {
+			fmt.Fprintln(p.report, "output", s.Name+":", n, "writes dropped with policy", s.Policy)
+		}
+		if s.err != nil {
+			fmt.Fprintln(p.report, "output", s.Name+":", s.err)
+			if err == nil {
+				err = s.err
+			}
+		}
+	}
+	return err
+}
+
+// OutputDrops returns the dropped writes of all not closed fan-outs per sink name.
+func OutputDrops() map[string]uint64 {
+	fanOutsMu.Lock()
+	defer fanOutsMu.Unlock()
+	m := make(map[string]uint64)
+	for _, f := range fanOuts {
+		for _, s := range f.sinks {
+			m[s.Name] += s.dropped.Load()
+		}
+	}
+	return m
+}
+
+// CloseFanOuts closes all fan-outs, so their queued data are written before the program ends.
+func CloseFanOuts() {
+	fanOutsMu.Lock()
+	all := append([]*FanOut(nil), fanOuts...)
+	fanOutsMu.Unlock()
+	for _, f := range all {
+		f.Close()
+	}
+}
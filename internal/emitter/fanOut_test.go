@@ -0,0 +1,108 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package emitter
+
+import (
+	"bytes"
+	"fmt"
+	"io"
+	"strings"
+	"testing"
+	"time"
+
+	"github.com/tj/assert"
+)
+
+// slowSink is a mock output, which waits delay per write or, if stall is not nil, until stall is closed.
+type slowSink struct {
+	lineCounter
+	delay time.Duration
+	stall chan struct{}
+}
+
+func (p *slowSink) Write(b []byte) (int, error) {
+	if p.stall != nil {
+		<-p.stall
+	}
+	time.Sleep(p.delay)
+	return p.lineCounter.Write(b)
+}
+
+// TestFanOutStalledSink checks, that a stalled sink with a drop policy does not stall the writer and the other sinks.
+func TestFanOutStalledSink(t *testing.T) {
+	for _, policy := range []Policy{DropNewest, DropOldest} {
+		fast := &lineCounter{}
+		slow := &slowSink{stall: make(chan struct{})}
+		var report bytes.Buffer
+		f := NewFanOut(&report, 100, Sink{"fast", fast, Block}, Sink{"slow", slow, policy})
+		const lines = 10000
+		for i := 0; i < lines; i++ {
+			fmt.Fprintf(f, "line %d\n", i)
+		}
+		for i := 0; i < 1000 && fast.count() < lines; i++ {
+			time.Sleep(time.Millisecond)
+		}
+		assert.Equal(t, lines, fast.count(), "the fast sink got all lines, while the slow sink is stalled")
+		close(slow.stall)
+		assert.Nil(t, f.Close())
+		dropped := int(f.Dropped("slow"))
+		assert.True(t, dropped > lines/2, dropped) // a queue of 100 writes and the writes combined before the stall
+		assert.Equal(t, lines, slow.count()+dropped, policy)
+		assert.Equal(t, fmt.Sprintf("output slow: %d writes dropped with policy %s\n", dropped, policy), report.String())
+		last := fmt.Sprintf("line %d\n", lines-1)
+		assert.Equal(t, policy == DropOldest, strings.HasSuffix(slow.String(), last), "only dropOldest keeps the newest lines")
+		assert.True(t, strings.HasPrefix(slow.String(), "line 0\n") || policy == DropOldest, "dropNewest keeps the oldest lines")
+	}
+}
+
+// TestFanOutBlock checks, that the block policy loses nothing and all data are written on Close.
+func TestFanOutBlock(t *testing.T) {
+	slow := &slowSink{delay: 100 * time.Microsecond}
+	var report bytes.Buffer
+	f := NewFanOut(&report, 4, Sink{"slow", slow, Block})
+	var exp bytes.Buffer
+	for i := 0; i < 1000; i++ {
+		fmt.Fprintf(io.MultiWriter(f, &exp), "line %d\n", i)
+	}
+	assert.Nil(t, f.Close())
+	assert.Equal(t, exp.String(), slow.String())
+	assert.Equal(t, "", report.String())
+	fmt.Fprintln(f, "after close")
+	assert.True(t, strings.HasSuffix(slow.String(), "after close\n"), "direct write after Close")
+}
+
+func TestParseOutputPolicies(t *testing.T) {
+	m, err := ParseOutputPolicies("terminal:block, logfile:dropoldest,tcp:dropNewest")
+	assert.Nil(t, err)
+	assert.Equal(t, map[string]Policy{"terminal": Block, "logfile": DropOldest, "tcp": DropNewest}, m)
+	_, err = ParseOutputPolicies("tcp")
+	assert.Error(t, err)
+	_, err = ParseOutputPolicies("tcp:later")
+	assert.Error(t, err)
+}
+
+// BenchmarkFanOut shows the writer throughput with a fast sink and a sink needing 1 ms per write,
+// once called inline like with io.MultiWriter and once with a fan-out dropping the newest writes for the slow sink.
+func BenchmarkFanOut(b *testing.B) {
+	line := []byte("time:   1,234_567 COM1: msg:some measurement value 12345\n")
+	b.Run("inline", func(b *testing.B) {
+		fast, slow := &lineCounter{}, &slowSink{delay: time.Millisecond}
+		w := io.MultiWriter(fast, slow)
+		b.SetBytes(int64(len(line)))
+		for i := 0; i < b.N; i++ {
+			w.Write(line)
+		}
+	})
+	b.Run("fanOut", func(b *testing.B) {
+		fast, slow := &lineCounter{}, &slowSink{delay: time.Millisecond}
+		f := NewFanOut(io.Discard, OutputQueue, Sink{"fast", fast, Block}, Sink{"slow", slow, DropNewest})
+		b.SetBytes(int64(len(line)))
+		for i := 0; i < b.N; i++ {
+			f.Write(line)
+		}
+		f.Close()
+		b.ReportMetric(float64(f.Dropped("slow"))/float64(b.N), "slowDrops/op")
+		assert.Equal(b, b.N, fast.count())
+	})
+}
@@ -19,24 +19,30 @@ type TriceLineComposer struct {
 	suffix          string
 	Line            []string // line collector
 	err             error
+	now             func() time.Time // now returns the host time for the line timestamps.
 }
 
 // newLineComposer constructs log lines according to these rules:...
 // It provides an io.StringWriter interface which is used for the reception of (trice) strings.
 // It uses lw for writing the generated lines.
 func newLineComposer(lw LineWriter) *TriceLineComposer {
-	p := &TriceLineComposer{lw, HostStamp, Prefix, Suffix, make([]string, 0, 4096), nil} // not more than 4096 strings per line expected
+	p := &TriceLineComposer{lw, HostStamp, Prefix, Suffix, make([]string, 0, 4096), nil, time.Now} // not more than 4096 strings per line expected
 	return p
 }
 
+// SetClock lets p use now for the line timestamps instead of the actual time, like the original reception time during a replay.
+func (p *TriceLineComposer) SetClock(now func() time.Time) {
+	p.now = now
+}
+
 // timestamp returns local time as string according var p.timeStampFormat
 func (p *TriceLineComposer) timestamp() string {
 	var s string
 	switch p.timestampFormat {
 	case "LOCmicro":
-		s = time.Now().Format(time.StampMicro) + "  "
+		s = p.now().Format(time.StampMicro) + "  "
 	case "UTCmicro":
-		s = "UTC " + time.Now().UTC().Format(time.StampMicro) + "  "
+		s = "UTC " + p.now().UTC().Format(time.StampMicro) + "  "
 	case "off", "none":
 		s = ""
 	case "zero":
@@ -120,8 +126,17 @@ func (p *TriceLineComposer) WriteString(s string) (n int, err error) {
 	return
 }
 
+// Flush passes all lines buffered by the line writer on, if it buffers lines, like the remote display.
+func (p *TriceLineComposer) Flush() {
+	if f, ok := p.lw.(interface{ Flush() }); ok {
+		f.Flush()
+	}
+}
+
 func (p *TriceLineComposer) completeLine() {
 	p.lw.WriteLine(p.Line)
 	p.Line = p.Line[:0]
-	NextLine = true
+	if TestTableMode { // NextLine is used only there, so avoid a shared write, when several devices log in parallel.
+		NextLine = true
+	}
 }
@@ -9,6 +9,8 @@ import (
 	"fmt"
 	"io"
 	"strings"
+	"sync"
+	"sync/atomic"
 	"unicode"
 
 	"github.com/mgutz/ansi"
@@ -21,6 +23,7 @@ import (
 type lineTransformerANSI struct {
 	lw           LineWriter
 	colorPalette string
+	events       []int64 // events are the channel event counters of the device output, accessed atomically.
 }
 
 func ShowAllColors() {
@@ -47,8 +50,9 @@ func ShowAllColors() {
 
 // newLineTransformerANSI translates lines to ANSI colors according to colorPalette.
 // It provides a Linewriter interface and uses internally a Linewriter.
+// The channel events are counted for the device output "".
 func newLineTransformerANSI(lw LineWriter, colorPalette string) *lineTransformerANSI {
-	p := &lineTransformerANSI{lw, colorPalette}
+	p := &lineTransformerANSI{lw: lw, colorPalette: colorPalette, events: deviceChannelEvents("")}
 	return p
 }
 
@@ -98,7 +102,7 @@ func isLower(s string) bool {
 }
 
 type colorChannel struct {
-	events   int
+	events   int64 // events is the sum of all device outputs. It is accessed atomically, because several devices can log in parallel.
 	channel  []string
 	colorize func(string) string
 }
@@ -136,24 +140,43 @@ var colorChannels = []colorChannel{
 	{0, []string{"Verbose", "verbose", "VERBOSE"}, colorizeVERBOSE},
 }
 
-// ColorChannelEvents returns count of occurred channel events.
+// deviceEvents holds the channel event counters of each device output. The key is the device label, "" for a single device.
+var deviceEvents = struct {
+	sync.Mutex
+	m map[string][]int64
+}{m: make(map[string][]int64)}
+
+// deviceChannelEvents returns the channel event counters of the device output label.
+func deviceChannelEvents(label string) []int64 {
+	deviceEvents.Lock()
+	defer deviceEvents.Unlock()
+	events, ok := deviceEvents.m[label]
+	if !ok {
+		events = make([]int64, len(colorChannels))
+		deviceEvents.m[label] = events
+	}
+	return events
+}
+
+// ColorChannelEvents returns count of occurred channel events of the device output label, "" for a single device.
 // If ch is unknown, the returned value is -1.
-func ColorChannelEvents(ch string) int {
-	for _, s := range colorChannels {
-		for _, c := range s.channel {
+func ColorChannelEvents(label, ch string) int {
+	for i := range colorChannels {
+		for _, c := range colorChannels[i].channel {
 			if c == ch {
-				return s.events
+				return int(atomic.LoadInt64(&deviceChannelEvents(label)[i]))
 			}
 		}
 	}
 	return -1
 }
 
-// PrintColorChannelEvents shows the amount of occurred channel events.
+// PrintColorChannelEvents shows the amount of occurred channel events of all device outputs.
 func PrintColorChannelEvents(w io.Writer) {
-	for _, s := range colorChannels {
-		if s.events != 0 {
-			fmt.Fprintf(w, "%6d times: ", s.events)
+	for i := range colorChannels {
+		s := &colorChannels[i]
+		if events := atomic.LoadInt64(&s.events); events != 0 {
+			fmt.Fprintf(w, "%6d times: ", events)
 			for _, c := range s.channel {
 				if ColorPalette != "off" && ColorPalette != "none" {
 					c = s.colorize(c)
@@ -168,7 +191,8 @@ func PrintColorChannelEvents(w io.Writer) {
 // channelVariants returns all variants of ch as string slice.
 // If ch is not inside ansiSel nil is returned.
 func channelVariants(ch string) []string {
-	for _, s := range colorChannels {
+	for i := range colorChannels {
+		s := &colorChannels[i]
 		for _, c := range s.channel {
 			if c == ch {
 				return s.channel
@@ -184,6 +208,14 @@ func isChannel(ch string) bool {
 	return cv != nil
 }
 
+// Channel returns the channel specifier at the start of the trice format string s, like "wrn" for "wrn:hi", or "" if s starts without a known one.
+func Channel(s string) string {
+	if ch, _, ok := strings.Cut(s, ":"); ok && isChannel(ch) {
+		return ch
+	}
+	return ""
+}
+
 // colorize prefixes s with an ansi color code according to these conditions:
 // If p.colorPalette is "off", do nothing.
 // If p.colorPalette is "none" remove only lower case channel info "col:"
@@ -203,10 +235,11 @@ func (p *lineTransformerANSI) colorize(s string) (r string, show bool) {
 	if len(sc) < 2 { // no color separator (no log level)
 		return r, true // do nothing, return unchanged string
 	}
-	for i, cc := range colorChannels {
-		for _, c := range cc.channel {
+	for i := range colorChannels {
+		for _, c := range colorChannels[i].channel {
 			if c == sc[0] {
-				colorChannels[i].events++ // count event
+				atomic.AddInt64(&colorChannels[i].events, 1) // count event
+				atomic.AddInt64(&p.events[i], 1)
 				logLev = i
 			}
 			if c == LogLevel {
@@ -229,7 +262,8 @@ func (p *lineTransformerANSI) colorize(s string) (r string, show bool) {
 	if p.colorPalette == "none" {
 		return r, true
 	}
-	for _, cs := range colorChannels {
+	for i := range colorChannels {
+		cs := &colorChannels[i]
 		for _, c := range cs.channel {
 			if c == sc[0] {
 				return cs.colorize(r), true
@@ -30,6 +30,30 @@ func Test2colorize(t *testing.T) {
 	assert.Equal(t, "de", c)
 }
 
+// TestChannel checks the channel detection of format strings.
+// TestColorChannelEventsPerDevice checks, that each device output counts only its own channel events.
+func TestColorChannelEventsPerDevice(t *testing.T) {
+	a := newLineTransformerANSI(newCheckDisplay(), "none")
+	a.events = deviceChannelEvents("devA")
+	b := newLineTransformerANSI(newCheckDisplay(), "none")
+	b.events = deviceChannelEvents("devB")
+	cycleA := ColorChannelEvents("devA", "CYCLE")
+	cycleB := ColorChannelEvents("devB", "CYCLE")
+	a.colorize("CYCLE:x")
+	a.colorize("cycle:y")
+	b.colorize("CYCLE:z")
+	assert.Equal(t, cycleA+2, ColorChannelEvents("devA", "CYCLE"))
+	assert.Equal(t, cycleB+1, ColorChannelEvents("devB", "CYCLE"))
+	assert.Equal(t, -1, ColorChannelEvents("devA", "unknown"))
+}
+
+func TestChannel(t *testing.T) {
+	assert.Equal(t, "wrn", Channel("wrn:hi %d\\n"))
+	assert.Equal(t, "CYCLE", Channel("CYCLE:x"))
+	assert.Equal(t, "", Channel("abc:de"))
+	assert.Equal(t, "", Channel("msg"))
+}
+
 func Test3colorize(t *testing.T) {
 	lw := newCheckDisplay()
 	p := newLineTransformerANSI(lw, "off")
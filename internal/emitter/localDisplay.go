@@ -10,6 +10,8 @@ import (
 	"path/filepath"
 	"runtime"
 	"strings"
+
+	"github.com/rokath/trice/internal/profile"
 )
 
 // localDisplay is an object used for displaying.
@@ -42,8 +44,10 @@ func (p *localDisplay) errorFatal() {
 // WriteLine is the implemented Linewriter interface for localDisplay.
 func (p *localDisplay) WriteLine(line []string) {
 	p.errorFatal()
+	start := profile.Now()
 	s := strings.Join(line, "")
 	_, p.Err = fmt.Fprintln(p.w, s)
+	profile.Output.Done(start, 1, len(s)+1)
 }
 
 // colorDisplay is an object used for displaying.
@@ -55,8 +59,8 @@ type colorDisplay struct {
 }
 
 // newColorDisplay creates a ColorDisplay. It provides a Linewriter.
-// It uses internally a local display combined with a line transformer.
-func newColorDisplay(w io.Writer, colorPalette string) *colorDisplay {
+// It uses internally a local display combined with a line transformer, which counts the channel events for the device output label.
+func newColorDisplay(w io.Writer, colorPalette, label string) *colorDisplay {
 
 	// display lD implements the Linewriter interface needed by lineTransformer.
 	// It interprets the lines written to it according to its properties.
@@ -64,6 +68,7 @@ func newColorDisplay(w io.Writer, colorPalette string) *colorDisplay {
 	// lwT uses the Linewriter lD internally.
 	// It provides a Linewriter.
 	lwT := newLineTransformerANSI(lD, colorPalette)
+	lwT.events = deviceChannelEvents(label)
 
 	cD := &colorDisplay{lD, lwT}
 	return cD
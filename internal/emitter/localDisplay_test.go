@@ -18,7 +18,7 @@ func Example_newLocalDisplay() {
 }
 
 func Example_newColorDisplay() {
-	p := newColorDisplay(os.Stdout, "none")
+	p := newColorDisplay(os.Stdout, "none", "")
 	l1 := []string{"msg:This is ", "the 1st ", "line"}
 	l2 := []string{"MSG:This is ", "the 2nd ", "line"}
 	p.WriteLine(l1)
@@ -11,11 +11,29 @@ import (
 	"path/filepath"
 	"runtime"
 	"strings"
+	"sync"
+	"time"
 
 	"github.com/rokath/trice/pkg/msg"
 )
 
+var (
+	// DisplayServerBatch is the maximum line count sent with one DisplayServer.WriteLines call.
+	// 0 sends each line with a synchronous DisplayServer.WriteLine call.
+	DisplayServerBatch = 256
+
+	// DisplayServerDelay is the maximum time a line waits for more lines to fill a batch.
+	DisplayServerDelay = 20 * time.Millisecond
+
+	// DisplayServerQueue is the count of batches waiting for sending. When full, lines are dropped and counted.
+	DisplayServerQueue = 64
+)
+
 // remoteDisplay is transferring to a remote display object.
+//
+// Lines are collected into batches, which a sender Go routine transfers one after another over the RPC connection.
+// So the decoding does not wait for the network round trip. Only when the batch queue is full, lines are dropped.
+// The dropped line count is displayed remotely with the next sent batch.
 type remoteDisplay struct {
 	w      io.Writer   // os.Stdout
 	Err    error       // stored error
@@ -24,6 +42,18 @@ type remoteDisplay struct {
 	IPAddr string      // IP addr
 	IPPort string      // IP port
 	PtrRPC *rpc.Client // PtrRPC is a pointer for remote calls valid after a successful rpc.Dial()
+
+	batchLines int             // batchLines is the maximum batch size or 0 for synchronous line transfers.
+	mu         sync.Mutex      // mu protects the fields below.
+	batch      [][]string      // batch collects the lines until it is full or the delay expired.
+	timer      *time.Timer     // timer sends an incomplete batch after the delay.
+	q          chan [][]string // q holds the batches for the sender.
+	pending    int             // pending is the count of queued and not yet sent batches.
+	sent       *sync.Cond      // sent signals a sent batch.
+	dropped    uint64          // dropped is the count of lines not sent yet reported.
+	drops      uint64          // drops is the total count of dropped lines.
+	closed     bool
+	done       chan struct{} // done is closed, when the sender ended.
 }
 
 // newRemoteDisplay creates a connection to a remote Display and implements the Linewriter interface.
@@ -49,6 +79,13 @@ func newRemoteDisplay(w io.Writer, args []string) *remoteDisplay {
 	//  if Autostart {
 	//  	p.startServer()
 	p.connect()
+	if DisplayServerBatch > 0 {
+		p.batchLines = DisplayServerBatch
+		p.q = make(chan [][]string, DisplayServerQueue)
+		p.done = make(chan struct{})
+		p.sent = sync.NewCond(&p.mu)
+		go p.send()
+	}
 	return p
 }
 
@@ -63,8 +100,125 @@ func (p *remoteDisplay) errorFatal() {
 
 // WriteLine is implementing the Linewriter interface for RemoteDisplay.
 func (p *remoteDisplay) WriteLine(line []string) {
-	p.errorFatal()
-	p.Err = p.PtrRPC.Call("DisplayServer.WriteLine", line, nil)
+	if p.batchLines == 0 {
+		p.errorFatal()
+		p.Err = p.PtrRPC.Call("DisplayServer.WriteLine", line, nil)
+		return
+	}
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	if p.closed {
+		return
+	}
+	p.batch = append(p.batch, append([]string(nil), line...)) // The line composer reuses line.
+	if len(p.batch) >= p.batchLines {
+		p.queue()
+	} else if len(p.batch) == 1 {
+		p.timer = time.AfterFunc(DisplayServerDelay, func() {
+			p.mu.Lock()
+			defer p.mu.Unlock()
+			if !p.closed {
+				p.queue()
+			}
+		})
+	}
+}
+
+// queue passes the batch to the sender or drops it, if the sender queue is full. p.mu must be locked.
+func (p *remoteDisplay) queue() {
+	if p.timer != nil {
+		p.timer.Stop()
+		p.timer = nil
+	}
+	if len(p.batch) == 0 {
+		return
+	}
+	if p.dropped > 0 {
+		p.batch = append([][]string{{fmt.Sprintf("wrn:displayserver queue overflow, %d lines dropped", p.dropped)}}, p.batch...)
+	}
+	select {
+	case p.q <- p.batch:
+		p.pending++
+		p.dropped = 0
+	default:
+		n := uint64(len(p.batch))
+		if p.dropped > 0 {
+			n-- // the overflow message
+		}
+		p.dropped += n
+		p.drops += n
+	}
+	p.batch = nil
+}
+
+// Flush sends the collected lines and waits until all queued batches are sent.
+func (p *remoteDisplay) Flush() {
+	if p.batchLines == 0 {
+		return
+	}
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	if !p.closed {
+		p.queue()
+	}
+	for p.pending > 0 {
+		p.sent.Wait()
+	}
+}
+
+// Close sends the collected lines and waits until all queued batches are sent.
+func (p *remoteDisplay) Close() error {
+	if p.batchLines == 0 {
+		return p.Err
+	}
+	p.mu.Lock()
+	if !p.closed {
+		p.queue()
+		p.closed = true
+		close(p.q)
+	}
+	p.mu.Unlock()
+	<-p.done
+	if p.drops > 0 && Verbose {
+		fmt.Fprintln(p.w, "displayserver queue overflow,", p.drops, "lines dropped")
+	}
+	return p.Err
+}
+
+// send is the sender Go routine.
+// A display server without DisplayServer.WriteLines, like an older trice version, gets the lines one by one.
+func (p *remoteDisplay) send() {
+	defer close(p.done)
+	perLine := false
+	for b := range p.q {
+		var err error
+		if !perLine {
+			var n int64
+			err = p.PtrRPC.Call("DisplayServer.WriteLines", b, &n)
+			if se, ok := err.(rpc.ServerError); ok && strings.HasPrefix(string(se), "rpc: can't find method") {
+				perLine = true
+				if Verbose {
+					fmt.Fprintln(p.w, "displayserver has no DisplayServer.WriteLines, sending lines one by one")
+				}
+			}
+		}
+		if perLine {
+			err = nil
+			for _, line := range b {
+				if err = p.PtrRPC.Call("DisplayServer.WriteLine", line, nil); err != nil {
+					break
+				}
+			}
+		}
+		if err != nil && p.Err == nil {
+			p.Err = err
+			fmt.Fprintln(p.w, err)
+		}
+		p.mu.Lock()
+		p.pending--
+		p.sent.Broadcast()
+		p.mu.Unlock()
+	}
 }
 
 //  // startServer starts a display server with the filename exe (if not already running).
@@ -113,6 +267,7 @@ func ScShutdownRemoteDisplayServer(w io.Writer, timeStamp int64, args ...string)
 	if nil == p.PtrRPC {
 		p.connect()
 	}
+	msg.OnErr(p.Close())
 	p.stopServer(timeStamp)
 	return p.Err
 }
@@ -4,6 +4,194 @@
 // white-box test for package emitter.
 package emitter
 
+import (
+	"bytes"
+	"fmt"
+	"io"
+	"net"
+	"net/rpc"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/tj/assert"
+)
+
+// lineCounter is a display output counting the lines. If block is not nil, each write waits for it.
+type lineCounter struct {
+	mu      sync.Mutex
+	b       bytes.Buffer
+	lines   int
+	writing chan struct{} // writing gets a signal on each blocked write.
+	block   chan struct{}
+}
+
+func (p *lineCounter) Write(b []byte) (int, error) {
+	if p.block != nil {
+		p.writing <- struct{}{}
+		<-p.block
+	}
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.lines += bytes.Count(b, []byte("\n"))
+	return p.b.Write(b)
+}
+
+func (p *lineCounter) String() string {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.b.String()
+}
+
+func (p *lineCounter) count() int {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.lines
+}
+
+// startTestDisplayServer serves a display server writing into out on a free loopback port and lets IPAddr and IPPort point to it.
+func startTestDisplayServer(t testing.TB, out io.Writer) {
+	serveTestDisplayServer(t, &DisplayServer{Display: *newColorDisplay(out, "none", "")})
+}
+
+// oldDisplayServer is a display server of a trice version without DisplayServer.WriteLines.
+type oldDisplayServer struct {
+	s     DisplayServer
+	calls int
+}
+
+func (p *oldDisplayServer) WriteLine(line []string, reply *int64) error {
+	p.calls++
+	return p.s.WriteLine(line, reply)
+}
+
+// serveTestDisplayServer serves rcvr as DisplayServer on a free loopback port and lets IPAddr and IPPort point to it.
+func serveTestDisplayServer(t testing.TB, rcvr any) {
+	srv := rpc.NewServer()
+	assert.Nil(t, srv.RegisterName("DisplayServer", rcvr))
+	l, err := net.Listen("tcp", "127.0.0.1:0")
+	assert.Nil(t, err)
+	go func() {
+		for {
+			c, err := l.Accept()
+			if err != nil {
+				return
+			}
+			go srv.ServeConn(c)
+		}
+	}()
+	ipa, ipp := IPAddr, IPPort
+	IPAddr, IPPort, _ = net.SplitHostPort(l.Addr().String())
+	t.Cleanup(func() {
+		l.Close()
+		IPAddr, IPPort = ipa, ipp
+	})
+}
+
+// setDisplayServerBatching sets the batching parameters and restores them after the test.
+func setDisplayServerBatching(t testing.TB, lines int, delay time.Duration, queue int) {
+	l, d, q := DisplayServerBatch, DisplayServerDelay, DisplayServerQueue
+	DisplayServerBatch, DisplayServerDelay, DisplayServerQueue = lines, delay, queue
+	t.Cleanup(func() { DisplayServerBatch, DisplayServerDelay, DisplayServerQueue = l, d, q })
+}
+
+func TestRemoteDisplayBatch(t *testing.T) {
+	out := &lineCounter{}
+	startTestDisplayServer(t, out)
+	setDisplayServerBatching(t, 4, time.Hour, 8)
+	p := newRemoteDisplay(io.Discard, []string{""})
+	line := []string{"msg:", "line", ""}
+	for i := 0; i < 10; i++ {
+		line[2] = fmt.Sprint(i)
+		p.WriteLine(line) // line is reused like by the line composer
+	}
+	p.Flush()
+	assert.Equal(t, "line0\nline1\nline2\nline3\nline4\nline5\nline6\nline7\nline8\nline9\n", out.String())
+	assert.Nil(t, p.Close())
+}
+
+// TestRemoteDisplayOldServer checks, that batched lines reach a display server without DisplayServer.WriteLines.
+func TestRemoteDisplayOldServer(t *testing.T) {
+	out := &lineCounter{}
+	old := &oldDisplayServer{s: DisplayServer{Display: *newColorDisplay(out, "none", "")}}
+	serveTestDisplayServer(t, old)
+	setDisplayServerBatching(t, 4, time.Hour, 8)
+	p := newRemoteDisplay(io.Discard, []string{""})
+	for i := 0; i < 10; i++ {
+		p.WriteLine([]string{"line", fmt.Sprint(i)})
+	}
+	assert.Nil(t, p.Close())
+	assert.Equal(t, "line0\nline1\nline2\nline3\nline4\nline5\nline6\nline7\nline8\nline9\n", out.String())
+	assert.Equal(t, 10, old.calls)
+}
+
+// TestRemoteDisplayDelay checks, that an incomplete batch is sent after the delay.
+func TestRemoteDisplayDelay(t *testing.T) {
+	out := &lineCounter{}
+	startTestDisplayServer(t, out)
+	setDisplayServerBatching(t, 100, 10*time.Millisecond, 8)
+	p := newRemoteDisplay(io.Discard, []string{""})
+	defer p.Close()
+	p.WriteLine([]string{"single"})
+	for i := 0; i < 100 && out.String() == ""; i++ {
+		time.Sleep(10 * time.Millisecond)
+	}
+	assert.Equal(t, "single\n", out.String())
+}
+
+// TestRemoteDisplayDrops checks, that a blocked display server does not block WriteLine and the drops are reported.
+func TestRemoteDisplayDrops(t *testing.T) {
+	out := &lineCounter{writing: make(chan struct{}), block: make(chan struct{})}
+	startTestDisplayServer(t, out)
+	setDisplayServerBatching(t, 1, time.Hour, 1)
+	p := newRemoteDisplay(io.Discard, []string{""})
+	p.WriteLine([]string{"line1"})
+	<-out.writing // The server is busy with line1.
+	for i := 2; i <= 5; i++ {
+		p.WriteLine([]string{fmt.Sprint("line", i)}) // line2 is queued, line3...5 are dropped
+	}
+	go func() {
+		for range out.writing {
+		}
+	}()
+	close(out.block)
+	p.Flush()
+	p.WriteLine([]string{"line6"})
+	assert.Nil(t, p.Close())
+	close(out.writing)
+	assert.Equal(t, "line1\nline2\ndisplayserver queue overflow, 3 lines dropped\nline6\n", out.String())
+	assert.Equal(t, uint64(3), p.drops)
+}
+
+// BenchmarkRemoteDisplay compares the lines/s of synchronous RPC calls per line with batched lines over a loopback connection.
+func BenchmarkRemoteDisplay(b *testing.B) {
+	for _, batch := range []int{0, 256} {
+		name := "batched"
+		if batch == 0 {
+			name = "rpcPerLine"
+		}
+		b.Run(name, func(b *testing.B) {
+			out := &lineCounter{}
+			startTestDisplayServer(b, out)
+			setDisplayServerBatching(b, batch, 20*time.Millisecond, 1<<20) // The queue is big enough to measure without drops.
+			p := newRemoteDisplay(io.Discard, []string{""})
+			line := []string{"time:   1,234_567", "COM1:", "msg:some measurement value ", "12345"}
+			b.ResetTimer()
+			start := time.Now()
+			for i := 0; i < b.N; i++ {
+				p.WriteLine(line)
+			}
+			p.Flush()
+			b.ReportMetric(float64(b.N)/time.Since(start).Seconds(), "lines/s")
+			b.StopTimer()
+			assert.Nil(b, p.Close())
+			assert.Equal(b, b.N, out.lines)
+			assert.True(b, strings.HasSuffix(out.String(), "12345\n"))
+		})
+	}
+}
+
 //  func TestDummy(t *testing.T) {
 //  }
 //
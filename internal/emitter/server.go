@@ -35,6 +35,15 @@ func (p *DisplayServer) WriteLine(line []string, reply *int64) error {
 	return nil // todo: ? p.Display.lw.Err
 }
 
+// WriteLines is the exported server method for the display of a line batch, if trice tool acts as display server.
+func (p *DisplayServer) WriteLines(lines [][]string, reply *int64) error {
+	*reply = int64(len(lines))
+	for _, line := range lines {
+		p.Display.WriteLine(line)
+	}
+	return nil
+}
+
 // ColorPalette is the exported server function for color palette, if trice tool acts as display server.
 // By declaring it as a Server struct method it is registered as RPC destination.
 func (p *DisplayServer) ColorPalette(s []string, reply *int64) error {
@@ -87,7 +96,7 @@ func ScDisplayServer(w io.Writer) error {
 	a := fmt.Sprintf("%s:%s", IPAddr, IPPort)
 	fmt.Fprintln(w, "displayServer @", a)
 	srv := new(DisplayServer)
-	srv.Display = *newColorDisplay(w, ColorPalette)
+	srv.Display = *newColorDisplay(w, ColorPalette, "")
 	msg.OnErr(rpc.Register(srv))
 	var err error
 	listener, err = net.Listen("tcp", a)
@@ -0,0 +1,395 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+// Generated C format string list for targets decoding trices themselves.
+//
+// The generated C file contains all format strings sorted by ID together with the parameter information and the
+// function triceFormatStringListLookup, which finds an ID in constant time. Depending on the ID density one of two
+// index types is generated:
+//
+//   - direct index: When the ID span is not bigger than twice the ID count, an uint16_t array over the whole ID span
+//     holds the list index + 1 for each ID. That is fastest and not bigger than the hash index.
+//   - perfect hash: Otherwise the IDs are hashed into buckets and each bucket gets a seed, which maps its IDs into
+//     free slots of a power of 2 sized slot table. No ID collides, so the lookup is one bucket and one slot access.
+//
+// The hash function in the generated C code must be identical with cFmtHash.
+
+import (
+	"bytes"
+	"fmt"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"strings"
+
+	"github.com/spf13/afero"
+)
+
+// CFmtListFn is the C file name for the generated format string list or "off".
+var CFmtListFn = "off"
+
+// Values of the generated C enum triceFmtKind_t.
+const (
+	cFmtValues = iota // paramCount values with bitWidth each
+	cFmtS             // TRICE_S runtime string
+	cFmtN             // TRICE_N runtime string with length
+	cFmtB             // TRICE_B buffer
+	cFmtF             // TRICE_F remote function call with buffer
+)
+
+// cFmtListHeader returns the header file name for the C list file fn.
+func cFmtListHeader(fn string) string {
+	return strings.TrimSuffix(fn, filepath.Ext(fn)) + ".h"
+}
+
+// cIncludeGuard returns the include guard macro name for the header file name hName.
+func cIncludeGuard(hName string) string {
+	return strings.ToUpper(strings.Map(func(r rune) rune {
+		if ('a' <= r && r <= 'z') || ('A' <= r && r <= 'Z') || ('0' <= r && r <= '9') {
+			return r
+		}
+		return '_'
+	}, hName)) + "_"
+}
+
+// cFmtListElement is one element of the generated C format string list.
+type cFmtListElement struct {
+	id         TriceID
+	tF         TriceFmt
+	kind       int
+	bitWidth   int
+	paramCount int
+}
+
+// cFmtInfo returns the parameter information of tF for the generated C list.
+// Examples for tF.Type: trice, Trice8, TRice16_2, TRICE_S, TRICE_N, TRICE8_B, TRICE32_F, TRICE_1, triceAssertTrue, TriceSpanEnter.
+func cFmtInfo(tF TriceFmt) (kind, bitWidth, paramCount int) {
+	t := strings.ToUpper(tF.Type)
+	t = strings.TrimSuffix(t, "ASSERTTRUE")
+	t = strings.TrimSuffix(t, "ASSERTFALSE")
+	t = strings.TrimSuffix(t, "SPANENTER")
+	t = strings.TrimSuffix(t, "SPANEXIT")
+	t = strings.TrimPrefix(t, "TRICE")
+	i := strings.IndexByte(t, '_')
+	if i < 0 {
+		i = len(t)
+	}
+	bitWidth, err := strconv.Atoi(t[:i])
+	if err != nil {
+		bitWidth, _ = strconv.Atoi(DefaultTriceBitWidth)
+	}
+	switch suffix := t[i:]; suffix {
+	case "_S":
+		return cFmtS, 8, 1
+	case "_N":
+		return cFmtN, 8, 1
+	case "_B":
+		if i == 0 {
+			bitWidth = 8
+		}
+		return cFmtB, bitWidth, 1
+	case "_F":
+		if i == 0 {
+			bitWidth = 8
+		}
+		return cFmtF, bitWidth, 1
+	case "":
+		return cFmtValues, bitWidth, formatSpecifierCount(tF.Strg)
+	default:
+		paramCount, err = strconv.Atoi(suffix[1:])
+		if err != nil {
+			paramCount = formatSpecifierCount(tF.Strg)
+		}
+		return cFmtValues, bitWidth, paramCount
+	}
+}
+
+// cQuote returns s as C string literal. Non-printable and non-ASCII bytes are octal escaped.
+func cQuote(s string) string {
+	var b strings.Builder
+	b.WriteByte('"')
+	for i := 0; i < len(s); i++ {
+		switch c := s[i]; c {
+		case '"', '\\', '?': // '?' avoids trigraphs
+			b.WriteByte('\\')
+			b.WriteByte(c)
+		case '\n':
+			b.WriteString(`\n`)
+		case '\r':
+			b.WriteString(`\r`)
+		case '\t':
+			b.WriteString(`\t`)
+		default:
+			if c < 0x20 || c >= 0x7f {
+				fmt.Fprintf(&b, `\%03o`, c)
+			} else {
+				b.WriteByte(c)
+			}
+		}
+	}
+	b.WriteByte('"')
+	return b.String()
+}
+
+// cFmtHash is the hash function used for the perfect hash index. It must match triceFmtHash in the generated C code.
+func cFmtHash(x, seed uint32) uint32 {
+	x ^= seed * 0x9E3779B9
+	x *= 0x85EBCA6B
+	x ^= x >> 13
+	x *= 0xC2B2AE35
+	x ^= x >> 16
+	return x
+}
+
+// nextPow2 returns the smallest power of 2 not smaller than n and at least 1.
+func nextPow2(n int) int {
+	p := 1
+	for p < n {
+		p <<= 1
+	}
+	return p
+}
+
+// cFmtPerfectHash returns bucket seeds and a slot table (list index + 1, 0 = free) for ids without collisions.
+// The bucket of an id is (cFmtHash(id, 0) >> 16) & (len(seeds)-1) and its slot is cFmtHash(id, seed) & (len(slots)-1).
+func cFmtPerfectHash(ids []TriceID) (seeds []uint16, slots []uint16) {
+	bucketCount := nextPow2(len(ids) / 4)
+	buckets := make([][]int, bucketCount) // list indexes
+	for i, id := range ids {
+		b := (cFmtHash(uint32(id), 0) >> 16) & uint32(bucketCount-1)
+		buckets[b] = append(buckets[b], i)
+	}
+	order := make([]int, bucketCount)
+	for i := range order {
+		order[i] = i
+	}
+	sort.SliceStable(order, func(i, k int) bool { return len(buckets[order[i]]) > len(buckets[order[k]]) })
+
+	for slotCount := nextPow2(2 * len(ids)); ; slotCount <<= 1 {
+		seeds = make([]uint16, bucketCount)
+		slots = make([]uint16, slotCount)
+		if placeBuckets(ids, buckets, order, seeds, slots) {
+			return
+		}
+	}
+}
+
+// placeBuckets searches a seed for each bucket in order, which maps all bucket ids into free slots.
+func placeBuckets(ids []TriceID, buckets [][]int, order []int, seeds, slots []uint16) bool {
+	mask := uint32(len(slots) - 1)
+	taken := make([]uint32, 0, 16)
+	for _, b := range order {
+		if len(buckets[b]) == 0 {
+			break // sorted by size
+		}
+	nextSeed:
+		for seed := uint32(1); seed <= 0xffff; seed++ {
+			taken = taken[:0]
+			for _, i := range buckets[b] {
+				s := cFmtHash(uint32(ids[i]), seed) & mask
+				if slots[s] != 0 {
+					continue nextSeed
+				}
+				for _, t := range taken {
+					if t == s {
+						continue nextSeed
+					}
+				}
+				taken = append(taken, s)
+			}
+			for k, i := range buckets[b] {
+				slots[taken[k]] = uint16(i + 1)
+			}
+			seeds[b] = uint16(seed)
+			break
+		}
+		if seeds[b] == 0 {
+			return false
+		}
+	}
+	return true
+}
+
+// cFmtListElements returns the C list elements of ilu sorted by ID.
+func (ilu TriceIDLookUp) cFmtListElements() []cFmtListElement {
+	list := make([]cFmtListElement, 0, len(ilu))
+	for _, id := range sortedIDs(ilu) {
+		e := cFmtListElement{id: id, tF: ilu[id]}
+		e.kind, e.bitWidth, e.paramCount = cFmtInfo(e.tF)
+		list = append(list, e)
+	}
+	return list
+}
+
+// appendCTable appends the uint16_t values v as C initializer lines to b.
+func appendCTable(b *bytes.Buffer, v []uint16) {
+	for i, x := range v {
+		if i%16 == 0 {
+			b.WriteString("\n   ")
+		}
+		fmt.Fprintf(b, " %5d,", x)
+	}
+	b.WriteString("\n};\n")
+}
+
+// toCFmtList converts ilu into C source and header in human-readable form. fileName is the C file name.
+func (ilu TriceIDLookUp) toCFmtList(fileName string) (c, h []byte) {
+	hName := filepath.Base(cFmtListHeader(fileName))
+	guard := cIncludeGuard(hName)
+
+	h = []byte(`//! \file ` + hName + `
+//! ///////////////////////////////////////////////////////////////////////////
+
+//! generated code - do not edit!
+
+#ifndef ` + guard + `
+#define ` + guard + `
+
+#include <stdint.h>
+
+//! triceFmtKind_t tells, how the trice parameters are to interpret.
+typedef enum{
+    TRICE_FMT_VALUES = 0, //!< paramCount values with bitWidth each
+    TRICE_FMT_S = 1, //!< runtime string (TRICE_S)
+    TRICE_FMT_N = 2, //!< runtime string with length (TRICE_N)
+    TRICE_FMT_B = 3, //!< buffer with bitWidth elements, the format string is applied to each element (TRICE_B)
+    TRICE_FMT_F = 4 //!< remote function call with a buffer with bitWidth elements (TRICE_F)
+} triceFmtKind_t;
+
+typedef struct{
+    const char* formatString;
+    uint16_t id;
+    uint8_t kind; //!< kind is a triceFmtKind_t value.
+    uint8_t bitWidth; //!< bitWidth is the parameter bit width 8, 16, 32 or 64.
+    uint8_t paramCount; //!< paramCount is the format specifier count for TRICE_FMT_VALUES, otherwise 1.
+} triceFormatStringList_t;
+
+//! triceFormatStringList contains all trice format strings sorted by id together with the parameter information.
+extern const triceFormatStringList_t triceFormatStringList[];
+
+//! triceFormatStringListElements is the triceFormatStringList element count.
+extern const unsigned triceFormatStringListElements;
+
+//! triceFormatStringListLookup returns the triceFormatStringList element for id or 0, if id is unknown.
+//! The lookup time does not depend on the list size.
+const triceFormatStringList_t* triceFormatStringListLookup(uint16_t id);
+
+#endif // ` + guard + `
+`)
+
+	list := ilu.cFmtListElements()
+	var b bytes.Buffer
+	b.WriteString(`//! \file ` + filepath.Base(fileName) + `
+//! ///////////////////////////////////////////////////////////////////////////
+
+//! generated code - do not edit!
+
+#include "` + hName + `"
+
+const triceFormatStringList_t triceFormatStringList[] = {
+    // format-string, id, kind, bitWidth, paramCount
+`)
+	for _, e := range list {
+		fmt.Fprintf(&b, "    { %s, %5d, %d, %2d, %2d }, // %s\n", cQuote(e.tF.Strg), e.id, e.kind, e.bitWidth, e.paramCount, e.tF.Type)
+	}
+	if len(list) == 0 {
+		b.WriteString("    { \"\", 0, 0, 0, 0 } // placeholder, C does not allow empty arrays\n")
+	}
+	fmt.Fprintf(&b, "};\n\nconst unsigned triceFormatStringListElements = %d;\n", len(list))
+
+	ids := make([]TriceID, len(list))
+	for i, e := range list {
+		ids[i] = e.id
+	}
+	switch {
+	case len(ids) == 0:
+		b.WriteString(`
+const triceFormatStringList_t* triceFormatStringListLookup(uint16_t id){
+    (void)id;
+    return 0;
+}
+`)
+	case int(ids[len(ids)-1]-ids[0])+1 <= 2*len(ids): // dense IDs
+		span := int(ids[len(ids)-1]-ids[0]) + 1
+		index := make([]uint16, span)
+		for i, id := range ids {
+			index[id-ids[0]] = uint16(i + 1)
+		}
+		fmt.Fprintf(&b, `
+// Direct index: The IDs are dense enough.
+
+#define TRICE_FMT_ID_MIN %du //!< TRICE_FMT_ID_MIN is the smallest ID.
+#define TRICE_FMT_ID_SPAN %du //!< TRICE_FMT_ID_SPAN is the distance from the smallest to the biggest ID + 1.
+
+//! triceFmtIndex holds for each ID - TRICE_FMT_ID_MIN the triceFormatStringList index + 1 or 0 for an unused ID.
+static const uint16_t triceFmtIndex[TRICE_FMT_ID_SPAN] = {`, ids[0], span)
+		appendCTable(&b, index)
+		b.WriteString(`
+const triceFormatStringList_t* triceFormatStringListLookup(uint16_t id){
+    unsigned i = (unsigned)id - TRICE_FMT_ID_MIN; // wraps for id < TRICE_FMT_ID_MIN
+    if( i >= TRICE_FMT_ID_SPAN || triceFmtIndex[i] == 0 ){
+        return 0;
+    }
+    return &triceFormatStringList[triceFmtIndex[i] - 1];
+}
+`)
+	default: // sparse IDs
+		seeds, slots := cFmtPerfectHash(ids)
+		fmt.Fprintf(&b, `
+// Perfect hash index: The IDs are too sparse for a direct index.
+
+#define TRICE_FMT_BUCKETS %du //!< TRICE_FMT_BUCKETS is the power of 2 bucket count.
+#define TRICE_FMT_SLOTS %du //!< TRICE_FMT_SLOTS is the power of 2 slot count.
+
+//! triceFmtSeed holds for each bucket the hash seed, which maps its IDs into free slots.
+static const uint16_t triceFmtSeed[TRICE_FMT_BUCKETS] = {`, len(seeds), len(slots))
+		appendCTable(&b, seeds)
+		b.WriteString(`
+//! triceFmtSlot holds for each slot the triceFormatStringList index + 1 or 0 for an unused slot.
+static const uint16_t triceFmtSlot[TRICE_FMT_SLOTS] = {`)
+		appendCTable(&b, slots)
+		b.WriteString(`
+static uint32_t triceFmtHash(uint32_t x, uint32_t seed){
+    x ^= seed * 0x9E3779B9u;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+const triceFormatStringList_t* triceFormatStringListLookup(uint16_t id){
+    uint32_t bucket = (triceFmtHash(id, 0) >> 16) & (TRICE_FMT_BUCKETS - 1);
+    uint32_t slot = triceFmtHash(id, triceFmtSeed[bucket]) & (TRICE_FMT_SLOTS - 1);
+    uint16_t k = triceFmtSlot[slot];
+    if( k == 0 || triceFormatStringList[k - 1].id != id ){
+        return 0;
+    }
+    return &triceFormatStringList[k - 1];
+}
+`)
+	}
+	return b.Bytes(), h
+}
+
+// writeFileIfChanged writes b into file fn, when its content differs. That avoids needless target rebuilds.
+func writeFileIfChanged(fSys *afero.Afero, fn string, b []byte) error {
+	if old, err := fSys.ReadFile(fn); err == nil && bytes.Equal(old, b) {
+		return nil
+	}
+	return fSys.WriteFile(fn, b, 0644)
+}
+
+// UpdateCFmtList writes the C format string list source and header for ilu, if CFmtListFn is set.
+func UpdateCFmtList(fSys *afero.Afero, ilu TriceIDLookUp) error {
+	if CFmtListFn == "" || CFmtListFn == "off" || CFmtListFn == "none" {
+		return nil
+	}
+	c, h := ilu.toCFmtList(CFmtListFn)
+	if err := writeFileIfChanged(fSys, CFmtListFn, c); err != nil {
+		return err
+	}
+	return writeFileIfChanged(fSys, cFmtListHeader(CFmtListFn), h)
+}
@@ -0,0 +1,219 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+import (
+	"bytes"
+	"fmt"
+	"math/rand"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strconv"
+	"strings"
+	"testing"
+
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+func TestCFmtInfo(t *testing.T) {
+	ResetGlobalVars(t)
+	tt := []struct {
+		tF                         TriceFmt
+		kind, bitWidth, paramCount int
+	}{
+		{TriceFmt{"trice", "msg:%d %u\n"}, cFmtValues, 32, 2},
+		{TriceFmt{"Trice8", "msg:%d\n"}, cFmtValues, 8, 1},
+		{TriceFmt{"TRice16_2", "msg:%d %d\n"}, cFmtValues, 16, 2},
+		{TriceFmt{"TRICE64_1", "msg:%d\n"}, cFmtValues, 64, 1},
+		{TriceFmt{"TRICE_1", "msg:%d\n"}, cFmtValues, 32, 1},
+		{TriceFmt{"TRICE_S", "msg:%s\n"}, cFmtS, 8, 1},
+		{TriceFmt{"triceS", "msg:%s\n"}, cFmtValues, 32, 1},
+		{TriceFmt{"TRICE_N", "msg:%s\n"}, cFmtN, 8, 1},
+		{TriceFmt{"TRICE_B", "%02x "}, cFmtB, 8, 1},
+		{TriceFmt{"TRICE16_B", "%04x "}, cFmtB, 16, 1},
+		{TriceFmt{"TRICE32_F", "rpc:fn"}, cFmtF, 32, 1},
+		{TriceFmt{"triceAssertTrue", "msg:%d\n"}, cFmtValues, 32, 1},
+		{TriceFmt{"TriceSpanEnter", "sensorRead"}, cFmtValues, 32, 0},
+	}
+	for _, x := range tt {
+		kind, bitWidth, paramCount := cFmtInfo(x.tF)
+		assert.Equal(t, []int{x.kind, x.bitWidth, x.paramCount}, []int{kind, bitWidth, paramCount}, x.tF.Type)
+	}
+}
+
+func TestCQuote(t *testing.T) {
+	assert.Equal(t, `"a\"b\\c\n\t\?\303\244"`, cQuote("a\"b\\c\n\t?ä"))
+}
+
+// TestCFmtPerfectHash checks the perfect hash for collisions on sparse IDs.
+func TestCFmtPerfectHash(t *testing.T) {
+	ids := sparseIDs(3000)
+	seeds, slots := cFmtPerfectHash(ids)
+	mask := uint32(len(slots) - 1)
+	for i, id := range ids {
+		b := (cFmtHash(uint32(id), 0) >> 16) & uint32(len(seeds)-1)
+		s := cFmtHash(uint32(id), uint32(seeds[b])) & mask
+		assert.Equal(t, uint16(i+1), slots[s])
+	}
+}
+
+// sparseIDs returns n sorted pseudo random IDs spread over the whole uint16 range.
+func sparseIDs(n int) []TriceID {
+	r := rand.New(rand.NewSource(1))
+	m := make(map[TriceID]bool)
+	for len(m) < n {
+		m[TriceID(1+r.Intn(65535))] = true
+	}
+	return sortedIDs(m)
+}
+
+// testdataLut returns the ID list from _test/testdata/til.json.
+func testdataLut(t testing.TB) TriceIDLookUp {
+	b, err := os.ReadFile(filepath.Join("..", "..", "_test", "testdata", "til.json"))
+	assert.Nil(t, err)
+	ilu := make(TriceIDLookUp)
+	assert.Nil(t, ilu.FromJSON(b))
+	return ilu
+}
+
+// sparseLut returns an ID list with sparse IDs to get a perfect hash index.
+func sparseLut() TriceIDLookUp {
+	ilu := make(TriceIDLookUp)
+	for _, id := range sparseIDs(3000) {
+		ilu[id] = TriceFmt{Type: "Trice16", Strg: fmt.Sprintf("msg:id %d value %%d\\n", id)}
+	}
+	return ilu
+}
+
+// buildCFmtListCheck writes the C list for ilu, a C check program and compiles it into dir.
+// The check program verifies each ID lookup against the expected values and that unknown IDs are not found.
+// With a count parameter it performs count lookups as benchmark instead.
+func buildCFmtListCheck(t testing.TB, ilu TriceIDLookUp, dir string) string {
+	cc, err := exec.LookPath("cc")
+	if err != nil {
+		t.Skip("no C compiler")
+	}
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	CFmtListFn = filepath.Join(dir, "til.c")
+	defer func() { CFmtListFn = "off" }()
+	assert.Nil(t, UpdateCFmtList(fSys, ilu))
+
+	var b bytes.Buffer
+	b.WriteString(`#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "til.h"
+
+typedef struct{ const char* s; unsigned id, kind, bitWidth, paramCount; } expected_t;
+
+static const expected_t expected[] = {
+`)
+	for _, e := range ilu.cFmtListElements() {
+		fmt.Fprintf(&b, "    { %s, %d, %d, %d, %d },\n", cQuote(e.tF.Strg), e.id, e.kind, e.bitWidth, e.paramCount)
+	}
+	fmt.Fprintf(&b, `};
+#define COUNT %d
+
+int main(int argc, char** argv){
+    unsigned i, known = 0;
+    if( argc > 1 ){ // benchmark
+        unsigned long n = strtoul(argv[1], 0, 10), sum = 0;
+        for( unsigned long k = 0; k < n; k++ ){
+            sum += triceFormatStringListLookup(expected[k %% COUNT].id)->bitWidth;
+        }
+        printf("%%lu\n", sum);
+        return 0;
+    }
+    if( triceFormatStringListElements != COUNT ){
+        printf("element count %%u\n", triceFormatStringListElements);
+        return 1;
+    }
+    for( i = 0; i < COUNT; i++ ){
+        const expected_t* x = &expected[i];
+        const triceFormatStringList_t* e = triceFormatStringListLookup((uint16_t)x->id);
+        if( e == 0 || e->id != x->id || strcmp(e->formatString, x->s) || e->kind != x->kind || e->bitWidth != x->bitWidth || e->paramCount != x->paramCount ){
+            printf("id %%u wrong\n", x->id);
+            return 1;
+        }
+    }
+    for( i = 0; i < 0x10000; i++ ){
+        if( triceFormatStringListLookup((uint16_t)i) ){
+            known++;
+        }
+    }
+    if( known != COUNT ){
+        printf("%%u IDs found instead of %%u\n", known, COUNT);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
+`, len(ilu))
+	assert.Nil(t, os.WriteFile(filepath.Join(dir, "check.c"), b.Bytes(), 0644))
+	exe := filepath.Join(dir, "check")
+	out, err := exec.Command(cc, "-O2", "-std=c99", "-Wall", "-Werror", "-o", exe, filepath.Join(dir, "check.c"), CFmtListFn).CombinedOutput()
+	assert.Nil(t, err, string(out))
+	return exe
+}
+
+// TestCFmtListHost compiles the generated C list for the test data IDs (direct index) and for sparse IDs (perfect hash)
+// and checks, that all IDs resolve correctly.
+func TestCFmtListHost(t *testing.T) {
+	ResetGlobalVars(t)
+	for _, x := range []struct {
+		name  string
+		ilu   TriceIDLookUp
+		index string
+	}{
+		{"testdata", testdataLut(t), "Direct index"},
+		{"sparse", sparseLut(), "Perfect hash index"},
+	} {
+		t.Run(x.name, func(t *testing.T) {
+			dir := t.TempDir()
+			exe := buildCFmtListCheck(t, x.ilu, dir)
+			c, err := os.ReadFile(filepath.Join(dir, "til.c"))
+			assert.Nil(t, err)
+			assert.True(t, strings.Contains(string(c), x.index))
+			out, err := exec.Command(exe).CombinedOutput()
+			assert.Nil(t, err, string(out))
+			assert.Equal(t, "OK\n", string(out))
+		})
+	}
+}
+
+// TestCFmtListUnchanged checks, that the C files are not written again, when the content is unchanged.
+func TestCFmtListUnchanged(t *testing.T) {
+	ResetGlobalVars(t)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	CFmtListFn = "til.c"
+	ilu := TriceIDLookUp{1: {Type: "trice", Strg: "msg:%d\n"}}
+	assert.Nil(t, UpdateCFmtList(fSys, ilu))
+	fi0, err := fSys.Stat("til.h")
+	assert.Nil(t, err)
+	assert.Nil(t, fSys.Chtimes("til.h", fi0.ModTime().Add(-1e9), fi0.ModTime().Add(-1e9)))
+	fi0, _ = fSys.Stat("til.h")
+	assert.Nil(t, UpdateCFmtList(fSys, ilu))
+	fi1, _ := fSys.Stat("til.h")
+	assert.Equal(t, fi0.ModTime(), fi1.ModTime())
+}
+
+// BenchmarkCFmtListLookup measures the C lookup time for the test data IDs.
+func BenchmarkCFmtListLookup(b *testing.B) {
+	for _, x := range []struct {
+		name string
+		ilu  TriceIDLookUp
+	}{
+		{"direct", testdataLut(b)},
+		{"hash", sparseLut()},
+	} {
+		b.Run(x.name, func(b *testing.B) {
+			exe := buildCFmtListCheck(b, x.ilu, b.TempDir())
+			b.ResetTimer()
+			out, err := exec.Command(exe, strconv.Itoa(b.N)).CombinedOutput()
+			assert.Nil(b, err, string(out))
+		})
+	}
+}
@@ -0,0 +1,167 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+import (
+	"bytes"
+	"flag"
+	"fmt"
+	"os"
+	"path/filepath"
+	"regexp"
+	"strings"
+	"testing"
+
+	"github.com/tj/assert"
+)
+
+var updateGate = flag.Bool("updateGate", false, "regenerate the gated trice macros in src/triceIdGate.h")
+
+// idGateSources are the headers defining the trice macros, which src/triceIdGate.h redefines with an ID gate.
+var idGateSources = []string{"trice.h", "trice8.h", "trice16.h", "trice32.h", "trice64.h", "triceOn.h"}
+
+const (
+	idGateBegin = "// Code generated from trice.h, trice8.h ... trice64.h and triceOn.h by \"go test ./internal/id -run TestIDGate -updateGate\". DO NOT EDIT.\n"
+	idGateEnd   = "// End of generated code.\n"
+)
+
+var (
+	idGateDefine  = regexp.MustCompile(`^\s*#\s*define\s+(\w+)\(([^)]*)\)\s*(.*)$`)
+	idGateComment = regexp.MustCompile(`/\*.*?\*/|//.*$`)
+	idGateSpace   = regexp.MustCompile(`\s+`)
+	idGateID      = regexp.MustCompile(`\bid\b`)
+	idGateCall    = regexp.MustCompile(`(\b\w+|\))\(tid\b`)
+)
+
+// idGateMacro is a trice macro with an ID as first and a format string as second parameter.
+type idGateMacro struct {
+	file, name, params, body string
+}
+
+// idGateMacros returns the trice macros of the idGateSources in src with tid as ID parameter name and a one line body.
+func idGateMacros(src string) ([]idGateMacro, error) {
+	var ms []idGateMacro
+	for _, fn := range idGateSources {
+		b, err := os.ReadFile(filepath.Join(src, fn))
+		if err != nil {
+			return nil, err
+		}
+		text := strings.ReplaceAll(string(b), "\r\n", "\n")
+		text = regexp.MustCompile(`\\\n`).ReplaceAllString(text, " ")
+		for _, line := range strings.Split(text, "\n") {
+			m := idGateDefine.FindStringSubmatch(line)
+			if m == nil {
+				continue
+			}
+			params := strings.Split(m[2], ",")
+			for i := range params {
+				params[i] = strings.TrimSpace(params[i])
+			}
+			if len(params) < 2 || (params[0] != "tid" && params[0] != "id") || (params[1] != "fmt" && params[1] != "pFmt") {
+				continue
+			}
+			body := strings.TrimSpace(idGateSpace.ReplaceAllString(idGateComment.ReplaceAllString(m[3], ""), " "))
+			if params[0] == "id" {
+				params[0] = "tid"
+				body = idGateID.ReplaceAllString(body, "tid")
+			}
+			ms = append(ms, idGateMacro{file: fn, name: m[1], params: strings.Join(params, ", "), body: body})
+		}
+	}
+	return ms, nil
+}
+
+// idGateCode returns the gated redefinitions of the trice macros in src. A gated macro calling another gated macro
+// passes the ID as TRICE_ID_ON(tid), because the ID is expanded there and its gate is already passed.
+func idGateCode(src string) ([]byte, error) {
+	ms, err := idGateMacros(src)
+	if err != nil {
+		return nil, err
+	}
+	gated := make(map[string]bool, len(ms))
+	for _, m := range ms {
+		gated[m.name] = true
+	}
+	var b bytes.Buffer
+	b.WriteString(idGateBegin)
+	file := ""
+	for _, m := range ms {
+		if m.file != file {
+			file = m.file
+			fmt.Fprintf(&b, "\n// %s\n", file)
+		}
+		body := idGateCall.ReplaceAllStringFunc(m.body, func(s string) string {
+			callee := strings.TrimSuffix(s, "(tid")
+			if callee != ")" && !gated[callee] {
+				return s // a trice function or TRICE_ENTER gets the ID unchanged
+			}
+			return callee + "(TRICE_ID_ON(tid)"
+		})
+		fmt.Fprintf(&b, "#undef %s\n#define %s(%s) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(%s)\n", m.name, m.name, m.params, body)
+	}
+	b.WriteString("\n" + idGateEnd)
+	return b.Bytes(), nil
+}
+
+// TestIDGate checks, that the gated macros in src/triceIdGate.h match the trice macro definitions.
+// After changing a trice macro, run "go test ./internal/id -run TestIDGate -updateGate" to regenerate them.
+func TestIDGate(t *testing.T) {
+	src := filepath.Join("..", "..", "src")
+	fn := filepath.Join(src, "triceIdGate.h")
+	h, err := os.ReadFile(fn)
+	assert.Nil(t, err)
+	begin := bytes.Index(h, []byte(idGateBegin))
+	end := bytes.Index(h, []byte(idGateEnd))
+	assert.True(t, begin >= 0 && end > begin, "generated code markers missing in "+fn)
+	end += len(idGateEnd)
+
+	code, err := idGateCode(src)
+	assert.Nil(t, err)
+	if *updateGate {
+		var b bytes.Buffer
+		b.Write(h[:begin])
+		b.Write(code)
+		b.Write(h[end:])
+		assert.Nil(t, os.WriteFile(fn, b.Bytes(), 0644))
+		return
+	}
+	assert.Equal(t, string(code), string(h[begin:end]), fn+" is outdated, run \"go test ./internal/id -run TestIDGate -updateGate\"")
+}
+
+func TestIDGateMacros(t *testing.T) {
+	dir := t.TempDir()
+	for _, fn := range idGateSources {
+		assert.Nil(t, os.WriteFile(filepath.Join(dir, fn), nil, 0644))
+	}
+	assert.Nil(t, os.WriteFile(filepath.Join(dir, "trice16.h"), []byte(`
+#define TRICE16(tid, fmt, ...) TRICE_CONCAT2(TRICE16_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(tid, fmt, ##__VA_ARGS__)
+#define TRICE_PUT16_1(v0) TRICE_PUT(v0);
+#define TRICE16_1(id, pFmt, v0) \
+	TRICE_ENTER id;             \
+	TRICE_CNTC(2);              \
+	TRICE_PUT16_1(v0)           \
+	TRICE_LEAVE
+#define TRICE16_B(id, pFmt, buf, n)    \
+	do {                               \
+		TRICE16_1(id, pFmt, n); /* count */ \
+	} while (0)
+#define trice16_1(tid, fmt, v0) trice16fn_1(tid, (uint16_t)(v0)) //!< function call
+#define TRICE16_F TRICE16_B
+`), 0644))
+	code, err := idGateCode(dir)
+	assert.Nil(t, err)
+	exp := idGateBegin + `
+// trice16.h
+#undef TRICE16
+#define TRICE16(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRICE16_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRICE16_1
+#define TRICE16_1(tid, pFmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(2); TRICE_PUT16_1(v0) TRICE_LEAVE)
+#undef TRICE16_B
+#define TRICE16_B(tid, pFmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(do { TRICE16_1(TRICE_ID_ON(tid), pFmt, n); } while (0))
+#undef trice16_1
+#define trice16_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_1(tid, (uint16_t)(v0)))
+
+` + idGateEnd
+	assert.Equal(t, exp, string(code))
+}
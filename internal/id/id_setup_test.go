@@ -54,6 +54,14 @@ func ResetGlobalVars(t *testing.T) {
 	DefaultStampSize = 32
 	StampSizeId = " ID(0),"
 	TriceCacheEnabled = false
+	WriteSidecars = false
+	Journal = false
+	JournalCompact = false
+	JournalLimit = 65536
+	Watch = false
+	CFmtListFn = "off"
+	StripHeaderFn = "off"
+	StripChannels = nil
 	var err error
 	UserHomeDir, err = os.UserHomeDir()
 	assert.Nil(t, err)
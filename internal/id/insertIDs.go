@@ -22,6 +22,9 @@ import (
 
 // SubCmdIdInsert performs sub-command insert, adding trice IDs to source tree.
 func SubCmdIdInsert(w io.Writer, fSys *afero.Afero) (e error) {
+	if Watch {
+		return WatchInsert(w, fSys, nil)
+	}
 	e = IDData.cmdSwitchTriceIDs(w, fSys, IDData.triceIDInsertion)
 	if e != nil {
 		return e
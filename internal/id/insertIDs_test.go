@@ -420,6 +420,43 @@ func TestInsertWithTickInComment(t *testing.T) {
 	assert.Equal(t, expSrc1, string(actSrc1))
 }
 
+// TestInsertSpans checks, that span trices get different IDs for enter and exit with the same name.
+func TestInsertSpans(t *testing.T) {
+
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer id.SetupTest(t, fSys)()
+
+	// create src file
+	sFn := "file.c"
+	src := `TriceSpanEnter("sensorRead"); TRiceSpanExit("sensorRead");`
+	assert.Nil(t, fSys.WriteFile(sFn, []byte(src), 0777))
+
+	// action
+	var b bytes.Buffer
+	assert.Nil(t, args.Handler(io.Writer(&b), fSys, []string{"trice", "insert", "-IDMin", "100", "-IDMax", "999", "-IDMethod", "downward", "-til", id.FnJSON, "-li", id.LIFnJSON}))
+
+	// check modified src file
+	expSrc := `TriceSpanEnter(iD(999), "sensorRead"); TRiceSpanExit(iD(998), "sensorRead");`
+	actSrc, e := fSys.ReadFile(sFn)
+	assert.Nil(t, e)
+	assert.Equal(t, expSrc, string(actSrc))
+
+	// check modified til.json file
+	expTIL := `{
+	"998": {
+		"Type": "TRiceSpanExit",
+		"Strg": "sensorRead"
+	},
+	"999": {
+		"Type": "TriceSpanEnter",
+		"Strg": "sensorRead"
+	}
+}`
+	actTIL, e := fSys.ReadFile(id.FnJSON)
+	assert.Nil(t, e)
+	assert.Equal(t, expTIL, string(actTIL))
+}
+
 // TestInsertIDsIntoTilJSONFromFileWithLi ...
 //
 // IDs 1200 & 1201 are exist, so they are expected to go into til.json.
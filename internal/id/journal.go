@@ -0,0 +1,257 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+// Append-only journal for til.json and li.json updates.
+//
+// Rewriting the complete til.json and li.json on each insert|add|clean run costs time with big lists and
+// parallel runs on the same lists can loose each others changes. With -journal the lists are locked for
+// the whole run and only new or changed elements are appended to small journal files as JSON lines:
+//
+//	til.json.journal: {"ID":1234,"Type":"TRice","Strg":"msg:value=%d\n"}
+//	li.json.journal:  {"ID":1234,"File":"main.c","Line":77}
+//
+// Readers (NewLut, NewLutLI) apply the journal on top of the JSON file, later lines win.
+// Any complete write of a list file (compaction) removes its journal.
+
+import (
+	"bytes"
+	"encoding/json"
+	"fmt"
+	"io"
+	"os"
+	"sync/atomic"
+	"time"
+
+	"github.com/spf13/afero"
+)
+
+var (
+	// Journal set true, lets insert, add and clean append list changes to journal files under a list lock instead of rewriting the lists.
+	Journal bool
+
+	// JournalCompact set true, forces the merge of the journal files into til.json and li.json.
+	JournalCompact bool
+
+	// JournalLimit is the journal file size in bytes, which triggers an automatic compaction.
+	JournalLimit = 65536
+
+	// LockTimeout is the age after which a not refreshed list lock is considered as left over from a crashed run and removed.
+	LockTimeout = 120 * time.Second
+)
+
+// journalTil is one journal line for til.json.
+type journalTil struct {
+	ID   TriceID
+	Type string
+	Strg string
+}
+
+// journalLi is one journal line for li.json.
+type journalLi struct {
+	ID   TriceID
+	File string
+	Line int
+}
+
+// JournalFileName returns the journal file name for the JSON list file fn.
+func JournalFileName(fn string) string {
+	return fn + ".journal"
+}
+
+// lockFileName returns the lock file name for the JSON list file fn.
+func lockFileName(fn string) string {
+	return fn + ".lock"
+}
+
+// lockSeq makes the lock tokens inside one process unique.
+var lockSeq atomic.Uint64
+
+// lockList acquires an exclusive lock for the list file fn and returns the unlock function.
+// The lock is a lock file created exclusively, what works on all operating systems and file systems.
+// It contains a token of the process ID and a sequence number, so unlock removes only its own lock.
+// While the lock is held, its modification time is refreshed every LockTimeout/4, so that a long run keeps its lock.
+// A lock not refreshed for LockTimeout is treated as stale and removed. Messages go to w.
+func lockList(w io.Writer, fSys *afero.Afero, fn string) (unlock func(), err error) {
+	lfn := lockFileName(fn)
+	token := fmt.Sprintf("%d-%d", os.Getpid(), lockSeq.Add(1))
+	for {
+		f, err := fSys.OpenFile(lfn, os.O_CREATE|os.O_EXCL|os.O_WRONLY, 0644)
+		if err == nil {
+			_, err = f.WriteString(token)
+			if e := f.Close(); err == nil {
+				err = e
+			}
+			if err != nil {
+				fSys.Remove(lfn)
+				return nil, err
+			}
+			done := make(chan struct{})
+			go refreshLock(fSys, lfn, LockTimeout/4, done)
+			return func() {
+				close(done)
+				if b, e := fSys.ReadFile(lfn); e == nil && string(b) == token { // The lock was not taken over as stale.
+					fSys.Remove(lfn)
+				}
+			}, nil
+		}
+		if !os.IsExist(err) {
+			return nil, err // Not a lock conflict, like a missing folder or a missing permission.
+		}
+		fi, e := fSys.Stat(lfn)
+		if e == nil && time.Since(fi.ModTime()) > LockTimeout {
+			removeStaleLock(w, fSys, lfn, token)
+			continue
+		}
+		time.Sleep(10 * time.Millisecond)
+	}
+}
+
+// removeStaleLock removes the stale lock file lfn. Several waiters can see the same stale lock, so lfn is renamed to
+// a name unique for token first. Only one waiter can rename it, but meanwhile another waiter could have replaced the
+// stale lock by a fresh one. Therefore the modification time is checked again after the rename and a fresh lock is given back.
+func removeStaleLock(w io.Writer, fSys *afero.Afero, lfn, token string) {
+	sfn := lfn + "." + token
+	if err := fSys.Rename(lfn, sfn); err != nil {
+		return // Another waiter took it.
+	}
+	if fi, err := fSys.Stat(sfn); err == nil && time.Since(fi.ModTime()) <= LockTimeout {
+		if ok, _ := fSys.Exists(lfn); !ok {
+			fSys.Rename(sfn, lfn)
+			return
+		}
+	}
+	if Verbose {
+		fmt.Fprintln(w, "removing stale lock", lfn)
+	}
+	fSys.Remove(sfn)
+}
+
+// refreshLock sets the modification time of the lock file lfn to now every period until done is closed.
+func refreshLock(fSys *afero.Afero, lfn string, period time.Duration, done chan struct{}) {
+	t := time.NewTicker(period)
+	defer t.Stop()
+	for {
+		select {
+		case <-done:
+			return
+		case <-t.C:
+			now := time.Now()
+			fSys.Chtimes(lfn, now, now)
+		}
+	}
+}
+
+// appendJournal appends lines to the journal of list file fn and returns the resulting journal size.
+func appendJournal(fSys *afero.Afero, fn string, lines []byte) (size int64, err error) {
+	f, err := fSys.OpenFile(JournalFileName(fn), os.O_CREATE|os.O_APPEND|os.O_WRONLY, 0644)
+	if err != nil {
+		return 0, err
+	}
+	defer func() {
+		if e := f.Close(); err == nil {
+			err = e
+		}
+	}()
+	if _, err = f.Write(lines); err != nil {
+		return 0, err
+	}
+	fi, err := f.Stat()
+	if err != nil {
+		return 0, err
+	}
+	return fi.Size(), nil
+}
+
+// journalLines calls f for each complete line in the journal of list file fn.
+// An incomplete last line, left over from an interrupted write, is ignored.
+func journalLines(fSys *afero.Afero, fn string, f func(line []byte) error) error {
+	b, err := fSys.ReadFile(JournalFileName(fn))
+	if err != nil {
+		return nil // no journal
+	}
+	for {
+		i := bytes.IndexByte(b, '\n')
+		if i < 0 {
+			return nil
+		}
+		if err := f(b[:i]); err != nil {
+			return fmt.Errorf("%s: %w", JournalFileName(fn), err)
+		}
+		b = b[i+1:]
+	}
+}
+
+// fromJournal applies the journal of list file fn to ilu.
+func (ilu TriceIDLookUp) fromJournal(fSys *afero.Afero, fn string) error {
+	return journalLines(fSys, fn, func(line []byte) error {
+		var e journalTil
+		if err := json.Unmarshal(line, &e); err != nil {
+			return err
+		}
+		ilu[e.ID] = TriceFmt{Type: e.Type, Strg: e.Strg}
+		return nil
+	})
+}
+
+// fromJournal applies the journal of list file fn to li.
+func (li TriceIDLookUpLI) fromJournal(fSys *afero.Afero, fn string) error {
+	return journalLines(fSys, fn, func(line []byte) error {
+		var e journalLi
+		if err := json.Unmarshal(line, &e); err != nil {
+			return err
+		}
+		li[e.ID] = TriceLI{File: e.File, Line: e.Line}
+		return nil
+	})
+}
+
+// toJournal appends all elements of ilu not equal inside ref to the journal of list file fn.
+func (ilu TriceIDLookUp) toJournal(fSys *afero.Afero, fn string, ref TriceIDLookUp) (size int64, err error) {
+	var lines []byte
+	for _, id := range sortedIDs(ilu) {
+		tF := ilu[id]
+		if r, ok := ref[id]; ok && r == tF {
+			continue
+		}
+		b, err := json.Marshal(journalTil{ID: id, Type: tF.Type, Strg: tF.Strg})
+		if err != nil {
+			return 0, err
+		}
+		lines = append(append(lines, b...), '\n')
+	}
+	if len(lines) == 0 {
+		return 0, nil
+	}
+	return appendJournal(fSys, fn, lines)
+}
+
+// toJournal appends all elements of li not equal inside ref to the journal of list file fn.
+func (li TriceIDLookUpLI) toJournal(fSys *afero.Afero, fn string, ref TriceIDLookUpLI) (size int64, err error) {
+	var lines []byte
+	for _, id := range sortedIDs(li) {
+		l := li[id]
+		if r, ok := ref[id]; ok && r == l {
+			continue
+		}
+		b, err := json.Marshal(journalLi{ID: id, File: l.File, Line: l.Line})
+		if err != nil {
+			return 0, err
+		}
+		lines = append(append(lines, b...), '\n')
+	}
+	if len(lines) == 0 {
+		return 0, nil
+	}
+	return appendJournal(fSys, fn, lines)
+}
+
+// removeJournal removes the journal of list file fn, if existing.
+func removeJournal(fSys afero.Fs, fn string) error {
+	err := fSys.Remove(JournalFileName(fn))
+	if err != nil && os.IsNotExist(err) {
+		return nil
+	}
+	return err
+}
@@ -0,0 +1,139 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+import (
+	"bytes"
+	"io"
+	"path/filepath"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// TestLockListMissingFolder checks, that a lock in a not existing folder fails at once instead of waiting forever.
+func TestLockListMissingFolder(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	fn := filepath.Join(t.TempDir(), "missing", "til.json")
+	done := make(chan error)
+	go func() {
+		_, err := lockList(io.Discard, fSys, fn)
+		done <- err
+	}()
+	select {
+	case err := <-done:
+		assert.NotNil(t, err)
+	case <-time.After(5 * time.Second):
+		t.Fatal("lockList waits for a not existing folder")
+	}
+}
+
+// TestLockListRefresh checks, that a lock held longer than LockTimeout is refreshed and not stolen.
+func TestLockListRefresh(t *testing.T) {
+	defer func(d time.Duration) { LockTimeout = d }(LockTimeout)
+	LockTimeout = 200 * time.Millisecond
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	unlock, err := lockList(io.Discard, fSys, "til.json")
+	assert.Nil(t, err)
+	time.Sleep(2 * LockTimeout)
+
+	acquired := make(chan func())
+	go func() {
+		u, err := lockList(io.Discard, fSys, "til.json")
+		assert.Nil(t, err)
+		acquired <- u
+	}()
+	select {
+	case <-acquired:
+		t.Fatal("held lock was stolen")
+	case <-time.After(2 * LockTimeout):
+	}
+	unlock()
+	(<-acquired)()
+	ok, _ := fSys.Exists(lockFileName("til.json"))
+	assert.False(t, ok)
+}
+
+// setStaleLock writes a lock file for fn, which is older than LockTimeout.
+func setStaleLock(t *testing.T, fSys *afero.Afero, fn string) {
+	lfn := lockFileName(fn)
+	assert.Nil(t, fSys.WriteFile(lfn, []byte("crashed"), 0644))
+	old := time.Now().Add(-2 * LockTimeout)
+	assert.Nil(t, fSys.Chtimes(lfn, old, old))
+}
+
+// TestLockListStaleRace lets two waiters meet one stale lock at the same time. Only one of them may hold the lock.
+func TestLockListStaleRace(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	for i := 0; i < 50; i++ {
+		setStaleLock(t, fSys, "til.json")
+		var mu sync.Mutex
+		var holders, maxHolders int
+		var wg sync.WaitGroup
+		start := make(chan struct{})
+		for k := 0; k < 2; k++ {
+			wg.Add(1)
+			go func() {
+				defer wg.Done()
+				<-start
+				unlock, err := lockList(io.Discard, fSys, "til.json")
+				assert.Nil(t, err)
+				mu.Lock()
+				holders++
+				if holders > maxHolders {
+					maxHolders = holders
+				}
+				mu.Unlock()
+				time.Sleep(time.Millisecond)
+				mu.Lock()
+				holders--
+				mu.Unlock()
+				unlock()
+			}()
+		}
+		close(start)
+		wg.Wait()
+		assert.Equal(t, 1, maxHolders, i)
+		ok, _ := fSys.Exists(lockFileName("til.json"))
+		assert.False(t, ok)
+	}
+}
+
+// TestLockListStaleTakeover checks the late waiter, which acts on an old look at the stale lock after another
+// waiter replaced it already, and the unlock of a run, whose lock was taken over as stale.
+func TestLockListStaleTakeover(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	lfn := lockFileName("til.json")
+	setStaleLock(t, fSys, "til.json")
+	var out bytes.Buffer
+	defer func(v bool) { Verbose = v }(Verbose)
+	Verbose = true
+	unlockA, err := lockList(&out, fSys, "til.json")
+	assert.Nil(t, err)
+	assert.Contains(t, out.String(), "removing stale lock")
+	tokenA, err := fSys.ReadFile(lfn)
+	assert.Nil(t, err)
+
+	removeStaleLock(io.Discard, fSys, lfn, "late") // The late waiter must give the fresh lock back.
+	token, err := fSys.ReadFile(lfn)
+	assert.Nil(t, err)
+	assert.Equal(t, tokenA, token)
+
+	old := time.Now().Add(-2 * LockTimeout) // A hangs and its lock is taken over.
+	assert.Nil(t, fSys.Chtimes(lfn, old, old))
+	unlockB, err := lockList(io.Discard, fSys, "til.json")
+	assert.Nil(t, err)
+	tokenB, err := fSys.ReadFile(lfn)
+	assert.Nil(t, err)
+	unlockA() // must not remove the lock of B
+	token, err = fSys.ReadFile(lfn)
+	assert.Nil(t, err)
+	assert.Equal(t, tokenB, token)
+	unlockB()
+	ok, _ := fSys.Exists(lfn)
+	assert.False(t, ok)
+}
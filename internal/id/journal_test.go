@@ -0,0 +1,131 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id_test
+
+import (
+	"bytes"
+	"fmt"
+	"io"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"regexp"
+	"testing"
+
+	"github.com/rokath/trice/internal/args"
+	"github.com/rokath/trice/internal/id"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// journalInsertArgs returns the insert command line for the lists inside dir and source folder src.
+func journalInsertArgs(dir, src string, extra ...string) []string {
+	a := []string{"trice", "insert", "-journal", "-addParamCount=false", "-IDMin", "1000", "-IDMax", "1199",
+		"-til", filepath.Join(dir, "til.json"), "-li", filepath.Join(dir, "li.json"), "-src", src}
+	return append(a, extra...)
+}
+
+// TestJournalInsertHelper is no real test. It is executed as separate process by TestJournalConcurrentInsert.
+func TestJournalInsertHelper(t *testing.T) {
+	dir, src := os.Getenv("TRICE_JOURNAL_DIR"), os.Getenv("TRICE_JOURNAL_SRC")
+	if dir == "" {
+		t.Skip("helper process only")
+	}
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	assert.Nil(t, args.Handler(io.Discard, fSys, journalInsertArgs(dir, src)))
+}
+
+// TestJournalConcurrentInsert runs several trice insert processes in parallel on the same lists
+// and checks, that no ID is assigned to different format strings.
+func TestJournalConcurrentInsert(t *testing.T) {
+	if testing.Short() {
+		t.Skip("starts processes")
+	}
+	const processes, lines = 8, 12
+	dir := t.TempDir()
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	assert.Nil(t, fSys.WriteFile(filepath.Join(dir, "til.json"), nil, 0644))
+	assert.Nil(t, fSys.WriteFile(filepath.Join(dir, "li.json"), nil, 0644))
+
+	cmds := make([]*exec.Cmd, processes)
+	outs := make([]bytes.Buffer, processes)
+	for p := range cmds {
+		src := filepath.Join(dir, fmt.Sprint("component", p))
+		assert.Nil(t, os.Mkdir(src, 0755))
+		var s string
+		for i := 0; i < lines; i++ {
+			s += fmt.Sprintf("\tTRice(\"msg:component %d line %d value %%d\\n\", %d);\n", p, i, i)
+			s += fmt.Sprintf("\tTRice(\"msg:shared %d value %%d\\n\", %d);\n", i, i)
+		}
+		assert.Nil(t, fSys.WriteFile(filepath.Join(src, "file.c"), []byte(s), 0644))
+
+		cmds[p] = exec.Command(os.Args[0], "-test.run=^TestJournalInsertHelper$")
+		cmds[p].Env = append(os.Environ(), "TRICE_JOURNAL_DIR="+dir, "TRICE_JOURNAL_SRC="+src)
+		cmds[p].Stdout = &outs[p]
+		cmds[p].Stderr = &outs[p]
+		assert.Nil(t, cmds[p].Start())
+	}
+	for p, cmd := range cmds {
+		assert.Nil(t, cmd.Wait(), outs[p].String())
+	}
+
+	// The lists themselves are untouched, all changes are inside the journals.
+	til, err := fSys.ReadFile(filepath.Join(dir, "til.json"))
+	assert.Nil(t, err)
+	assert.Equal(t, 0, len(til))
+	_, err = fSys.Stat(id.JournalFileName(filepath.Join(dir, "til.json")))
+	assert.Nil(t, err)
+
+	check := func() {
+		ilu := id.NewLut(io.Discard, fSys, filepath.Join(dir, "til.json"))
+		li := id.NewLutLI(io.Discard, fSys, filepath.Join(dir, "li.json"))
+		matchInserted := regexp.MustCompile(`TRice\(iD\((\d+)\), "([^"]*)"`)
+		for p := 0; p < processes; p++ {
+			b, err := fSys.ReadFile(filepath.Join(dir, fmt.Sprint("component", p), "file.c"))
+			assert.Nil(t, err)
+			m := matchInserted.FindAllStringSubmatch(string(b), -1)
+			assert.Equal(t, 2*lines, len(m))
+			for _, x := range m {
+				var n id.TriceID
+				assert.Nil(t, n.Set(x[1]))
+				assert.Equal(t, x[2], ilu[n].Strg, "ID "+x[1]+" assigned to different format strings")
+				_, ok := li[n]
+				assert.True(t, ok, "ID "+x[1]+" without location information")
+			}
+		}
+	}
+	check()
+
+	// explicit compaction merges the journals
+	fSysMem := &afero.Afero{Fs: afero.NewOsFs()}
+	assert.Nil(t, args.Handler(io.Discard, fSysMem, journalInsertArgs(dir, filepath.Join(dir, "component0"), "-compact")))
+	for _, fn := range []string{"til.json", "li.json"} {
+		_, err = fSys.Stat(id.JournalFileName(filepath.Join(dir, fn)))
+		assert.True(t, os.IsNotExist(err), fn+" journal not removed")
+	}
+	check()
+}
+
+// TestJournalLimit checks the automatic compaction.
+func TestJournalLimit(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer id.SetupTest(t, fSys)()
+
+	assert.Nil(t, fSys.WriteFile("file0.c", []byte(`TRice("msg:a %d\n", 1);`), 0777))
+	assert.Nil(t, args.Handler(io.Discard, fSys, []string{"trice", "insert", "-journal", "-addParamCount=false", "-til", id.FnJSON, "-li", id.LIFnJSON, "-src", "file0.c"}))
+	til, err := fSys.ReadFile(id.FnJSON)
+	assert.Nil(t, err)
+	assert.Equal(t, "", string(til))
+	assert.Equal(t, 1, len(id.NewLut(io.Discard, fSys, id.FnJSON)))
+
+	assert.Nil(t, fSys.WriteFile("file1.c", []byte(`TRice("msg:b %d\n", 1);`), 0777))
+	assert.Nil(t, args.Handler(io.Discard, fSys, []string{"trice", "insert", "-journal", "-journalLimit", "10", "-addParamCount=false", "-til", id.FnJSON, "-li", id.LIFnJSON, "-src", "file1.c"}))
+	ilu := make(id.TriceIDLookUp)
+	til, err = fSys.ReadFile(id.FnJSON)
+	assert.Nil(t, err)
+	assert.Nil(t, ilu.FromJSON(til))
+	assert.Equal(t, 2, len(ilu))
+	_, err = fSys.Stat(id.JournalFileName(id.FnJSON))
+	assert.True(t, os.IsNotExist(err))
+}
@@ -25,6 +25,7 @@ func NewLut(w io.Writer, fSys *afero.Afero, fn string) TriceIDLookUp {
 		return lu
 	}
 	msg.FatalOnErr(lu.fromFile(fSys, fn))
+	msg.FatalOnErr(lu.fromJournal(fSys, fn))
 	if Verbose {
 		fmt.Fprintln(w, "Read ID List file", fn, "with", len(lu), "items.")
 	}
@@ -38,6 +39,7 @@ func NewLutLI(w io.Writer, fSys *afero.Afero, fn string) TriceIDLookUpLI {
 		return li
 	}
 	msg.FatalOnErr(li.fromFile(fSys, fn))
+	msg.FatalOnErr(li.fromJournal(fSys, fn))
 	if Verbose {
 		fmt.Fprintln(w, "Read ID location information file", fn, "with", len(li), "items.")
 	}
@@ -167,6 +169,9 @@ func (ilu TriceIDLookUp) fromFile(fSys *afero.Afero, fn string) error {
 		b = b[:n]
 	*/
 
+	if ilu.fromSidecar(readSidecar(fSys, fn), b) == nil {
+		return nil // fresh sidecar found
+	}
 	return ilu.FromJSON(b)
 }
 
@@ -178,6 +183,9 @@ func (li TriceIDLookUpLI) fromFile(fSys *afero.Afero, fn string) error {
 	//fSys := os.DirFS("")
 	b, err := fSys.ReadFile(fn)
 	if err == nil { // file found
+		if li.fromSidecar(readSidecar(fSys, fn), b) == nil {
+			return nil // fresh sidecar found
+		}
 		return li.FromJSON(b)
 	}
 	// no li.json
@@ -213,6 +221,7 @@ func (lu TriceIDLookUp) toJSON() ([]byte, error) {
 }
 
 // toFile writes lut into file fn as indented JSON and in verbose mode helpers for third party.
+// An existing journal of fn is removed, because its content is part of ilu now.
 func (ilu TriceIDLookUp) toFile(fSys afero.Fs, fn string) (err error) {
 	var fJSON afero.File
 	fJSON, err = fSys.Create(fn)
@@ -220,6 +229,7 @@ func (ilu TriceIDLookUp) toFile(fSys afero.Fs, fn string) (err error) {
 	defer func() {
 		err = fJSON.Close()
 		msg.FatalOnErr(err)
+		msg.FatalOnErr(removeJournal(fSys, fn))
 	}()
 	var b []byte
 	b, err = ilu.toJSON()
@@ -227,54 +237,19 @@ func (ilu TriceIDLookUp) toFile(fSys afero.Fs, fn string) (err error) {
 	_, err = fJSON.Write(b)
 	msg.FatalOnErr(err)
 	/*
-		var fC, fH, fCS afero.File
+		var fCS afero.File
 		if Verbose { // generate helpers for third party
-			fnC := fn + ".c"
-			fC, err = fSys.Create(fnC)
-			msg.FatalOnErr(err)
-			fnH := fn + ".h"
-			fH, err = fSys.Create(fnH)
-			msg.FatalOnErr(err)
 			fnCS := fn + ".cs"
 			fCS, err = fSys.Create(fnCS)
 			msg.FatalOnErr(err)
 			defer func() {
-				err = fC.Close()
-				msg.FatalOnErr(err)
-				err = fH.Close()
-				msg.FatalOnErr(err)
 				err = fCS.Close()
 				msg.FatalOnErr(err)
 			}()
 
-			cs, e := ilu.toCSFmtList(fnC)
+			cs, e := ilu.toCSFmtList(fn + ".c")
 			_, err = fCS.Write(cs)
 			msg.FatalOnErr(e)
-
-			c, e := ilu.toCFmtList(fnC)
-			_, err = fC.Write(c)
-			msg.FatalOnErr(e)
-
-			h := []byte(`//! \file ` + fnH + `
-		//! ///////////////////////////////////////////////////////////////////////////
-
-		//! generated code - do not edit!
-
-		#include <stdint.h>
-
-		typedef struct{
-		char* formatString;
-		uint16_t id;
-		int16_t dataLength;
-		uint8_t bitWidth;
-		} triceFormatStringList_t;
-
-		extern const triceFormatStringList_t triceFormatStringList[];
-		extern const unsigned triceFormatStringListElements;
-
-		`)
-			_, e = fH.Write(h)
-			msg.FatalOnErr(e)
 		}
 	*/
 	return
@@ -298,12 +273,14 @@ func addID(tF TriceFmt, id TriceID, flu triceFmtLookUp) {
 }
 
 // toFile writes lut into file fn as indented JSON.
+// An existing journal of fn is removed, because its content is part of lim now.
 func (lim TriceIDLookUpLI) toFile(fSys afero.Fs, fn string) (err error) {
 	f0, err := fSys.Create(fn)
 	msg.FatalOnErr(err)
 	defer func() {
 		err = f0.Close()
 		msg.FatalOnErr(err)
+		msg.FatalOnErr(removeJournal(fSys, fn))
 	}()
 
 	b, err := lim.toJSON()
@@ -321,117 +298,6 @@ func (lim TriceIDLookUpLI) toJSON() ([]byte, error) {
 }
 
 /*
-// toCFmtList converts lim into C-source byte slice in human-readable form.
-func (ilu TriceIDLookUp) toCFmtList(fileName string) ([]byte, error) {
-	fileNameBody := fileNameWithoutSuffix(filepath.Base(fileName))
-	c := []byte(`//! \file ` + fileNameBody + `.c
-//! ///////////////////////////////////////////////////////////////////////////
-
-//! generated code - do not edit!
-
-#include "` + fileNameBody + `.h"
-
-//! triceFormatStringList contains all trice format strings together with id and parameter information.
-const triceFormatStringList_t triceFormatStringList[] = {
-	// format-string,                                                                     id, dataLength, bitWidth,
-`)
-	var s string
-	var paramCount int
-	var bitWidth int
-	var dataLength int
-	var add bool
-
-	for id, k := range ilu {
-		s = k.Strg
-		switch k.Type {
-
-		case "TRICE0", "TRICE", "TRICE32", "TRICE32_1", "TRICE32_2", "TRICE32_3", "TRICE32_4", "TRICE32_5", "TRICE32_6", "TRICE32_7", "TRICE32_8", "TRICE32_9", "TRICE32_10", "TRICE32_11", "TRICE32_12":
-			bitWidth = 32
-			paramCount = formatSpecifierCount(s)
-			dataLength = paramCount * 4 // use for checks
-			add = true
-		case "TRICE16", "TRICE16_1", "TRICE16_2", "TRICE16_3", "TRICE16_4", "TRICE16_5", "TRICE16_6", "TRICE16_7", "TRICE16_8", "TRICE16_9", "TRICE16_10", "TRICE16_11", "TRICE16_12":
-			bitWidth = 16
-			paramCount = formatSpecifierCount(s)
-			dataLength = paramCount * 2 // use for checks
-			add = true
-		case "TRICE8", "TRICE8_1", "TRICE8_2", "TRICE8_3", "TRICE8_4", "TRICE8_5", "TRICE8_6", "TRICE8_7", "TRICE8_8", "TRICE8_9", "TRICE8_10", "TRICE8_11", "TRICE8_12":
-			bitWidth = 8
-			paramCount = formatSpecifierCount(s)
-			dataLength = paramCount * 1 // use for checks
-			add = true
-		case "TRICE64", "TRICE64_1", "TRICE64_2", "TRICE64_3", "TRICE64_4", "TRICE64_5", "TRICE64_6", "TRICE64_7", "TRICE64_8", "TRICE64_9", "TRICE64_10", "TRICE64_11", "TRICE64_12":
-			bitWidth = 64
-			paramCount = formatSpecifierCount(s)
-			dataLength = paramCount * 8 // use for checks
-			add = true
-		case "TRICE_S":
-			bitWidth = 8
-			paramCount = 1
-			dataLength = -1 // needs to be derived
-			add = true
-		case "TRICE_N":
-			bitWidth = 8
-			paramCount = 1
-			dataLength = -2 // needs to be derived, add terminating 0
-			add = true
-		case "TRICE_B", "TRICE8_B":
-			bitWidth = 8
-			paramCount = 1
-			dataLength = -8 // needs to be derived
-			add = false     // provide generated format string
-		case "TRICE16_B":
-			bitWidth = 16
-			paramCount = 1
-			dataLength = -16 // needs to be derived
-			add = false      // provide generated format string
-		case "TRICE32_B":
-			bitWidth = 32
-			paramCount = 1
-			dataLength = -32 // needs to be derived
-			add = false      // provide generated format string
-		case "TRICE64_B":
-			bitWidth = 64
-			paramCount = 1
-			dataLength = -64 // needs to be derived
-			add = false      // provide generated format string
-		case "TRICE8_F", "TRICE_F": // example: TRICE_F( Id( 2844), "info:FunctionNameW",  b8,  sizeof(b8) /sizeof(int8_t) );
-			bitWidth = 8
-			paramCount = 1
-			dataLength = -9 // needs to be derived
-			add = false     // provide generated format string
-		case "TRICE16_F":
-			bitWidth = 16
-			paramCount = 1
-			dataLength = -17 // needs to be derived
-			add = false      // provide generated format string
-		case "TRICE32_F":
-			bitWidth = 32
-			paramCount = 1
-			dataLength = -33 // needs to be derived
-			add = false      // provide generated format string
-		case "TRICE64_F":
-			bitWidth = 64
-			paramCount = 1
-			dataLength = -65 // needs to be derived
-			add = false      // provide generated format string
-		default:
-			add = false
-		}
-		if add {
-			c = append(c, []byte(fmt.Sprintf(`    { "%s",%s%5d, %3d, %2d },`+"\n", s, distance(s), id, dataLength, bitWidth))...)
-		}
-	}
-
-	tail := []byte(`};
-
-//! triceFormatStringListElements holds the compile time computed count of list elements.
-const unsigned triceFormatStringListElements = sizeof(triceFormatStringList) / sizeof(triceFormatStringList_t);
-`)
-	c = append(c, tail...)
-	return c, nil
-}
-
 // toCSFmtList converts ilu into CS-source byte slice in human-readable form.
 func (ilu TriceIDLookUp) toCSFmtList(fileName string) ([]byte, error) {
 	c := []byte(`// generated code - do not edit!
@@ -0,0 +1,270 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+// Binary sidecar files for fast list loading.
+//
+// Parsing a til.json with thousands of IDs with encoding/json takes noticeable time on each trice log start.
+// When enabled, trice insert|add|clean write a compact binary copy of til.json and li.json next to them.
+// The sidecar carries the size and a hash of the JSON file it was generated from, so a stale sidecar is detected
+// and ignored. The JSON files stay the only source of truth and should be under version control, the sidecars not.
+//
+// Sidecar layout (little endian):
+//
+//	offset size content
+//	     0    4 magic "TLUT"
+//	     4    1 sidecarVersion
+//	     5    1 kind: sidecarKindTil or sidecarKindLi
+//	     6    2 reserved (0)
+//	     8    8 JSON file size
+//	    16    4 JSON file CRC-32C
+//	    20    4 element count
+//	    24    - elements
+//
+// A til element is uvarint(id), uvarint(len(Type)), Type, uvarint(len(Strg)), Strg.
+// A li element is uvarint(id), uvarint(len(File)), File, uvarint(Line).
+
+import (
+	"encoding/binary"
+	"errors"
+	"hash/crc32"
+	"sort"
+
+	"github.com/spf13/afero"
+)
+
+const (
+	sidecarMagic      = "TLUT"
+	sidecarVersion    = 1
+	sidecarKindTil    = 1
+	sidecarKindLi     = 2
+	sidecarHeaderSize = 24
+
+	// sidecarMinElementSize is the encoded size of an element with empty strings and single byte uvarints.
+	sidecarMinElementSize = 3
+)
+
+var (
+	errSidecar = errors.New("invalid sidecar")
+	castagnoli = crc32.MakeTable(crc32.Castagnoli) // hardware accelerated on most hosts
+)
+
+// SidecarFileName returns the binary sidecar file name for the JSON list file fn.
+func SidecarFileName(fn string) string {
+	return fn + ".bin"
+}
+
+// jsonHash returns the CRC-32C of b. Together with the size it is sufficient to detect a changed JSON file.
+func jsonHash(b []byte) uint32 {
+	return crc32.Checksum(b, castagnoli)
+}
+
+// sidecarHeader returns a sidecar header for count elements of kind generated from JSON data j.
+func sidecarHeader(kind byte, j []byte, count int) []byte {
+	b := make([]byte, sidecarHeaderSize, sidecarHeaderSize+64*count)
+	copy(b, sidecarMagic)
+	b[4] = sidecarVersion
+	b[5] = kind
+	binary.LittleEndian.PutUint64(b[8:], uint64(len(j)))
+	binary.LittleEndian.PutUint32(b[16:], jsonHash(j))
+	binary.LittleEndian.PutUint32(b[20:], uint32(count))
+	return b
+}
+
+// sidecarBody checks the header of sidecar b against kind and JSON data j and returns element count and elements.
+// A sidecar not matching j is stale and reported as error. A count exceeding the body size is an error too.
+func sidecarBody(b []byte, kind byte, j []byte) (count int, body []byte, err error) {
+	if len(b) < sidecarHeaderSize || string(b[:4]) != sidecarMagic || b[4] != sidecarVersion || b[5] != kind {
+		return 0, nil, errSidecar
+	}
+	if binary.LittleEndian.Uint64(b[8:]) != uint64(len(j)) || binary.LittleEndian.Uint32(b[16:]) != jsonHash(j) {
+		return 0, nil, errors.New("stale sidecar")
+	}
+	count, body = int(binary.LittleEndian.Uint32(b[20:])), b[sidecarHeaderSize:]
+	if count > len(body)/sidecarMinElementSize { // a damaged count must not cause a huge allocation
+		return 0, nil, errSidecar
+	}
+	return count, body, nil
+}
+
+// appendString appends s with its uvarint length prefix to b.
+func appendString(b []byte, s string) []byte {
+	b = binary.AppendUvarint(b, uint64(len(s)))
+	return append(b, s...)
+}
+
+// sidecarReader reads elements from a sidecar body.
+// All strings are sub-strings of one single string conversion to avoid an allocation per string.
+type sidecarReader struct {
+	s   string
+	err error
+}
+
+// uvarint reads the next uvarint.
+func (p *sidecarReader) uvarint() uint64 {
+	if p.err != nil {
+		return 0
+	}
+	var x uint64
+	var shift uint
+	for i := 0; i < len(p.s); i++ {
+		c := p.s[i]
+		if i == binary.MaxVarintLen64 {
+			break
+		}
+		if c < 0x80 {
+			p.s = p.s[i+1:]
+			return x | uint64(c)<<shift
+		}
+		x |= uint64(c&0x7f) << shift
+		shift += 7
+	}
+	p.err = errSidecar
+	return 0
+}
+
+// string reads the next length prefixed string.
+func (p *sidecarReader) string() string {
+	n := p.uvarint()
+	if p.err != nil {
+		return ""
+	}
+	if n > uint64(len(p.s)) {
+		p.err = errSidecar
+		return ""
+	}
+	s := p.s[:n]
+	p.s = p.s[n:]
+	return s
+}
+
+// sortedIDs returns the keys of a lookup map in ascending order, so that equal maps give equal sidecars.
+func sortedIDs[V any](m map[TriceID]V) []TriceID {
+	ids := make([]TriceID, 0, len(m))
+	for id := range m {
+		ids = append(ids, id)
+	}
+	sort.Slice(ids, func(i, k int) bool { return ids[i] < ids[k] })
+	return ids
+}
+
+// toSidecar converts ilu into sidecar data. j is the JSON data ilu was written to.
+func (ilu TriceIDLookUp) toSidecar(j []byte) []byte {
+	b := sidecarHeader(sidecarKindTil, j, len(ilu))
+	for _, id := range sortedIDs(ilu) {
+		tF := ilu[id]
+		b = binary.AppendUvarint(b, uint64(id))
+		b = appendString(b, tF.Type)
+		b = appendString(b, tF.Strg)
+	}
+	return b
+}
+
+// fromSidecar extends ilu with the content of sidecar b, if b matches the JSON data j.
+// Nothing is added to ilu in case of an error.
+func (ilu TriceIDLookUp) fromSidecar(b, j []byte) error {
+	count, body, err := sidecarBody(b, sidecarKindTil, j)
+	if err != nil {
+		return err
+	}
+	type element struct {
+		id TriceID
+		tF TriceFmt
+	}
+	elements := make([]element, count)
+	r := sidecarReader{s: string(body)}
+	for i := range elements {
+		elements[i].id = TriceID(r.uvarint())
+		elements[i].tF.Type = r.string()
+		elements[i].tF.Strg = r.string()
+	}
+	if r.err != nil || len(r.s) != 0 {
+		return errSidecar
+	}
+	for _, e := range elements {
+		ilu[e.id] = e.tF
+	}
+	return nil
+}
+
+// toSidecar converts li into sidecar data. j is the JSON data li was written to.
+func (li TriceIDLookUpLI) toSidecar(j []byte) []byte {
+	b := sidecarHeader(sidecarKindLi, j, len(li))
+	for _, id := range sortedIDs(li) {
+		l := li[id]
+		b = binary.AppendUvarint(b, uint64(id))
+		b = appendString(b, l.File)
+		b = binary.AppendUvarint(b, uint64(l.Line))
+	}
+	return b
+}
+
+// fromSidecar extends li with the content of sidecar b, if b matches the JSON data j.
+// Nothing is added to li in case of an error.
+func (li TriceIDLookUpLI) fromSidecar(b, j []byte) error {
+	count, body, err := sidecarBody(b, sidecarKindLi, j)
+	if err != nil {
+		return err
+	}
+	type element struct {
+		id TriceID
+		l  TriceLI
+	}
+	elements := make([]element, count)
+	r := sidecarReader{s: string(body)}
+	for i := range elements {
+		elements[i].id = TriceID(r.uvarint())
+		elements[i].l.File = r.string()
+		elements[i].l.Line = int(r.uvarint())
+	}
+	if r.err != nil || len(r.s) != 0 {
+		return errSidecar
+	}
+	for _, e := range elements {
+		li[e.id] = e.l
+	}
+	return nil
+}
+
+// readSidecar returns the sidecar data for JSON list file fn or nil, if not existing.
+func readSidecar(fSys *afero.Afero, fn string) []byte {
+	b, err := fSys.ReadFile(SidecarFileName(fn))
+	if err != nil {
+		return nil
+	}
+	return b
+}
+
+// writeSidecarIfStale writes sidecar data s for JSON list file fn, when the existing sidecar differs.
+func writeSidecarIfStale(fSys *afero.Afero, fn string, s []byte) error {
+	if string(readSidecar(fSys, fn)) == string(s) {
+		return nil
+	}
+	return fSys.WriteFile(SidecarFileName(fn), s, 0644)
+}
+
+// UpdateSidecars writes binary sidecars for til.json and li.json, if they are missing or stale.
+// The JSON files are read back to derive the sidecars exactly from what is on disk.
+func UpdateSidecars(fSys *afero.Afero) error {
+	if j, err := fSys.ReadFile(FnJSON); err == nil {
+		ilu := make(TriceIDLookUp)
+		if err = ilu.FromJSON(j); err != nil {
+			return err
+		}
+		if err = writeSidecarIfStale(fSys, FnJSON, ilu.toSidecar(j)); err != nil {
+			return err
+		}
+	}
+	if LIFnJSON == "" || LIFnJSON == "off" || LIFnJSON == "none" {
+		return nil
+	}
+	if j, err := fSys.ReadFile(LIFnJSON); err == nil {
+		li := make(TriceIDLookUpLI)
+		if err = li.FromJSON(j); err != nil {
+			return err
+		}
+		return writeSidecarIfStale(fSys, LIFnJSON, li.toSidecar(j))
+	}
+	return nil
+}
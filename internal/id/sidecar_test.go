@@ -0,0 +1,176 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+// white-box test
+package id
+
+import (
+	"encoding/binary"
+	"fmt"
+	"io"
+	"os"
+	"testing"
+
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// TestSidecarRoundTrip checks, that a fresh sidecar gives the same lookup maps as the JSON files.
+func TestSidecarRoundTrip(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer SetupTest(t, fSys)()
+
+	ilu := sampleLut0()
+	assert.Nil(t, ilu.toFile(fSys, FnJSON))
+	li := TriceIDLookUpLI{11: {File: "file0.c", Line: 7}, 12: {File: "dir/file1.c", Line: 1234567}}
+	assert.Nil(t, li.toFile(fSys, LIFnJSON))
+	assert.Nil(t, UpdateSidecars(fSys))
+
+	j, err := fSys.ReadFile(FnJSON)
+	assert.Nil(t, err)
+	rd := make(TriceIDLookUp)
+	assert.Nil(t, rd.fromSidecar(readSidecar(fSys, FnJSON), j))
+	assert.Equal(t, ilu, rd)
+
+	j, err = fSys.ReadFile(LIFnJSON)
+	assert.Nil(t, err)
+	rdLI := make(TriceIDLookUpLI)
+	assert.Nil(t, rdLI.fromSidecar(readSidecar(fSys, LIFnJSON), j))
+	assert.Equal(t, li, rdLI)
+
+	assert.Equal(t, ilu, NewLut(io.Discard, fSys, FnJSON))
+	assert.Equal(t, li, NewLutLI(io.Discard, fSys, LIFnJSON))
+}
+
+// TestSidecarStale checks, that a sidecar not matching its JSON file is ignored.
+func TestSidecarStale(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer SetupTest(t, fSys)()
+
+	assert.Nil(t, sampleLut0().toFile(fSys, FnJSON))
+	assert.Nil(t, UpdateSidecars(fSys))
+	s0 := readSidecar(fSys, FnJSON)
+
+	// edit til.json manually
+	exp := TriceIDLookUp{33: {Type: "t33", Strg: "s33"}}
+	assert.Nil(t, exp.toFile(fSys, FnJSON))
+	j, err := fSys.ReadFile(FnJSON)
+	assert.Nil(t, err)
+	assert.NotEqual(t, nil, make(TriceIDLookUp).fromSidecar(s0, j))
+	assert.Equal(t, exp, NewLut(io.Discard, fSys, FnJSON))
+
+	// refresh
+	assert.Nil(t, UpdateSidecars(fSys))
+	assert.NotEqual(t, s0, readSidecar(fSys, FnJSON))
+	assert.Equal(t, exp, NewLut(io.Discard, fSys, FnJSON))
+
+	// a truncated sidecar is rejected as a whole
+	s1 := readSidecar(fSys, FnJSON)
+	rd := make(TriceIDLookUp)
+	assert.NotEqual(t, nil, rd.fromSidecar(s1[:len(s1)-1], j))
+	assert.Equal(t, 0, len(rd))
+}
+
+// TestSidecarCorruptCount checks, that an element count not fitting into the sidecar is rejected before allocating.
+func TestSidecarCorruptCount(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer SetupTest(t, fSys)()
+
+	assert.Nil(t, sampleLut0().toFile(fSys, FnJSON))
+	li := TriceIDLookUpLI{11: {File: "file0.c", Line: 7}}
+	assert.Nil(t, li.toFile(fSys, LIFnJSON))
+	assert.Nil(t, UpdateSidecars(fSys))
+
+	j, err := fSys.ReadFile(FnJSON)
+	assert.Nil(t, err)
+	s := readSidecar(fSys, FnJSON)
+	binary.LittleEndian.PutUint32(s[20:], 0xFFFFFFFF)
+	rd := make(TriceIDLookUp)
+	assert.Equal(t, errSidecar, rd.fromSidecar(s, j))
+	assert.Equal(t, 0, len(rd))
+
+	j, err = fSys.ReadFile(LIFnJSON)
+	assert.Nil(t, err)
+	s = readSidecar(fSys, LIFnJSON)
+	binary.LittleEndian.PutUint32(s[20:], uint32(len(s)-sidecarHeaderSize)/sidecarMinElementSize+1)
+	rdLI := make(TriceIDLookUpLI)
+	assert.Equal(t, errSidecar, rdLI.fromSidecar(s, j))
+	assert.Equal(t, 0, len(rdLI))
+}
+
+// TestInsertWritesSidecars checks, that insert with WriteSidecars leaves fresh sidecars.
+func TestInsertWritesSidecars(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer SetupTest(t, fSys)()
+	WriteSidecars = true
+
+	src := `TRice("msg:value=%d\n", 1);`
+	fn := t.Name() + "file.c"
+	assert.Nil(t, fSys.WriteFile(fn, []byte(src), 0777))
+	Srcs = ArrayFlag{fn}
+	assert.Nil(t, SubCmdIdInsert(io.Discard, fSys))
+
+	for _, name := range []string{FnJSON, LIFnJSON} {
+		j, err := fSys.ReadFile(name)
+		assert.Nil(t, err)
+		assert.Nil(t, sidecarBodyErr(readSidecar(fSys, name), j), name)
+	}
+	assert.Equal(t, 1, len(NewLut(io.Discard, fSys, FnJSON)))
+}
+
+// sidecarBodyErr returns nil, when sidecar b is fresh for JSON data j.
+func sidecarBodyErr(b, j []byte) error {
+	if len(b) < 6 {
+		return errSidecar
+	}
+	_, _, err := sidecarBody(b, b[5], j)
+	return err
+}
+
+// sidecarBenchmarkFiles writes a til.json and li.json with n elements each into fSys.
+func sidecarBenchmarkFiles(b *testing.B, fSys *afero.Afero, n int) {
+	ilu := make(TriceIDLookUp, n)
+	li := make(TriceIDLookUpLI, n)
+	for i := 0; i < n; i++ {
+		id := TriceID(i + 1)
+		ilu[id] = TriceFmt{Type: "TRice", Strg: fmt.Sprintf("info:This is message %d with value %%d and %%x\\n", i)}
+		li[id] = TriceLI{File: fmt.Sprintf("src/module%03d.c", i%200), Line: i}
+	}
+	FnJSON = b.Name() + "_til.json"
+	LIFnJSON = b.Name() + "_li.json"
+	if err := ilu.toFile(fSys, FnJSON); err != nil {
+		b.Fatal(err)
+	}
+	if err := li.toFile(fSys, LIFnJSON); err != nil {
+		b.Fatal(err)
+	}
+}
+
+// benchmarkLoad measures the trice log list loading time for a 16k elements list.
+func benchmarkLoad(b *testing.B, sidecars bool) {
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	dir, err := os.MkdirTemp("", "sidecar")
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+	fSys = &afero.Afero{Fs: afero.NewBasePathFs(fSys.Fs, dir)}
+	sidecarBenchmarkFiles(b, fSys, 16384)
+	if sidecars {
+		if err := UpdateSidecars(fSys); err != nil {
+			b.Fatal(err)
+		}
+	}
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if len(NewLut(io.Discard, fSys, FnJSON)) != 16384 || len(NewLutLI(io.Discard, fSys, LIFnJSON)) != 16384 {
+			b.Fatal("unexpected list length")
+		}
+	}
+}
+
+// BenchmarkLoadJSON16k measures the til.json and li.json loading time with 16384 elements each.
+func BenchmarkLoadJSON16k(b *testing.B) { benchmarkLoad(b, false) }
+
+// BenchmarkLoadSidecar16k measures the same loading time with fresh sidecars.
+func BenchmarkLoadSidecar16k(b *testing.B) { benchmarkLoad(b, true) }
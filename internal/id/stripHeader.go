@@ -0,0 +1,98 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+// Generated C header for per ID compile time stripping.
+//
+// The header defines TRICE_ID_STRIP to 1 and for each ID n TRICE_ID_ENABLE_n to 0, when the format string starts
+// with a channel listed in StripChannels, like "dbg:" or "diag:", otherwise to 1. Included in triceConfig.h, the
+// variadic trice macros in trice.h compile to nothing for disabled IDs. The source code stays unchanged.
+
+import (
+	"bytes"
+	"fmt"
+	"path/filepath"
+	"strings"
+
+	"github.com/spf13/afero"
+)
+
+var (
+	// StripHeaderFn is the C header file name for the per ID compile time stripping or "off".
+	StripHeaderFn = "off"
+
+	// StripChannels contains colon separated channel lists. IDs of these channels are disabled inside StripHeaderFn.
+	StripChannels ArrayFlag
+)
+
+// stripChannelSet returns the lower case channels of StripChannels.
+func stripChannelSet() map[string]bool {
+	m := make(map[string]bool)
+	for _, list := range StripChannels {
+		for _, ch := range strings.Split(list, ":") {
+			if ch != "" {
+				m[strings.ToLower(ch)] = true
+			}
+		}
+	}
+	return m
+}
+
+// formatChannel returns the channel of format string s, like "dbg" for "dbg:x=%d\n", or "" if s has no channel.
+func formatChannel(s string) string {
+	ch, _, found := strings.Cut(s, ":")
+	if !found || strings.ContainsAny(ch, " \t\n%") {
+		return ""
+	}
+	return ch
+}
+
+// toStripHeader converts ilu into the C header for per ID stripping. fileName is the header file name.
+func (ilu TriceIDLookUp) toStripHeader(fileName string) []byte {
+	hName := filepath.Base(fileName)
+	guard := cIncludeGuard(hName)
+	strip := stripChannelSet()
+	channels := make([]string, 0, len(StripChannels))
+	for _, list := range StripChannels {
+		channels = append(channels, strings.Split(list, ":")...)
+	}
+
+	var b bytes.Buffer
+	fmt.Fprintf(&b, `//! \file %s
+//! ///////////////////////////////////////////////////////////////////////////
+
+//! generated code - do not edit!
+//! Include this file in triceConfig.h to remove trices of the channels %s at compile time.
+
+#ifndef %s
+#define %s
+
+#define TRICE_ID_STRIP 1 //!< TRICE_ID_STRIP enables the per ID compile time stripping in trice.h.
+
+// TRICE_ID_ENABLE_n is 0 for a disabled and 1 for an enabled ID n.
+`, hName, strings.Join(channels, ", "), guard, guard)
+	var disabled int
+	for _, id := range sortedIDs(ilu) {
+		ch := formatChannel(ilu[id].Strg)
+		enable := 1
+		if strip[strings.ToLower(ch)] {
+			enable = 0
+			disabled++
+		}
+		if ch == "" {
+			ch = "-"
+		}
+		fmt.Fprintf(&b, "#define TRICE_ID_ENABLE_%d %d // %s\n", id, enable, ch)
+	}
+	fmt.Fprintf(&b, "\n// %d of %d IDs disabled\n\n#endif // %s\n", disabled, len(ilu), guard)
+	return b.Bytes()
+}
+
+// UpdateStripHeader writes the C header for per ID compile time stripping for ilu, if StripHeaderFn is set.
+func UpdateStripHeader(fSys *afero.Afero, ilu TriceIDLookUp) error {
+	if StripHeaderFn == "" || StripHeaderFn == "off" || StripHeaderFn == "none" {
+		return nil
+	}
+	return writeFileIfChanged(fSys, StripHeaderFn, ilu.toStripHeader(StripHeaderFn))
+}
@@ -0,0 +1,182 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+import (
+	"debug/elf"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+	"testing"
+
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+func TestFormatChannel(t *testing.T) {
+	assert.Equal(t, "dbg", formatChannel("dbg:x=%d\n"))
+	assert.Equal(t, "DIAG", formatChannel("DIAG:x"))
+	assert.Equal(t, "", formatChannel("x=%d\n"))
+	assert.Equal(t, "", formatChannel("x %d: y\n"))
+}
+
+func TestStripHeader(t *testing.T) {
+	ResetGlobalVars(t)
+	StripChannels = ArrayFlag{"dbg:diag"}
+	ilu := TriceIDLookUp{
+		1001: {Type: "trice", Strg: "dbg:a %d\n"},
+		1002: {Type: "trice", Strg: "msg:b %d\n"},
+		1003: {Type: "trice", Strg: "DIAG:c\n"},
+		1004: {Type: "trice", Strg: "no channel\n"},
+	}
+	h := string(ilu.toStripHeader("my/triceStrip.h"))
+	assert.True(t, strings.Contains(h, "#ifndef TRICESTRIP_H_\n"))
+	assert.True(t, strings.Contains(h, "#define TRICE_ID_STRIP 1"))
+	assert.True(t, strings.Contains(h, "#define TRICE_ID_ENABLE_1001 0 // dbg\n"))
+	assert.True(t, strings.Contains(h, "#define TRICE_ID_ENABLE_1002 1 // msg\n"))
+	assert.True(t, strings.Contains(h, "#define TRICE_ID_ENABLE_1003 0 // DIAG\n"))
+	assert.True(t, strings.Contains(h, "#define TRICE_ID_ENABLE_1004 1 // -\n"))
+	assert.True(t, strings.Contains(h, "// 2 of 4 IDs disabled\n"))
+}
+
+// stripCheckC contains trices with enabled and disabled IDs. Each trice is followed by an output of the emitted bytes.
+// It uses variadic, fixed parameter count, uppercase, buffer and string macros and a trice function.
+// ID 1009 has no TRICE_ID_ENABLE_1009 and stays enabled.
+const stripCheckC = `#include <stdio.h>
+#include "trice.h"
+
+extern unsigned cgoTriceBufferDepth;
+void CgoSetTriceBuffer(uint8_t* buf);
+void CgoClearTriceBuffer(void);
+
+static uint8_t buf[4096];
+static uint32_t words[2] = {1, 2};
+
+static void out(const char* name){
+    printf("%s:", name);
+    for( unsigned i = 0; i < cgoTriceBufferDepth; i++ ){
+        printf(" %02x", buf[i]);
+    }
+    printf("\n");
+    CgoClearTriceBuffer();
+}
+
+int main(void){
+    CgoSetTriceBuffer(buf);
+    trice(iD(1001), "dbg:a %d\n", 1); out("1001");
+    trice(iD(1002), "msg:b %d\n", 2); out("1002");
+    TRice16(iD(1003), "diag:c %d %d\n", 3, 4); out("1003");
+    Trice8(iD(1004), "msg:d %d %d %d\n", 5, 6, 7); out("1004");
+    trice(iD(1005), "dbg:e\n"); out("1005");
+    TRICE8(id(1006), "dbg:g %d\n", 9); out("1006");
+    TRICE16_2(Id(1007), "msg:h %d %d\n", 10, 11); out("1007");
+    TRice8_2(iD(1008), "dbg:i %d %d\n", 12, 13); out("1008");
+    triceS(iD(1010), "dbg:j %s\n", "s"); out("1010");
+    TRICE_S(ID(1011), "diag:k %s\n", "S"); out("1011");
+    TRICE32_B(id(1012), "msg:l %d\n", words, 2); out("1012");
+    TriceSpanEnter(iD(1013), "span"); out("1013");
+    trice(iD(1009), "dbg:f %d\n", 8); out("1009");
+    return 0;
+}
+`
+
+// stripTriceConfigH is a host trice configuration, which includes the strip header, when STRIP is defined.
+const stripTriceConfigH = `#ifndef TRICE_CONFIG_H_
+#define TRICE_CONFIG_H_
+#define TRICE_BUFFER TRICE_STACK_BUFFER
+#define TRICE_DIRECT_OUTPUT 1
+#define TRICE_DIRECT_AUXILIARY8 1
+#define TRICE_CGO 1
+#define TRICE_CYCLE_COUNTER 0
+#ifdef STRIP
+#include "triceStrip.h"
+#endif
+#endif
+`
+
+// textSize returns the size of all code sections of the ELF object file fn, like .text and .text.startup.
+func textSize(t *testing.T, fn string) (size uint64) {
+	f, err := elf.Open(fn)
+	if err != nil {
+		t.Skip("no ELF object file")
+	}
+	defer f.Close()
+	for _, s := range f.Sections {
+		if strings.HasPrefix(s.Name, ".text") {
+			size += s.Size
+		}
+	}
+	return
+}
+
+// TestStripHeaderHost compiles host trice code with and without the generated strip header.
+// It checks, that disabled trices emit no bytes, enabled trices are unchanged and the code shrinks.
+func TestStripHeaderHost(t *testing.T) {
+	cc, err := exec.LookPath("cc")
+	if err != nil {
+		t.Skip("no C compiler")
+	}
+	ResetGlobalVars(t)
+	dir := t.TempDir()
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	StripHeaderFn = filepath.Join(dir, "triceStrip.h")
+	StripChannels = ArrayFlag{"dbg", "diag"}
+	ilu := TriceIDLookUp{
+		1001: {Type: "trice", Strg: "dbg:a %d\n"},
+		1002: {Type: "trice", Strg: "msg:b %d\n"},
+		1003: {Type: "TRice16", Strg: "diag:c %d %d\n"},
+		1004: {Type: "Trice8", Strg: "msg:d %d %d %d\n"},
+		1005: {Type: "trice", Strg: "dbg:e\n"},
+		1006: {Type: "TRICE8", Strg: "dbg:g %d\n"},
+		1007: {Type: "TRICE16_2", Strg: "msg:h %d %d\n"},
+		1008: {Type: "TRice8_2", Strg: "dbg:i %d %d\n"},
+		1010: {Type: "triceS", Strg: "dbg:j %s\n"},
+		1011: {Type: "TRICE_S", Strg: "diag:k %s\n"},
+		1012: {Type: "TRICE32_B", Strg: "msg:l %d\n"},
+		1013: {Type: "TriceSpanEnter", Strg: "span"},
+	}
+	assert.Nil(t, UpdateStripHeader(fSys, ilu))
+	assert.Nil(t, os.WriteFile(filepath.Join(dir, "triceConfig.h"), []byte(stripTriceConfigH), 0644))
+	assert.Nil(t, os.WriteFile(filepath.Join(dir, "main.c"), []byte(stripCheckC), 0644))
+
+	src := filepath.Join("..", "..", "src")
+	testdata := filepath.Join("..", "..", "_test", "testdata")
+	lib := []string{filepath.Join(testdata, "cgoTrice.c")}
+	for _, fn := range []string{"trice.c", "trice8.c", "trice16.c", "trice32.c", "trice64.c", "triceAuxiliary.c", "triceStackBuffer.c", "cobsEncode.c", "tcobsv1Encode.c"} {
+		lib = append(lib, filepath.Join(src, fn))
+	}
+
+	build := func(variant string, defines ...string) (output map[string]string, size uint64) {
+		args := append([]string{"-Os", "-Werror", "-I", dir, "-I", src}, defines...)
+		obj := filepath.Join(dir, variant+".o")
+		out, err := exec.Command(cc, append(args, "-c", "-o", obj, filepath.Join(dir, "main.c"))...).CombinedOutput()
+		assert.Nil(t, err, string(out))
+		exe := filepath.Join(dir, variant)
+		out, err = exec.Command(cc, append(append(args, "-o", exe, obj), lib...)...).CombinedOutput()
+		assert.Nil(t, err, string(out))
+		out, err = exec.Command(exe).CombinedOutput()
+		assert.Nil(t, err, string(out))
+		output = make(map[string]string)
+		for _, line := range strings.Split(strings.TrimSpace(string(out)), "\n") {
+			id, bytes, _ := strings.Cut(line, ":")
+			output[id] = bytes
+		}
+		return output, textSize(t, obj)
+	}
+	all, allSize := build("all")
+	stripped, strippedSize := build("stripped", "-DSTRIP")
+
+	for _, id := range []string{"1001", "1002", "1003", "1004", "1005", "1006", "1007", "1008", "1009", "1010", "1011", "1012", "1013"} {
+		assert.NotEqual(t, "", all[id], id)
+	}
+	for _, id := range []string{"1001", "1003", "1005", "1006", "1008", "1010", "1011"} { // disabled
+		assert.Equal(t, "", stripped[id], id)
+	}
+	for _, id := range []string{"1002", "1004", "1007", "1009", "1012", "1013"} { // enabled
+		assert.Equal(t, all[id], stripped[id], id)
+	}
+	assert.True(t, strippedSize < allSize, "code size", allSize, "->", strippedSize)
+	t.Log("main.o code size:", allSize, "without stripping,", strippedSize, "with stripping")
+}
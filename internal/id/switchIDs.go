@@ -22,6 +22,7 @@ type idData struct {
 	triceToId      triceFmtLookUp  // triceToId is a trice fmt lookup map (reversed idToFmt for faster operation). Each fmt can have several trice IDs (slice). This map is only reduced during SubCmdIdInsert and goes _not_ back into til.json afterwards.
 	idToLocRef     TriceIDLookUpLI // idToLocRef is the trice ID location information as reference generated from li.json (if exists) at the begin of SubCmdIdInsert and is not modified at all. At the end of SubCmdIdInsert a new li.json is generated from itemToId.
 	idToLocNew     TriceIDLookUpLI // idToLocNew is the trice ID location information generated during insertTriceIDs. At the end of SubCmdIdInsert a new li.json is generated from idToLocRef + idToLocNew.
+	idToTriceRef   TriceIDLookUp   // idToTriceRef is a copy of the initial idToTrice in Journal mode. Only elements differing from it go into the journal.
 	idInitialCount int             // idInitialCount is the initial used ID count.
 	IDSpace        []TriceID       // IDSpace contains unused IDs.
 	err            error
@@ -81,6 +82,13 @@ func (p *idData) GetIDStateFromJSONFiles(w io.Writer, fSys *afero.Afero) {
 	p.idInitialCount = len(p.idToTrice)
 	p.idToLocRef = NewLutLI(w, fSys, LIFnJSON) // for reference lookup
 	p.idToLocNew = make(TriceIDLookUpLI, 4000) // for new li.json
+	p.idToTriceRef = nil
+	if Journal {
+		p.idToTriceRef = make(TriceIDLookUp, len(p.idToTrice))
+		for k, v := range p.idToTrice {
+			p.idToTriceRef[k] = v
+		}
+	}
 }
 
 // PreProcessing reads til.json and li.json and converts the data for processing.
@@ -115,6 +123,11 @@ func (p *idData) PreProcessing(w io.Writer, fSys *afero.Afero) {
 
 // postProcessing
 func (p *idData) postProcessing(w io.Writer, fSys *afero.Afero) {
+	if Journal && !DryRun {
+		p.postProcessingJournal(w, fSys)
+		return
+	}
+
 	// til.json
 	idsAdded := len(p.idToTrice) - p.idInitialCount
 	if idsAdded > 0 && !DryRun {
@@ -135,6 +148,51 @@ func (p *idData) postProcessing(w io.Writer, fSys *afero.Afero) {
 	if Verbose {
 		fmt.Fprintln(w, len(p.idToLocRef), "ID's in source code and now in", LIFnJSON, "file.")
 	}
+
+	// sidecars
+	if WriteSidecars && !DryRun {
+		msg.OnErr(UpdateSidecars(fSys))
+	}
+
+	// C format string list and strip header
+	if !DryRun {
+		msg.OnErr(UpdateCFmtList(fSys, p.idToTrice))
+		msg.OnErr(UpdateStripHeader(fSys, p.idToTrice))
+	}
+}
+
+// postProcessingJournal appends the til.json and li.json changes to their journals.
+// The lists are compacted, when requested or when a journal exceeds JournalLimit.
+func (p *idData) postProcessingJournal(w io.Writer, fSys *afero.Afero) {
+	tilSize, err := p.idToTrice.toJournal(fSys, FnJSON, p.idToTriceRef)
+	msg.FatalOnErr(err)
+	if JournalCompact || tilSize > int64(JournalLimit) {
+		msg.FatalOnErr(p.idToTrice.toFile(fSys, FnJSON))
+	}
+	if Verbose {
+		fmt.Fprintln(w, len(p.idToTrice)-p.idInitialCount, "ID's added, now", len(p.idToTrice), "ID's in", FnJSON, "file and journal.")
+	}
+
+	var liSize int64
+	if len(p.idToLocNew) > 0 {
+		liSize, err = p.idToLocNew.toJournal(fSys, LIFnJSON, p.idToLocRef)
+		msg.FatalInfoOnErr(err, "could not write LIFnJSON journal")
+		for k, v := range p.idToLocNew {
+			p.idToLocRef[k] = v
+		}
+	}
+	if JournalCompact || liSize > int64(JournalLimit) {
+		msg.FatalInfoOnErr(p.idToLocRef.toFile(fSys, LIFnJSON), "could not write LIFnJSON")
+	}
+	if Verbose {
+		fmt.Fprintln(w, len(p.idToLocRef), "ID's in source code and now in", LIFnJSON, "file and journal.")
+	}
+
+	if WriteSidecars {
+		msg.OnErr(UpdateSidecars(fSys))
+	}
+	msg.OnErr(UpdateCFmtList(fSys, p.idToTrice))
+	msg.OnErr(UpdateStripHeader(fSys, p.idToTrice))
 }
 
 // cmdSwitchTriceIDs performs action (triceIDCleaning or triceIDInsertion) between preProcessing and postProcessing.
@@ -146,6 +204,15 @@ func (p *idData) cmdSwitchTriceIDs(w io.Writer, fSys *afero.Afero, action ant.Pr
 	a.Trees = Srcs
 	a.MatchingFileName = isSourceFile
 
+	// In Journal mode the lists are locked for the whole run, so parallel runs cannot assign the same new IDs.
+	if Journal && !DryRun {
+		unlock, err := lockList(w, fSys, FnJSON)
+		if err != nil {
+			return err
+		}
+		defer unlock()
+	}
+
 	// process
 	p.PreProcessing(w, fSys)
 	err := a.Walk(w, fSys)
@@ -51,6 +51,9 @@ var (
 	// TriceCacheEnabled needs to be true to use the Trice cache.
 	TriceCacheEnabled bool
 
+	// WriteSidecars set true, lets insert, add and clean write binary sidecars of til.json and li.json for a faster trice log start.
+	WriteSidecars bool
+
 	// UserHomeDir needs to be changed for cache tests.
 	UserHomeDir string
 )
@@ -0,0 +1,244 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+// Watch mode for trice insert
+
+import (
+	"fmt"
+	"hash/crc32"
+	"io"
+	"os"
+	"path/filepath"
+	"reflect"
+	"sort"
+	"strings"
+	"time"
+
+	"github.com/fsnotify/fsnotify"
+	"github.com/rokath/trice/pkg/ant"
+	"github.com/rokath/trice/pkg/msg"
+	"github.com/spf13/afero"
+)
+
+var (
+	// Watch set true, lets trice insert keep running and insert IDs into source files as soon as they are saved.
+	Watch bool
+
+	// WatchDebounce is the quiet time after the last file system event before changed files are processed.
+	// Editors often write a file several times on one save.
+	WatchDebounce = 300 * time.Millisecond
+)
+
+// watchState holds the watch mode data additionally to idData.
+type watchState struct {
+	a       *ant.Admin        // a is needed for the insertTriceIDs mutex.
+	known   map[string]uint32 // known holds the CRC of each processed source file after processing.
+	written TriceIDLookUpLI   // written is the last written location information.
+	pending map[string]bool   // pending holds the changed but not processed files.
+	watcher *fsnotify.Watcher // watcher delivers the file system events.
+	files   map[string]bool   // files are the single source files inside Srcs.
+}
+
+// WatchInsert performs an initial trice insert run and then keeps the lookup tables in memory.
+// Source files inside Srcs are watched and each saved file is processed again alone. til.json and li.json
+// are updated immediately after that. A source file is only written, when IDs were inserted or changed.
+// WatchInsert returns when stop is closed. A nil stop runs forever.
+// The watching process should be the only one changing the lists during its lifetime.
+func WatchInsert(w io.Writer, fSys *afero.Afero, stop <-chan struct{}) error {
+	return IDData.watchInsert(w, fSys, stop)
+}
+
+func (p *idData) watchInsert(w io.Writer, fSys *afero.Afero, stop <-chan struct{}) (err error) {
+	ws := &watchState{
+		a:       &ant.Admin{Action: p.triceIDInsertion, Trees: Srcs, MatchingFileName: isSourceFile},
+		known:   make(map[string]uint32),
+		pending: make(map[string]bool),
+		files:   make(map[string]bool),
+	}
+
+	// initial full run
+	p.PreProcessing(w, fSys)
+	msg.OnErr(ws.a.Walk(w, fSys))
+	p.err = nil
+	p.watchFlush(w, fSys, ws)
+
+	ws.watcher, err = fsnotify.NewWatcher()
+	if err != nil {
+		return err
+	}
+	defer func() { msg.OnErr(ws.watcher.Close()) }()
+	for _, src := range Srcs {
+		fi, err := fSys.Stat(src)
+		if err != nil {
+			fmt.Fprintln(w, src, err)
+			continue
+		}
+		if fi.IsDir() {
+			ws.addTree(fSys, src, false)
+		} else {
+			ws.files[src] = true
+			msg.OnErr(ws.watcher.Add(filepath.Dir(src)))
+		}
+	}
+	fmt.Fprintln(w, "watching", Srcs, "for changes...")
+
+	debounce := time.NewTimer(WatchDebounce)
+	debounce.Stop()
+	for {
+		select {
+		case <-stop:
+			return nil
+		case event, ok := <-ws.watcher.Events:
+			if !ok {
+				return nil
+			}
+			if Verbose {
+				fmt.Fprintln(w, "EVENT:", event)
+			}
+			if event.Op&fsnotify.Create == fsnotify.Create {
+				if fi, err := fSys.Stat(event.Name); err == nil && fi.IsDir() {
+					ws.addTree(fSys, event.Name, true)
+					debounce.Reset(WatchDebounce)
+					continue
+				}
+			}
+			if ws.isWatchedSourceFile(event.Name) {
+				ws.pending[event.Name] = true
+				debounce.Reset(WatchDebounce)
+			}
+		case err, ok := <-ws.watcher.Errors:
+			if !ok {
+				return nil
+			}
+			fmt.Fprintln(w, "watch error:", err)
+		case <-debounce.C:
+			paths := make([]string, 0, len(ws.pending))
+			for path := range ws.pending {
+				paths = append(paths, path)
+			}
+			sort.Strings(paths)
+			ws.pending = make(map[string]bool)
+			for _, path := range paths {
+				p.watchProcess(w, fSys, ws, path)
+			}
+			p.watchFlush(w, fSys, ws)
+		}
+	}
+}
+
+// addTree adds root and all its sub-folders to the watcher. With pending set, existing source files inside are marked
+// as pending. That is needed for folders created after the watch start, like from a git checkout.
+func (ws *watchState) addTree(fSys *afero.Afero, root string, pending bool) {
+	msg.OnErr(fSys.Walk(root, func(path string, fi os.FileInfo, err error) error {
+		if err != nil {
+			return nil // ignore vanished folders
+		}
+		if fi.IsDir() {
+			msg.InfoOnErr(ws.watcher.Add(path), "cannot watch "+path)
+		} else if pending && isSourceFile(fi) {
+			ws.pending[path] = true
+		}
+		return nil
+	}))
+}
+
+// isWatchedSourceFile returns true, if path is a source file inside Srcs.
+func (ws *watchState) isWatchedSourceFile(path string) bool {
+	if !matchSourceFile.MatchString(filepath.Base(path)) {
+		return false
+	}
+	if ws.files[path] {
+		return true
+	}
+	for _, src := range Srcs {
+		if !ws.files[src] && (src == "." || strings.HasPrefix(path, src+string(filepath.Separator)) || strings.HasPrefix(path, src+"/")) {
+			return true
+		}
+	}
+	return false
+}
+
+// watchProcess inserts IDs into the source file path, if its content changed since the last processing.
+func (p *idData) watchProcess(w io.Writer, fSys *afero.Afero, ws *watchState, path string) {
+	liPath := filepath.Base(path)
+	if LiPathIsRelative {
+		liPath = filepath.ToSlash(path)
+	}
+	b, err := fSys.ReadFile(path)
+	if err != nil { // removed or renamed
+		p.releaseIDs(liPath)
+		delete(ws.known, path)
+		return
+	}
+	crc := crc32.ChecksumIEEE(b)
+	if c, ok := ws.known[path]; ok && c == crc {
+		return // no change, probably our own write
+	}
+	fi, err := fSys.Stat(path)
+	if err != nil {
+		return
+	}
+	fmt.Fprintln(w, "watch: processing", path)
+
+	// The IDs of the file are free again and get re-used for the unchanged trices in the file.
+	// The ID cache is bypassed, because a cache hit would not update the location information.
+	p.releaseIDs(liPath)
+	p.err = nil
+	if err = p.processTriceIDInsertion(w, fSys, path, fi, ws.a); err != nil {
+		fmt.Fprintln(w, path, err) // Keep watching, the user will fix the file.
+	}
+	p.err = nil
+	if b, err = fSys.ReadFile(path); err == nil {
+		ws.known[path] = crc32.ChecksumIEEE(b)
+	}
+}
+
+// releaseIDs gives all IDs assigned to liPath during this watch session back into p.triceToId.
+func (p *idData) releaseIDs(liPath string) {
+	for id, li := range p.idToLocNew {
+		if li.File != liPath {
+			continue
+		}
+		delete(p.idToLocNew, id)
+		tF, ok := p.idToTrice[id]
+		if !ok {
+			continue
+		}
+		ids := p.triceToId[tF]
+		found := false
+		for _, x := range ids {
+			if x == id {
+				found = true
+				break
+			}
+		}
+		if !found {
+			p.triceToId[tF] = append(ids, id)
+		}
+	}
+}
+
+// watchFlush writes til.json and li.json, when they changed since the last write.
+func (p *idData) watchFlush(w io.Writer, fSys *afero.Afero, ws *watchState) {
+	li := make(TriceIDLookUpLI, len(p.idToLocRef)+len(p.idToLocNew))
+	for k, v := range p.idToLocRef {
+		li[k] = v
+	}
+	for k, v := range p.idToLocNew {
+		li[k] = v
+	}
+	if len(p.idToTrice) == p.idInitialCount && reflect.DeepEqual(li, ws.written) {
+		return
+	}
+	p.postProcessing(w, fSys)
+	p.idInitialCount = len(p.idToTrice)
+	ws.written = li
+	if Journal {
+		p.idToTriceRef = make(TriceIDLookUp, len(p.idToTrice))
+		for k, v := range p.idToTrice {
+			p.idToTriceRef[k] = v
+		}
+	}
+}
@@ -0,0 +1,132 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package id
+
+import (
+	"bytes"
+	"path/filepath"
+	"regexp"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// syncBuffer is a bytes.Buffer usable from several Go routines.
+type syncBuffer struct {
+	mu sync.Mutex
+	b  bytes.Buffer
+}
+
+func (p *syncBuffer) Write(b []byte) (int, error) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.b.Write(b)
+}
+
+func (p *syncBuffer) String() string {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.b.String()
+}
+
+// waitFor polls f until it returns true or fails t after a timeout.
+func waitFor(t *testing.T, what string, f func() bool) {
+	t.Helper()
+	for deadline := time.Now().Add(10 * time.Second); time.Now().Before(deadline); time.Sleep(20 * time.Millisecond) {
+		if f() {
+			return
+		}
+	}
+	t.Fatal("timeout waiting for", what)
+}
+
+// TestWatchInsert edits files in a watched source tree and checks the IDs inserted into the sources and lists.
+func TestWatchInsert(t *testing.T) {
+	if testing.Short() {
+		t.Skip("uses the OS file system")
+	}
+	ResetGlobalVars(t)
+	defer func() { WatchDebounce = 300 * time.Millisecond }()
+	WatchDebounce = 50 * time.Millisecond
+	dir := t.TempDir()
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	FnJSON = filepath.Join(dir, "til.json")
+	LIFnJSON = filepath.Join(dir, "li.json")
+	src := filepath.Join(dir, "src")
+	Srcs = ArrayFlag{src}
+	assert.Nil(t, fSys.WriteFile(FnJSON, nil, 0644))
+	assert.Nil(t, fSys.WriteFile(LIFnJSON, nil, 0644))
+	assert.Nil(t, fSys.MkdirAll(src, 0755))
+
+	fa := filepath.Join(src, "a.c")
+	fb := filepath.Join(src, "b.c")
+	assert.Nil(t, fSys.WriteFile(fa, []byte("\ttrice(\"msg:a0\\n\");\n"), 0644))
+	assert.Nil(t, fSys.WriteFile(fb, []byte("\ttrice(\"msg:b0\\n\");\n"), 0644))
+
+	var out syncBuffer
+	stop := make(chan struct{})
+	done := make(chan error)
+	p := new(idData)
+	go func() { done <- p.watchInsert(&out, fSys, stop) }()
+	defer func() {
+		close(stop)
+		assert.Nil(t, <-done)
+	}()
+	waitFor(t, "watch start", func() bool { return strings.Contains(out.String(), "watching") })
+
+	idPattern := regexp.MustCompile(`iD\(\d+\)`)
+	fileIDs := func(fn string) []string {
+		b, err := fSys.ReadFile(fn)
+		assert.Nil(t, err)
+		return idPattern.FindAllString(string(b), -1)
+	}
+	assert.Equal(t, 1, len(fileIDs(fa)))
+	assert.Equal(t, 1, len(fileIDs(fb)))
+	a0 := fileIDs(fa)[0]
+	fiB, err := fSys.Stat(fb)
+	assert.Nil(t, err)
+
+	// Several writes in a row, like from an editor, are processed once.
+	s := "\ttrice(" + a0 + ", \"msg:a0\\n\");\n\ttrice(\"msg:a1\\n\");\n"
+	for i := 0; i < 5; i++ {
+		assert.Nil(t, fSys.WriteFile(fa, []byte(s), 0644))
+	}
+	waitFor(t, "a1 ID", func() bool { return len(fileIDs(fa)) == 2 })
+	ids := fileIDs(fa)
+	assert.Equal(t, a0, ids[0]) // existing ID kept
+	waitFor(t, "til.json update", func() bool {
+		til, err := fSys.ReadFile(FnJSON)
+		assert.Nil(t, err)
+		return strings.Contains(string(til), "msg:a1")
+	})
+	waitFor(t, "li.json update", func() bool {
+		li, err := fSys.ReadFile(LIFnJSON)
+		assert.Nil(t, err)
+		return strings.Count(string(li), `"File"`) == 3
+	})
+	assert.Equal(t, 1, strings.Count(out.String(), "watch: processing "+fa))
+
+	// Saving unchanged content does not change the IDs.
+	b, err := fSys.ReadFile(fa)
+	assert.Nil(t, err)
+	assert.Nil(t, fSys.WriteFile(fa, []byte(strings.Replace(string(b), "\n", "\n\n", 1)), 0644))
+	waitFor(t, "a.c processed again", func() bool { return strings.Count(out.String(), "watch: processing "+fa) == 2 })
+	assert.Equal(t, ids, fileIDs(fa))
+
+	// A new file in a new folder gets IDs.
+	fc := filepath.Join(src, "sub", "c.c")
+	assert.Nil(t, fSys.MkdirAll(filepath.Dir(fc), 0755))
+	assert.Nil(t, fSys.WriteFile(fc, []byte("\ttrice(\"msg:c0\\n\");\n"), 0644))
+	waitFor(t, "c0 ID", func() bool { return len(fileIDs(fc)) == 1 })
+
+	// b.c was never touched.
+	fi, err := fSys.Stat(fb)
+	assert.Nil(t, err)
+	assert.Equal(t, fiB.ModTime(), fi.ModTime())
+	assert.False(t, strings.Contains(out.String(), "watch: processing "+fb))
+}
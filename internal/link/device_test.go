@@ -0,0 +1,138 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package link
+
+import (
+	"bytes"
+	"io"
+	"os"
+	"path/filepath"
+	"strconv"
+	"testing"
+	"time"
+
+	"github.com/rokath/trice/internal/id"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// stubLoggerEnv is set, when the test binary acts as RTT logger.
+const stubLoggerEnv = "TRICE_LINK_STUB_LOGGER"
+
+// stubData returns the bytes the stub logger writes in chunk i.
+func stubData(i int) []byte {
+	return bytes.Repeat([]byte{byte(i)}, 1000+i)
+}
+
+// TestHelperLogger is no real test. It is the stub RTT logger started by the link device tests.
+// It writes the value of stubLoggerEnv chunks into the file passed as last argument and ends.
+func TestHelperLogger(t *testing.T) {
+	count, err := strconv.Atoi(os.Getenv(stubLoggerEnv))
+	if err != nil {
+		return
+	}
+	fh, err := os.Create(os.Args[len(os.Args)-1])
+	if err != nil {
+		os.Exit(2)
+	}
+	for i := 0; i < count; i++ {
+		if _, err = fh.Write(stubData(i)); err != nil {
+			os.Exit(3)
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	fh.Close()
+	os.Exit(0)
+}
+
+// newStubDevice returns a link device using the test binary as RTT logger, which writes count chunks.
+func newStubDevice(t *testing.T, count int, args string) *Device {
+	t.Setenv(stubLoggerEnv, strconv.Itoa(count))
+	defer func(s string) { id.FnJSON = s }(id.FnJSON)
+	id.FnJSON = filepath.Join(t.TempDir(), "til.json")
+	p := NewDevice(io.Discard, &afero.Afero{Fs: afero.NewOsFs()}, "JLINK", args)
+	p.Exec = os.Args[0]
+	p.args = append([]string{"-test.run=^TestHelperLogger$", "--"}, p.args...)
+	return p
+}
+
+// readStub reads from p until all count chunks arrived. It reads not more, because the stub logger can write further chunks.
+func readStub(t *testing.T, p *Device, count int) {
+	var exp []byte
+	for i := 0; i < count; i++ {
+		exp = append(exp, stubData(i)...)
+	}
+	act := make([]byte, 0, len(exp))
+	b := make([]byte, 4096)
+	deadline := time.Now().Add(10 * time.Second)
+	for len(act) < len(exp) && time.Now().Before(deadline) {
+		m := len(exp) - len(act)
+		if m > len(b) {
+			m = len(b)
+		}
+		n, err := p.Read(b[:m])
+		assert.Nil(t, err)
+		act = append(act, b[:n]...)
+	}
+	assert.Equal(t, exp, act)
+}
+
+// TestDeviceFifo checks, that the RTT data go through a named pipe without a growing file and that Open does not wait.
+func TestDeviceFifo(t *testing.T) {
+	p := newStubDevice(t, 200, "")
+	if !p.fifo {
+		t.Skip("no named pipes")
+	}
+	start := time.Now()
+	assert.Nil(t, p.Open())
+	assert.True(t, time.Since(start) < 500*time.Millisecond, "Open took", time.Since(start))
+	readStub(t, p, 200)
+	n, err := p.Read(make([]byte, 10))
+	assert.Equal(t, 0, n)
+	assert.Equal(t, io.EOF, err) // after the logger ended
+	fi, err := os.Stat(p.tempLogFileName)
+	assert.Nil(t, err)
+	assert.True(t, fi.Mode()&os.ModeNamedPipe != 0)
+	assert.Nil(t, p.Close())
+	_, err = os.Stat(p.tempLogFileName)
+	assert.True(t, os.IsNotExist(err))
+}
+
+// TestDeviceFile checks tailing a growing log file, when an explicit *.bin file name is given. Close keeps that file.
+func TestDeviceFile(t *testing.T) {
+	fn := filepath.Join(t.TempDir(), "rtt.bin")
+	p := newStubDevice(t, 50, "-Device STM32G0B1RE -If SWD -Speed 4000 -RTTChannel 0 "+fn)
+	assert.False(t, p.fifo)
+	start := time.Now()
+	assert.Nil(t, p.Open())
+	assert.True(t, time.Since(start) < 500*time.Millisecond, "Open took", time.Since(start))
+	readStub(t, p, 50)
+	assert.Nil(t, p.Close())
+	fi, err := os.Stat(fn)
+	assert.Nil(t, err)
+	assert.Equal(t, int64(50*1000+49*50/2), fi.Size())
+}
+
+// TestDeviceCloseWhileReading checks, that Close ends a blocking Read and stops the RTT logger.
+func TestDeviceCloseWhileReading(t *testing.T) {
+	p := newStubDevice(t, 1000000, "")
+	assert.Nil(t, p.Open())
+	readStub(t, p, 3)
+	done := make(chan struct{})
+	go func() {
+		b := make([]byte, 1<<20)
+		for {
+			if _, err := p.Read(b); err != nil {
+				close(done)
+				return
+			}
+		}
+	}()
+	assert.Nil(t, p.Close())
+	select {
+	case <-done:
+	case <-time.After(5 * time.Second):
+		t.Fatal("Read not ended by Close")
+	}
+}
@@ -0,0 +1,11 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package link
+
+import "errors"
+
+// mkfifo is not supported on Windows, so the RTT logger writes into a regular file.
+func mkfifo(fn string) error {
+	return errors.New("named pipes are not supported on Windows")
+}
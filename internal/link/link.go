@@ -5,9 +5,15 @@
 //
 // It provides a ReadCloser interface and makes no assumptions about the delivered data.
 // It is also agnostic concerning the RTT channel and other setup parameters.
+//
+// The RTT logger writes into the file passed as last argument. Where possible, this file is a named pipe (FIFO),
+// so the data do not touch the disk and reads block until the logger delivers. Otherwise, like on Windows or
+// with an explicit *.bin file name argument, the growing file is tailed with reads waiting for file
+// system notifications.
 package link
 
 import (
+	"errors"
 	"fmt"
 	"io"
 	"log"
@@ -17,7 +23,7 @@ import (
 	"strings"
 	"time"
 
-	"github.com/pkg/errors"
+	"github.com/fsnotify/fsnotify"
 	"github.com/rokath/trice/internal/id"
 	"github.com/rokath/trice/pkg/msg"
 	"github.com/spf13/afero"
@@ -26,6 +32,12 @@ import (
 var (
 	// Verbose gives more information on output if set. The value is injected from main packages.
 	Verbose bool
+
+	// StartTimeout is the max time to wait for the RTT logger to create its log file.
+	StartTimeout = 10 * time.Second
+
+	// pollInterval is the file check interval, when file system notifications are missing.
+	pollInterval = 100 * time.Millisecond
 )
 
 // Device is the RTT logger reader interface.
@@ -40,6 +52,11 @@ type Device struct {
 	cmd               *exec.Cmd // link command handle
 	tempLogFileName   string
 	tempLogFileHandle afero.File
+	fifo              bool              // fifo is true, when tempLogFileName is a named pipe.
+	ownLogFile        bool              // ownLogFile is true, when tempLogFileName was created here and not passed as argument.
+	watcher           *fsnotify.Watcher // watcher signals log file changes in file mode.
+	exited            chan struct{}     // exited is closed, when the RTT logger process ended.
+	closed            chan struct{}     // closed is closed by Close.
 	Err               error
 	Done              chan bool
 }
@@ -71,6 +88,9 @@ func NewDevice(w io.Writer, fSys *afero.Afero, port, arguments string) *Device {
 	// Add missing values as default values
 	p.args = strings.Split(arguments, " ")
 	for _, a := range p.args {
+		if strings.ToLower(a) == "-device" {
+			deviceIsSpecified = true
+		}
 		if strings.ToLower(a) == "-if" {
 			interfaceIsSpecified = true
 		}
@@ -105,8 +125,8 @@ func NewDevice(w io.Writer, fSys *afero.Afero, port, arguments string) *Device {
 	if lastArgExt == ".bin" {
 		if Verbose {
 			fmt.Printf("An intermediate log file name \"%s\" is specified inside p.args, so use that.\n", lastArg)
-			p.tempLogFileName = lastArg
 		}
+		p.tempLogFileName = lastArg
 	} else {
 		// get a temporary file name in a writable folder temp
 		dir := filepath.Dir(id.FnJSON) // the id list folder is assumed to be writable and readable
@@ -120,8 +140,17 @@ func NewDevice(w io.Writer, fSys *afero.Afero, port, arguments string) *Device {
 		fh, e := os.CreateTemp(tempDir, "trice-*.bin") // opens for read and write
 		msg.OnErr(e)
 		p.tempLogFileName = fh.Name() // p.tempLogFileName is trice needed to know where to read from
+		p.ownLogFile = true
 		msg.OnErr(fh.Close())
 
+		// Replace the file with a named pipe, so the RTT data do not fill the disk.
+		msg.OnErr(os.Remove(p.tempLogFileName))
+		if e = mkfifo(p.tempLogFileName); e == nil {
+			p.fifo = true
+		} else if Verbose {
+			fmt.Fprintln(w, "no named pipe:", e, "- using a log file")
+		}
+
 		p.args = append(p.args, p.tempLogFileName) // p.tempLogFileName is passed here for JLinkRTTLogger
 	}
 	return p
@@ -141,8 +170,35 @@ func (p *Device) errorFatal() {
 }
 
 // Read is part of the exported interface io.ReadCloser. It reads a slice of bytes.
+// In file mode Read waits for new data at the log file end. It returns io.EOF only, when the RTT logger ended.
+// In named pipe mode Read returns io.EOF, when the RTT logger ended and the pipe is empty.
 func (p *Device) Read(b []byte) (int, error) {
-	return p.tempLogFileHandle.Read(b)
+	if p.fifo {
+		select {
+		case <-p.exited:
+			p.fifoDeadline()
+		default:
+		}
+		n, err := p.tempLogFileHandle.Read(b)
+		if errors.Is(err, os.ErrDeadlineExceeded) {
+			return n, io.EOF
+		}
+		return n, err
+	}
+	for {
+		n, err := p.tempLogFileHandle.Read(b)
+		if n > 0 || err != io.EOF || p.fifo {
+			return n, err
+		}
+		select {
+		case <-p.closed:
+			return 0, io.EOF
+		case <-p.exited:
+			return p.tempLogFileHandle.Read(b) // last data after logger end
+		case <-p.watcher.Events:
+		case <-time.After(pollInterval):
+		}
+	}
 }
 
 func (p *Device) Write(b []byte) (int, error) {
@@ -150,20 +206,39 @@ func (p *Device) Write(b []byte) (int, error) {
 }
 
 // Close is part of the exported interface io.ReadCloser. It ends the connection.
+// The RTT logger process is stopped and the temporary log file removed. A log file passed as argument is kept.
 func (p *Device) Close() error {
 	if Verbose {
 		fmt.Fprintln(p.w, "Closing link device.")
 	}
-	// CTRL-C sends SIGTERM also to the started command. It closes the temporary file and terminates itself.
-	// Todo: If trice is terminated not with CTRL-C kill automatically.
-	// p.Err = errors.Wrap(p.Err, p.cmd.Process.Kill().Error())
-	// p.Err = errors.Wrap(p.Err, p.tempLogFileHandle.Close().Error())
-	p.Err = errors.Wrap(p.Err, p.fSys.Remove(p.tempLogFileName).Error())
+	if p.closed != nil {
+		close(p.closed)
+	}
+	if p.cmd != nil && p.cmd.Process != nil {
+		select {
+		case <-p.exited:
+		default:
+			msg.OnErr(p.cmd.Process.Kill())
+			<-p.exited
+		}
+	}
+	if p.watcher != nil {
+		msg.OnErr(p.watcher.Close())
+	}
+	if p.tempLogFileHandle != nil {
+		msg.OnErr(p.tempLogFileHandle.Close())
+	}
+	if !p.ownLogFile {
+		return p.Err
+	}
+	if err := p.fSys.Remove(p.tempLogFileName); err != nil && p.Err == nil {
+		p.Err = err
+	}
 	return p.Err
 }
 
 // Open starts the RTT logger command with a temporary logfile.
-// The temporary logfile is opened for reading.
+// The temporary logfile is opened for reading, as soon as it exists.
 func (p *Device) Open() error {
 	if Verbose {
 		fmt.Fprintln(p.w, "Start a process:", p.Exec, "with needed lib", p.Lib, "and args:")
@@ -178,55 +253,70 @@ func (p *Device) Open() error {
 		p.cmd.Stdout = os.Stdout
 		p.cmd.Stderr = os.Stderr
 	}
+	p.exited = make(chan struct{})
+	p.closed = make(chan struct{})
+
+	if p.fifo {
+		// Opening a named pipe for reading and writing does not block until the RTT logger opens it.
+		// Being a writer too, reads block when the RTT logger ends, instead of returning io.EOF repeatedly.
+		p.tempLogFileHandle, p.Err = os.OpenFile(p.tempLogFileName, os.O_RDWR, 0)
+		p.errorFatal()
+	} else {
+		// Watch the folder, because the log file does not exist yet.
+		p.watcher, p.Err = fsnotify.NewWatcher()
+		p.errorFatal()
+		p.Err = p.watcher.Add(filepath.Dir(p.tempLogFileName))
+		p.errorFatal()
+	}
+
 	p.Err = p.cmd.Start()
 	p.errorFatal()
 
 	go func() {
 		e := p.cmd.Wait()
-		if e != nil {
-			fmt.Println(e)
+		if e != nil && Verbose {
+			fmt.Fprintln(p.w, p.Exec, e)
+		}
+		close(p.exited)
+		if p.fifo { // Being a writer too, a blocking read would wait forever.
+			p.fifoDeadline()
 		}
 	}()
 
-	// todo: check if file exists in a loop for more speed
-	time.Sleep(1000 * time.Millisecond)                         // to be sure, log fie is created
-	p.tempLogFileHandle, p.Err = p.fSys.Open(p.tempLogFileName) // Open() opens a file with read only flag.
-	p.errorFatal()
-
-	// p.watchLogfile() // todo: make it working well
+	if !p.fifo {
+		p.Err = p.waitForLogfile()
+		p.errorFatal()
+	}
 	if Verbose {
 		fmt.Fprintln(p.w, "trice is watching and reading from", p.tempLogFileName)
 	}
 	return nil
 }
 
-// watchLogfile creates a new file watcher.
-//  func (p *Device) watchLogfile() {
-//  	var watcher *fsnotify.Watcher
-//  	watcher, p.Err = fsnotify.NewWatcher()
-//  	defer func() { msg.OnErr(watcher.Close()) }()
-//
-//  	go func() {
-//  		for {
-//  			var ok bool
-//  			var event fsnotify.Event
-//  			p.ErrorFatal()
-//  			select {
-//  			case event, ok = <-watcher.Events: // watch for events
-//  				if !ok {
-//  					continue // return
-//  				}
-//  				fmt.Printf("EVENT! %#v\n", event)
-//  				if event.Op&fsnotify.Write == fsnotify.Write {
-//  					log.Println("modified file:", event.Name)
-//  				}
-//  			case p.Err, ok = <-watcher.Errors: // watch for errors
-//  				if !ok {
-//  					continue // return
-//  				}
-//  			}
-//  		}
-//  	}()
-//  	// out of the box fsnotify can watch a single file, or a single directory
-//  	p.Err = watcher.Add(p.tempLogFileName)
-//  }
+// fifoDeadline lets a read of the named pipe fail, when no data arrive within pollInterval.
+// It is used after the RTT logger ended, so the remaining pipe content is read before io.EOF.
+func (p *Device) fifoDeadline() {
+	if f, ok := p.tempLogFileHandle.(*os.File); ok {
+		_ = f.SetReadDeadline(time.Now().Add(pollInterval)) // fails only, when already closed
+	}
+}
+
+// waitForLogfile opens the log file for reading, as soon as the RTT logger created it.
+func (p *Device) waitForLogfile() (err error) {
+	timeout := time.After(StartTimeout)
+	for {
+		if p.tempLogFileHandle, err = p.fSys.Open(p.tempLogFileName); err == nil { // Open() opens a file with read only flag.
+			return nil
+		}
+		select {
+		case <-p.watcher.Events:
+		case err = <-p.watcher.Errors:
+			return err
+		case <-p.exited:
+			return fmt.Errorf("%s ended without creating %s", p.Exec, p.tempLogFileName)
+		case <-timeout:
+			return fmt.Errorf("%s did not create %s within %v", p.Exec, p.tempLogFileName, StartTimeout)
+		case <-time.After(pollInterval):
+		}
+	}
+}
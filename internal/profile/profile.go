@@ -0,0 +1,257 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+// Package profile provides opt-in profiling of the trice log processing.
+//
+// It writes pprof CPU and heap profiles and a runtime trace into files and counts per processing stage
+// the items, the bytes, the spent time and the queue waits. The stage counters are global, so several
+// devices logged in parallel are summed up. When counting is off, a stage measurement costs only
+// an atomic flag load.
+//
+// The stages nest: decode contains receive, deframe and format, because the decoder reads its input
+// and formats the trices itself. compose contains output. The summary shows the time without the
+// nested stages as self time.
+package profile
+
+import (
+	"fmt"
+	"io"
+	"runtime"
+	"runtime/pprof"
+	"runtime/trace"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/spf13/afero"
+)
+
+var (
+	// CPUFileName is the pprof CPU profile file name or "off".
+	CPUFileName = "off"
+
+	// MemFileName is the pprof heap profile file name or "off". The heap profile is written at the end.
+	MemFileName = "off"
+
+	// TraceFileName is the runtime trace file name or "off".
+	TraceFileName = "off"
+
+	// Stages is "off", "exit" for a stage summary at the end, or a duration like "10s" for additional periodic summaries.
+	Stages = "off"
+
+	counting atomic.Bool // counting is true, when the stages are counted.
+
+	mu       sync.Mutex // mu protects the running profiling.
+	running  bool
+	report   io.Writer
+	cpuFile  io.Closer
+	trcFile  io.Closer
+	fSystem  *afero.Afero
+	started  time.Time
+	stopTick chan struct{}
+)
+
+// Stage counts the work of one processing stage.
+type Stage struct {
+	name   string
+	unit   string // unit is the item name, like "trices".
+	parent *Stage // parent is the stage containing this stage or nil.
+	items  atomic.Uint64
+	bytes  atomic.Uint64
+	busy   atomic.Int64 // busy is the time spent in ns including the nested stages.
+	wait   atomic.Int64 // wait is the time spent waiting for queues in ns.
+}
+
+// The stages of the trice log processing in data flow order.
+var (
+	Decode  = &Stage{name: "decode", unit: "trices"}                    // Decode counts the decoder Read calls with output.
+	Receive = &Stage{name: "receive", unit: "reads", parent: Decode}    // Receive counts the port reads including the waits for data.
+	Deframe = &Stage{name: "deframe", unit: "packages", parent: Decode} // Deframe counts the COBS or TCOBS decoding and decryption.
+	Format  = &Stage{name: "format", unit: "trices", parent: Decode}    // Format counts the formatting of the trice parameters.
+	Compose = &Stage{name: "compose", unit: "strings"}                  // Compose counts the line composing of the decoded strings.
+	Output  = &Stage{name: "output", unit: "lines", parent: Compose}    // Output counts the line writes including the queue waits.
+
+	stages = []*Stage{Receive, Deframe, Decode, Format, Compose, Output}
+)
+
+// Counting reports, if the stages are counted.
+func Counting() bool {
+	return counting.Load()
+}
+
+// Now returns the actual time, when the stages are counted, and otherwise the zero time without reading the clock.
+func Now() time.Time {
+	if !counting.Load() {
+		return time.Time{}
+	}
+	return time.Now()
+}
+
+// Done counts items and bytes together with the time since start, which is a Now result.
+func (p *Stage) Done(start time.Time, items, bytes int) {
+	if !counting.Load() {
+		return
+	}
+	p.busy.Add(int64(time.Since(start)))
+	p.items.Add(uint64(items))
+	p.bytes.Add(uint64(bytes))
+}
+
+// Waited counts the time since start, which is a Now result, as queue wait.
+func (p *Stage) Waited(start time.Time) {
+	if !counting.Load() {
+		return
+	}
+	p.wait.Add(int64(time.Since(start)))
+}
+
+// Reset clears all stage counters.
+func Reset() {
+	for _, s := range stages {
+		s.items.Store(0)
+		s.bytes.Store(0)
+		s.busy.Store(0)
+		s.wait.Store(0)
+	}
+}
+
+// Start starts the profiling selected by CPUFileName, MemFileName, TraceFileName and Stages.
+// The files are created in fSys and the stage summaries are written into w.
+func Start(w io.Writer, fSys *afero.Afero) error {
+	mu.Lock()
+	defer mu.Unlock()
+	if running || !isOn(CPUFileName) && !isOn(MemFileName) && !isOn(TraceFileName) && !isOn(Stages) {
+		return nil
+	}
+	var period time.Duration
+	switch Stages {
+	case "off", "none", "exit":
+	default:
+		var err error
+		if period, err = time.ParseDuration(Stages); err != nil || period <= 0 {
+			return fmt.Errorf("invalid -stages value %q, use off, exit or a duration like 10s", Stages)
+		}
+	}
+	if isOn(CPUFileName) {
+		f, err := fSys.Create(CPUFileName)
+		if err != nil {
+			return err
+		}
+		if err = pprof.StartCPUProfile(f); err != nil {
+			f.Close()
+			return err
+		}
+		cpuFile = f
+	}
+	if isOn(TraceFileName) {
+		f, err := fSys.Create(TraceFileName)
+		if err != nil {
+			stopFiles()
+			return err
+		}
+		if err = trace.Start(f); err != nil {
+			f.Close()
+			stopFiles()
+			return err
+		}
+		trcFile = f
+	}
+	running, report, fSystem, started = true, w, fSys, time.Now()
+	if isOn(Stages) {
+		Reset()
+		counting.Store(true)
+	}
+	if period > 0 {
+		stopTick = make(chan struct{})
+		go func(stop chan struct{}) {
+			ticker := time.NewTicker(period)
+			defer ticker.Stop()
+			for {
+				select {
+				case <-ticker.C:
+					mu.Lock()
+					Summary(report, time.Since(started))
+					mu.Unlock()
+				case <-stop:
+					return
+				}
+			}
+		}(stopTick)
+	}
+	return nil
+}
+
+// Stop ends the profiling started with Start, writes the heap profile and the final stage summary.
+// Stop does nothing, if no profiling runs, so it can be called on each program end.
+func Stop() {
+	mu.Lock()
+	defer mu.Unlock()
+	if !running {
+		return
+	}
+	running = false
+	if stopTick != nil {
+		close(stopTick)
+		stopTick = nil
+	}
+	stopFiles()
+	if isOn(MemFileName) {
+		if f, err := fSystem.Create(MemFileName); err != nil {
+			fmt.Fprintln(report, err)
+		} else {
+			runtime.GC() // get up-to-date statistics
+			if err = pprof.WriteHeapProfile(f); err != nil {
+				fmt.Fprintln(report, err)
+			}
+			f.Close()
+		}
+	}
+	if counting.Load() {
+		Summary(report, time.Since(started))
+		counting.Store(false)
+	}
+}
+
+// stopFiles stops the CPU profile and the trace and closes their files.
+func stopFiles() {
+	if cpuFile != nil {
+		pprof.StopCPUProfile()
+		cpuFile.Close()
+		cpuFile = nil
+	}
+	if trcFile != nil {
+		trace.Stop()
+		trcFile.Close()
+		trcFile = nil
+	}
+}
+
+// Summary writes the stage counters into w. elapsed is the measuring duration used for the rates.
+func Summary(w io.Writer, elapsed time.Duration) {
+	fmt.Fprintf(w, "stages after %v:\n", elapsed.Round(time.Millisecond))
+	fmt.Fprintf(w, "%-8s %12s %-8s %12s %10s %10s %10s %10s %10s\n", "stage", "items", "", "bytes", "MB/s", "time", "self", "ns/item", "wait")
+	for _, s := range stages {
+		items, bytes, busy := s.items.Load(), s.bytes.Load(), time.Duration(s.busy.Load())
+		self := busy
+		for _, c := range stages {
+			if c.parent == s {
+				self -= time.Duration(c.busy.Load())
+			}
+		}
+		var rate string
+		if bytes > 0 && elapsed > 0 {
+			rate = fmt.Sprintf("%.2f", float64(bytes)/elapsed.Seconds()/1e6)
+		}
+		var perItem int64
+		if items > 0 {
+			perItem = self.Nanoseconds() / int64(items)
+		}
+		fmt.Fprintf(w, "%-8s %12d %-8s %12d %10s %10v %10v %10d %10v\n", s.name, items, s.unit, bytes, rate,
+			busy.Round(time.Microsecond), self.Round(time.Microsecond), perItem, time.Duration(s.wait.Load()).Round(time.Microsecond))
+	}
+}
+
+// isOn reports, if the switch value s selects something.
+func isOn(s string) bool {
+	return s != "" && s != "off" && s != "none"
+}
@@ -0,0 +1,111 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package profile
+
+import (
+	"bytes"
+	"strings"
+	"testing"
+	"time"
+
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// setProfile sets the profile options for one test and restores them afterwards.
+func setProfile(t *testing.T, cpu, mem, trc, stages string) {
+	CPUFileName, MemFileName, TraceFileName, Stages = cpu, mem, trc, stages
+	t.Cleanup(func() {
+		Stop()
+		CPUFileName, MemFileName, TraceFileName, Stages = "off", "off", "off", "off"
+	})
+}
+
+// TestStages checks the stage counting, the self time of nested stages and the exit summary.
+func TestStages(t *testing.T) {
+	setProfile(t, "off", "off", "off", "exit")
+	var out bytes.Buffer
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	assert.Nil(t, Start(&out, fSys))
+	assert.True(t, Counting())
+
+	outer := Now()
+	inner := Now()
+	time.Sleep(2 * time.Millisecond)
+	Format.Done(inner, 1, 10)
+	Decode.Done(outer, 1, 12)
+	Output.Waited(Now())
+
+	assert.Equal(t, uint64(1), Decode.items.Load())
+	assert.Equal(t, uint64(12), Decode.bytes.Load())
+	assert.True(t, Decode.busy.Load() >= Format.busy.Load())
+	assert.True(t, Format.busy.Load() >= int64(2*time.Millisecond))
+
+	Stop()
+	assert.False(t, Counting())
+	s := out.String()
+	assert.True(t, strings.HasPrefix(s, "stages after "), s)
+	for _, name := range []string{"receive", "deframe", "decode", "format", "compose", "output"} {
+		assert.True(t, strings.Contains(s, "\n"+name+" "), name)
+	}
+	Stop() // a second Stop does nothing
+	assert.Equal(t, s, out.String())
+}
+
+// TestDisabled checks, that stages are not counted without Start.
+func TestDisabled(t *testing.T) {
+	setProfile(t, "off", "off", "off", "off")
+	Reset()
+	assert.Nil(t, Start(&bytes.Buffer{}, &afero.Afero{Fs: afero.NewMemMapFs()}))
+	assert.False(t, Counting())
+	assert.True(t, Now().IsZero())
+	Deframe.Done(Now(), 1, 100)
+	assert.Equal(t, uint64(0), Deframe.items.Load())
+}
+
+// TestFiles checks, that the CPU, heap and trace profile files are written.
+func TestFiles(t *testing.T) {
+	setProfile(t, "cpu.pprof", "mem.pprof", "trace.out", "off")
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	var out bytes.Buffer
+	assert.Nil(t, Start(&out, fSys))
+	time.Sleep(10 * time.Millisecond)
+	Stop()
+	for _, fn := range []string{"cpu.pprof", "mem.pprof", "trace.out"} {
+		fi, err := fSys.Stat(fn)
+		assert.Nil(t, err, fn)
+		assert.True(t, fi.Size() > 0, fn)
+	}
+	assert.Equal(t, "", out.String())
+}
+
+// TestPeriodic checks the periodic summaries and the rejection of an invalid period.
+func TestPeriodic(t *testing.T) {
+	setProfile(t, "off", "off", "off", "later")
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	assert.NotNil(t, Start(&bytes.Buffer{}, fSys))
+
+	Stages = "5ms"
+	var out bytes.Buffer // The summaries are written under the lock, which Stop takes too.
+	assert.Nil(t, Start(&out, fSys))
+	time.Sleep(30 * time.Millisecond)
+	Stop()
+	assert.True(t, strings.Count(out.String(), "stages after ") >= 2, out.String())
+}
+
+// BenchmarkStage measures the cost of one stage measurement with counting off and on.
+func BenchmarkStage(b *testing.B) {
+	b.Run("off", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			Decode.Done(Now(), 1, 16)
+		}
+	})
+	b.Run("on", func(b *testing.B) {
+		counting.Store(true)
+		defer counting.Store(false)
+		for i := 0; i < b.N; i++ {
+			Decode.Done(Now(), 1, 16)
+		}
+	})
+}
@@ -0,0 +1,648 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+// Indexed binary logfiles.
+//
+// The index is a sidecar file, like "trice.bin.tix" for "trice.bin". It divides the logfile in blocks of about
+// IndexBlockSize bytes, each starting at a package boundary. Per block it records the byte offset, the smallest and
+// biggest target stamp, the first cycle counter and a sparse bitmap of the contained trice IDs.
+//
+// The index file starts with IndexMagic, followed by 8 bytes indexed logfile size, 4 bytes block size, 4 bytes
+// block count, all little endian, 1 byte flags and 1 byte cycle counter expected after the indexed data. Each block is: 8 bytes offset, 4 bytes package count, 4 bytes min stamp, 4 bytes
+// max stamp, 1 byte flags, 1 byte cycle, 2 bytes bitmap word count and per not zero bitmap word 1 byte word index
+// and 8 bytes bits.
+//
+// A query selects the blocks after a byte offset, overlapping a target stamp range and containing at least one of
+// a set of IDs. Only the selected blocks are read. Data appended after the indexing are always read.
+// Packages bigger than the reader buffer cannot be trice packages and are not indexed.
+
+import (
+	"bufio"
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"io"
+	"math/bits"
+	"strconv"
+	"strings"
+	"sync/atomic"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/rokath/tcobs/v1"
+	"github.com/spf13/afero"
+)
+
+// IndexMagic starts a binary logfile index.
+const IndexMagic = "TRICE-INDEX-2\n"
+
+var (
+	// IndexBlockSize is the approximate byte count of an indexed block.
+	IndexBlockSize = 64 * 1024
+
+	// QueryOffset selects the blocks from the block containing this logfile byte offset on. -1 means off.
+	QueryOffset int64 = -1
+
+	// QueryStamps selects the trices with target stamps in a range like "1000:2000". "" means off.
+	QueryStamps string
+
+	// QueryIDs selects the trices with IDs in a list like "12,100-199". "" means off.
+	QueryIDs string
+)
+
+// CycleSyncer is implemented by inputs with gaps, like an index query.
+type CycleSyncer interface {
+	// CycleSync returns the expected cycle counter of the data returned by the last Read and true, if they follow a gap.
+	CycleSync() (cycle uint8, ok bool)
+}
+
+// TriceMatcher is implemented by inputs, which deliver also not wanted trices, like an index query.
+type TriceMatcher interface {
+	MatchTrice(id uint16, stamp uint64, stampSize int) bool // MatchTrice returns false for a not wanted trice.
+}
+
+// IndexFileName returns the index file name for the binary logfile fn.
+func IndexFileName(fn string) string {
+	return fn + ".tix"
+}
+
+// IndexFormat describes the trice encoding inside a binary logfile.
+type IndexFormat struct {
+	Framing        string // Framing is "COBS" or "TCOBS".
+	IDBits         int    // IDBits is the count of ID bits.
+	BigEndian      bool   // BigEndian is true for big endian trice data.
+	Doubled16BitID bool   // Doubled16BitID is true, when 16-bit stamped trices carry the ID twice.
+}
+
+// idWords is the count of 64-bit words of a bitmap for all 14-bit IDs.
+const idWords = 1 << 14 / 64
+
+// idWord is a not zero word of a sparse ID bitmap.
+type idWord struct {
+	i    uint8
+	bits uint64
+}
+
+// idSet is a sparse ID bitmap sorted by word index.
+type idSet []idWord
+
+func (s idSet) has(id uint16) bool {
+	i := uint8(id >> 6)
+	for _, w := range s {
+		if w.i == i {
+			return w.bits&(1<<(id&63)) != 0
+		}
+	}
+	return false
+}
+
+// intersects returns true, if s contains an ID of the full bitmap ids.
+func (s idSet) intersects(ids *[idWords]uint64) bool {
+	for _, w := range s {
+		if w.bits&ids[w.i] != 0 {
+			return true
+		}
+	}
+	return false
+}
+
+// Count returns the number of IDs in s.
+func (s idSet) Count() (n int) {
+	for _, w := range s {
+		n += bits.OnesCount64(w.bits)
+	}
+	return
+}
+
+// IndexBlock is an indexed part of a binary logfile.
+type IndexBlock struct {
+	Offset     int64  // Offset is the logfile byte offset of the first package.
+	Size       int64  // Size is the block byte count.
+	Packages   int    // Packages is the count of packages.
+	MinStamp   uint32 // MinStamp is the smallest target stamp, if Stamped.
+	MaxStamp   uint32 // MaxStamp is the biggest target stamp, if Stamped.
+	Stamped    bool   // Stamped is true, if the block contains trices with target stamps.
+	Cycle      uint8  // Cycle is the cycle counter of the first trice with a cycle counter, if CycleValid.
+	CycleValid bool
+	IDs        idSet // IDs are the trice IDs inside the block.
+}
+
+// Index is a binary logfile index.
+type Index struct {
+	Size           int64 // Size is the indexed logfile byte count.
+	BlockSize      int
+	Blocks         []IndexBlock
+	NextCycle      uint8 // NextCycle is the cycle counter expected for data appended after Size, if NextCycleValid.
+	NextCycleValid bool
+}
+
+// indexBuilder collects the blocks of a package stream.
+type indexBuilder struct {
+	f     IndexFormat
+	idx   Index
+	blk   IndexBlock
+	ids   [idWords]uint64
+	frame []byte // frame is the decoding buffer.
+}
+
+// BuildIndex reads the binary logfile fn and writes its index into IndexFileName(fn).
+func BuildIndex(fSys *afero.Afero, fn string, f IndexFormat) (*Index, error) {
+	fh, err := fSys.Open(fn)
+	if err != nil {
+		return nil, err
+	}
+	defer fh.Close()
+	idx, err := NewIndex(fh, f)
+	if err != nil {
+		return nil, fmt.Errorf("%s: %w", fn, err)
+	}
+	out, err := fSys.Create(IndexFileName(fn))
+	if err != nil {
+		return nil, err
+	}
+	bw := bufio.NewWriter(out)
+	err = idx.write(bw)
+	if e := bw.Flush(); err == nil {
+		err = e
+	}
+	if e := out.Close(); err == nil {
+		err = e
+	}
+	return idx, err
+}
+
+// NewIndex returns the index of the framed packages read from r. A not terminated package at the end is not indexed.
+func NewIndex(r io.Reader, f IndexFormat) (*Index, error) {
+	switch strings.ToUpper(f.Framing) {
+	case "COBS", "TCOBS", "TCOBSV1":
+	default:
+		return nil, fmt.Errorf("framing %s cannot be indexed, use COBS or TCOBS", f.Framing)
+	}
+	if f.IDBits == 0 {
+		f.IDBits = 14
+	}
+	br := bufio.NewReaderSize(r, binaryLogBufferSize)
+	if magic, _ := br.Peek(len(TimedLogMagic)); string(magic) == TimedLogMagic {
+		return nil, errors.New("timed binary logfiles cannot be indexed")
+	}
+	if magic, _ := br.Peek(2); len(magic) == 2 && magic[0] == 0x1f && magic[1] == 0x8b {
+		return nil, errors.New("compressed binary logfiles cannot be indexed")
+	}
+	p := &indexBuilder{f: f, idx: Index{BlockSize: IndexBlockSize}, frame: make([]byte, 64*1024)}
+	var offset, end int64 // end is the offset after the last terminated package.
+	oversized := false    // oversized is true inside a package bigger than the reader buffer.
+	for {
+		pkg, err := br.ReadSlice(0)
+		offset += int64(len(pkg))
+		if err == bufio.ErrBufferFull { // no package, so skip to the next delimiter
+			oversized = true
+			continue
+		}
+		if err == io.EOF {
+			break
+		}
+		if err != nil {
+			return nil, err
+		}
+		if !oversized {
+			p.add(end, pkg[:len(pkg)-1])
+		}
+		oversized, end = false, offset
+	}
+	p.closeBlock(end)
+	p.idx.Size = end
+	return &p.idx, nil
+}
+
+// add indexes the framed package at offset. pkg is without the terminating 0.
+func (p *indexBuilder) add(offset int64, pkg []byte) {
+	if p.blk.Packages > 0 && offset-p.blk.Offset >= int64(p.idx.BlockSize) {
+		p.closeBlock(offset)
+	}
+	if p.blk.Packages == 0 {
+		p.blk = IndexBlock{Offset: offset}
+	}
+	p.blk.Packages++
+	var b []byte
+	if strings.ToUpper(p.f.Framing) == "COBS" {
+		n, err := cobs.Decode(p.frame, pkg)
+		if err != nil {
+			return
+		}
+		b = p.frame[:n]
+	} else {
+		n, err := tcobs.Decode(p.frame, pkg)
+		if err != nil {
+			return
+		}
+		b = p.frame[len(p.frame)-n:] // buffer is filled from the end
+	}
+	p.addTrices(b)
+}
+
+// addTrices records IDs, stamps and the first cycle counter of the trices inside the decoded package b.
+func (p *indexBuilder) addTrices(b []byte) {
+	u16 := binary.LittleEndian.Uint16
+	u32 := binary.LittleEndian.Uint32
+	if p.f.BigEndian {
+		u16 = binary.BigEndian.Uint16
+		u32 = binary.BigEndian.Uint32
+	}
+	for len(b) >= 2 {
+		tyID := u16(b)
+		typ := tyID >> p.f.IDBits
+		if typ == 0 { // padding zero, like in multi pack mode
+			b = b[1:]
+			continue
+		}
+		id := tyID & (1<<p.f.IDBits - 1)
+		b = b[2:]
+		var stampSize int
+		switch typ {
+		case 2:
+			stampSize = 2
+			if p.f.Doubled16BitID {
+				if len(b) < 2 {
+					return
+				}
+				b = b[2:]
+			}
+		case 3:
+			stampSize = 4
+		}
+		if len(b) < stampSize+2 {
+			return
+		}
+		switch stampSize {
+		case 2:
+			p.addStamp(uint32(u16(b)))
+		case 4:
+			p.addStamp(u32(b))
+		}
+		b = b[stampSize:]
+		nc := u16(b)
+		b = b[2:]
+		size := int(nc >> 8)
+		if nc>>15 == 1 { // more than 127 data bytes, no cycle counter
+			size = int(nc & 0x7FFF)
+		} else {
+			if !p.blk.CycleValid {
+				p.blk.Cycle = uint8(nc)
+				p.blk.CycleValid = true
+			}
+			p.idx.NextCycle = uint8(nc) + 1
+			p.idx.NextCycleValid = true
+		}
+		p.ids[id>>6] |= 1 << (id & 63)
+		if size > len(b) {
+			return
+		}
+		b = b[size:]
+	}
+}
+
+func (p *indexBuilder) addStamp(s uint32) {
+	if !p.blk.Stamped || s < p.blk.MinStamp {
+		p.blk.MinStamp = s
+	}
+	if !p.blk.Stamped || s > p.blk.MaxStamp {
+		p.blk.MaxStamp = s
+	}
+	p.blk.Stamped = true
+}
+
+// closeBlock ends the actual block at offset end.
+func (p *indexBuilder) closeBlock(end int64) {
+	if p.blk.Packages == 0 {
+		return
+	}
+	p.blk.Size = end - p.blk.Offset
+	for i, w := range p.ids {
+		if w != 0 {
+			p.blk.IDs = append(p.blk.IDs, idWord{uint8(i), w})
+			p.ids[i] = 0
+		}
+	}
+	p.idx.Blocks = append(p.idx.Blocks, p.blk)
+	p.blk = IndexBlock{}
+}
+
+const (
+	blockStamped    = 1
+	blockCycleValid = 2
+
+	indexBlocksPrealloc = 4096 // indexBlocksPrealloc limits the block slice allocation before reading the blocks.
+)
+
+// write writes p in the index file format into w.
+func (p *Index) write(w io.Writer) error {
+	b := []byte(IndexMagic)
+	b = binary.LittleEndian.AppendUint64(b, uint64(p.Size))
+	b = binary.LittleEndian.AppendUint32(b, uint32(p.BlockSize))
+	b = binary.LittleEndian.AppendUint32(b, uint32(len(p.Blocks)))
+	var flags byte
+	if p.NextCycleValid {
+		flags |= blockCycleValid
+	}
+	b = append(b, flags, p.NextCycle)
+	for _, blk := range p.Blocks {
+		var flags byte
+		if blk.Stamped {
+			flags |= blockStamped
+		}
+		if blk.CycleValid {
+			flags |= blockCycleValid
+		}
+		b = binary.LittleEndian.AppendUint64(b, uint64(blk.Offset))
+		b = binary.LittleEndian.AppendUint32(b, uint32(blk.Packages))
+		b = binary.LittleEndian.AppendUint32(b, blk.MinStamp)
+		b = binary.LittleEndian.AppendUint32(b, blk.MaxStamp)
+		b = append(b, flags, blk.Cycle)
+		b = binary.LittleEndian.AppendUint16(b, uint16(len(blk.IDs)))
+		for _, word := range blk.IDs {
+			b = append(b, word.i)
+			b = binary.LittleEndian.AppendUint64(b, word.bits)
+		}
+		if len(b) > binaryLogBufferSize {
+			if _, err := w.Write(b); err != nil {
+				return err
+			}
+			b = b[:0]
+		}
+	}
+	_, err := w.Write(b)
+	return err
+}
+
+// ReadIndex reads the index file fn.
+func ReadIndex(fSys *afero.Afero, fn string) (*Index, error) {
+	fh, err := fSys.Open(fn)
+	if err != nil {
+		return nil, err
+	}
+	defer fh.Close()
+	idx, err := readIndex(bufio.NewReaderSize(fh, binaryLogBufferSize))
+	if err != nil {
+		return nil, fmt.Errorf("%s: %w", fn, err)
+	}
+	return idx, nil
+}
+
+func readIndex(r io.Reader) (*Index, error) {
+	hdr := make([]byte, len(IndexMagic)+18)
+	if _, err := io.ReadFull(r, hdr); err != nil || string(hdr[:len(IndexMagic)]) != IndexMagic {
+		return nil, errors.New("no trice index")
+	}
+	hdr = hdr[len(IndexMagic):]
+	p := &Index{
+		Size:           int64(binary.LittleEndian.Uint64(hdr)),
+		BlockSize:      int(binary.LittleEndian.Uint32(hdr[8:])),
+		NextCycle:      hdr[17],
+		NextCycleValid: hdr[16]&blockCycleValid != 0,
+	}
+	if p.Size < 0 {
+		return nil, fmt.Errorf("invalid trice index size %d", p.Size)
+	}
+	// The block count is not trusted for the allocation. A damaged count ends with a truncated index error.
+	count := int(binary.LittleEndian.Uint32(hdr[12:]))
+	prealloc := count
+	if prealloc > indexBlocksPrealloc {
+		prealloc = indexBlocksPrealloc
+	}
+	p.Blocks = make([]IndexBlock, 0, prealloc)
+	var b [24]byte
+	for i := 0; i < count; i++ {
+		if _, err := io.ReadFull(r, b[:]); err != nil {
+			return nil, fmt.Errorf("truncated trice index: %w", err)
+		}
+		var blk IndexBlock
+		blk.Offset = int64(binary.LittleEndian.Uint64(b[:]))
+		if blk.Offset < 0 || blk.Offset >= p.Size || (i > 0 && blk.Offset <= p.Blocks[i-1].Offset) {
+			return nil, fmt.Errorf("invalid trice index block %d offset %d", i, blk.Offset)
+		}
+		blk.Packages = int(binary.LittleEndian.Uint32(b[8:]))
+		blk.MinStamp = binary.LittleEndian.Uint32(b[12:])
+		blk.MaxStamp = binary.LittleEndian.Uint32(b[16:])
+		blk.Stamped = b[20]&blockStamped != 0
+		blk.CycleValid = b[20]&blockCycleValid != 0
+		blk.Cycle = b[21]
+		blk.IDs = make(idSet, binary.LittleEndian.Uint16(b[22:]))
+		for j := range blk.IDs {
+			if _, err := io.ReadFull(r, b[:9]); err != nil {
+				return nil, fmt.Errorf("truncated trice index: %w", err)
+			}
+			blk.IDs[j] = idWord{b[0], binary.LittleEndian.Uint64(b[1:])}
+		}
+		if i > 0 {
+			p.Blocks[i-1].Size = blk.Offset - p.Blocks[i-1].Offset
+		}
+		p.Blocks = append(p.Blocks, blk)
+	}
+	if n := len(p.Blocks); n > 0 {
+		p.Blocks[n-1].Size = p.Size - p.Blocks[n-1].Offset
+	}
+	return p, nil
+}
+
+// List writes a line per block into w.
+func (p *Index) List(w io.Writer) {
+	fmt.Fprintf(w, "%d bytes in %d blocks\n", p.Size, len(p.Blocks))
+	for i, blk := range p.Blocks {
+		fmt.Fprintf(w, "block %6d offset %12d size %8d packages %6d", i, blk.Offset, blk.Size, blk.Packages)
+		if blk.Stamped {
+			fmt.Fprintf(w, " stamps %10d..%-10d", blk.MinStamp, blk.MaxStamp)
+		}
+		if blk.CycleValid {
+			fmt.Fprintf(w, " cycle %3d", blk.Cycle)
+		}
+		fmt.Fprintf(w, " IDs %d\n", blk.IDs.Count())
+	}
+}
+
+// IndexQuery selects blocks of an indexed binary logfile.
+type IndexQuery struct {
+	Offset   int64  // Offset selects the blocks from the block containing this logfile byte offset on. -1 means off.
+	Stamps   bool   // Stamps is true for a target stamp range query.
+	From, To uint32 // From and To are the inclusive target stamp range.
+	IDs      *[idWords]uint64
+}
+
+// NewIndexQuery returns the query according QueryOffset, QueryStamps and QueryIDs and true, if any is set.
+func NewIndexQuery() (q IndexQuery, active bool, err error) {
+	q.Offset = QueryOffset
+	active = QueryOffset >= 0
+	if QueryStamps != "" {
+		from, to, found := strings.Cut(QueryStamps, ":")
+		f, e0 := strconv.ParseUint(from, 10, 32)
+		t, e1 := strconv.ParseUint(to, 10, 32)
+		if !found || e0 != nil || e1 != nil || f > t {
+			return q, false, fmt.Errorf("invalid target stamp range %s, use from:to like 1000:2000", QueryStamps)
+		}
+		q.Stamps, q.From, q.To = true, uint32(f), uint32(t)
+		active = true
+	}
+	if QueryIDs != "" {
+		q.IDs = new([idWords]uint64)
+		for _, s := range strings.Split(QueryIDs, ",") {
+			from, to, found := strings.Cut(strings.TrimSpace(s), "-")
+			if !found {
+				to = from
+			}
+			f, e0 := strconv.ParseUint(from, 10, 14)
+			t, e1 := strconv.ParseUint(to, 10, 14)
+			if e0 != nil || e1 != nil || f > t {
+				return q, false, fmt.Errorf("invalid ID list %s, use IDs and ranges like 12,100-199", QueryIDs)
+			}
+			for id := f; id <= t; id++ {
+				q.IDs[id>>6] |= 1 << (id & 63)
+			}
+		}
+		active = true
+	}
+	return
+}
+
+// selects returns true, if blk can contain wanted trices.
+func (q *IndexQuery) selects(blk *IndexBlock) bool {
+	if q.Offset >= 0 && blk.Offset+blk.Size <= q.Offset {
+		return false
+	}
+	if q.Stamps && (!blk.Stamped || blk.MaxStamp < q.From || blk.MinStamp > q.To) {
+		return false
+	}
+	if q.IDs != nil && !blk.IDs.intersects(q.IDs) {
+		return false
+	}
+	return true
+}
+
+// MatchTrice returns true for a wanted trice. Trices without target stamp do not match a stamp range.
+func (q *IndexQuery) MatchTrice(id uint16, stamp uint64, stampSize int) bool {
+	if q.Stamps && (stampSize == 0 || stamp < uint64(q.From) || stamp > uint64(q.To)) {
+		return false
+	}
+	if q.IDs != nil && q.IDs[id>>6]&(1<<(id&63)) == 0 {
+		return false
+	}
+	return true
+}
+
+// indexRun is a contiguous logfile part to read.
+type indexRun struct {
+	offset, end int64 // end is -1 for the file end.
+	cycle       uint8
+	sync        bool // sync is true, if the decoder needs to expect cycle at the run start.
+}
+
+// runs returns the contiguous logfile parts selected by q. Data after p.Size are always selected.
+func (p *Index) runs(q *IndexQuery) (runs []indexRun) {
+	for i := range p.Blocks {
+		blk := &p.Blocks[i]
+		if !q.selects(blk) {
+			continue
+		}
+		if n := len(runs); n > 0 && runs[n-1].end == blk.Offset {
+			runs[n-1].end += blk.Size
+			continue
+		}
+		runs = append(runs, indexRun{offset: blk.Offset, end: blk.Offset + blk.Size, cycle: blk.Cycle, sync: blk.CycleValid && blk.Offset > 0})
+	}
+	if n := len(runs); n > 0 && runs[n-1].end == p.Size {
+		runs[n-1].end = -1
+	} else { // The appended data follow a gap, so the decoder needs to expect the cycle after the indexed data.
+		runs = append(runs, indexRun{offset: p.Size, end: -1, cycle: p.NextCycle, sync: p.NextCycleValid && p.Size > 0})
+	}
+	return
+}
+
+// indexQueryReader reads the parts of an indexed binary logfile selected by a query.
+type indexQueryReader struct {
+	IndexQuery
+	w     io.Writer
+	fn    string
+	fh    afero.File
+	runs  []indexRun
+	left  int64 // left is the not yet read byte count of the actual run or -1 until the file end.
+	gap   bool  // gap is true, if the last Read returned the first data of a run after a gap.
+	sync  bool  // sync is true, until the first data of a run after a gap are read.
+	cycle uint8
+	ended atomic.Bool
+}
+
+// newIndexQueryReader opens the binary logfile fn for the query q using its index.
+func newIndexQueryReader(w io.Writer, fSys *afero.Afero, fn string, q IndexQuery) (*indexQueryReader, error) {
+	idx, err := ReadIndex(fSys, IndexFileName(fn))
+	if err != nil {
+		return nil, fmt.Errorf("%w, build it with 'trice index -args %s'", err, fn)
+	}
+	fh, err := fSys.Open(fn)
+	if err != nil {
+		return nil, err
+	}
+	if fi, err := fh.Stat(); err == nil && fi.Size() < idx.Size {
+		fh.Close()
+		return nil, fmt.Errorf("index %s does not match %s, rebuild it with 'trice index -args %s'", IndexFileName(fn), fn, fn)
+	}
+	p := &indexQueryReader{IndexQuery: q, w: w, fn: fn, fh: fh, runs: idx.runs(&q)}
+	if Verbose {
+		fmt.Fprintln(w, "Index query reads", len(p.runs), "parts of", fn)
+	}
+	return p, nil
+}
+
+// Read returns data of one run only, so a gap is always at the start of a Read.
+func (p *indexQueryReader) Read(b []byte) (n int, err error) {
+	p.gap = false
+	if p.left == 0 {
+		if len(p.runs) == 0 {
+			p.ended.Store(true)
+			return 0, io.EOF
+		}
+		r := p.runs[0]
+		p.runs = p.runs[1:]
+		if _, err = p.fh.Seek(r.offset, io.SeekStart); err != nil {
+			return
+		}
+		p.left = -1
+		if r.end >= 0 {
+			p.left = r.end - r.offset
+		}
+		p.sync, p.cycle = r.sync, r.cycle
+	}
+	if p.left > 0 && int64(len(b)) > p.left {
+		b = b[:p.left]
+	}
+	n, err = p.fh.Read(b)
+	if n > 0 {
+		p.gap, p.sync = p.sync, false
+	}
+	if p.left > 0 {
+		p.left -= int64(n)
+	}
+	if err == io.EOF { // The run ends with the file.
+		p.left = 0
+		err = nil
+	}
+	return
+}
+
+// CycleSync returns the first cycle counter of the run started by the last Read, if it follows a gap.
+func (p *indexQueryReader) CycleSync() (uint8, bool) {
+	return p.cycle, p.gap
+}
+
+// Ended returns true after the last selected run.
+func (p *indexQueryReader) Ended() bool {
+	return p.ended.Load()
+}
+
+func (p *indexQueryReader) Write(b []byte) (int, error) {
+	return len(b), nil // discard, do not change files!
+}
+
+// Close is part of the exported interface io.ReadCloser.
+func (p *indexQueryReader) Close() error {
+	p.ended.Store(true)
+	return p.fh.Close()
+}
@@ -0,0 +1,251 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+import (
+	"bytes"
+	"encoding/binary"
+	"io"
+	"testing"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// indexTestCapture returns count COBS framed trices with 32-bit stamps seq*10. The IDs are 100...109,
+// despite each 1000th trice, which has ID 200. Each 7th package contains a second trice with ID 300.
+func indexTestCapture(count int) []byte {
+	var out []byte
+	frame := make([]byte, 64)
+	for seq := 0; seq < count; seq++ {
+		tid := uint16(100 + seq%10)
+		if seq%1000 == 500 {
+			tid = 200
+		}
+		pkg := binary.LittleEndian.AppendUint16(nil, 3<<14|tid)
+		pkg = binary.LittleEndian.AppendUint32(pkg, uint32(seq*10))
+		pkg = binary.LittleEndian.AppendUint16(pkg, 4<<8|uint16(0xc0+seq%64))
+		pkg = binary.LittleEndian.AppendUint32(pkg, uint32(seq))
+		if seq%7 == 0 {
+			pkg = binary.LittleEndian.AppendUint16(pkg, 1<<14|300) // no stamp
+			pkg = binary.LittleEndian.AppendUint16(pkg, 0x8000)    // long count without cycle
+		}
+		n := cobs.Encode(frame, pkg)
+		out = append(out, frame[:n]...)
+		out = append(out, 0)
+	}
+	return out
+}
+
+// setIndexQuery sets the query switches and restores them after the test.
+func setIndexQuery(t *testing.T, offset int64, stamps, ids string) {
+	QueryOffset, QueryStamps, QueryIDs = offset, stamps, ids
+	t.Cleanup(func() { QueryOffset, QueryStamps, QueryIDs = -1, "", "" })
+}
+
+func TestBuildIndex(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	capture := indexTestCapture(10000)
+	assert.Nil(t, fSys.WriteFile("trice.bin", capture, 0644))
+	defer func(size int) { IndexBlockSize = size }(IndexBlockSize)
+	IndexBlockSize = 4096
+
+	idx, err := BuildIndex(fSys, "trice.bin", IndexFormat{Framing: "COBS"})
+	assert.Nil(t, err)
+	assert.Equal(t, int64(len(capture)), idx.Size)
+	assert.True(t, len(idx.Blocks) > 20)
+	var packages int
+	for i, blk := range idx.Blocks {
+		assert.True(t, blk.Offset == 0 || capture[blk.Offset-1] == 0, "block starts at a package boundary")
+		assert.True(t, blk.Stamped && blk.CycleValid)
+		seq := int(blk.MinStamp / 10)
+		assert.Equal(t, packages, seq, "first package of block", i)
+		assert.Equal(t, uint8(0xc0+seq%64), blk.Cycle)
+		assert.True(t, blk.IDs.has(100) && blk.IDs.has(109) && blk.IDs.has(300))
+		var rare bool
+		for s := seq; s < seq+blk.Packages; s++ {
+			rare = rare || s%1000 == 500
+		}
+		assert.Equal(t, rare, blk.IDs.has(200), "block", i)
+		packages += blk.Packages
+	}
+	assert.Equal(t, 10000, packages)
+
+	rd, err := ReadIndex(fSys, "trice.bin.tix")
+	assert.Nil(t, err)
+	assert.Equal(t, idx, rd)
+}
+
+func TestBuildIndexRejects(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	assert.Nil(t, fSys.WriteFile("timed.bin", []byte(TimedLogMagic+"data"), 0644))
+	_, err := BuildIndex(fSys, "timed.bin", IndexFormat{Framing: "TCOBS"})
+	assert.Error(t, err)
+	assert.Nil(t, fSys.WriteFile("trice.bin", indexTestCapture(10), 0644))
+	_, err = BuildIndex(fSys, "trice.bin", IndexFormat{Framing: "none"})
+	assert.Error(t, err)
+}
+
+// TestIndexQuery checks, that the query reads only the selected blocks and reports the cycle counter after gaps.
+func TestIndexQuery(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	capture := indexTestCapture(10000)
+	assert.Nil(t, fSys.WriteFile("trice.bin", capture, 0644))
+	defer func(size int) { IndexBlockSize = size }(IndexBlockSize)
+	IndexBlockSize = 4096
+	idx, err := BuildIndex(fSys, "trice.bin", IndexFormat{Framing: "COBS"})
+	assert.Nil(t, err)
+
+	query := func(offset int64, stamps, ids string) (data []byte, gaps int) {
+		setIndexQuery(t, offset, stamps, ids)
+		rwc, err := NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", "trice.bin")
+		assert.Nil(t, err)
+		defer rwc.Close()
+		b := make([]byte, 1000)
+		for !rwc.(Ender).Ended() {
+			n, _ := rwc.Read(b)
+			if cycle, ok := rwc.(CycleSyncer).CycleSync(); ok {
+				gaps++
+				pkg := make([]byte, 64)
+				_, err := cobs.Decode(pkg, b[:bytes.IndexByte(b[:n], 0)])
+				assert.Nil(t, err)
+				seq := binary.LittleEndian.Uint32(pkg[8:]) // after ID, stamp and count
+				assert.Equal(t, uint8(0xc0+seq%64), cycle, "cycle after gap")
+			}
+			data = append(data, b[:n]...)
+		}
+		return
+	}
+
+	all, gaps := query(0, "", "")
+	assert.Equal(t, capture, all)
+	assert.Equal(t, 0, gaps)
+
+	rare, gaps := query(-1, "", "200")
+	assert.Equal(t, 10, gaps)
+	assert.True(t, len(rare) < 10*(IndexBlockSize+64), len(rare)) // 10 blocks
+	for seq := 500; seq < 10000; seq += 1000 {
+		pkg := indexTestCapture(seq + 1)
+		assert.True(t, bytes.Contains(rare, pkg[len(indexTestCapture(seq)):]), seq)
+	}
+
+	blk := idx.Blocks[len(idx.Blocks)/2]
+	tail, _ := query(blk.Offset+1, "", "")
+	assert.Equal(t, capture[blk.Offset:], tail)
+
+	stamps, _ := query(-1, "50000:50100", "")
+	assert.True(t, len(stamps) <= 2*IndexBlockSize, len(stamps))
+	assert.True(t, bytes.Contains(stamps, indexTestCapture(5011)[len(indexTestCapture(5000)):]))
+
+	none, _ := query(-1, "50000:50100", "200")
+	assert.Equal(t, 0, len(none))
+
+	assert.Nil(t, fSys.WriteFile("trice.bin", capture[:len(capture)/2], 0644))
+	setIndexQuery(t, -1, "", "200")
+	_, err = NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", "trice.bin")
+	assert.Error(t, err, "outdated index")
+}
+
+// TestIndexQueryAppended checks, that data appended after indexing are always read and that the cycle counter
+// of their first trice is expected after a gap.
+func TestIndexQueryAppended(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	capture := indexTestCapture(3000)
+	indexed := len(indexTestCapture(1500))
+	assert.Nil(t, fSys.WriteFile("trice.bin", capture[:indexed], 0644))
+	_, err := BuildIndex(fSys, "trice.bin", IndexFormat{Framing: "COBS"})
+	assert.Nil(t, err)
+	assert.Nil(t, fSys.WriteFile("trice.bin", capture, 0644))
+
+	setIndexQuery(t, -1, "", "12")
+	rwc, err := NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", "trice.bin")
+	assert.Nil(t, err)
+	defer rwc.Close()
+	b := make([]byte, 100)
+	n, err := rwc.Read(b)
+	assert.Nil(t, err)
+	cycle, ok := rwc.(CycleSyncer).CycleSync()
+	assert.True(t, ok)
+	assert.Equal(t, uint8(0xc0+1500%64), cycle)
+	data, err := io.ReadAll(rwc)
+	assert.Nil(t, err)
+	assert.Equal(t, capture[indexed:], append(b[:n], data...))
+	assert.True(t, rwc.(Ender).Ended())
+}
+
+// TestBuildIndexOversized checks, that a package bigger than the reader buffer is skipped as a whole.
+func TestBuildIndexOversized(t *testing.T) {
+	head, tail := indexTestCapture(100), indexTestCapture(200)[len(indexTestCapture(100)):]
+	capture := append(append(append([]byte{}, head...), bytes.Repeat([]byte{0x55}, 3*binaryLogBufferSize/2)...), 0)
+	capture = append(capture, tail...)
+	idx, err := NewIndex(bytes.NewReader(append(capture, bytes.Repeat([]byte{0x55}, 2*binaryLogBufferSize)...)), IndexFormat{Framing: "COBS"})
+	assert.Nil(t, err)
+	assert.Equal(t, int64(len(capture)), idx.Size, "a not terminated package at the end is not indexed")
+	var packages int
+	for _, blk := range idx.Blocks {
+		assert.True(t, blk.Offset == 0 || capture[blk.Offset-1] == 0, "block starts at a package boundary")
+		assert.Equal(t, uint8(0xc0+blk.MinStamp/10%64), blk.Cycle)
+		packages += blk.Packages
+	}
+	assert.Equal(t, 200, packages)
+	assert.True(t, idx.NextCycleValid)
+	assert.Equal(t, uint8(0xc0+200%64), idx.NextCycle)
+}
+
+// TestReadIndexDamaged checks, that a damaged index file is rejected without trusting its block count and offsets.
+func TestReadIndexDamaged(t *testing.T) {
+	defer func(size int) { IndexBlockSize = size }(IndexBlockSize)
+	IndexBlockSize = 256
+	idx, err := NewIndex(bytes.NewReader(indexTestCapture(100)), IndexFormat{Framing: "COBS"})
+	assert.Nil(t, err)
+	assert.True(t, len(idx.Blocks) > 2)
+	var buf bytes.Buffer
+	assert.Nil(t, idx.write(&buf))
+	rd, err := readIndex(bytes.NewReader(buf.Bytes()))
+	assert.Nil(t, err)
+	assert.Equal(t, idx, rd)
+
+	hdr := len(IndexMagic)
+	blk1 := hdr + 18 + 24 + 9*len(idx.Blocks[0].IDs) // second block
+	damage := func(at int, v uint64, size int) string {
+		b := append([]byte{}, buf.Bytes()...)
+		if size == 4 {
+			binary.LittleEndian.PutUint32(b[at:], uint32(v))
+		} else {
+			binary.LittleEndian.PutUint64(b[at:], v)
+		}
+		if _, err := readIndex(bytes.NewReader(b)); err != nil {
+			return err.Error()
+		}
+		return "no error"
+	}
+	assert.Contains(t, damage(hdr+12, 0xFFFFFFFF, 4), "truncated trice index")
+	assert.Contains(t, damage(hdr, 1<<63, 8), "invalid trice index size")
+	assert.Contains(t, damage(hdr, uint64(idx.Blocks[1].Offset), 8), "invalid trice index block 1")
+	assert.Contains(t, damage(blk1, uint64(idx.Blocks[0].Offset), 8), "invalid trice index block 1")
+	assert.Contains(t, damage(hdr+18, 1<<63, 8), "invalid trice index block 0")
+}
+
+func TestNewIndexQuery(t *testing.T) {
+	setIndexQuery(t, -1, "", "")
+	_, active, err := NewIndexQuery()
+	assert.False(t, active)
+	assert.Nil(t, err)
+
+	setIndexQuery(t, -1, "10:20", "5,100-102")
+	q, active, err := NewIndexQuery()
+	assert.True(t, active)
+	assert.Nil(t, err)
+	assert.True(t, q.MatchTrice(101, 10, 4))
+	assert.False(t, q.MatchTrice(103, 10, 4))
+	assert.False(t, q.MatchTrice(5, 21, 2))
+	assert.False(t, q.MatchTrice(5, 0, 0))
+
+	for _, bad := range [][2]string{{"10", ""}, {"20:10", ""}, {"", "a"}, {"", "20-10"}, {"", "16384"}} {
+		setIndexQuery(t, -1, bad[0], bad[1])
+		_, _, err = NewIndexQuery()
+		assert.Error(t, err, bad)
+	}
+}
@@ -0,0 +1,303 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+// Asynchronous binary logfile writer.
+//
+// The received chunks are copied into a bounded queue and written by a dedicated Go routine with large buffered writes,
+// so a slow disk does not slow down the reception. Only when the queue is full, the reception waits and a stall is counted.
+// The logfile is optionally rotated by size or time. A time based rotation happens with the first data after the interval.
+// Rotated segments get a sequence number, like "trice_0001.bin", and are optionally gzip compressed in the background.
+// Port FILE reads compressed segments directly. With BinaryLogTimed each chunk is stored with its reception time, see timedLog.go.
+
+import (
+	"bufio"
+	"compress/gzip"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/rokath/trice/pkg/msg"
+	"github.com/spf13/afero"
+)
+
+var (
+	// BinaryLogRotate is the binary logfile rotation size, like "64MB", or interval, like "1h", or "off".
+	BinaryLogRotate = "off"
+
+	// BinaryLogCompress enables the gzip compression of rotated binary logfile segments.
+	BinaryLogCompress bool
+
+	// BinaryLogQueueSize is the count of received chunks the binary logfile queue can hold.
+	BinaryLogQueueSize = 1024
+)
+
+// binaryLogBufferSize is the write buffer size of the binary logfile.
+const binaryLogBufferSize = 256 * 1024
+
+// parseRotate returns the rotation size in bytes or the rotation interval of s.
+func parseRotate(s string) (size int64, interval time.Duration, err error) {
+	switch strings.ToLower(s) {
+	case "", "off", "none":
+		return
+	}
+	if interval, err = time.ParseDuration(s); err == nil {
+		if interval <= 0 {
+			err = fmt.Errorf("invalid binary logfile rotation interval %s", s)
+		}
+		return
+	}
+	interval = 0
+	u := strings.TrimSuffix(strings.ToUpper(s), "B")
+	factor := int64(1)
+	for i, suffix := range []string{"K", "M", "G"} {
+		if strings.HasSuffix(u, suffix) {
+			factor = 1 << (10 * (i + 1))
+			u = strings.TrimSuffix(u, suffix)
+		}
+	}
+	n, e := strconv.ParseInt(u, 10, 64)
+	if e != nil || n <= 0 {
+		return 0, 0, fmt.Errorf("invalid binary logfile rotation %s, use a size like 64MB or an interval like 1h", s)
+	}
+	return n * factor, 0, nil
+}
+
+// logWriter writes queued chunks into a rotating logfile.
+type logWriter struct {
+	w        io.Writer // w gets the messages.
+	fSys     *afero.Afero
+	fn       string
+	maxSize  int64         // maxSize is the rotation size or 0.
+	interval time.Duration // interval is the rotation interval or 0.
+	compress bool
+	timed    bool             // timed is true for a timed binary logfile.
+	now      func() time.Time // now returns the reception time of a chunk.
+	q        chan *logChunk
+	mu       sync.RWMutex // mu protects q against a Write after Close.
+	closed   bool
+	pool     sync.Pool
+	stalls   atomic.Uint64
+	done     chan struct{}
+	zip      sync.WaitGroup // zip waits for the running segment compressions.
+
+	// used only inside the writer Go routine
+	fh     afero.File
+	bw     *bufio.Writer
+	size   int64
+	opened time.Time
+	seq    int   // seq is the last used segment number.
+	err    error // err is the first write error.
+}
+
+// logChunk is a queued chunk together with its reception time, which the time based rotation uses.
+type logChunk struct {
+	b  []byte
+	at time.Time
+}
+
+// newLogWriter opens fn for appending and starts the writer Go routine.
+func newLogWriter(w io.Writer, fSys *afero.Afero, fn string) (*logWriter, error) {
+	maxSize, interval, err := parseRotate(BinaryLogRotate)
+	if err != nil {
+		return nil, err
+	}
+	p := &logWriter{
+		w:        w,
+		fSys:     fSys,
+		fn:       fn,
+		maxSize:  maxSize,
+		interval: interval,
+		compress: BinaryLogCompress,
+		timed:    BinaryLogTimed,
+		now:      time.Now,
+		q:        make(chan *logChunk, BinaryLogQueueSize),
+		done:     make(chan struct{}),
+	}
+	p.pool.New = func() any { return &logChunk{b: make([]byte, 0, 4096)} }
+	if err = p.open(os.O_APPEND, p.now()); err != nil {
+		return nil, err
+	}
+	go p.loop()
+	return p, nil
+}
+
+// Write queues a copy of b. Only when the queue is full, Write waits and counts a stall. After Close b is discarded.
+func (p *logWriter) Write(b []byte) (int, error) {
+	p.mu.RLock()
+	defer p.mu.RUnlock()
+	if p.closed {
+		return 0, os.ErrClosed
+	}
+	c := p.pool.Get().(*logChunk)
+	c.at = p.now()
+	c.b = c.b[:0]
+	if p.timed {
+		c.b = appendTimedRecordHeader(c.b, c.at, len(b))
+	}
+	c.b = append(c.b, b...)
+	select {
+	case p.q <- c:
+	default:
+		if p.stalls.Add(1) == 1 {
+			fmt.Fprintln(p.w, "binary logfile", p.fn, "queue overflow, reception waits for the disk")
+		}
+		p.q <- c
+	}
+	return len(b), nil
+}
+
+// Stalls returns how often the queue was full.
+func (p *logWriter) Stalls() uint64 {
+	return p.stalls.Load()
+}
+
+// Close writes all queued chunks, closes the logfile and waits for running compressions.
+func (p *logWriter) Close() error {
+	p.mu.Lock()
+	p.closed = true
+	close(p.q)
+	p.mu.Unlock()
+	<-p.done
+	p.zip.Wait()
+	if n := p.Stalls(); n > 0 {
+		fmt.Fprintln(p.w, "binary logfile", p.fn, "queue overflowed", n, "times")
+	}
+	return p.err
+}
+
+// loop is the writer Go routine. When the logfile could not be reopened after a rotation, the chunks are discarded.
+func (p *logWriter) loop() {
+	defer close(p.done)
+	for c := range p.q {
+		at := c.at
+		p.write(c.b)
+		p.pool.Put(c)
+		if p.fh == nil {
+			continue
+		}
+		if p.rotationDue(at) {
+			p.rotate(at)
+		} else if len(p.q) == 0 { // idle, so bring the data to the disk
+			p.setErr(p.bw.Flush())
+		}
+	}
+	if p.fh != nil {
+		p.setErr(p.bw.Flush())
+		p.setErr(p.fh.Close())
+	}
+}
+
+// setErr keeps the first error.
+func (p *logWriter) setErr(err error) {
+	if err != nil && p.err == nil {
+		p.err = err
+		fmt.Fprintln(p.w, "binary logfile", p.fn, err)
+	}
+}
+
+func (p *logWriter) write(b []byte) {
+	if p.fh == nil {
+		return
+	}
+	n, err := p.bw.Write(b)
+	p.size += int64(n)
+	p.setErr(err)
+}
+
+// open opens the logfile at time at with the additional flag, which is os.O_APPEND or os.O_TRUNC.
+func (p *logWriter) open(flag int, at time.Time) (err error) {
+	p.fh, err = p.fSys.OpenFile(p.fn, os.O_WRONLY|os.O_CREATE|flag, 0666)
+	if err != nil {
+		p.fh = nil
+		return
+	}
+	p.size = 0
+	if fi, e := p.fh.Stat(); e == nil {
+		p.size = fi.Size()
+	}
+	p.opened = at
+	if p.bw == nil {
+		p.bw = bufio.NewWriterSize(p.fh, binaryLogBufferSize)
+	} else {
+		p.bw.Reset(p.fh)
+	}
+	if p.timed && p.size == 0 { // Each segment of a timed binary logfile starts with the magic.
+		p.write([]byte(TimedLogMagic))
+	}
+	return
+}
+
+// rotationDue reports, if the logfile reached its size or if the chunk received at at came after the interval.
+func (p *logWriter) rotationDue(at time.Time) bool {
+	return (p.maxSize > 0 && p.size >= p.maxSize) || (p.interval > 0 && at.Sub(p.opened) >= p.interval)
+}
+
+// nextSegment returns the next not existing segment name, like "trice_0001.bin" for "trice.bin".
+func (p *logWriter) nextSegment() string {
+	ext := filepath.Ext(p.fn)
+	for {
+		p.seq++
+		fn := fmt.Sprintf("%s_%04d%s", strings.TrimSuffix(p.fn, ext), p.seq, ext)
+		if ok, _ := p.fSys.Exists(fn); ok {
+			continue
+		}
+		if ok, _ := p.fSys.Exists(fn + ".gz"); ok {
+			continue
+		}
+		return fn
+	}
+}
+
+// rotate renames the logfile into the next segment and opens a new logfile at time at.
+func (p *logWriter) rotate(at time.Time) {
+	p.setErr(p.bw.Flush())
+	p.setErr(p.fh.Close())
+	seg := p.nextSegment()
+	if err := p.fSys.Rename(p.fn, seg); err != nil {
+		p.setErr(err)
+	} else if p.compress {
+		p.zip.Add(1)
+		go func() {
+			defer p.zip.Done()
+			msg.OnErr(compressSegment(p.fSys, seg))
+		}()
+	}
+	p.setErr(p.open(os.O_TRUNC, at))
+}
+
+// compressSegment streams fn into fn.gz and removes fn afterwards.
+func compressSegment(fSys *afero.Afero, fn string) (err error) {
+	in, err := fSys.Open(fn)
+	if err != nil {
+		return
+	}
+	out, err := fSys.Create(fn + ".gz")
+	if err != nil {
+		in.Close()
+		return
+	}
+	zw := gzip.NewWriter(out)
+	zw.Name = filepath.Base(fn)
+	_, err = io.Copy(zw, in)
+	if e := zw.Close(); err == nil {
+		err = e
+	}
+	if e := out.Close(); err == nil {
+		err = e
+	}
+	if e := in.Close(); err == nil {
+		err = e
+	}
+	if err != nil {
+		return
+	}
+	return fSys.Remove(fn)
+}
@@ -0,0 +1,295 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+import (
+	"bytes"
+	"io"
+	"math/rand"
+	"os"
+	"path/filepath"
+	"sort"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+func TestParseRotate(t *testing.T) {
+	for _, x := range []struct {
+		s        string
+		size     int64
+		interval time.Duration
+	}{
+		{"off", 0, 0},
+		{"", 0, 0},
+		{"1000", 1000, 0},
+		{"4KB", 4096, 0},
+		{"64M", 64 << 20, 0},
+		{"2gb", 2 << 30, 0},
+		{"90s", 0, 90 * time.Second},
+		{"1h", 0, time.Hour},
+	} {
+		size, interval, err := parseRotate(x.s)
+		assert.Nil(t, err, x.s)
+		assert.Equal(t, x.size, size, x.s)
+		assert.Equal(t, x.interval, interval, x.s)
+	}
+	for _, s := range []string{"x", "-5MB", "0", "-1s", "12XB"} {
+		_, _, err := parseRotate(s)
+		assert.NotNil(t, err, s)
+	}
+}
+
+// setBinaryLog sets the binary logfile options and restores the defaults at the test end.
+func setBinaryLog(t *testing.T, fn, rotate string, compress bool) {
+	t.Cleanup(func() {
+		BinaryLogfileName = ""
+		BinaryLogRotate = "off"
+		BinaryLogCompress = false
+		BinaryLogQueueSize = 1024
+		BinaryLogTimed = false
+		ReplaySpeed = 1
+	})
+	BinaryLogfileName = fn
+	BinaryLogRotate = rotate
+	BinaryLogCompress = compress
+}
+
+// logThrough reads data in random chunks through a binary logger and closes it.
+func logThrough(t *testing.T, fSys *afero.Afero, data []byte) {
+	src := &buffer{}
+	src.Write(data)
+	rc := NewBinaryLogger(io.Discard, fSys, src)
+	b := make([]byte, 1500)
+	r := rand.New(rand.NewSource(2))
+	for {
+		n, err := rc.Read(b[:1+r.Intn(len(b)-1)])
+		if err == io.EOF {
+			break
+		}
+		assert.Nil(t, err)
+		assert.True(t, n > 0)
+	}
+	assert.Nil(t, rc.Close())
+	assert.Nil(t, rc.Close()) // a second close is harmless
+}
+
+// replay reads all segments of the binary logfile fn in order through port FILE, followed by fn itself.
+func replay(t *testing.T, fSys *afero.Afero, fn string) (segments []string, data []byte) {
+	stem := strings.TrimSuffix(filepath.Base(fn), filepath.Ext(fn)) + "_"
+	fis, err := fSys.ReadDir(filepath.Dir(fn))
+	assert.Nil(t, err)
+	for _, fi := range fis {
+		if strings.HasPrefix(fi.Name(), stem) {
+			segments = append(segments, filepath.Join(filepath.Dir(fn), fi.Name()))
+		}
+	}
+	sort.Strings(segments)
+	for _, seg := range append(segments, fn) {
+		rc, err := NewReadWriteCloser(io.Discard, fSys, false, "FILE", seg)
+		assert.Nil(t, err)
+		b, err := io.ReadAll(rc)
+		assert.Nil(t, err, seg)
+		assert.Nil(t, rc.Close())
+		data = append(data, b...)
+	}
+	return
+}
+
+// TestBinaryLoggerRotateCompress checks, that rotated and compressed segments replay identically through port FILE.
+func TestBinaryLoggerRotateCompress(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	fn := filepath.Join("logs", "trice.bin")
+	assert.Nil(t, fSys.MkdirAll("logs", 0755))
+	assert.Nil(t, fSys.WriteFile(fn, []byte("existing"), 0644)) // existing logs are appended
+	setBinaryLog(t, fn, "16KB", true)
+	data := make([]byte, 200000)
+	rand.New(rand.NewSource(1)).Read(data[:100000]) // not compressible
+	logThrough(t, fSys, data)
+
+	segments, replayed := replay(t, fSys, fn)
+	assert.True(t, len(segments) >= 10, segments)
+	for _, seg := range segments {
+		assert.Equal(t, ".gz", filepath.Ext(seg), seg)
+	}
+	assert.True(t, bytes.Equal(append([]byte("existing"), data...), replayed))
+
+	fi, err := fSys.Stat(segments[len(segments)-1]) // zeroes compress well
+	assert.Nil(t, err)
+	assert.True(t, fi.Size() < 1000, fi.Size())
+
+	// A next logging continues with the next segment number.
+	n := len(segments)
+	logThrough(t, fSys, data[:40000])
+	segments, _ = replay(t, fSys, fn)
+	assert.True(t, len(segments) > n)
+	assert.Equal(t, filepath.Join("logs", "trice_0001.bin.gz"), segments[0])
+}
+
+// TestBinaryLoggerRotateTime checks the time based rotation without compression.
+// The reception times come from a test clock, so a busy writer Go routine does not change the segments.
+func TestBinaryLoggerRotateTime(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	setBinaryLog(t, "trice.bin", "30ms", false)
+	clock := &testClock{t: time.Now()}
+	src := &slowReader{chunks: [][]byte{{1, 2, 3}, {4, 5}, {6}, {7}}, delays: []time.Duration{50 * time.Millisecond, 50 * time.Millisecond, 10 * time.Millisecond, 40 * time.Millisecond}, clock: clock}
+	rc := NewBinaryLogger(io.Discard, fSys, src)
+	rc.(*binaryLogger).w.now = clock.Now
+	b, err := io.ReadAll(rc)
+	assert.Nil(t, err)
+	assert.Nil(t, rc.Close())
+	assert.Equal(t, []byte{1, 2, 3, 4, 5, 6, 7}, b)
+	segments, replayed := replay(t, fSys, "trice.bin")
+	assert.Equal(t, []string{"trice_0001.bin", "trice_0002.bin", "trice_0003.bin"}, segments) // 6 came only 10ms after 4, 5.
+	for i, data := range [][]byte{{1, 2, 3}, {4, 5}, {6, 7}} {
+		seg, err := fSys.ReadFile(segments[i])
+		assert.Nil(t, err)
+		assert.Equal(t, data, seg, segments[i])
+	}
+	assert.Equal(t, b, replayed)
+}
+
+// testClock is a manually advanced clock.
+type testClock struct {
+	mu sync.Mutex
+	t  time.Time
+}
+
+// Now returns the clock time.
+func (p *testClock) Now() time.Time {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.t
+}
+
+// Add advances the clock by d.
+func (p *testClock) Add(d time.Duration) {
+	p.mu.Lock()
+	p.t = p.t.Add(d)
+	p.mu.Unlock()
+}
+
+// slowReader returns its chunks, each after its delay. With a clock the delays advance it instead of sleeping.
+type slowReader struct {
+	chunks [][]byte
+	delays []time.Duration
+	clock  *testClock
+}
+
+func (p *slowReader) Read(b []byte) (int, error) {
+	if len(p.chunks) == 0 {
+		return 0, io.EOF
+	}
+	if p.clock != nil {
+		p.clock.Add(p.delays[0])
+	} else {
+		time.Sleep(p.delays[0])
+	}
+	n := copy(b, p.chunks[0])
+	p.chunks, p.delays = p.chunks[1:], p.delays[1:]
+	return n, nil
+}
+
+func (p *slowReader) Write(b []byte) (int, error) { return len(b), nil }
+func (p *slowReader) Close() error                { return nil }
+
+// failingFs fails all OpenFile calls after the first n.
+type failingFs struct {
+	afero.Fs
+	n int
+}
+
+func (p *failingFs) OpenFile(name string, flag int, perm os.FileMode) (afero.File, error) {
+	if p.n--; p.n < 0 {
+		return nil, os.ErrPermission
+	}
+	return p.Fs.OpenFile(name, flag, perm)
+}
+
+// TestBinaryLoggerRotateOpenError checks, that a failing reopen after a rotation does not end the process,
+// but stops the logging and is returned by Close.
+func TestBinaryLoggerRotateOpenError(t *testing.T) {
+	fSys := &afero.Afero{Fs: &failingFs{afero.NewMemMapFs(), 1}}
+	setBinaryLog(t, "trice.bin", "1KB", false)
+	var out bytes.Buffer
+	src := &buffer{}
+	data := make([]byte, 3000)
+	src.Write(data)
+	rc := NewBinaryLogger(&out, fSys, src)
+	b, err := io.ReadAll(rc)
+	assert.Nil(t, err)
+	assert.Equal(t, data, b) // The reception goes on.
+	assert.Equal(t, os.ErrPermission, rc.Close())
+	assert.True(t, strings.Contains(out.String(), os.ErrPermission.Error()), out.String())
+	seg, err := fSys.ReadFile("trice_0001.bin")
+	assert.Nil(t, err)
+	assert.True(t, len(seg) >= 1024, len(seg))
+	ok, _ := fSys.Exists("trice.bin")
+	assert.False(t, ok)
+}
+
+// blockingFs delays all file writes until release is closed.
+type blockingFs struct {
+	afero.Fs
+	release chan struct{}
+}
+
+func (p *blockingFs) OpenFile(name string, flag int, perm os.FileMode) (afero.File, error) {
+	f, err := p.Fs.OpenFile(name, flag, perm)
+	return &blockingFile{f, p.release}, err
+}
+
+type blockingFile struct {
+	afero.File
+	release chan struct{}
+}
+
+func (p *blockingFile) Write(b []byte) (int, error) {
+	<-p.release
+	return p.File.Write(b)
+}
+
+// TestBinaryLoggerStall checks, that the reception does not wait for a blocked disk, until the queue is full.
+func TestBinaryLoggerStall(t *testing.T) {
+	bfs := &blockingFs{afero.NewMemMapFs(), make(chan struct{})}
+	fSys := &afero.Afero{Fs: bfs}
+	setBinaryLog(t, "trice.bin", "off", false)
+	BinaryLogQueueSize = 4
+	var out bytes.Buffer
+	src := &buffer{}
+	data := bytes.Repeat([]byte{1, 2, 3, 4, 5, 6, 7, 8}, binaryLogBufferSize) // 8 chunks
+	src.Write(data)
+	rc := NewBinaryLogger(&out, fSys, src)
+	p := rc.(*binaryLogger).w
+
+	b := make([]byte, binaryLogBufferSize) // chunks with buffer size are written directly
+	// The first chunk blocks the writer and the others go into the queue.
+	for i := 0; i < 5; i++ {
+		_, err := rc.Read(b)
+		assert.Nil(t, err)
+		for i == 0 && len(p.q) > 0 { // wait until the writer took the first chunk
+			time.Sleep(time.Millisecond)
+		}
+	}
+	assert.Equal(t, uint64(0), p.Stalls())
+
+	go func() { // release the disk after a while
+		time.Sleep(50 * time.Millisecond)
+		close(bfs.release)
+	}()
+	for i := 0; i < 3; i++ {
+		_, err := rc.Read(b)
+		assert.Nil(t, err)
+	}
+	assert.True(t, p.Stalls() > 0)
+	assert.Nil(t, rc.Close())
+	assert.True(t, strings.Contains(out.String(), "queue overflowed"), out.String())
+	logged, err := fSys.ReadFile("trice.bin")
+	assert.Nil(t, err)
+	assert.True(t, bytes.Equal(data, logged))
+}
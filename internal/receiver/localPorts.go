@@ -0,0 +1,188 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+// Low overhead input ports for Linux hosted targets and simulators: UDP4, UNIX (domain stream socket) and STDIN.
+
+import (
+	"errors"
+	"fmt"
+	"io"
+	"net"
+	"os"
+	"sync/atomic"
+)
+
+// Ender is implemented by inputs, which can end, like a closed socket or stdin after EOF.
+type Ender interface {
+	Ended() bool // Ended returns true, when no more data will come.
+}
+
+// Source returns the input of r, which is possibly wrapped by NewBytesViewer or NewBinaryLogger.
+func Source(r io.Reader) io.Reader {
+	for {
+		w, ok := r.(interface{ unwrap() io.Reader })
+		if !ok {
+			return r
+		}
+		r = w.unwrap()
+	}
+}
+
+// udpDatagramSize is the maximum UDP payload size.
+const udpDatagramSize = 64 * 1024
+
+// udp4 receives datagrams on a local endpoint. Each datagram contains one or more complete framed trice packages.
+// A lost datagram is detected by the decoder cycle counter check.
+type udp4 struct {
+	w       io.Writer
+	conn    *net.UDPConn
+	buf     []byte       // buf is the reused datagram buffer.
+	pending []byte       // pending is the not yet read rest of the last datagram.
+	peer    *net.UDPAddr // peer is the sender of the last datagram.
+	ended   atomic.Bool
+}
+
+// newUDP4Listener returns a udp4 instance listening on endpoint, like ":17006".
+func newUDP4Listener(w io.Writer, endpoint string) (*udp4, error) {
+	addr, err := net.ResolveUDPAddr("udp4", endpoint)
+	if err != nil {
+		return nil, err
+	}
+	conn, err := net.ListenUDP("udp4", addr)
+	if err != nil {
+		return nil, err
+	}
+	return &udp4{w: w, conn: conn, buf: make([]byte, udpDatagramSize)}, nil
+}
+
+// LocalAddr returns the local endpoint, what is useful with port 0.
+func (p *udp4) LocalAddr() net.Addr {
+	return p.conn.LocalAddr()
+}
+
+// Read is part of the exported interface io.ReadCloser. It reads a slice of bytes.
+// A datagram bigger than b is delivered over several reads. After Close, Read returns io.EOF.
+func (p *udp4) Read(b []byte) (int, error) {
+	if len(p.pending) == 0 {
+		n, peer, err := p.conn.ReadFromUDP(p.buf)
+		if err != nil {
+			p.ended.Store(true)
+			if errors.Is(err, net.ErrClosed) {
+				return 0, io.EOF
+			}
+			return 0, err
+		}
+		p.pending = p.buf[:n]
+		p.peer = peer
+	}
+	n := copy(b, p.pending)
+	p.pending = p.pending[n:]
+	return n, nil
+}
+
+// Write sends b to the sender of the last datagram. Without a received datagram b is discarded.
+func (p *udp4) Write(b []byte) (int, error) {
+	if p.peer == nil {
+		return len(b), nil
+	}
+	return p.conn.WriteToUDP(b, p.peer)
+}
+
+// Ended returns true after Close.
+func (p *udp4) Ended() bool {
+	return p.ended.Load()
+}
+
+// Close is part of the exported interface io.ReadCloser. It ends the listening.
+func (p *udp4) Close() error {
+	if Verbose {
+		fmt.Fprintln(p.w, "Closing udp4 device.")
+	}
+	p.ended.Store(true)
+	return p.conn.Close()
+}
+
+// unixSocket holds an open Unix domain stream socket connection.
+type unixSocket struct {
+	w     io.Writer
+	conn  net.Conn
+	ended atomic.Bool
+}
+
+// newUnixSocketConnection connects to the Unix domain stream socket path.
+func newUnixSocketConnection(w io.Writer, path string) (*unixSocket, error) {
+	conn, err := net.Dial("unix", path)
+	if err != nil {
+		return nil, err
+	}
+	return &unixSocket{w: w, conn: conn}, nil
+}
+
+// Read is part of the exported interface io.ReadCloser. It reads a slice of bytes.
+// A closed connection returns io.EOF.
+func (p *unixSocket) Read(b []byte) (n int, err error) {
+	n, err = p.conn.Read(b)
+	if err != nil {
+		p.ended.Store(true)
+		if err == io.EOF || errors.Is(err, net.ErrClosed) {
+			err = io.EOF
+		}
+	}
+	return
+}
+
+func (p *unixSocket) Write(b []byte) (int, error) {
+	return p.conn.Write(b)
+}
+
+// Ended returns true after the connection ended.
+func (p *unixSocket) Ended() bool {
+	return p.ended.Load()
+}
+
+// Close is part of the exported interface io.ReadCloser. It ends the connection.
+func (p *unixSocket) Close() error {
+	if Verbose {
+		fmt.Fprintln(p.w, "Closing unix socket device.")
+	}
+	p.ended.Store(true)
+	return p.conn.Close()
+}
+
+// stdinReader is replaceable for tests.
+var stdinReader io.Reader = os.Stdin
+
+// stdin reads the trice input from the standard input, like "simulator | trice log -p STDIN".
+type stdin struct {
+	r     io.Reader
+	ended atomic.Bool
+}
+
+// Read is part of the exported interface io.ReadCloser. It reads a slice of bytes.
+func (p *stdin) Read(b []byte) (n int, err error) {
+	n, err = p.r.Read(b)
+	if err != nil {
+		p.ended.Store(true)
+		if err != io.EOF {
+			err = fmt.Errorf("stdin: %w", err)
+		}
+	}
+	return
+}
+
+func (p *stdin) Write(b []byte) (int, error) {
+	return len(b), nil // discard
+}
+
+// Ended returns true after the end of the standard input.
+func (p *stdin) Ended() bool {
+	return p.ended.Load()
+}
+
+// Close is part of the exported interface io.ReadCloser. The standard input stays open.
+func (p *stdin) Close() error {
+	p.ended.Store(true)
+	return nil
+}
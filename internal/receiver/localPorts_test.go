@@ -0,0 +1,163 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+import (
+	"bytes"
+	"io"
+	"net"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/tj/assert"
+)
+
+// TestUDP4Receiver checks, that datagrams are delivered completely, also over several reads, and answers go back to the sender.
+func TestUDP4Receiver(t *testing.T) {
+	rc, err := NewReadWriteCloser(nil, nil, false, "UDP4", "127.0.0.1:0")
+	assert.Nil(t, err)
+	client, err := net.DialUDP("udp4", nil, rc.(*udp4).LocalAddr().(*net.UDPAddr))
+	assert.Nil(t, err)
+	defer client.Close()
+	_, err = client.Write([]byte{1, 2, 3, 0, 4, 5, 0})
+	assert.Nil(t, err)
+	_, err = client.Write([]byte{6, 7, 0})
+	assert.Nil(t, err)
+
+	b := make([]byte, 4)
+	for _, exp := range [][]byte{{1, 2, 3, 0}, {4, 5, 0}, {6, 7, 0}} {
+		n, err := rc.Read(b)
+		assert.Nil(t, err)
+		assert.Equal(t, exp, b[:n])
+	}
+	_, err = rc.Write([]byte("ok"))
+	assert.Nil(t, err)
+	n, err := client.Read(b)
+	assert.Nil(t, err)
+	assert.Equal(t, "ok", string(b[:n]))
+
+	assert.False(t, rc.(Ender).Ended())
+	assert.Nil(t, rc.Close())
+	_, err = rc.Read(b)
+	assert.Equal(t, io.EOF, err)
+	assert.True(t, rc.(Ender).Ended())
+}
+
+// TestUNIXReceiver reads from a Unix domain socket until the server closes the connection.
+func TestUNIXReceiver(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "trice.sock")
+	l, err := net.Listen("unix", path)
+	if err != nil {
+		t.Skip("no unix domain sockets:", err)
+	}
+	defer l.Close()
+	go func() {
+		conn, err := l.Accept()
+		assert.Nil(t, err)
+		conn.Write([]byte{0x01, 0x7f, 0xFF})
+		conn.Close()
+	}()
+	rc, err := NewReadWriteCloser(nil, nil, false, "UNIX", path)
+	assert.Nil(t, err)
+	defer rc.Close()
+	b, err := io.ReadAll(rc)
+	assert.Nil(t, err)
+	assert.Equal(t, []byte{0x01, 0x7f, 0xFF}, b)
+	assert.True(t, rc.(Ender).Ended())
+
+	_, err = NewReadWriteCloser(nil, nil, false, "UNIX", filepath.Join(t.TempDir(), "none.sock"))
+	assert.NotNil(t, err)
+}
+
+// TestSTDINReceiver reads from the standard input until its end.
+func TestSTDINReceiver(t *testing.T) {
+	defer func() { stdinReader = os.Stdin }()
+	stdinReader = bytes.NewReader([]byte{115, 111, 109, 101, 10})
+	rc, err := NewReadWriteCloser(nil, nil, false, "STDIN", "default")
+	assert.Nil(t, err)
+	assert.False(t, rc.(Ender).Ended())
+	b, err := io.ReadAll(rc)
+	assert.Nil(t, err)
+	assert.Equal(t, "some\n", string(b))
+	assert.True(t, rc.(Ender).Ended())
+	assert.Nil(t, rc.Close())
+}
+
+// benchmarkPort reads b.N chunks from rc, which are written with send. Not more than 32 chunks are in flight,
+// so UDP datagrams are not dropped because of a full socket buffer.
+func benchmarkPort(b *testing.B, rc io.ReadCloser, send func(chunk []byte) error) {
+	const chunkSize, window = 1024, 32
+	chunk := bytes.Repeat([]byte{1, 2, 3, 4, 5, 6, 7, 0}, chunkSize/8) // several small framed packages
+	tokens := make(chan struct{}, window)
+	for i := 0; i < window; i++ {
+		tokens <- struct{}{}
+	}
+	b.SetBytes(chunkSize)
+	b.ResetTimer()
+	go func() {
+		for i := 0; i < b.N; i++ {
+			<-tokens
+			if err := send(chunk); err != nil {
+				b.Error(err)
+				return
+			}
+		}
+	}()
+	buf := make([]byte, 64*1024)
+	for received, released := 0, 0; received < b.N*chunkSize; {
+		n, err := rc.Read(buf)
+		if err != nil {
+			b.Fatal(err)
+		}
+		for received += n; released < received/chunkSize; released++ {
+			tokens <- struct{}{}
+		}
+	}
+	b.StopTimer()
+	assert.Nil(b, rc.Close())
+}
+
+// BenchmarkPorts compares the throughput of the TCP4, UDP4, UNIX and STDIN input ports.
+func BenchmarkPorts(b *testing.B) {
+	stream := func(b *testing.B, network, address, port string) {
+		l, err := net.Listen(network, address)
+		if err != nil {
+			b.Skip(err)
+		}
+		defer l.Close()
+		accepted := make(chan net.Conn)
+		go func() {
+			conn, err := l.Accept()
+			assert.Nil(b, err)
+			accepted <- conn
+		}()
+		rc, err := NewReadWriteCloser(nil, nil, false, port, l.Addr().String())
+		assert.Nil(b, err)
+		conn := <-accepted
+		defer conn.Close()
+		benchmarkPort(b, rc, func(chunk []byte) error { _, err := conn.Write(chunk); return err })
+	}
+	b.Run("TCP4", func(b *testing.B) { stream(b, "tcp4", "127.0.0.1:0", "TCP4") })
+	b.Run("UNIX", func(b *testing.B) { stream(b, "unix", filepath.Join(b.TempDir(), "trice.sock"), "UNIX") })
+	b.Run("UDP4", func(b *testing.B) {
+		rc, err := NewReadWriteCloser(nil, nil, false, "UDP4", "127.0.0.1:0")
+		assert.Nil(b, err)
+		client, err := net.DialUDP("udp4", nil, rc.(*udp4).LocalAddr().(*net.UDPAddr))
+		assert.Nil(b, err)
+		defer client.Close()
+		benchmarkPort(b, rc, func(chunk []byte) error { _, err := client.Write(chunk); return err })
+	})
+	b.Run("STDIN", func(b *testing.B) {
+		defer func() { stdinReader = os.Stdin }()
+		r, w, err := os.Pipe()
+		assert.Nil(b, err)
+		defer r.Close()
+		defer w.Close()
+		stdinReader = r
+		rc, err := NewReadWriteCloser(nil, nil, false, "STDIN", "default")
+		assert.Nil(b, err)
+		benchmarkPort(b, rc, func(chunk []byte) error { _, err := w.Write(chunk); return err })
+	})
+}
@@ -33,20 +33,23 @@
 package receiver
 
 import (
+	"bufio"
 	"bytes"
+	"compress/gzip"
 	"encoding/hex"
 	"fmt"
 	"io"
 	"log"
 	"net"
-	"os"
 	"path/filepath"
 	"strings"
+	"sync"
 	"time"
 	"unicode"
 
 	"github.com/rokath/trice/internal/com"
 	"github.com/rokath/trice/internal/link"
+	"github.com/rokath/trice/internal/profile"
 	"github.com/rokath/trice/pkg/msg"
 	"github.com/spf13/afero"
 )
@@ -73,6 +76,15 @@ var (
 	// DefaultTCP4Args replaces "default" args value for TCP4 port.
 	DefaultTCP4Args = "localhost:17001" // OpenOCD starts a server on localhost:17001 where it dumps all RTT messages.
 
+	// DefaultTCP4ServerArgs replaces "default" args value for TCP4SERVER port.
+	DefaultTCP4ServerArgs = ":17005"
+
+	// DefaultUDP4Args replaces "default" args value for UDP4 port.
+	DefaultUDP4Args = ":17006"
+
+	// DefaultUNIXArgs replaces "default" args value for UNIX port.
+	DefaultUNIXArgs = "trice.sock"
+
 	// DefaultFileArgs replaces "default" args value for FILE port.
 	DefaultFileArgs = "trices.raw"
 
@@ -178,13 +190,18 @@ func (p *tcp4) Close() error {
 
 // file holds an opened file handle.
 type file struct {
-	w  io.Writer // os.Stdout
-	fn string
-	fh afero.File
+	w      io.Writer // os.Stdout
+	fn     string
+	fh     afero.File
+	rd     io.Reader    // rd reads fh buffered, decompressed for gzip files and timed for timed binary logfiles.
+	timed  *timedReader // timed is not nil for a timed binary logfile.
+	follow bool         // follow is true, when more data can be appended to the file, like for port FILE.
+	eof    bool
 }
 
-// newFileReader returns a readCloser capable file instance.
-func newFileReader(fSys *afero.Afero, fn string) *file {
+// newFileReader returns a readCloser capable file instance. Files ending with ".gz" are decompressed.
+// Timed binary logfiles are replayed with ReplaySpeed. If follow is true, more data are expected at the file end.
+func newFileReader(fSys *afero.Afero, fn string, follow bool) *file {
 	r := &file{}
 	fh, err := fSys.Open(fn)
 	if err != nil {
@@ -192,12 +209,43 @@ func newFileReader(fSys *afero.Afero, fn string) *file {
 	}
 	r.fn = fn
 	r.fh = fh
+	r.rd = fh
+	r.follow = follow
+	if strings.HasSuffix(fn, ".gz") {
+		zr, err := gzip.NewReader(fh)
+		if err != nil {
+			log.Fatal(fn, err)
+		}
+		r.rd = zr
+	}
+	br := bufio.NewReader(r.rd)
+	r.rd = br
+	if magic, _ := br.Peek(len(TimedLogMagic)); string(magic) == TimedLogMagic {
+		br.Discard(len(TimedLogMagic))
+		r.timed = &timedReader{r: br, speed: ReplaySpeed, now: time.Now, sleep: time.Sleep}
+		r.rd = r.timed
+	}
 	return r
 }
 
 // Read is part of the exported interface io.ReadCloser. It reads a slice of bytes.
-func (p *file) Read(b []byte) (int, error) {
-	return p.fh.Read(b)
+func (p *file) Read(b []byte) (n int, err error) {
+	n, err = p.rd.Read(b)
+	p.eof = err == io.EOF
+	return
+}
+
+// HostTime returns the original reception time of the last read data of a timed binary logfile.
+func (p *file) HostTime() (time.Time, bool) {
+	if p.timed == nil {
+		return time.Time{}, false
+	}
+	return p.timed.HostTime()
+}
+
+// Ended returns true at the end of a not followed file.
+func (p *file) Ended() bool {
+	return p.eof && !p.follow
 }
 
 func (p *file) Write(b []byte) (int, error) {
@@ -219,6 +267,9 @@ func (p *file) Close() error {
 // When port is "BUFFER", args is expected to be a decimal byte sequence in the same format as for example coming from one of the other ports.
 // When port is "JLINK" args contains JLinkRTTLogger.exe specific parameters described inside UM08001_JLink.pdf.
 // When port is "STLINK" args has the same format as for "JLINK"
+// When port is "UDP4" args is the local endpoint to listen on, "UNIX" args is the socket path to connect to. "STDIN" ignores args.
+// Ports "FILE" and "FILEBUFFER" read only the parts selected by QueryOffset, QueryStamps and QueryIDs, if one of them is set.
+// Port "TCP4SERVER" is no single device, use NewTCP4Server instead.
 func NewReadWriteCloser(w io.Writer, fSys *afero.Afero, verbose bool, port, args string) (r io.ReadWriteCloser, err error) {
 	if Verbose {
 		if args == "default" {
@@ -252,6 +303,32 @@ func NewReadWriteCloser(w io.Writer, fSys *afero.Afero, verbose bool, port, args
 		}
 		l := newTCP4Connection(args)
 		r = l
+	case "UDP4":
+		if args == "default" { // nothing assigned in args
+			args = DefaultUDP4Args
+		}
+		if Verbose {
+			fmt.Fprintln(w, "PortArguments=", args)
+		}
+		var l *udp4
+		if l, err = newUDP4Listener(w, args); err == nil {
+			r = l
+		}
+	case "UNIX":
+		if args == "default" { // nothing assigned in args
+			args = DefaultUNIXArgs
+		}
+		if Verbose {
+			fmt.Fprintln(w, "PortArguments=", args)
+		}
+		var l *unixSocket
+		if l, err = newUnixSocketConnection(w, args); err == nil {
+			r = l
+		}
+	case "STDIN":
+		r = &stdin{r: stdinReader}
+	case "TCP4SERVER":
+		err = fmt.Errorf("port %s accepts many clients and cannot be combined with other ports", port)
 	case "FILE", "FILEBUFFER":
 		if args == "default" { // nothing assigned in args
 			args = DefaultFileArgs
@@ -259,7 +336,18 @@ func NewReadWriteCloser(w io.Writer, fSys *afero.Afero, verbose bool, port, args
 		if Verbose {
 			fmt.Fprintln(w, "PortArguments=", args)
 		}
-		r = newFileReader(fSys, args)
+		q, query, e := NewIndexQuery()
+		switch {
+		case e != nil:
+			err = e
+		case query:
+			var l *indexQueryReader
+			if l, err = newIndexQueryReader(w, fSys, args, q); err == nil {
+				r = l
+			}
+		default:
+			r = newFileReader(fSys, args, strings.ToUpper(port) == "FILE")
+		}
 	case "DUMP", "HEX":
 		if args == "default" { // nothing assigned in args
 			args = DefaultDumpArgs
@@ -303,6 +391,9 @@ func NewReadWriteCloser(w io.Writer, fSys *afero.Afero, verbose bool, port, args
 		}
 		r = c
 	}
+	if err == nil && profile.Counting() {
+		r = &stageReader{r}
+	}
 	return
 }
 
@@ -323,14 +414,25 @@ func (b *buffer) Close() error {
 //
 //	//
 type binaryLogger struct {
-	w io.Writer
-	r io.ReadCloser
+	w    *logWriter
+	r    io.ReadCloser
+	once sync.Once
 }
 
 // NewBinaryLogger returns a ReadWriteCloser `in` which is internally using reader `from`.
 // Calling the `in` Read method leads to internally calling the `from` Read method
 // but lets to do some additional logging
 func NewBinaryLogger(w io.Writer, fSys *afero.Afero, from io.ReadWriteCloser) (in io.ReadWriteCloser) {
+	return newBinaryLogger(w, fSys, from, "")
+}
+
+// NewDeviceBinaryLogger is like NewBinaryLogger, but for one of several devices.
+// The device label is inserted into the binary logfile name, so each device gets its own file.
+func NewDeviceBinaryLogger(w io.Writer, fSys *afero.Afero, from io.ReadWriteCloser, label string) (in io.ReadWriteCloser) {
+	return newBinaryLogger(w, fSys, from, label)
+}
+
+func newBinaryLogger(w io.Writer, fSys *afero.Afero, from io.ReadWriteCloser, label string) (in io.ReadWriteCloser) {
 	fn := BinaryLogfileName
 	if fn == "none" || fn == "off" || fn == "nul" || fn == "" {
 		return from
@@ -340,28 +442,44 @@ func NewBinaryLogger(w io.Writer, fSys *afero.Afero, from io.ReadWriteCloser) (i
 		fn = filepath.Join(filepath.Dir(fn), time.Now().Format("2006-01-02_1504-05_trice.bin")) // Replace timestamp in default log filename.
 	} // Otherwise, use cli defined log filename.
 
+	if label != "" { // trice.bin -> trice_COM3.bin
+		ext := filepath.Ext(fn)
+		fn = strings.TrimSuffix(fn, ext) + "_" + strings.Map(func(r rune) rune {
+			if r == '/' || r == '\\' || r == ':' || r == '@' || unicode.IsSpace(r) {
+				return '-'
+			}
+			return r
+		}, label) + ext
+	}
+
 	if Verbose {
 		fmt.Fprintf(w, "Writing trice input to binary logfile %s...\n", fn)
 	}
-	lfHandle, err := fSys.OpenFile(fn, os.O_RDWR|os.O_CREATE|os.O_APPEND, 0666)
+	lw, err := newLogWriter(w, fSys, fn)
 	msg.FatalOnErr(err)
 
 	p := new(binaryLogger)
 	p.r = from
-	p.w = lfHandle
+	p.w = lw
 	return p
 }
 
+// Read queues the read bytes for the binary logfile writer and returns without waiting for the disk.
 func (p *binaryLogger) Read(buf []byte) (count int, err error) {
 	count, err = p.r.Read(buf)
-	if 0 < count || (err != nil && err != io.EOF) {
+	if 0 < count {
 		p.w.Write(buf[:count])
 	}
 	return
 }
 
-// Close is needed to satisfy the ReadCloser interface.
-func (p *binaryLogger) Close() error { return nil }
+// Close writes all queued bytes into the binary logfile and closes it. The logged input stays open.
+func (p *binaryLogger) Close() (err error) {
+	p.once.Do(func() { err = p.w.Close() })
+	return
+}
+
+func (p *binaryLogger) unwrap() io.Reader { return p.r }
 
 func (p *binaryLogger) Write(buf []byte) (count int, err error) { return 0, nil }
 
@@ -404,12 +522,28 @@ func (p *bytesViewer) Read(buf []byte) (count int, err error) {
 // Close is needed to satisfy the ReadCloser interface.
 func (p *bytesViewer) Close() error { return nil }
 
+func (p *bytesViewer) unwrap() io.Reader { return p.r }
+
 // Close is needed to satisfy the ReadCloser interface.
 func (p *bytesViewer) Write(_ []byte) (int, error) { return 0, nil }
 
 //                                                                                               //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// stageReader counts the port reads in the receive stage. It is used only with stage counting to keep the disabled path free.
+type stageReader struct {
+	io.ReadWriteCloser
+}
+
+func (p *stageReader) Read(buf []byte) (count int, err error) {
+	start := profile.Now()
+	count, err = p.ReadWriteCloser.Read(buf)
+	profile.Receive.Done(start, 1, count)
+	return
+}
+
+func (p *stageReader) unwrap() io.Reader { return p.ReadWriteCloser }
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // This is possibly obsolete code
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,115 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+import (
+	"bufio"
+	"bytes"
+	"fmt"
+	"io"
+	"net"
+	"strings"
+	"sync/atomic"
+	"time"
+)
+
+// DeviceAnnouncement starts an optional first line sent by a TCP4SERVER client to name its device, like "#device:board17\n".
+// Without announcement the remote address is used as device name.
+const DeviceAnnouncement = "#device:"
+
+// AnnouncementTimeout is the max time to wait for the device announcement of a TCP4SERVER client.
+// A client sending less bytes, like an idle target, gets its remote address as device name.
+var AnnouncementTimeout = time.Second
+
+// TCP4Server accepts trice byte streams from many TCP clients.
+type TCP4Server struct {
+	w  io.Writer // os.Stdout
+	ln net.Listener
+}
+
+// NewTCP4Server starts listening on address, like ":17005" or "localhost:0".
+func NewTCP4Server(w io.Writer, address string) (*TCP4Server, error) {
+	ln, err := net.Listen("tcp4", address)
+	if err != nil {
+		return nil, err
+	}
+	if Verbose {
+		fmt.Fprintln(w, "Listening for trice clients on", ln.Addr())
+	}
+	return &TCP4Server{w, ln}, nil
+}
+
+// Addr returns the listening address.
+func (p *TCP4Server) Addr() net.Addr {
+	return p.ln.Addr()
+}
+
+// Close stops listening. Accepted connections stay open.
+func (p *TCP4Server) Close() error {
+	return p.ln.Close()
+}
+
+// Accept waits for the next client. It returns net.ErrClosed after Close.
+func (p *TCP4Server) Accept() (*TCP4ServerConn, error) {
+	conn, err := p.ln.Accept()
+	if err != nil {
+		return nil, err
+	}
+	if Verbose {
+		fmt.Fprintln(p.w, "Accepted trice client", conn.RemoteAddr())
+	}
+	return &TCP4ServerConn{conn: conn, r: bufio.NewReaderSize(conn, 64*1024)}, nil
+}
+
+// TCP4ServerConn is an accepted client connection.
+type TCP4ServerConn struct {
+	conn  net.Conn
+	r     *bufio.Reader
+	ended atomic.Bool
+}
+
+// Name returns the announced device name or the remote address. An announcement is consumed.
+// Name must be called before the first Read. Received bytes, which are no announcement, stay readable.
+func (p *TCP4ServerConn) Name() string {
+	if err := p.conn.SetReadDeadline(time.Now().Add(AnnouncementTimeout)); err != nil {
+		return p.conn.RemoteAddr().String()
+	}
+	defer func() { _ = p.conn.SetReadDeadline(time.Time{}) }()
+	b, _ := p.r.Peek(len(DeviceAnnouncement)) // A timeout error is consumed by Peek and does not end later reads.
+	if !bytes.Equal(b, []byte(DeviceAnnouncement)) {
+		return p.conn.RemoteAddr().String()
+	}
+	line, err := p.r.ReadString('\n')
+	name := strings.TrimSpace(strings.TrimPrefix(line, DeviceAnnouncement))
+	if err != nil || name == "" {
+		return p.conn.RemoteAddr().String()
+	}
+	return name
+}
+
+// Ended returns true after the client disconnected.
+func (p *TCP4ServerConn) Ended() bool {
+	return p.ended.Load()
+}
+
+// Read is part of the exported interface io.ReadCloser. It reads a slice of bytes.
+// Any connection error ends the connection and is returned as io.EOF, because a client disconnect is no fatal error.
+func (p *TCP4ServerConn) Read(b []byte) (n int, err error) {
+	n, err = p.r.Read(b)
+	if err != nil {
+		p.ended.Store(true)
+		err = io.EOF
+	}
+	return
+}
+
+func (p *TCP4ServerConn) Write(b []byte) (int, error) {
+	return p.conn.Write(b)
+}
+
+// Close is part of the exported interface io.ReadCloser. It ends the connection.
+func (p *TCP4ServerConn) Close() error {
+	p.ended.Store(true)
+	return p.conn.Close()
+}
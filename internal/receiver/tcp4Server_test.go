@@ -0,0 +1,64 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+import (
+	"io"
+	"net"
+	"testing"
+	"time"
+
+	"github.com/tj/assert"
+)
+
+// TestTCP4ServerShortClient checks, that a client sending less bytes than an announcement does not block Name
+// and that its bytes stay readable.
+func TestTCP4ServerShortClient(t *testing.T) {
+	defer func(d time.Duration) { AnnouncementTimeout = d }(AnnouncementTimeout)
+	AnnouncementTimeout = 50 * time.Millisecond
+	srv, err := NewTCP4Server(io.Discard, "localhost:0")
+	assert.Nil(t, err)
+	defer srv.Close()
+	client, err := net.Dial("tcp4", srv.Addr().String())
+	assert.Nil(t, err)
+	defer client.Close()
+	_, err = client.Write([]byte{1, 2, 3})
+	assert.Nil(t, err)
+
+	c, err := srv.Accept()
+	assert.Nil(t, err)
+	defer c.Close()
+	assert.Equal(t, client.LocalAddr().String(), c.Name())
+
+	go func() {
+		time.Sleep(2 * AnnouncementTimeout) // later than the announcement timeout
+		_, _ = client.Write([]byte{4})
+	}()
+	b := make([]byte, 4)
+	n, err := io.ReadFull(c, b)
+	assert.Nil(t, err)
+	assert.Equal(t, []byte{1, 2, 3, 4}, b[:n])
+	assert.False(t, c.Ended())
+}
+
+// TestTCP4ServerAnnouncement checks, that an announcement is consumed.
+func TestTCP4ServerAnnouncement(t *testing.T) {
+	srv, err := NewTCP4Server(io.Discard, "localhost:0")
+	assert.Nil(t, err)
+	defer srv.Close()
+	client, err := net.Dial("tcp4", srv.Addr().String())
+	assert.Nil(t, err)
+	defer client.Close()
+	_, err = client.Write([]byte(DeviceAnnouncement + "board17\n\x05"))
+	assert.Nil(t, err)
+
+	c, err := srv.Accept()
+	assert.Nil(t, err)
+	defer c.Close()
+	assert.Equal(t, "board17", c.Name())
+	b := make([]byte, 1)
+	_, err = io.ReadFull(c, b)
+	assert.Nil(t, err)
+	assert.Equal(t, []byte{5}, b)
+}
@@ -0,0 +1,100 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+// Timed binary logfiles.
+//
+// A timed binary logfile starts with TimedLogMagic, followed by records. Each record is a received chunk:
+// 8 bytes host reception time in Unix nanoseconds, 4 bytes data length, both little endian, and the data.
+// Port FILE and FILEBUFFER detect the format and replay the chunks with their original timing scaled by ReplaySpeed.
+
+import (
+	"encoding/binary"
+	"io"
+	"time"
+)
+
+// TimedLogMagic starts a timed binary logfile.
+const TimedLogMagic = "TRICE-TIMED-1\n"
+
+// timedRecordHeaderSize is the byte count of a record header.
+const timedRecordHeaderSize = 12
+
+var (
+	// BinaryLogTimed enables the recording of the host reception time per read chunk in the binary logfile.
+	BinaryLogTimed bool
+
+	// ReplaySpeed is the replay speed factor for timed binary logfiles. 1 is the original speed, 0 means as fast as possible.
+	ReplaySpeed = 1.0
+)
+
+// HostTimer is implemented by inputs, which know the original host reception time, like a timed binary logfile replay.
+type HostTimer interface {
+	HostTime() (t time.Time, ok bool) // HostTime returns the reception time of the last read data and true, if known.
+}
+
+// appendTimedRecordHeader appends the record header for n data bytes received at t to b.
+func appendTimedRecordHeader(b []byte, t time.Time, n int) []byte {
+	b = binary.LittleEndian.AppendUint64(b, uint64(t.UnixNano()))
+	return binary.LittleEndian.AppendUint32(b, uint32(n))
+}
+
+// timedReader replays the records of a timed binary logfile.
+type timedReader struct {
+	r     io.Reader
+	speed float64
+	hdr   [timedRecordHeaderSize]byte
+	hn    int       // hn is the count of valid bytes in hdr.
+	left  int       // left is the count of not yet read data bytes of the actual record.
+	stamp time.Time // stamp is the reception time of the actual record.
+	first time.Time // first is the reception time of the first record.
+	start time.Time // start is the replay start time.
+	now   func() time.Time
+	sleep func(time.Duration)
+}
+
+// Read returns data of the actual record only. The first read of a record waits until its replay time.
+func (p *timedReader) Read(b []byte) (n int, err error) {
+	for p.left == 0 {
+		n, err = p.r.Read(p.hdr[p.hn:])
+		p.hn += n
+		if p.hn < timedRecordHeaderSize {
+			return 0, err // no complete header yet
+		}
+		p.hn = 0
+		p.stamp = time.Unix(0, int64(binary.LittleEndian.Uint64(p.hdr[:8])))
+		p.left = int(binary.LittleEndian.Uint32(p.hdr[8:]))
+		p.wait()
+	}
+	if len(b) > p.left {
+		b = b[:p.left]
+	}
+	n, err = p.r.Read(b)
+	p.left -= n
+	if err == io.EOF && n > 0 {
+		err = nil
+	}
+	return
+}
+
+// wait sleeps until the replay time of the actual record.
+func (p *timedReader) wait() {
+	if p.first.IsZero() {
+		p.first = p.stamp
+		p.start = p.now()
+		return
+	}
+	if p.speed <= 0 {
+		return
+	}
+	due := p.start.Add(time.Duration(float64(p.stamp.Sub(p.first)) / p.speed))
+	if d := due.Sub(p.now()); d > 0 {
+		p.sleep(d)
+	}
+}
+
+// HostTime returns the original reception time of the actual record.
+func (p *timedReader) HostTime() (time.Time, bool) {
+	return p.stamp, !p.first.IsZero()
+}
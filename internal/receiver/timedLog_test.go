@@ -0,0 +1,107 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package receiver
+
+import (
+	"io"
+	"os"
+	"testing"
+	"time"
+
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// TestTimedCaptureReplay captures a stream with known timing into a timed binary logfile and replays it
+// with different speeds. It checks the chunks, the original reception times and the replayed inter-arrival times.
+// Capture and replay use a test clock, so the checks are exact and do not depend on the scheduling.
+func TestTimedCaptureReplay(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	setBinaryLog(t, "timed.bin", "off", false)
+	BinaryLogTimed = true
+	chunks := [][]byte{{1, 2, 3}, {4, 5}, {6, 7, 8, 9}, {10}}
+	gaps := []time.Duration{0, 40 * time.Millisecond, 80 * time.Millisecond, 20 * time.Millisecond}
+	clock := &testClock{t: time.Date(2026, 1, 2, 3, 4, 5, 6000, time.UTC)}
+
+	// capture
+	rc := NewBinaryLogger(io.Discard, fSys, &slowReader{chunks: append([][]byte{}, chunks...), delays: append([]time.Duration{}, gaps...), clock: clock})
+	rc.(*binaryLogger).w.now = clock.Now
+	b := make([]byte, 100)
+	received := make([]time.Time, len(chunks))
+	for i := range chunks {
+		n, err := rc.Read(b)
+		received[i] = clock.Now()
+		assert.Nil(t, err)
+		assert.Equal(t, chunks[i], b[:n])
+	}
+	assert.Nil(t, rc.Close())
+
+	// replay
+	for _, speed := range []float64{1, 4, 0} {
+		ReplaySpeed = speed
+		rc, err := NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", "timed.bin")
+		assert.Nil(t, err)
+		rc.(*file).timed.now = clock.Now
+		rc.(*file).timed.sleep = clock.Add
+		var stamps, arrivals []time.Time
+		for {
+			n, err := rc.Read(b)
+			if err == io.EOF {
+				break
+			}
+			assert.Nil(t, err)
+			i := len(stamps)
+			assert.Equal(t, chunks[i], b[:n], speed)
+			stamp, ok := rc.(HostTimer).HostTime()
+			assert.True(t, ok)
+			assert.True(t, stamp.Equal(received[i]), speed, i, stamp, received[i])
+			stamps = append(stamps, stamp)
+			arrivals = append(arrivals, clock.Now())
+		}
+		assert.True(t, rc.(Ender).Ended())
+		assert.Nil(t, rc.Close())
+		assert.Equal(t, len(chunks), len(stamps))
+		for i := 1; i < len(stamps); i++ {
+			replayed := arrivals[i].Sub(arrivals[0])
+			if speed == 0 {
+				assert.Equal(t, time.Duration(0), replayed)
+				continue
+			}
+			assert.Equal(t, time.Duration(float64(stamps[i].Sub(stamps[0]))/speed), replayed, speed, i)
+		}
+	}
+}
+
+// TestTimedReplayFollow checks, that a followed timed binary logfile does not end and reads records appended later.
+func TestTimedReplayFollow(t *testing.T) {
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	setBinaryLog(t, "timed.bin", "off", false)
+	ReplaySpeed = 0
+	stamp := time.Date(2026, 1, 2, 3, 4, 5, 6000, time.UTC)
+	data := append([]byte(TimedLogMagic), appendTimedRecordHeader(nil, stamp, 2)...)
+	assert.Nil(t, fSys.WriteFile("timed.bin", append(data, 7, 8), 0644))
+	rc, err := NewReadWriteCloser(io.Discard, fSys, false, "FILE", "timed.bin")
+	assert.Nil(t, err)
+	defer rc.Close()
+	b, err := io.ReadAll(io.LimitReader(rc, 2))
+	assert.Nil(t, err)
+	assert.Equal(t, []byte{7, 8}, b)
+	_, err = rc.Read(b)
+	assert.Equal(t, io.EOF, err)
+	assert.False(t, rc.(Ender).Ended())
+	h, ok := rc.(HostTimer).HostTime()
+	assert.True(t, ok)
+	assert.True(t, stamp.Equal(h))
+
+	f, err := fSys.OpenFile("timed.bin", os.O_WRONLY|os.O_APPEND, 0644)
+	assert.Nil(t, err)
+	_, err = f.Write(append(appendTimedRecordHeader(nil, stamp.Add(time.Second), 1), 9))
+	assert.Nil(t, err)
+	assert.Nil(t, f.Close())
+	n, err := rc.Read(b)
+	assert.Nil(t, err)
+	assert.Equal(t, []byte{9}, b[:n])
+	h, _ = rc.(HostTimer).HostTime()
+	assert.True(t, stamp.Add(time.Second).Equal(h))
+}
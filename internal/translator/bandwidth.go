@@ -0,0 +1,373 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"encoding/csv"
+	"fmt"
+	"io"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/rokath/trice/internal/decoder"
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/rokath/trice/internal/trexDecoder"
+	"github.com/spf13/afero"
+)
+
+var (
+	// BandwidthCSV is the CSV file name for the bandwidth report or "off".
+	BandwidthCSV = "off"
+
+	// BandwidthInterval is the time window for the peak rates of the bandwidth report.
+	BandwidthInterval = time.Second
+
+	// BandwidthStampUnit is the unit of the 32-bit target stamps, "us" or "ms". It is used for the rates, if the logfile has no host timestamps.
+	BandwidthStampUnit = "us"
+
+	// BandwidthTrace is the CSV file name for the trice sequence or "off". Its rows are the input of the target buffer simulation in _test.
+	BandwidthTrace = "off"
+)
+
+// bandwidthTraceHeader are the column names of the trice sequence.
+// time_us is the target time since the first 32-bit stamp. Without 32-bit stamps it is the host reception time since the first trice.
+var bandwidthTraceHeader = []string{"time_us", "id", "stampSize", "params"}
+
+// bandwidthCost is the link usage of one ID, one channel or of the not assignable bytes.
+type bandwidthCost struct {
+	level   string // level is "id", "channel", "other" or "total".
+	name    string
+	channel string
+	typ     string
+	format  string
+	trices  int
+	bytes   int     // bytes are the trice bytes including stamp, but without framing.
+	framed  float64 // framed are the bytes including the package share of the framing, padding and encryption.
+	parent  *bandwidthCost
+	window  int64   // window is the index of the actual BandwidthInterval.
+	inWin   float64 // inWin are the framed bytes inside window.
+	peakWin float64 // peakWin are the framed bytes of the busiest window.
+}
+
+// add counts framed bytes at window w and updates the peak window.
+func (p *bandwidthCost) add(framed float64, w int64) {
+	for c := p; c != nil; c = c.parent {
+		c.framed += framed
+		if w != c.window {
+			c.window, c.inWin = w, 0
+		}
+		c.inWin += framed
+		if c.inWin > c.peakWin {
+			c.peakWin = c.inWin
+		}
+	}
+}
+
+// bandwidthTrice is an exported trice waiting for the framing share of its package.
+type bandwidthTrice struct {
+	cost   *bandwidthCost
+	size   int
+	window int64
+}
+
+// bandwidthAccount is the Exporter collecting the bandwidth costs of all decoded trices.
+type bandwidthAccount struct {
+	mu       sync.Mutex // mu protects the counters against a report during an Export.
+	lut      id.TriceIDLookUp
+	m        *sync.RWMutex
+	ids      map[id.TriceID]*bandwidthCost
+	channels map[string]*bandwidthCost
+	trices   int
+
+	pkgSize int              // pkgSize is the framed size of the actual package or 0 without package framing.
+	pending []bandwidthTrice // pending are the trices of the actual package.
+
+	host     receiver.HostTimer // host gives the reception times of timed logfiles. Without them the 32-bit target stamps are used.
+	unit     time.Duration      // unit is the duration of one 32-bit target stamp tick.
+	first    uint64             // first is the first 32-bit target stamp.
+	last     uint64             // last is the last 32-bit target stamp.
+	wraps    uint64             // wraps counts the 32-bit target stamp overflows.
+	stamped  bool               // stamped is true, when at least one 32-bit target stamp was decoded.
+	target   time.Duration      // target is the time of the last 32-bit target stamp since the first one.
+	timed    bool               // timed is true, when at least one time was known.
+	now      time.Duration      // now is the time of the last trice since the epoch of its source.
+	from, to time.Duration      // from and to are the times of the first and the last trice.
+
+	trace *csv.Writer // trace, if not nil, gets a row for each trice.
+}
+
+// newBandwidthAccount returns an accountant for the trices of lut. If host is not nil, its reception times are used.
+func newBandwidthAccount(lut id.TriceIDLookUp, m *sync.RWMutex, host receiver.HostTimer) *bandwidthAccount {
+	p := &bandwidthAccount{lut: lut, m: m, ids: make(map[id.TriceID]*bandwidthCost), channels: make(map[string]*bandwidthCost), host: host, unit: time.Microsecond}
+	if BandwidthStampUnit == "ms" {
+		p.unit = time.Millisecond
+	}
+	return p
+}
+
+// ExportPackage assigns the framing share of the previous package and starts a new one.
+func (p *bandwidthAccount) ExportPackage(size int) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.flush()
+	p.pkgSize = size
+}
+
+// flush assigns the package size proportionally to the sizes of its trices.
+func (p *bandwidthAccount) flush() {
+	var sum int
+	for _, t := range p.pending {
+		sum += t.size
+	}
+	if sum > 0 && p.pkgSize > sum {
+		scale := float64(p.pkgSize) / float64(sum)
+		for _, t := range p.pending {
+			t.cost.add(float64(t.size)*scale, t.window)
+		}
+	} else {
+		for _, t := range p.pending {
+			t.cost.add(float64(t.size), t.window)
+		}
+	}
+	p.pending, p.pkgSize = p.pending[:0], 0
+}
+
+// Export counts a decoded trice.
+func (p *bandwidthAccount) Export(tid id.TriceID, stamp uint64, stampSize int, params []byte) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.trices++
+	c := p.ids[tid]
+	if c == nil {
+		p.m.RLock()
+		tf := p.lut[tid]
+		p.m.RUnlock()
+		ch := emitter.Channel(tf.Strg)
+		if ch == "" {
+			ch = "none"
+		}
+		if p.channels[ch] == nil {
+			p.channels[ch] = &bandwidthCost{level: "channel", name: ch, channel: ch, window: -1}
+		}
+		c = &bandwidthCost{level: "id", name: strconv.Itoa(int(tid)), channel: ch, typ: tf.Type, format: tf.Strg, parent: p.channels[ch], window: -1}
+		p.ids[tid] = c
+	}
+	size := 4 + stampSize + len(params) // ID, stamp, count and cycle, parameters
+	if stampSize == 2 && trexDecoder.Doubled16BitID {
+		size += 2
+	}
+	c.trices++
+	c.bytes += size
+	for x := c.parent; x != nil; x = x.parent {
+		x.trices++
+		x.bytes += size
+	}
+	p.tick(stamp, stampSize)
+	if p.trace != nil {
+		at := p.target
+		if !p.stamped && p.timed {
+			at = p.now - p.from
+		}
+		p.trace.Write([]string{strconv.FormatInt(at.Microseconds(), 10), strconv.Itoa(int(tid)), strconv.Itoa(stampSize), strconv.Itoa(len(params))})
+	}
+	t := bandwidthTrice{c, size, int64(p.now / BandwidthInterval)}
+	if p.pkgSize == 0 { // no package framing
+		t.cost.add(float64(size), t.window)
+		return
+	}
+	p.pending = append(p.pending, t)
+}
+
+// tick updates the target time from a 32-bit target stamp and the actual time from the host reception time or from the target time.
+// 16-bit stamps overflow too fast and their trices get the time of the previous 32-bit stamp.
+func (p *bandwidthAccount) tick(stamp uint64, stampSize int) {
+	if stampSize == 4 {
+		if !p.stamped {
+			p.stamped, p.first, p.last = true, stamp, stamp
+		}
+		if stamp < p.last && p.last-stamp > 1<<31 {
+			p.wraps++
+		}
+		p.last = stamp
+		p.target = time.Duration(int64(p.wraps<<32+stamp)-int64(p.first)) * p.unit
+	}
+	if p.host != nil {
+		if t, ok := p.host.HostTime(); ok {
+			p.setNow(time.Duration(t.UnixNano()))
+			return
+		}
+	}
+	if p.stamped {
+		p.setNow(p.target)
+	}
+}
+
+// setNow sets the actual time to t.
+func (p *bandwidthAccount) setNow(t time.Duration) {
+	if !p.timed {
+		p.timed, p.from = true, t
+	}
+	p.now, p.to = t, t
+}
+
+// decoded returns the count of decoded trices.
+func (p *bandwidthAccount) decoded() int {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.trices
+}
+
+// costs returns the ID and channel costs sorted by framed bytes and the totals. total are the received bytes.
+func (p *bandwidthAccount) costs(total int) (ids, channels []*bandwidthCost, other, all *bandwidthCost) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.flush()
+	all = &bandwidthCost{level: "total", name: "total", trices: p.trices, framed: float64(total)}
+	other = &bandwidthCost{level: "other", name: "other", format: "unknown IDs, corrupted data, padding zeroes"}
+	for _, c := range p.ids {
+		ids = append(ids, c)
+		all.bytes += c.bytes
+		other.framed -= c.framed
+	}
+	for _, c := range p.channels {
+		channels = append(channels, c)
+	}
+	other.framed += float64(total)
+	if other.framed < 0.5 {
+		other.framed = 0
+	}
+	byCost := func(c []*bandwidthCost) {
+		sort.Slice(c, func(i, j int) bool {
+			if c[i].framed != c[j].framed {
+				return c[i].framed > c[j].framed
+			}
+			return c[i].name < c[j].name
+		})
+	}
+	byCost(ids)
+	byCost(channels)
+	return
+}
+
+// bandwidthRow returns the report values of c.
+func bandwidthRow(c *bandwidthCost, total float64, seconds float64) []string {
+	r := []string{c.level, c.name, c.channel, c.typ, c.format, strconv.Itoa(c.trices), strconv.Itoa(c.bytes), "", fmt.Sprintf("%.0f", c.framed), "", "", "", ""}
+	if c.trices > 0 && c.bytes > 0 {
+		r[7] = fmt.Sprintf("%.1f", float64(c.bytes)/float64(c.trices))
+	}
+	if total > 0 {
+		r[9] = fmt.Sprintf("%.2f", 100*c.framed/total)
+	}
+	if seconds > 0 {
+		r[10] = fmt.Sprintf("%.1f", float64(c.trices)/seconds)
+		r[11] = fmt.Sprintf("%.1f", c.framed/seconds)
+		if c.level != "other" && c.level != "total" {
+			r[12] = fmt.Sprintf("%.1f", c.peakWin/BandwidthInterval.Seconds())
+		}
+	}
+	return r
+}
+
+// bandwidthHeader are the column names of the bandwidth report.
+var bandwidthHeader = []string{"level", "name", "channel", "type", "format", "trices", "bytes", "avgBytes", "framedBytes", "share%", "trices/s", "bytes/s", "peakBytes/s"}
+
+// report writes the bandwidth table into w and, if BandwidthCSV is not "off", the CSV file.
+func (p *bandwidthAccount) report(w io.Writer, fSys *afero.Afero, total int) error {
+	ids, channels, other, all := p.costs(total)
+	var seconds float64
+	if p.timed && p.to > p.from {
+		seconds = (p.to - p.from).Seconds()
+	}
+	var rows [][]string
+	for _, c := range ids {
+		rows = append(rows, bandwidthRow(c, float64(total), seconds))
+	}
+	for _, c := range channels {
+		rows = append(rows, bandwidthRow(c, float64(total), seconds))
+	}
+	rows = append(rows, bandwidthRow(other, float64(total), seconds), bandwidthRow(all, float64(total), seconds))
+
+	fmt.Fprintf(w, "%-7s %8s %-8s %10s %12s %8s %12s %7s %10s %11s %11s  %s\n", "level", "name", "channel", "trices", "bytes", "avg", "framed", "share%", "trices/s", "bytes/s", "peak B/s", "format")
+	for _, r := range rows {
+		format := r[4]
+		if len(format) > 40 {
+			format = format[:37] + "..."
+		}
+		fmt.Fprintf(w, "%-7s %8s %-8s %10s %12s %8s %12s %7s %10s %11s %11s  %s\n", r[0], r[1], r[2], r[5], r[6], r[7], r[8], r[9], r[10], r[11], r[12], format)
+	}
+	if seconds == 0 {
+		fmt.Fprintln(w, "No rates, because the logfile has neither host timestamps nor 32-bit target stamps.")
+	} else {
+		fmt.Fprintf(w, "Rates over %v, peak rates in %v windows.\n", (p.to - p.from).Round(time.Millisecond), BandwidthInterval)
+	}
+
+	if BandwidthCSV == "off" || BandwidthCSV == "none" {
+		return nil
+	}
+	fh, err := fSys.Create(BandwidthCSV)
+	if err != nil {
+		return err
+	}
+	cw := csv.NewWriter(fh)
+	cw.Write(bandwidthHeader)
+	cw.WriteAll(rows) // flushes
+	if err = cw.Error(); err != nil {
+		fh.Close()
+		return err
+	}
+	return fh.Close()
+}
+
+// Bandwidth decodes rwc without formatting and writes the bandwidth cost of each ID and channel into w and optionally into BandwidthCSV.
+// If BandwidthTrace is not "off", the trice sequence is written into it as well.
+//
+// The framed size of each package is distributed on its trices proportionally to their sizes. Bytes not belonging to
+// a decoded trice, like unknown IDs, corrupted packages and padding without package framing, are reported as "other".
+// Only the TREX encoding is supported. Bandwidth returns io.EOF, when the input ended and the report was written.
+func Bandwidth(w io.Writer, fSys *afero.Afero, lut id.TriceIDLookUp, m *sync.RWMutex, rwc io.ReadWriteCloser) error {
+	if strings.ToUpper(Encoding) != "TREX" {
+		return fmt.Errorf("bandwidth needs the TREX encoding and not %s", Encoding)
+	}
+	if BandwidthInterval <= 0 {
+		return fmt.Errorf("invalid interval %v", BandwidthInterval)
+	}
+	h, _ := receiver.Source(rwc).(receiver.HostTimer)
+	x := newBandwidthAccount(lut, m, h)
+	var traceFile afero.File
+	if BandwidthTrace != "off" && BandwidthTrace != "none" {
+		fh, err := fSys.Create(BandwidthTrace)
+		if err != nil {
+			return err
+		}
+		traceFile = fh
+		x.trace = csv.NewWriter(fh)
+		x.trace.Write(bandwidthTraceHeader)
+	}
+	dec := newDecoder(w, lut, m, nil, rwc)
+	dec.(interface{ SetExporter(decoder.Exporter) }).SetExporter(x)
+	received := trexDecoder.Counters.Bytes.Load()
+	err := exportLoop(w, dec, x, receiver.Port, endedFunc(rwc))
+	if e := x.report(w, fSys, int(trexDecoder.Counters.Bytes.Load()-received)); e != nil {
+		if traceFile != nil {
+			traceFile.Close()
+		}
+		return e
+	}
+	if traceFile != nil {
+		x.trace.Flush()
+		if e := x.trace.Error(); e != nil {
+			traceFile.Close()
+			return e
+		}
+		if e := traceFile.Close(); e != nil {
+			return e
+		}
+	}
+	return err
+}
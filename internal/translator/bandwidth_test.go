@@ -0,0 +1,111 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"bytes"
+	"encoding/csv"
+	"io"
+	"math"
+	"strconv"
+	"strings"
+	"testing"
+
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// TestBandwidth checks, that the bandwidth report of generated logfiles accounts all trices and bytes.
+func TestBandwidth(t *testing.T) {
+	lut, m := loadTestTil(t)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	for _, v := range streamVariants() {
+		s := setupStream(t, fSys, "trice.bin", lut, v, 64<<10)
+		var out bytes.Buffer
+		rwc, err := receiver.NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", s.fn)
+		assert.Nil(t, err)
+		costCSV, traceCSV := BandwidthCSV, BandwidthTrace
+		BandwidthCSV, BandwidthTrace = "cost.csv", "trace.csv"
+		assert.Equal(t, io.EOF, Bandwidth(&out, fSys, lut, m, rwc), v.name)
+		BandwidthCSV, BandwidthTrace = costCSV, traceCSV
+		rwc.Close()
+		b, err := fSys.ReadFile("cost.csv")
+		assert.Nil(t, err)
+		records, err := csv.NewReader(bytes.NewReader(b)).ReadAll()
+		assert.Nil(t, err)
+		assert.Equal(t, bandwidthHeader, records[0])
+
+		sums := make(map[string]float64) // framed bytes per level
+		trices := make(map[string]int)
+		var last float64 = math.MaxFloat64
+		for _, r := range records[1:] {
+			framed, err := strconv.ParseFloat(r[8], 64)
+			assert.Nil(t, err)
+			n, _ := strconv.Atoi(r[5])
+			sums[r[0]] += framed
+			trices[r[0]] += n
+			if r[0] == "id" {
+				assert.True(t, framed <= last, v.name, "sorted by cost")
+				last = framed
+				assert.NotEqual(t, "", r[11], v.name, "rates from 32-bit stamps")
+			}
+		}
+		assert.Equal(t, s.trices, trices["id"], v.name)
+		assert.Equal(t, s.trices, trices["channel"], v.name)
+		assert.Equal(t, s.trices, trices["total"], v.name)
+		assert.Equal(t, float64(s.size), sums["total"], v.name)
+		assert.True(t, math.Abs(sums["id"]-sums["channel"]) < float64(len(records)), v.name)
+		assert.True(t, math.Abs(sums["id"]+sums["other"]-float64(s.size)) < float64(len(records)), v.name, sums)
+		if !strings.HasPrefix(v.name, "NONE") { // without framing the padding is not assignable
+			assert.True(t, sums["other"] < 8, v.name, sums["other"])
+		}
+		assert.True(t, strings.Contains(out.String(), "Rates over "), out.String())
+
+		b, err = fSys.ReadFile("trace.csv")
+		assert.Nil(t, err)
+		records, err = csv.NewReader(bytes.NewReader(b)).ReadAll()
+		assert.Nil(t, err)
+		assert.Equal(t, bandwidthTraceHeader, records[0])
+		assert.Equal(t, s.trices, len(records)-1, v.name)
+		var params int
+		for _, r := range records[1:] {
+			us, err := strconv.ParseInt(r[0], 10, 64)
+			assert.Nil(t, err)
+			assert.True(t, us >= 0, v.name, r)
+			n, _ := strconv.Atoi(r[3])
+			params += n
+		}
+		assert.True(t, params > 0, v.name)
+	}
+}
+
+// BenchmarkBandwidth compares the bandwidth report with the full text decoding of the same -captureMB logfile.
+func BenchmarkBandwidth(b *testing.B) {
+	lut, m := loadTestTil(b)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	for _, v := range []streamVariant{streamVariants()[1], streamVariants()[2]} { // COBS/single/xtea and COBS/multi
+		v := v
+		b.Run(v.name+"/bandwidth", func(b *testing.B) {
+			s := setupStream(b, fSys, "trice.bin", lut, v, *captureMB<<20)
+			b.SetBytes(int64(s.size))
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				rwc, err := receiver.NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", s.fn)
+				assert.Nil(b, err)
+				assert.Equal(b, io.EOF, Bandwidth(io.Discard, fSys, lut, m, rwc))
+				rwc.Close()
+			}
+		})
+		b.Run(v.name+"/log", func(b *testing.B) {
+			s := setupStream(b, fSys, "trice.bin", lut, v, *captureMB<<20)
+			var h latencyHistogram
+			b.SetBytes(int64(s.size))
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				decodeStream(b, fSys, s, lut, m, nil, &h)
+			}
+		})
+	}
+}
@@ -0,0 +1,259 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"fmt"
+	"io"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/rokath/trice/internal/decoder"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/rokath/trice/pkg/columnar"
+	"github.com/spf13/afero"
+)
+
+// ExportFileName is the columnar export file name or "off".
+var ExportFileName = "off"
+
+// NewColumnSchema derives the column groups from the trice ID list lut.
+// Only trices with numeric parameters or without parameters get a column group. Strings and buffers are not exported.
+func NewColumnSchema(lut id.TriceIDLookUp) (s columnar.Schema) {
+	for tid, tf := range lut {
+		if g, ok := columnGroup(tid, tf); ok {
+			s.Groups = append(s.Groups, g)
+		}
+	}
+	sort.Slice(s.Groups, func(i, j int) bool { return s.Groups[i].ID < s.Groups[j].ID })
+	return
+}
+
+// columnGroup returns the column group for tf, if it has only numeric parameters.
+// The trice type is reconstructed the same way as the TREX decoder does it.
+func columnGroup(tid id.TriceID, tf id.TriceFmt) (g columnar.Group, ok bool) {
+	typ := strings.TrimSuffix(strings.TrimSuffix(tf.Type, "AssertTrue"), "AssertFalse")
+	typ = strings.TrimSuffix(strings.TrimSuffix(typ, "SpanEnter"), "SpanExit")
+	if len(typ) < 5 || strings.ToUpper(typ[:5]) != "TRICE" {
+		return
+	}
+	name, rest := typ[:5], typ[5:]
+	_, u := decoder.UReplaceN(tf.Strg)
+	bits, count := id.DefaultTriceBitWidth, len(u)
+	if i := strings.IndexByte(rest, '_'); i >= 0 {
+		n, err := strconv.Atoi(rest[i+1:])
+		if err != nil { // like TRICE_S or TRICE8_B
+			return
+		}
+		count, rest = n, rest[:i]
+	}
+	if rest != "" {
+		bits = rest
+	}
+	if bits == "0" && count == 0 {
+		bits = "8" // TRICE0, no parameters anyway
+	}
+	if count != len(u) || count > 12 {
+		return
+	}
+	switch bits {
+	case "8", "16", "32", "64":
+	default:
+		return
+	}
+	g = columnar.Group{ID: uint16(tid), Type: tf.Type, Format: tf.Strg, Columns: make([]columnar.Column, count)}
+	switch name {
+	case "trice":
+	case "Trice":
+		g.Stamp = "u16"
+	default: // TRice has 32-bit stamps and TRICE 0, 16 or 32-bit stamps, depending on the id() variant.
+		g.Stamp = "u32"
+	}
+	for i, f := range u {
+		var kind string
+		switch f {
+		case decoder.UnsignedFormatSpecifier, decoder.PointerFormatSpecifier:
+			kind = "u"
+		case decoder.SignedFormatSpecifier:
+			kind = "i"
+		case decoder.FloatFormatSpecifier:
+			kind = "f"
+		case decoder.BooleanFormatSpecifier:
+			kind = "b"
+		}
+		g.Columns[i] = columnar.Column{Name: fmt.Sprintf("p%d", i), Type: columnar.Type(kind + bits)}
+		if g.Columns[i].Type.Size() == 0 { // like an 8-bit float
+			return g, false
+		}
+	}
+	return g, true
+}
+
+// columnExporter writes the parameters of the decoded trices into a columnar file.
+type columnExporter struct {
+	mu        sync.Mutex // mu protects the writer against a Close during an Export.
+	w         io.Writer
+	fn        string
+	fh        afero.File
+	cw        *columnar.Writer
+	sizes     map[id.TriceID][]int // sizes are the column sizes of each exported ID.
+	bigEndian bool
+	match     func(id uint16, stamp uint64, stampSize int) bool
+	row       []byte // row is the byte swapped parameter buffer for big endian targets.
+	err       error
+	closed    bool
+
+	trices   int // trices is the count of all decoded trices.
+	rows     int // rows is the count of exported trices.
+	skipped  int // skipped is the count of trices without column group or with an unexpected parameter size.
+	filtered int // filtered is the count of trices not matching the index query.
+}
+
+// newColumnExporter creates fn and writes the schema s into it.
+func newColumnExporter(w io.Writer, fSys *afero.Afero, fn string, s columnar.Schema, bigEndian bool, match func(id uint16, stamp uint64, stampSize int) bool) (*columnExporter, error) {
+	fh, err := fSys.Create(fn)
+	if err != nil {
+		return nil, err
+	}
+	cw, err := columnar.NewWriter(fh, s)
+	if err != nil {
+		fh.Close()
+		return nil, err
+	}
+	p := &columnExporter{w: w, fn: fn, fh: fh, cw: cw, sizes: make(map[id.TriceID][]int, len(s.Groups)), bigEndian: bigEndian, match: match}
+	for _, g := range s.Groups {
+		sizes := make([]int, len(g.Columns))
+		for i, c := range g.Columns {
+			sizes[i] = c.Type.Size()
+		}
+		p.sizes[id.TriceID(g.ID)] = sizes
+	}
+	return p, nil
+}
+
+// Export appends the trice parameters as row to the column group of tid.
+func (p *columnExporter) Export(tid id.TriceID, stamp uint64, stampSize int, params []byte) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.trices++
+	if p.closed || p.err != nil {
+		return
+	}
+	if p.match != nil && !p.match(uint16(tid), stamp, stampSize) {
+		p.filtered++
+		return
+	}
+	sizes, ok := p.sizes[tid]
+	var rowSize int
+	for _, size := range sizes {
+		rowSize += size
+	}
+	if !ok || rowSize != len(params) {
+		p.skipped++
+		return
+	}
+	if p.bigEndian {
+		p.row = p.row[:0]
+		for _, size := range sizes {
+			for i := size - 1; i >= 0; i-- {
+				p.row = append(p.row, params[i])
+			}
+			params = params[size:]
+		}
+		params = p.row
+	}
+	p.err = p.cw.Append(uint16(tid), stamp, params)
+	p.rows++
+}
+
+// Close writes the buffered rows and closes the file.
+func (p *columnExporter) Close() error {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	if p.closed {
+		return p.err
+	}
+	p.closed = true
+	if err := p.cw.Flush(); p.err == nil {
+		p.err = err
+	}
+	if err := p.fh.Close(); p.err == nil {
+		p.err = err
+	}
+	fmt.Fprintln(p.w, "exported", p.rows, "of", p.trices, "trices into", p.fn, "- skipped", p.skipped, "not numeric and", p.filtered, "not queried trices")
+	return p.err
+}
+
+// decoded returns the count of decoded trices.
+func (p *columnExporter) decoded() int {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.trices
+}
+
+// Export decodes rwc like Translate, but writes the numeric trice parameters into the columnar file fn instead of trice lines.
+//
+// The schema is derived from lut. Decoder messages, like cycle errors, are written to w.
+// Only the TREX encoding is supported. Export returns io.EOF, when the input ended and fn was written.
+func Export(w io.Writer, fSys *afero.Afero, lut id.TriceIDLookUp, m *sync.RWMutex, rwc io.ReadWriteCloser, fn string) error {
+	if strings.ToUpper(Encoding) != "TREX" {
+		return fmt.Errorf("export needs the TREX encoding and not %s", Encoding)
+	}
+	m.RLock()
+	s := NewColumnSchema(lut)
+	m.RUnlock()
+	x, err := newColumnExporter(w, fSys, fn, s, TriceEndianness == "bigEndian", matchFunc(rwc))
+	if err != nil {
+		return err
+	}
+	dec := newDecoder(w, lut, m, nil, rwc)
+	dec.(interface{ SetExporter(decoder.Exporter) }).SetExporter(x)
+	done := make(chan struct{})
+	defer close(done)
+	go handleSIGTERM(w, multiCloser{rwc, x}, done)
+	err = exportLoop(w, dec, x, receiver.Port, endedFunc(rwc))
+	if e := x.Close(); e != nil {
+		return e
+	}
+	return err
+}
+
+// exportLoop reads from dec until the input ended. Only decoder messages are returned by dec, so the progress is
+// detected with the decoded trices count of the exporter x.
+func exportLoop(w io.Writer, dec decoder.Decoder, x interface{ decoded() int }, port string, ended func() bool) error {
+	b := make([]byte, decoder.DefaultSize)
+	start := time.Now()
+	sleepCounter := 0
+	for {
+		trices := x.decoded()
+		n, err := dec.Read(b)
+		if err != nil && err != io.EOF {
+			return err
+		}
+		if n > 0 {
+			if _, err := w.Write(b[:n]); err != nil {
+				return err
+			}
+		}
+		if n > 0 || x.decoded() != trices {
+			sleepCounter = 0
+			continue
+		}
+		if ended != nil && ended() {
+			return io.EOF
+		}
+		if ended == nil && predefinedBuffer(port) && time.Since(start) > 100*time.Millisecond {
+			return io.EOF
+		}
+		sleepCounter++
+		if sleepCounter > 100 {
+			time.Sleep(100 * time.Millisecond)
+			sleepCounter = 0
+		}
+	}
+}
@@ -0,0 +1,170 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"encoding/binary"
+	"io"
+	"math"
+	"path/filepath"
+	"sync"
+	"testing"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/rokath/trice/pkg/columnar"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// exportTestLut contains numeric trices of all bit widths and stamp sizes, a string and a trice without parameters.
+var exportTestLut = map[id.TriceID]id.TriceFmt{
+	1000: {Type: "TRice8", Strg: "msg:%d %u\\n"},
+	1001: {Type: "Trice16", Strg: "msg:%d %t\\n"},
+	1002: {Type: "trice32", Strg: "msg:%f %u\\n"},
+	1003: {Type: "TRice64", Strg: "msg:%d %g\\n"},
+	1004: {Type: "TRice_S", Strg: "msg:%s\\n"},
+	1005: {Type: "trice", Strg: "msg:tick\\n"},
+	1006: {Type: "TRICE16_2", Strg: "msg:%d %x\\n"},
+}
+
+// writeExportCapture writes count packages with the exportTestLut trices in target order o into w.
+func writeExportCapture(w io.Writer, o binary.AppendByteOrder, count int) {
+	frame := make([]byte, 256)
+	cycle := uint8(0xc0)
+	trice := func(pkg []byte, tid uint16, stampSize int, stamp uint32, params []byte) []byte {
+		switch stampSize {
+		case 0:
+			pkg = o.AppendUint16(pkg, 1<<14|tid)
+		case 2:
+			pkg = o.AppendUint16(o.AppendUint16(pkg, 2<<14|tid), uint16(stamp))
+		case 4:
+			pkg = o.AppendUint32(o.AppendUint16(pkg, 3<<14|tid), stamp)
+		}
+		pkg = o.AppendUint16(pkg, uint16(len(params))<<8|uint16(cycle))
+		if cycle++; cycle == 0 {
+			cycle = 0xc0
+		}
+		return append(pkg, params...)
+	}
+	for i := 0; i < count; i++ {
+		var pkg []byte
+		switch i % 6 {
+		case 0:
+			pkg = trice(pkg, 1000, 4, uint32(i), []byte{byte(-i), byte(i)})
+		case 1:
+			pkg = trice(pkg, 1001, 2, uint32(i), o.AppendUint16(o.AppendUint16(nil, uint16(-i)), uint16(i&1)))
+		case 2:
+			pkg = trice(pkg, 1002, 0, 0, o.AppendUint32(o.AppendUint32(nil, math.Float32bits(float32(i)/8)), uint32(i)))
+		case 3:
+			pkg = trice(pkg, 1003, 4, uint32(i), o.AppendUint64(o.AppendUint64(nil, uint64(-int64(i)<<40)), math.Float64bits(float64(i)/3)))
+		case 4:
+			pkg = trice(pkg, 1004, 4, uint32(i), []byte("text"))
+			pkg = trice(pkg, 1005, 0, 0, nil)
+		case 5:
+			pkg = trice(pkg, 1006, 2, uint32(i), o.AppendUint16(o.AppendUint16(nil, uint16(-i)), uint16(i)))
+		}
+		n := cobs.Encode(frame, pkg)
+		frame[n] = 0
+		w.Write(frame[:n+1])
+	}
+}
+
+// exportFile exports the binary logfile fn into the columnar file out and reads it back.
+func exportFile(t testing.TB, fSys *afero.Afero, fn, out string, ilu id.TriceIDLookUp, m *sync.RWMutex) (columnar.Schema, map[uint16]*columnar.Chunk) {
+	rwc, err := receiver.NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", fn)
+	assert.Nil(t, err)
+	defer rwc.Close()
+	assert.Equal(t, io.EOF, Export(io.Discard, fSys, ilu, m, rwc, out))
+	fh, err := fSys.Open(out)
+	assert.Nil(t, err)
+	defer fh.Close()
+	s, all, err := columnar.ReadAll(fh)
+	assert.Nil(t, err)
+	return s, all
+}
+
+// TestExportRoundTrip checks, that the exported values are the target values for both target endianness.
+func TestExportRoundTrip(t *testing.T) {
+	for _, o := range []binary.AppendByteOrder{binary.LittleEndian, binary.BigEndian} {
+		_, m := setupTestLog(t)
+		if o == binary.BigEndian {
+			TriceEndianness = "bigEndian"
+		}
+		ilu := make(id.TriceIDLookUp)
+		for k, v := range exportTestLut {
+			ilu[k] = v
+		}
+		fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+		fh, err := fSys.Create("trice.bin")
+		assert.Nil(t, err)
+		const count = 6 * 3000
+		writeExportCapture(fh, o, count)
+		fh.Close()
+
+		s, all := exportFile(t, fSys, "trice.bin", "trice.col", ilu, m)
+		assert.Equal(t, 6, len(s.Groups), "no group for the string trice")
+		assert.Equal(t, columnar.Group{ID: 1001, Type: "Trice16", Format: "msg:%d %t\\n", Stamp: "u16",
+			Columns: []columnar.Column{{Name: "p0", Type: "i16"}, {Name: "p1", Type: "b16"}}}, s.Groups[1])
+		assert.Equal(t, "", string(s.Groups[2].Stamp))
+		assert.Equal(t, columnar.Type("f32"), s.Groups[2].Columns[0].Type)
+		assert.Equal(t, 0, len(s.Groups[4].Columns))
+		assert.Nil(t, all[1004])
+		for _, tid := range []uint16{1000, 1001, 1002, 1003, 1005, 1006} {
+			assert.Equal(t, count/6, all[tid].Rows, tid)
+		}
+		for r := 0; r < count/6; r++ {
+			i := 6 * r
+			c := all[1000]
+			assert.Equal(t, uint64(i), c.Stamp(r))
+			assert.Equal(t, int8(-i), c.Value(0, r))
+			assert.Equal(t, uint8(i), c.Value(1, r))
+			c = all[1001]
+			assert.Equal(t, uint64(uint16(i+1)), c.Stamp(r))
+			assert.Equal(t, int16(-(i + 1)), c.Value(0, r))
+			assert.Equal(t, true, c.Value(1, r))
+			c = all[1002]
+			assert.Equal(t, float32(i+2)/8, c.Value(0, r))
+			assert.Equal(t, uint32(i+2), c.Value(1, r))
+			c = all[1003]
+			assert.Equal(t, uint64(i+3), c.Stamp(r))
+			assert.Equal(t, -int64(i+3)<<40, c.Value(0, r))
+			assert.Equal(t, float64(i+3)/3, c.Value(1, r))
+			c = all[1006]
+			assert.Equal(t, uint64(i+5), c.Stamp(r))
+			assert.Equal(t, int64(int16(-(i + 5))), c.Int(0, r))
+			assert.Equal(t, uint64(uint16(i+5)), c.Uint(1, r))
+		}
+	}
+}
+
+// BenchmarkExport compares the columnar export with the text output of a synthetic binary logfile of -captureMB size.
+func BenchmarkExport(b *testing.B) {
+	if testing.Short() {
+		b.Skip("big capture")
+	}
+	ilu, m := setupIndexTestLog(b)
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	dir := b.TempDir()
+	fn := filepath.Join(dir, "trice.bin")
+	fh, err := fSys.Create(fn)
+	assert.Nil(b, err)
+	size := int64(*captureMB) << 20
+	writeIndexCapture(fh, size)
+	fh.Close()
+
+	b.Run("text", func(b *testing.B) {
+		b.SetBytes(size)
+		for i := 0; i < b.N; i++ {
+			decodeLog(b, io.Discard, fSys, fn, ilu, m)
+		}
+	})
+	b.Run("columnar", func(b *testing.B) {
+		b.SetBytes(size)
+		for i := 0; i < b.N; i++ {
+			exportFile(b, fSys, fn, filepath.Join(dir, "trice.col"), ilu, m)
+		}
+	})
+}
@@ -0,0 +1,161 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"bufio"
+	"encoding/binary"
+	"flag"
+	"fmt"
+	"io"
+	"path/filepath"
+	"strings"
+	"sync"
+	"testing"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// captureMB is the synthetic capture size for BenchmarkIndexQuery, like "go test -bench IndexQuery -captureMB 4096".
+var captureMB = flag.Int("captureMB", 16, "synthetic binary logfile size in MB for BenchmarkIndexQuery")
+
+// writeIndexCapture writes COBS framed trices with 32-bit stamps seq*10 into w until size bytes are written and returns their count.
+// The IDs are 100...109, despite each 100000th trice, which has ID 200. Each 7th package contains a second trice with ID 300.
+// The cycle counter runs over all trices.
+func writeIndexCapture(w io.Writer, size int64) (count int) {
+	bw := bufio.NewWriter(w)
+	frame := make([]byte, 64)
+	cycle := uint8(0xc0)
+	trice := func(pkg []byte, tyID uint16, stamp bool, seq int, params int) []byte {
+		pkg = binary.LittleEndian.AppendUint16(pkg, tyID)
+		if stamp {
+			pkg = binary.LittleEndian.AppendUint32(pkg, uint32(seq*10))
+		}
+		pkg = binary.LittleEndian.AppendUint16(pkg, uint16(params)<<8|uint16(cycle))
+		cycle++
+		if cycle == 0 {
+			cycle = 0xc0
+		}
+		if params > 0 {
+			pkg = binary.LittleEndian.AppendUint32(pkg, uint32(seq))
+		}
+		return pkg
+	}
+	var written int64
+	pkg := make([]byte, 0, 32)
+	for seq := 0; written < size; seq++ {
+		tid := uint16(100 + seq%10)
+		if seq%100000 == 500 {
+			tid = 200
+		}
+		pkg = trice(pkg[:0], 3<<14|tid, true, seq, 4)
+		if seq%7 == 0 {
+			pkg = trice(pkg, 1<<14|300, false, seq, 0)
+		}
+		n := cobs.Encode(frame, pkg)
+		frame[n] = 0
+		bw.Write(frame[:n+1])
+		written += int64(n + 1)
+		count++
+	}
+	bw.Flush()
+	return
+}
+
+// setupIndexTestLog sets the global log options for the index tests and returns the shared look-up tables.
+func setupIndexTestLog(t testing.TB) (id.TriceIDLookUp, *sync.RWMutex) {
+	ilu, m := setupTestLog(t)
+	for i := id.TriceID(100); i < 110; i++ {
+		ilu[i] = id.TriceFmt{Type: "TRice", Strg: fmt.Sprintf("msg:id %d seq %%d\\n", i)}
+	}
+	ilu[200] = id.TriceFmt{Type: "TRice", Strg: "msg:rare seq %d\\n"}
+	ilu[300] = id.TriceFmt{Type: "trice", Strg: "msg:tick\\n"}
+	receiver.Port = "FILEBUFFER" // restored by setupTestLog
+	return ilu, m
+}
+
+// decodeLog decodes the binary logfile fn according the actual query switches.
+func decodeLog(t testing.TB, w io.Writer, fSys *afero.Afero, fn string, ilu id.TriceIDLookUp, m *sync.RWMutex) {
+	rwc, err := receiver.NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", fn)
+	assert.Nil(t, err)
+	defer rwc.Close()
+	assert.Equal(t, io.EOF, Translate(io.Discard, emitter.NewDeviceOutput(w).New("q"), ilu, m, nil, rwc))
+}
+
+// TestIndexQueryDecode checks, that index queries decode only the wanted trices without cycle errors.
+func TestIndexQueryDecode(t *testing.T) {
+	ilu, m := setupIndexTestLog(t)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	fh, err := fSys.Create("trice.bin")
+	assert.Nil(t, err)
+	count := writeIndexCapture(fh, 4<<20)
+	fh.Close()
+	_, err = receiver.BuildIndex(fSys, "trice.bin", receiver.IndexFormat{Framing: "COBS"})
+	assert.Nil(t, err)
+
+	receiver.QueryIDs = "200"
+	var out syncBuffer
+	decodeLog(t, &out, fSys, "trice.bin", ilu, m)
+	lines := strings.Split(strings.TrimSpace(out.String()), "\n")
+	assert.Equal(t, (count+99500)/100000, len(lines), out.String())
+	for i, line := range lines {
+		assert.True(t, strings.HasSuffix(line, fmt.Sprintf(" rare seq %d", 500+i*100000)), line)
+	}
+
+	receiver.QueryIDs = ""
+	receiver.QueryStamps = "1000000:1000030"
+	out = syncBuffer{}
+	decodeLog(t, &out, fSys, "trice.bin", ilu, m)
+	assert.Equal(t, "q: id 100 seq 100000 q: id 101 seq 100001 q: id 102 seq 100002 q: id 103 seq 100003", strings.Join(strings.Fields(out.String()), " "))
+
+	receiver.QueryStamps = ""
+	receiver.QueryOffset = 3 << 20
+	out = syncBuffer{}
+	decodeLog(t, &out, fSys, "trice.bin", ilu, m)
+	assert.False(t, strings.Contains(out.String(), "CYCLE"), out.String()[:200])
+	assert.True(t, strings.HasSuffix(out.String(), fmt.Sprintf("seq %d\n", count-1)))
+}
+
+// BenchmarkIndexQuery compares index queries with the full decoding of a synthetic binary logfile of -captureMB size.
+func BenchmarkIndexQuery(b *testing.B) {
+	if testing.Short() {
+		b.Skip("big capture")
+	}
+	ilu, m := setupIndexTestLog(b)
+	fSys := &afero.Afero{Fs: afero.NewOsFs()}
+	fn := filepath.Join(b.TempDir(), "trice.bin")
+	fh, err := fSys.Create(fn)
+	assert.Nil(b, err)
+	size := int64(*captureMB) << 20
+	count := writeIndexCapture(fh, size)
+	fh.Close()
+	_, err = receiver.BuildIndex(fSys, fn, receiver.IndexFormat{Framing: "COBS"})
+	assert.Nil(b, err)
+
+	b.Run("index", func(b *testing.B) {
+		b.SetBytes(size)
+		for i := 0; i < b.N; i++ {
+			_, err := receiver.BuildIndex(fSys, fn, receiver.IndexFormat{Framing: "COBS"})
+			assert.Nil(b, err)
+		}
+	})
+	run := func(name string, offset int64, stamps, ids string) {
+		b.Run(name, func(b *testing.B) {
+			receiver.QueryOffset, receiver.QueryStamps, receiver.QueryIDs = offset, stamps, ids
+			for i := 0; i < b.N; i++ {
+				decodeLog(b, io.Discard, fSys, fn, ilu, m)
+			}
+		})
+	}
+	run("full", -1, "", "")
+	run("queryIDs", -1, "", "200")
+	mid := uint32(count / 2 * 10)
+	run("queryStamps", -1, fmt.Sprintf("%d:%d", mid, mid+1000), "")
+	run("queryOffset", size-1<<20, "", "")
+}
@@ -0,0 +1,48 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"io"
+	"net"
+	"strings"
+	"testing"
+	"time"
+
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/tj/assert"
+)
+
+// TestUDP4CycleLoss sends several trices per datagram and drops one datagram. The loss is reported by the cycle counter check.
+func TestUDP4CycleLoss(t *testing.T) {
+	ilu, m := setupTestLog(t)
+	receiver.Port = "UDP4"
+	rwc, err := receiver.NewReadWriteCloser(io.Discard, nil, false, "UDP4", "127.0.0.1:0")
+	assert.Nil(t, err)
+	var out syncBuffer
+	done := make(chan error)
+	go func() { done <- Translate(io.Discard, emitter.NewDeviceOutput(&out).New("UDP4"), ilu, m, nil, rwc) }()
+
+	client, err := net.Dial("udp4", rwc.(interface{ LocalAddr() net.Addr }).LocalAddr().String())
+	assert.Nil(t, err)
+	defer client.Close()
+	_, err = client.Write(clientTrices(3, 0, 10))
+	assert.Nil(t, err)
+	// datagram with trices 10...19 lost
+	_, err = client.Write(clientTrices(3, 20, 30))
+	assert.Nil(t, err)
+
+	for deadline := time.Now().Add(10 * time.Second); !strings.Contains(out.String(), "seq 29\n") && time.Now().Before(deadline); {
+		time.Sleep(time.Millisecond)
+	}
+	assert.Nil(t, rwc.Close())
+	assert.Equal(t, io.EOF, <-done)
+
+	s := out.String()
+	assert.Equal(t, 20, strings.Count(s, "dev 3 seq"))
+	assert.Equal(t, 1, strings.Count(s, "CYCLE"))
+	assert.True(t, strings.Contains(s, "seq 9\n"))
+	assert.False(t, strings.Contains(s, "seq 10\n"))
+}
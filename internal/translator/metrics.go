@@ -0,0 +1,158 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"fmt"
+	"io"
+	"net"
+	"net/http"
+	"sort"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/trexDecoder"
+)
+
+var (
+	// MetricsAddress is the listen address of the metrics endpoint or "off". An address without host like ":9464" listens on localhost.
+	MetricsAddress = "off"
+
+	writtenTrices  atomic.Uint64 // writtenTrices counts the decoded strings passing the filters.
+	filteredTrices atomic.Uint64 // filteredTrices counts the decoded strings suppressed by -ban, -pick or an index query.
+)
+
+// ServeMetrics serves the decoder counters in the Prometheus text format on http://addr/metrics until the returned listener is closed.
+// lut is used for the channel of each ID.
+func ServeMetrics(w io.Writer, addr string, lut id.TriceIDLookUp, m *sync.RWMutex) (net.Listener, error) {
+	if strings.HasPrefix(addr, ":") {
+		addr = "localhost" + addr
+	}
+	ln, err := net.Listen("tcp", addr)
+	if err != nil {
+		return nil, err
+	}
+	mux := http.NewServeMux()
+	mux.HandleFunc("/metrics", func(rw http.ResponseWriter, _ *http.Request) {
+		rw.Header().Set("Content-Type", "text/plain; version=0.0.4; charset=utf-8")
+		WriteMetrics(rw, lut, m)
+	})
+	srv := &http.Server{Handler: mux, ReadHeaderTimeout: 5 * time.Second}
+	go srv.Serve(ln) // returns, when ln is closed
+	if Verbose {
+		fmt.Fprintln(w, "metrics on http://"+ln.Addr().String()+"/metrics")
+	}
+	return ln, nil
+}
+
+// idMetric is the counter pair of one ID or channel.
+type idMetric struct {
+	label   string
+	trices  uint64
+	bytes   uint64
+	channel string
+}
+
+// WriteMetrics writes all decoder counters in the Prometheus text format into w.
+// The rates, like trices/s per ID, are computed by the scraper from the counter differences.
+func WriteMetrics(w io.Writer, lut id.TriceIDLookUp, m *sync.RWMutex) {
+	c := &trexDecoder.Counters
+	counter(w, "trice_received_bytes_total", "Received bytes of all ports.", c.Bytes.Load())
+	counter(w, "trice_packages_total", "Deframed COBS or TCOBS packages.", c.Packages.Load())
+	counter(w, "trice_framing_errors_total", "Inconsistent packages and resync steps without framing.", c.FramingErrors.Load())
+	counter(w, "trice_cycle_gaps_total", "Cycle counter mismatches, which mean lost trices.", c.CycleGaps.Load())
+	counter(w, "trice_decode_errors_total", "Packages not fitting the trice sizes.", c.DecodeErrors.Load())
+	counter(w, "trice_unknown_ids_total", "Trices with an ID not inside the ID list.", c.UnknownIDs.Load())
+	counter(w, "trice_written_trices_total", "Decoded strings passing the filters.", writtenTrices.Load())
+	counter(w, "trice_filtered_trices_total", "Decoded strings suppressed by -ban, -pick or an index query.", filteredTrices.Load())
+
+	var ids []idMetric
+	channels := make(map[string]*idMetric)
+	m.RLock()
+	for i := range c.IDs {
+		n := c.IDs[i].Trices.Load()
+		if n == 0 {
+			continue
+		}
+		ch := emitter.Channel(lut[id.TriceID(i)].Strg)
+		if ch == "" {
+			ch = "none"
+		}
+		x := idMetric{label: fmt.Sprint(i), trices: n, bytes: c.IDs[i].Bytes.Load(), channel: ch}
+		ids = append(ids, x)
+		if channels[ch] == nil {
+			channels[ch] = &idMetric{label: ch}
+		}
+		channels[ch].trices += x.trices
+		channels[ch].bytes += x.bytes
+	}
+	m.RUnlock()
+	header(w, "trice_id_trices_total", "Decoded trices per ID.")
+	for _, x := range ids {
+		fmt.Fprintf(w, "trice_id_trices_total{id=%q,channel=%q} %d\n", x.label, x.channel, x.trices)
+	}
+	header(w, "trice_id_bytes_total", "Decoded trice bytes per ID including stamp, but without framing.")
+	for _, x := range ids {
+		fmt.Fprintf(w, "trice_id_bytes_total{id=%q,channel=%q} %d\n", x.label, x.channel, x.bytes)
+	}
+	names := make([]string, 0, len(channels))
+	for ch := range channels {
+		names = append(names, ch)
+	}
+	sort.Strings(names)
+	header(w, "trice_channel_trices_total", "Decoded trices per channel.")
+	for _, ch := range names {
+		fmt.Fprintf(w, "trice_channel_trices_total{channel=%q} %d\n", ch, channels[ch].trices)
+	}
+	header(w, "trice_channel_bytes_total", "Decoded trice bytes per channel.")
+	for _, ch := range names {
+		fmt.Fprintf(w, "trice_channel_bytes_total{channel=%q} %d\n", ch, channels[ch].bytes)
+	}
+
+	devices := trexDecoder.HealthDevices()
+	header(w, "trice_target_health_records_total", "Received target health records per device.")
+	for _, d := range devices {
+		records, _ := trexDecoder.Health(d)
+		fmt.Fprintf(w, "trice_target_health_records_total{device=%q} %d\n", d, records)
+	}
+	if len(devices) > 0 {
+		fmt.Fprintf(w, "# HELP trice_target_health Values of the last target health record per device.\n# TYPE trice_target_health gauge\n")
+	}
+	for _, d := range devices {
+		_, h := trexDecoder.Health(d)
+		for i, v := range h {
+			field := fmt.Sprint("field", i)
+			if i < len(trexDecoder.HealthFields) {
+				field = trexDecoder.HealthFields[i]
+			}
+			fmt.Fprintf(w, "trice_target_health{device=%q,field=%q} %d\n", d, field, v)
+		}
+	}
+
+	drops := emitter.OutputDrops()
+	names = names[:0]
+	for s := range drops {
+		names = append(names, s)
+	}
+	sort.Strings(names)
+	header(w, "trice_output_dropped_writes_total", "Writes dropped by the -outPolicy of each output.")
+	for _, s := range names {
+		fmt.Fprintf(w, "trice_output_dropped_writes_total{output=%q} %d\n", s, drops[s])
+	}
+}
+
+// header writes the help and type lines of the counter name.
+func header(w io.Writer, name, help string) {
+	fmt.Fprintf(w, "# HELP %s %s\n# TYPE %s counter\n", name, help, name)
+}
+
+// counter writes the counter name without labels.
+func counter(w io.Writer, name, help string, value uint64) {
+	header(w, name, help)
+	fmt.Fprintln(w, name, value)
+}
@@ -0,0 +1,123 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"bufio"
+	"io"
+	"net/http"
+	"strconv"
+	"strings"
+	"testing"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// scrape returns the counters of the metrics endpoint at addr by name including labels.
+func scrape(t *testing.T, addr string) map[string]uint64 {
+	resp, err := http.Get("http://" + addr + "/metrics")
+	assert.Nil(t, err)
+	defer resp.Body.Close()
+	assert.True(t, strings.HasPrefix(resp.Header.Get("Content-Type"), "text/plain"))
+	m := make(map[string]uint64)
+	s := bufio.NewScanner(resp.Body)
+	for s.Scan() {
+		if strings.HasPrefix(s.Text(), "#") {
+			continue
+		}
+		name, value, ok := strings.Cut(s.Text(), " ")
+		assert.True(t, ok, s.Text())
+		v, err := strconv.ParseUint(value, 10, 64)
+		assert.Nil(t, err, s.Text())
+		m[name] = v
+	}
+	return m
+}
+
+// TestMetricsReplayWithErrors scrapes the metrics endpoint while replaying a generated COBS logfile with a lost package,
+// a corrupted package and a package with an unknown ID.
+func TestMetricsReplayWithErrors(t *testing.T) {
+	lut, m := loadTestTil(t)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	s := setupStream(t, fSys, "trice.bin", lut, streamVariants()[0], 64<<10) // COBS/single
+	b, err := fSys.ReadFile(s.fn)
+	assert.Nil(t, err)
+
+	unknown := id.TriceID(16383)
+	for ; lut[unknown].Type != ""; unknown-- {
+	}
+	var faulty []byte
+	start := 0
+	for i, pkg := range s.packages {
+		p := b[start:pkg.end]
+		start = pkg.end
+		switch i {
+		case 10: // lost package
+			continue
+		case 20: // corrupted COBS code
+			p = append([]byte{0xFE}, p[1:]...)
+		case 30: // unknown ID without stamp
+			u := make([]byte, 8)
+			n := cobs.Encode(u, []byte{byte(unknown), 0x40 | byte(unknown>>8), 0xc5, 0}) // cycle and count
+			faulty = append(append(faulty, u[:n]...), 0)
+		}
+		faulty = append(faulty, p...)
+	}
+	assert.Nil(t, fSys.WriteFile("faulty.bin", faulty, 0644))
+
+	ln, err := ServeMetrics(io.Discard, "127.0.0.1:0", lut, m)
+	assert.Nil(t, err)
+	defer ln.Close()
+	addr := ln.Addr().String()
+	before := scrape(t, addr)
+
+	done := make(chan struct{})
+	scrapes := make(chan int)
+	go func() { // scrape during the replay
+		var n int
+		for {
+			select {
+			case <-done:
+				scrapes <- n
+				return
+			default:
+				scrape(t, addr)
+				n++
+			}
+		}
+	}()
+	rwc, err := receiver.NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", "faulty.bin")
+	assert.Nil(t, err)
+	assert.Equal(t, io.EOF, Translate(io.Discard, emitter.New(io.Discard), lut, m, nil, rwc))
+	assert.Nil(t, rwc.Close())
+	close(done)
+	assert.True(t, <-scrapes > 0)
+
+	after := scrape(t, addr)
+	delta := func(name string) uint64 { return after[name] - before[name] }
+	assert.Equal(t, uint64(len(faulty)), delta("trice_received_bytes_total"))
+	assert.Equal(t, uint64(len(s.packages)), delta("trice_packages_total"))
+	assert.Equal(t, uint64(1), delta("trice_framing_errors_total"))
+	assert.Equal(t, uint64(1), delta("trice_unknown_ids_total"))
+	assert.True(t, delta("trice_cycle_gaps_total") >= 3, delta("trice_cycle_gaps_total")) // lost, corrupted and unknown ID package
+	assert.Equal(t, uint64(0), delta("trice_decode_errors_total"))
+
+	var idTrices, channelTrices uint64
+	for name, v := range after {
+		if strings.HasPrefix(name, "trice_id_trices_total{") {
+			idTrices += v - before[name]
+		}
+		if strings.HasPrefix(name, "trice_channel_trices_total{") {
+			channelTrices += v - before[name]
+		}
+	}
+	assert.Equal(t, idTrices, channelTrices)
+	assert.Equal(t, uint64(s.trices-2), idTrices) // without the lost and the corrupted trice
+	assert.True(t, delta("trice_written_trices_total") >= idTrices)
+}
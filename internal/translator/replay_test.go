@@ -0,0 +1,46 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"encoding/binary"
+	"io"
+	"strings"
+	"testing"
+	"time"
+
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// TestTimedReplayHostStamps replays a timed binary logfile and checks, that the original host timestamps are displayed.
+func TestTimedReplayHostStamps(t *testing.T) {
+	ilu, m := setupTestLog(t)
+	emitter.HostStamp = "UTCmicro"
+	receiver.ReplaySpeed = 0
+	receiver.Port = "FILEBUFFER"
+
+	record := func(b []byte, t time.Time, data []byte) []byte {
+		b = binary.LittleEndian.AppendUint64(b, uint64(t.UnixNano()))
+		b = binary.LittleEndian.AppendUint32(b, uint32(len(data)))
+		return append(b, data...)
+	}
+	t0 := time.Date(2026, 1, 2, 3, 4, 5, 6000, time.UTC)
+	b := record([]byte(receiver.TimedLogMagic), t0, clientTrices(5, 0, 2))
+	b = record(b, t0.Add(time.Hour), clientTrices(5, 2, 3))
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	assert.Nil(t, fSys.WriteFile("timed.bin", b, 0644))
+
+	rwc, err := receiver.NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", "timed.bin")
+	assert.Nil(t, err)
+	var out syncBuffer
+	assert.Equal(t, io.EOF, Translate(io.Discard, emitter.NewDeviceOutput(&out).New("replay"), ilu, m, nil, rwc))
+	lines := strings.Split(strings.TrimSpace(out.String()), "\n")
+	assert.Equal(t, 3, len(lines), out.String())
+	for i, stamp := range []string{"UTC Jan  2 03:04:05.000006", "UTC Jan  2 03:04:05.000006", "UTC Jan  2 04:04:05.000006"} {
+		assert.True(t, strings.HasPrefix(lines[i], stamp), lines[i])
+	}
+}
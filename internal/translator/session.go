@@ -0,0 +1,86 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"bytes"
+	"sync"
+
+	"github.com/rokath/trice/internal/decoder"
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/id"
+)
+
+// sessionIdleReads is the count of reads without output after the input is exhausted, until a Decode call returns.
+// Some packages, like padding zeroes, give no output, so a single empty read does not mean, that all data are processed.
+const sessionIdleReads = 8
+
+// Session decodes binary trice data fed in pieces, like the output of target code executed in-process.
+// The decoder and line composer are kept between the Decode calls, so no port is opened and lut is used as is.
+type Session struct {
+	in   bytes.Buffer // in holds the not yet read input bytes.
+	out  bytes.Buffer // out collects the composed lines of one Decode call.
+	sw   *emitter.TriceLineComposer
+	dec  decoder.Decoder
+	lut  id.TriceIDLookUp
+	m    *sync.RWMutex
+	li   id.TriceIDLookUpLI
+	idle int // idle counts the reads without output after in is exhausted.
+}
+
+// sessionReader is the decoder input. It never ends, so the decoder keeps its state between the Decode calls.
+type sessionReader struct{ *bytes.Buffer }
+
+func (sessionReader) Write(b []byte) (int, error) { return len(b), nil }
+func (sessionReader) Close() error                { return nil }
+
+// sessionDecoder resets the idle counter of the session on each decoder output.
+type sessionDecoder struct {
+	decoder.Decoder
+	idle *int
+}
+
+func (p sessionDecoder) Read(b []byte) (n int, err error) {
+	n, err = p.Decoder.Read(b)
+	if n > 0 {
+		*p.idle = 0
+	}
+	return
+}
+
+// NewSession returns a decoding session with the actual decoder and display settings.
+// Changing these settings later does not affect the session decoder, but the line composing.
+func NewSession(lut id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUpLI) *Session {
+	p := &Session{lut: lut, m: m, li: li}
+	p.sw = emitter.New(&p.out)
+	p.Reset()
+	return p
+}
+
+// Reset drops incomplete trice data and starts with a new decoder using the actual decoder settings, like a new port.
+func (p *Session) Reset() {
+	p.in.Reset()
+	p.dec = sessionDecoder{newDecoder(&p.out, p.lut, p.m, p.li, sessionReader{&p.in}), &p.idle}
+}
+
+// Decode feeds b into the session decoder and returns the lines of all trices completed with b.
+// A started line is completed like at the end of a predefined buffer.
+// Incomplete trice data are kept and decoded together with the next b.
+func (p *Session) Decode(b []byte) string {
+	p.in.Write(b)
+	p.out.Reset()
+	p.idle = 0
+	setTargetStampDefaults()
+	_ = decodeAndComposeLoop(&p.out, p.sw, p.dec, p.li, "", p.ended, nil) // returns io.EOF only
+	return p.out.String()
+}
+
+// ended reports the end of the fed data, when the decoder gave no output sessionIdleReads times after in was exhausted.
+func (p *Session) ended() bool {
+	if p.in.Len() > 0 {
+		return false
+	}
+	p.idle++
+	return p.idle > sessionIdleReads
+}
@@ -0,0 +1,361 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"bufio"
+	"encoding/csv"
+	"encoding/json"
+	"fmt"
+	"io"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/rokath/trice/internal/decoder"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/spf13/afero"
+)
+
+var (
+	// SpansFileName is the Chrome Trace Event JSON file name for the span trices.
+	SpansFileName = "trace.json"
+
+	// SpansCSV is the CSV file name for the function statistics or "off".
+	SpansCSV = "off"
+
+	// SpansTick16 is the duration of one 16-bit target stamp tick.
+	SpansTick16 = time.Microsecond
+
+	// SpansTick32 is the duration of one 32-bit target stamp tick.
+	SpansTick32 = time.Microsecond
+)
+
+// span kinds of the trice IDs
+const (
+	spanNone = iota
+	spanEnter
+	spanExit
+)
+
+// spanFunc are the statistics of one span name.
+type spanFunc struct {
+	name    string
+	calls   int           // calls is the count of ended spans.
+	missing int           // missing is the count of spans ended without their exit trice.
+	total   time.Duration // total is the sum of the span durations. Recursive calls are counted several times.
+	self    time.Duration // self is total without the durations of the nested spans with the same stamp size.
+	max     time.Duration
+}
+
+// spanClock unwraps the 16-bit or the 32-bit target stamps into a monotonic tick count.
+// The 16-bit and the 32-bit stamps are independent clocks with own tick durations. Each needs at least one trice per stamp period.
+type spanClock struct {
+	mask    uint64        // mask is 1<<16-1 or 1<<32-1.
+	tick    time.Duration // tick is the duration of one stamp tick.
+	track   int           // track is the trace event tid of the spans with this stamp size.
+	now     uint64        // now is the unwrapped stamp of the last trice with this stamp size.
+	first   uint64        // first is the unwrapped stamp of the first trice with this stamp size.
+	stamped bool
+}
+
+// advance unwraps stamp.
+func (c *spanClock) advance(stamp uint64) {
+	if !c.stamped {
+		c.stamped, c.now, c.first = true, stamp, stamp
+		return
+	}
+	c.now += (stamp - c.now) & c.mask
+}
+
+// openSpan is a span waiting for its exit trice.
+type openSpan struct {
+	fn       *spanFunc
+	clock    *spanClock // clock is the clock of the enter trice stamp size or nil for an unstamped enter trice.
+	start    uint64
+	children time.Duration // children is the duration of the ended nested spans with the same clock.
+}
+
+// traceEvent is a Chrome Trace Event. Each ended stamped span is a complete event with phase "X". The times are in microseconds.
+type traceEvent struct {
+	Name string            `json:"name"`
+	Cat  string            `json:"cat"`
+	Ph   string            `json:"ph"`
+	Ts   float64           `json:"ts"`
+	Dur  float64           `json:"dur"`
+	Pid  int               `json:"pid"`
+	Tid  int               `json:"tid"`
+	Args map[string]string `json:"args,omitempty"`
+}
+
+// spanExporter is the Exporter pairing the span trices to nested spans.
+//
+// The 16-bit and the 32-bit target stamps are different clocks on many targets, like a SysTick down counter and a millisecond
+// counter. Therefore each stamp size has its own clock and trace track, and an exit trice ends the innermost open span with the
+// same name and the same stamp size. Open spans above it lost their exit trices and end as well. When the cycle counter shows
+// lost trices, all open spans end at the last trice of their clock before the loss, because their exit trices could be lost.
+// Exit trices without an open span are counted only. Spans without stamps are counted, but have no duration and no trace event.
+type spanExporter struct {
+	mu    sync.Mutex // mu protects the statistics against a report during an Export.
+	lut   id.TriceIDLookUp
+	m     *sync.RWMutex
+	kinds map[id.TriceID]int
+	names map[id.TriceID]string
+	funcs map[string]*spanFunc
+	stack []openSpan
+
+	clock16 spanClock
+	clock32 spanClock
+
+	trices    int // trices is the count of all decoded trices.
+	spans     int // spans is the count of ended spans.
+	missing   int // missing is the count of spans ended without their exit trice.
+	unmatched int // unmatched is the count of exit trices without an open span.
+	losses    int // losses is the count of cycle counter gaps.
+
+	out    *bufio.Writer // out gets the trace events.
+	events int
+	err    error
+}
+
+// newSpanExporter returns a span exporter for the trices of lut writing the trace events into out.
+func newSpanExporter(lut id.TriceIDLookUp, m *sync.RWMutex, out io.Writer) *spanExporter {
+	p := &spanExporter{lut: lut, m: m, kinds: make(map[id.TriceID]int), names: make(map[id.TriceID]string), funcs: make(map[string]*spanFunc), out: bufio.NewWriter(out)}
+	p.clock32 = spanClock{mask: 1<<32 - 1, tick: SpansTick32, track: 1}
+	p.clock16 = spanClock{mask: 1<<16 - 1, tick: SpansTick16, track: 2}
+	_, p.err = p.out.WriteString(`{"displayTimeUnit":"ns","traceEvents":[` + "\n" + `{"name":"process_name","ph":"M","pid":1,"tid":1,"args":{"name":"trice"}},` + "\n" +
+		`{"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"32-bit stamps"}},` + "\n" +
+		`{"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"16-bit stamps"}}`)
+	return p
+}
+
+// kind returns the span kind and the span name of tid.
+func (p *spanExporter) kind(tid id.TriceID) (int, string) {
+	k, ok := p.kinds[tid]
+	if !ok {
+		p.m.RLock()
+		tf := p.lut[tid]
+		p.m.RUnlock()
+		switch {
+		case strings.HasSuffix(tf.Type, "SpanEnter"):
+			k = spanEnter
+		case strings.HasSuffix(tf.Type, "SpanExit"):
+			k = spanExit
+		}
+		p.kinds[tid], p.names[tid] = k, strings.TrimSuffix(tf.Strg, `\n`)
+	}
+	return k, p.names[tid]
+}
+
+// Export pairs the span trices. All stamped trices advance the clock of their stamp size.
+func (p *spanExporter) Export(tid id.TriceID, stamp uint64, stampSize int, _ []byte) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.trices++
+	c := p.clock(stampSize)
+	var now uint64
+	if c != nil {
+		c.advance(stamp)
+		now = c.now
+	}
+	k, name := p.kind(tid)
+	switch k {
+	case spanEnter:
+		fn := p.funcs[name]
+		if fn == nil {
+			fn = &spanFunc{name: name}
+			p.funcs[name] = fn
+		}
+		p.stack = append(p.stack, openSpan{fn: fn, clock: c, start: now})
+	case spanExit:
+		i := len(p.stack) - 1
+		for i >= 0 && (p.stack[i].fn.name != name || p.stack[i].clock != c) {
+			i--
+		}
+		if i < 0 {
+			p.unmatched++
+			return
+		}
+		for len(p.stack) > i+1 {
+			p.end(true)
+		}
+		p.end(false)
+	}
+}
+
+// ExportGap ends all open spans, because the decoder detected lost trices.
+func (p *spanExporter) ExportGap() {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	p.losses++
+	for len(p.stack) > 0 {
+		p.end(true)
+	}
+}
+
+// clock returns the clock for stampSize or nil for unstamped trices.
+func (p *spanExporter) clock(stampSize int) *spanClock {
+	switch stampSize {
+	case 2:
+		return &p.clock16
+	case 4:
+		return &p.clock32
+	}
+	return nil
+}
+
+// end ends the innermost open span at the actual time of its clock and writes its trace event.
+func (p *spanExporter) end(missing bool) {
+	s := p.stack[len(p.stack)-1]
+	p.stack = p.stack[:len(p.stack)-1]
+	var d time.Duration
+	if s.clock != nil {
+		d = time.Duration(s.clock.now-s.start) * s.clock.tick
+	}
+	if len(p.stack) > 0 && p.stack[len(p.stack)-1].clock == s.clock {
+		p.stack[len(p.stack)-1].children += d
+	}
+	fn := s.fn
+	fn.calls++
+	fn.total += d
+	fn.self += d - s.children
+	if d > fn.max {
+		fn.max = d
+	}
+	p.spans++
+	if missing {
+		fn.missing++
+		p.missing++
+	}
+	if s.clock == nil || p.err != nil {
+		return
+	}
+	e := traceEvent{Name: fn.name, Cat: "trice", Ph: "X", Ts: us(time.Duration(s.start-s.clock.first) * s.clock.tick), Dur: us(d), Pid: 1, Tid: s.clock.track}
+	if missing {
+		e.Args = map[string]string{"exit": "missing"}
+	}
+	b, err := json.Marshal(e)
+	if err != nil {
+		p.err = err
+		return
+	}
+	p.out.WriteString(",\n")
+	_, p.err = p.out.Write(b)
+	p.events++
+}
+
+// us converts d into microseconds.
+func us(d time.Duration) float64 {
+	return float64(d) / float64(time.Microsecond)
+}
+
+// decoded returns the count of decoded trices.
+func (p *spanExporter) decoded() int {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.trices
+}
+
+// Close ends the open spans as missing and completes the trace events.
+func (p *spanExporter) Close() error {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	for len(p.stack) > 0 {
+		p.end(true)
+	}
+	if p.err == nil {
+		_, p.err = p.out.WriteString("\n]}\n")
+	}
+	if p.err == nil {
+		p.err = p.out.Flush()
+	}
+	return p.err
+}
+
+// spansHeader are the column names of the function statistics.
+var spansHeader = []string{"name", "calls", "missingExits", "total_us", "self_us", "avg_us", "max_us"}
+
+// report writes the function statistics sorted by self time into w and, if SpansCSV is not "off", the CSV file.
+func (p *spanExporter) report(w io.Writer, fSys *afero.Afero) error {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	fns := make([]*spanFunc, 0, len(p.funcs))
+	for _, fn := range p.funcs {
+		fns = append(fns, fn)
+	}
+	sort.Slice(fns, func(i, j int) bool {
+		if fns[i].self != fns[j].self {
+			return fns[i].self > fns[j].self
+		}
+		return fns[i].name < fns[j].name
+	})
+	fmt.Fprintf(w, "%-24s %8s %8s %14s %14s %12s %12s\n", "name", "calls", "missing", "total", "self", "avg", "max")
+	var rows [][]string
+	for _, fn := range fns {
+		var avg time.Duration
+		if fn.calls > 0 {
+			avg = fn.total / time.Duration(fn.calls)
+		}
+		fmt.Fprintf(w, "%-24s %8d %8d %14v %14v %12v %12v\n", fn.name, fn.calls, fn.missing, fn.total, fn.self, avg, fn.max)
+		f := func(d time.Duration) string { return strconv.FormatFloat(us(d), 'f', -1, 64) }
+		rows = append(rows, []string{fn.name, strconv.Itoa(fn.calls), strconv.Itoa(fn.missing), f(fn.total), f(fn.self), f(avg), f(fn.max)})
+	}
+	fmt.Fprintln(w, p.spans, "spans of", p.trices, "trices,", p.missing, "missing exits,", p.unmatched, "exits without enter,", p.losses, "trice losses")
+	if !p.clock16.stamped && !p.clock32.stamped {
+		fmt.Fprintln(w, "No durations, because the span trices have no target stamps.")
+	}
+
+	if SpansCSV == "off" || SpansCSV == "none" {
+		return nil
+	}
+	fh, err := fSys.Create(SpansCSV)
+	if err != nil {
+		return err
+	}
+	cw := csv.NewWriter(fh)
+	cw.Write(spansHeader)
+	cw.WriteAll(rows) // flushes
+	if err = cw.Error(); err != nil {
+		fh.Close()
+		return err
+	}
+	return fh.Close()
+}
+
+// Spans decodes rwc without formatting and writes the spans of the span trices as Chrome Trace Event JSON into SpansFileName.
+// This file is viewable with chrome://tracing or https://ui.perfetto.dev. The statistics of each span name are written into w
+// and optionally into SpansCSV.
+//
+// Only the TREX encoding is supported. Spans returns io.EOF, when the input ended and the files were written.
+func Spans(w io.Writer, fSys *afero.Afero, lut id.TriceIDLookUp, m *sync.RWMutex, rwc io.ReadWriteCloser) error {
+	if strings.ToUpper(Encoding) != "TREX" {
+		return fmt.Errorf("spans needs the TREX encoding and not %s", Encoding)
+	}
+	if SpansTick16 <= 0 || SpansTick32 <= 0 {
+		return fmt.Errorf("invalid tick %v or %v", SpansTick16, SpansTick32)
+	}
+	fh, err := fSys.Create(SpansFileName)
+	if err != nil {
+		return err
+	}
+	x := newSpanExporter(lut, m, fh)
+	dec := newDecoder(w, lut, m, nil, rwc)
+	dec.(interface{ SetExporter(decoder.Exporter) }).SetExporter(x)
+	err = exportLoop(w, dec, x, receiver.Port, endedFunc(rwc))
+	if e := x.Close(); e != nil {
+		fh.Close()
+		return e
+	}
+	if e := fh.Close(); e != nil {
+		return e
+	}
+	if e := x.report(w, fSys); e != nil {
+		return e
+	}
+	fmt.Fprintln(w, "wrote", x.events, "trace events into", SpansFileName)
+	return err
+}
@@ -0,0 +1,155 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"bytes"
+	"encoding/json"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/rokath/trice/internal/id"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// spansTestLut are span trices for main, filter and leaf and a value trice.
+var spansTestLut = id.TriceIDLookUp{
+	1: {Type: "TRiceSpanEnter", Strg: "main"},
+	2: {Type: "TRiceSpanExit", Strg: "main"},
+	3: {Type: "TriceSpanEnter", Strg: "filter"},
+	4: {Type: "TriceSpanExit", Strg: "filter"},
+	5: {Type: "TriceSpanEnter", Strg: "leaf"},
+	6: {Type: "TriceSpanExit", Strg: "leaf"},
+	7: {Type: "Trice", Strg: "msg:%d\\n"},
+}
+
+// spansTestTrace returns the trace events written by p.
+func spansTestTrace(t *testing.T, p *spanExporter, out *bytes.Buffer) (events []traceEvent) {
+	assert.Nil(t, p.Close())
+	var trace struct{ TraceEvents []traceEvent }
+	assert.Nil(t, json.Unmarshal(out.Bytes(), &trace), out.String())
+	for _, e := range trace.TraceEvents {
+		if e.Ph != "M" {
+			events = append(events, e)
+		}
+	}
+	return
+}
+
+// TestSpans checks nesting, statistics and the stamp unwrapping. The 16-bit and the 32-bit stamps are separate clocks.
+func TestSpans(t *testing.T) {
+	var out bytes.Buffer
+	p := newSpanExporter(spansTestLut, new(sync.RWMutex), &out)
+	now := uint64(0x1fff0) // The 16-bit stamps wrap inside the first filter.
+	ex := func(tid id.TriceID, ticks uint64) {
+		now += ticks
+		if tid == 1 || tid == 2 {
+			p.Export(tid, now&0xffffffff, 4, nil)
+		} else {
+			p.Export(tid, now&0xffff, 2, nil)
+		}
+	}
+	ex(1, 0)
+	for i := 0; i < 3; i++ {
+		ex(3, 2)
+		ex(5, 5)
+		ex(7, 3) // not a span trice
+		ex(6, 7)
+		ex(5, 0)
+		ex(6, 10)
+		ex(4, 5)
+	}
+	ex(2, 70000) // more than a 16-bit stamp period between 32-bit stamps
+	events := spansTestTrace(t, p, &out)
+
+	assert.Equal(t, 10, len(events))
+	assert.Equal(t, traceEvent{Name: "leaf", Cat: "trice", Ph: "X", Ts: 5, Dur: 10, Pid: 1, Tid: 2}, events[0])
+	assert.Equal(t, traceEvent{Name: "filter", Cat: "trice", Ph: "X", Ts: 0, Dur: 30, Pid: 1, Tid: 2}, events[2])
+	assert.Equal(t, traceEvent{Name: "main", Cat: "trice", Ph: "X", Ts: 0, Dur: 96 + 70000, Pid: 1, Tid: 1}, events[9])
+
+	f := p.funcs
+	us := time.Microsecond
+	assert.Equal(t, spanFunc{name: "leaf", calls: 6, total: 60 * us, self: 60 * us, max: 10 * us}, *f["leaf"])
+	assert.Equal(t, spanFunc{name: "filter", calls: 3, total: 90 * us, self: 30 * us, max: 30 * us}, *f["filter"])
+	assert.Equal(t, spanFunc{name: "main", calls: 1, total: 70096 * us, self: 70096 * us, max: 70096 * us}, *f["main"]) // other clock children
+	assert.Equal(t, 0, p.missing)
+
+	var report bytes.Buffer
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	defer func(s string) { SpansCSV = s }(SpansCSV)
+	SpansCSV = "spans.csv"
+	assert.Nil(t, p.report(&report, fSys))
+	lines := strings.Split(report.String(), "\n")
+	assert.True(t, strings.HasPrefix(lines[1], "main "), report.String()) // highest self time first
+	assert.True(t, strings.Contains(report.String(), "10 spans of 23 trices, 0 missing exits, 0 exits without enter, 0 trice losses"), report.String())
+	b, err := fSys.ReadFile("spans.csv")
+	assert.Nil(t, err)
+	assert.True(t, strings.Contains(string(b), "filter,3,0,90,30,30,30\n"), string(b))
+}
+
+// TestSpansMissingExits checks the span recovery after lost exit trices and after cycle counter gaps.
+func TestSpansMissingExits(t *testing.T) {
+	var out bytes.Buffer
+	p := newSpanExporter(spansTestLut, new(sync.RWMutex), &out)
+	p.Export(1, 100, 4, nil)
+	p.Export(3, 110, 2, nil)
+	p.Export(5, 120, 2, nil) // The leaf exit is lost.
+	p.Export(4, 150, 2, nil) // ends leaf and filter
+	p.Export(6, 160, 2, nil) // leaf exit without enter
+	p.Export(3, 170, 2, nil)
+	p.Export(5, 180, 2, nil)
+	p.ExportGap()            // lost trices, ends leaf, filter and main at 180
+	p.Export(4, 200, 2, nil) // exit without enter
+	p.Export(3, 210, 2, nil) // open at the end
+	p.Export(7, 230, 2, nil)
+	events := spansTestTrace(t, p, &out)
+
+	missing := map[string]int{}
+	for _, e := range events {
+		if e.Args["exit"] == "missing" {
+			missing[e.Name]++
+		}
+	}
+	assert.Equal(t, map[string]int{"leaf": 2, "filter": 2, "main": 1}, missing)
+	assert.Equal(t, traceEvent{Name: "leaf", Cat: "trice", Ph: "X", Ts: 10, Dur: 30, Pid: 1, Tid: 2, Args: map[string]string{"exit": "missing"}}, events[0])
+	assert.Equal(t, traceEvent{Name: "filter", Cat: "trice", Ph: "X", Ts: 0, Dur: 40, Pid: 1, Tid: 2}, events[1])
+	assert.Equal(t, traceEvent{Name: "main", Cat: "trice", Ph: "X", Ts: 0, Dur: 0, Pid: 1, Tid: 1, Args: map[string]string{"exit": "missing"}}, events[4]) // no further 32-bit stamp
+	assert.Equal(t, traceEvent{Name: "filter", Cat: "trice", Ph: "X", Ts: 100, Dur: 20, Pid: 1, Tid: 2, Args: map[string]string{"exit": "missing"}}, events[5])
+	assert.Equal(t, 6, len(events))
+	assert.Equal(t, 2, p.unmatched) // the leaf exit and the filter exit after the loss
+	assert.Equal(t, 1, p.losses)
+	us := time.Microsecond
+	assert.Equal(t, spanFunc{name: "filter", calls: 3, missing: 2, total: 70 * us, self: 40 * us, max: 40 * us}, *p.funcs["filter"])
+}
+
+// TestSpansClocks checks the independent 16-bit and 32-bit clocks and the spans without stamps.
+func TestSpansClocks(t *testing.T) {
+	defer func(t16, t32 time.Duration) { SpansTick16, SpansTick32 = t16, t32 }(SpansTick16, SpansTick32)
+	SpansTick16, SpansTick32 = 100*time.Nanosecond, time.Millisecond
+	var out bytes.Buffer
+	p := newSpanExporter(spansTestLut, new(sync.RWMutex), &out)
+	p.Export(3, 0, 0, nil) // unstamped filter
+	p.Export(4, 0, 0, nil)
+	p.Export(1, 5000, 4, nil)   // main on the millisecond clock
+	p.Export(3, 0xfff0, 2, nil) // filter on the 100 ns clock
+	p.Export(5, 0x0010, 2, nil) // leaf after the 16-bit wrap
+	p.Export(6, 5002, 4, nil)   // a leaf exit with a 32-bit stamp does not end the 16-bit leaf
+	p.Export(6, 0x0020, 2, nil)
+	p.Export(4, 0x0030, 2, nil)
+	p.Export(2, 5003, 4, nil)
+	p.Export(3, 5010, 4, nil) // open at the end
+	events := spansTestTrace(t, p, &out)
+
+	assert.Equal(t, 4, len(events))
+	assert.Equal(t, traceEvent{Name: "leaf", Cat: "trice", Ph: "X", Ts: 3.2, Dur: 1.6, Pid: 1, Tid: 2}, events[0])
+	assert.Equal(t, traceEvent{Name: "filter", Cat: "trice", Ph: "X", Ts: 0, Dur: 6.4, Pid: 1, Tid: 2}, events[1])
+	assert.Equal(t, traceEvent{Name: "main", Cat: "trice", Ph: "X", Ts: 0, Dur: 3000, Pid: 1, Tid: 1}, events[2])
+	assert.Equal(t, traceEvent{Name: "filter", Cat: "trice", Ph: "X", Ts: 10000, Dur: 0, Pid: 1, Tid: 1, Args: map[string]string{"exit": "missing"}}, events[3])
+	assert.Equal(t, 1, p.unmatched) // the 32-bit leaf exit
+	assert.Equal(t, spanFunc{name: "filter", calls: 3, missing: 1, total: 6400 * time.Nanosecond, self: 4800 * time.Nanosecond, max: 6400 * time.Nanosecond}, *p.funcs["filter"])
+	assert.Equal(t, spanFunc{name: "main", calls: 1, total: 3 * time.Millisecond, self: 3 * time.Millisecond, max: 3 * time.Millisecond}, *p.funcs["main"])
+}
@@ -0,0 +1,225 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"bytes"
+	"encoding/binary"
+	"fmt"
+	"io"
+	"net"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/rokath/trice/internal/decoder"
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/tj/assert"
+)
+
+// clientTrices returns the COBS framed trices seq from ... to-1 of client dev without target stamps.
+// The cycle counter continues over the whole sequence, like from a target behind a reconnecting bridge.
+func clientTrices(dev, from, to int) []byte {
+	var out []byte
+	frame := make([]byte, 32)
+	for seq := from; seq < to; seq++ {
+		cycle := uint8(0xc0 + seq%64)
+		pkg := binary.LittleEndian.AppendUint16(nil, 1<<14|16000) // no stamp, ID 16000
+		pkg = binary.LittleEndian.AppendUint16(pkg, 8<<8|uint16(cycle))
+		pkg = binary.LittleEndian.AppendUint32(pkg, uint32(dev))
+		pkg = binary.LittleEndian.AppendUint32(pkg, uint32(seq))
+		n := cobs.Encode(frame, pkg)
+		out = append(out, frame[:n]...)
+		out = append(out, 0)
+	}
+	return out
+}
+
+// setupTestLog sets the global log options for the tests and returns the shared look-up tables.
+// The options and the receiver options changed by the tests are restored after the test.
+func setupTestLog(t testing.TB) (id.TriceIDLookUp, *sync.RWMutex) {
+	enc, endian, framing := Encoding, TriceEndianness, decoder.PackageFraming
+	hostStamp, palette, prefix, liFn := emitter.HostStamp, emitter.ColorPalette, emitter.Prefix, id.LIFnJSON
+	port, speed := receiver.Port, receiver.ReplaySpeed
+	offset, stamps, ids := receiver.QueryOffset, receiver.QueryStamps, receiver.QueryIDs
+	t.Cleanup(func() {
+		Encoding, TriceEndianness, decoder.PackageFraming = enc, endian, framing
+		emitter.HostStamp, emitter.ColorPalette, emitter.Prefix, id.LIFnJSON = hostStamp, palette, prefix, liFn
+		receiver.Port, receiver.ReplaySpeed = port, speed
+		receiver.QueryOffset, receiver.QueryStamps, receiver.QueryIDs = offset, stamps, ids
+	})
+	Encoding = "TREX"
+	TriceEndianness = "littleEndian"
+	decoder.PackageFraming = "COBS"
+	emitter.HostStamp = "off"
+	emitter.ColorPalette = "none"
+	emitter.Prefix = "source: "
+	id.LIFnJSON = "off"
+	ilu := make(id.TriceIDLookUp)
+	assert.Nil(t, ilu.FromJSON([]byte(`{"16000": {"Type": "TRice", "Strg": "msg:dev %d seq %d\\n"}}`)))
+	return ilu, new(sync.RWMutex)
+}
+
+// syncBuffer is a bytes.Buffer usable from several Go routines.
+type syncBuffer struct {
+	mu      sync.Mutex
+	b       bytes.Buffer
+	waiting map[string]chan struct{} // waiting holds the channels returned by written, until their string is written.
+}
+
+func (p *syncBuffer) Write(b []byte) (int, error) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	for s, c := range p.waiting { // The device output writes whole lines.
+		if bytes.Contains(b, []byte(s)) {
+			close(c)
+			delete(p.waiting, s)
+		}
+	}
+	return p.b.Write(b)
+}
+
+// written returns a channel, which is closed, as soon as s was written.
+func (p *syncBuffer) written(s string) <-chan struct{} {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	c := make(chan struct{})
+	if strings.Contains(p.b.String(), s) {
+		close(c)
+		return c
+	}
+	if p.waiting == nil {
+		p.waiting = make(map[string]chan struct{})
+	}
+	p.waiting[s] = c
+	return c
+}
+
+// waitWritten waits until s was written into p.
+func waitWritten(t testing.TB, p *syncBuffer, s string) {
+	select {
+	case <-p.written(s):
+	case <-time.After(10 * time.Second):
+		t.Error("timeout waiting for", s)
+	}
+}
+
+func (p *syncBuffer) String() string {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	return p.b.String()
+}
+
+// runClients connects count clients to addr, each sending perClient trices. Every 10th client does not announce a name.
+// If reconnected is not nil, each 4th announced client disconnects in the middle of a package and reconnects after
+// reconnected(dev) returned. It sends the cut off package again after the reconnect.
+func runClients(t testing.TB, addr string, count, perClient int, reconnected func(dev int)) {
+	var wg sync.WaitGroup
+	for dev := 0; dev < count; dev++ {
+		wg.Add(1)
+		go func(dev int) {
+			defer wg.Done()
+			announced := dev%10 != 9
+			send := func(from, to int, cut bool) {
+				conn, err := net.Dial("tcp4", addr)
+				if !assert.Nil(t, err) {
+					return
+				}
+				defer conn.Close()
+				if announced {
+					fmt.Fprintf(conn, "%sdev%02d\n", receiver.DeviceAnnouncement, dev)
+				}
+				b := clientTrices(dev, from, to)
+				if cut {
+					next := clientTrices(dev, to, to+1)
+					b = append(b, next[:len(next)/2]...)
+				}
+				for len(b) > 0 { // several writes to get split packages on the server side
+					n := 1000 + dev
+					if n > len(b) {
+						n = len(b)
+					}
+					_, err = conn.Write(b[:n])
+					assert.Nil(t, err)
+					b = b[n:]
+				}
+			}
+			if reconnected != nil && announced && dev%4 == 0 {
+				send(0, perClient/2, true)
+				reconnected(dev)
+				send(perClient/2, perClient, false)
+			} else {
+				send(0, perClient, false)
+			}
+		}(dev)
+	}
+	wg.Wait()
+}
+
+// TestTCP4Server lets several clients push trices in parallel. It checks, that each client gets its own decoder
+// and output tag and that reconnects keep the cycle counter check and drop a package cut off by the disconnect.
+// BenchmarkTCP4Server measures the throughput.
+func TestTCP4Server(t *testing.T) {
+	ilu, m := setupTestLog(t)
+	srv, err := receiver.NewTCP4Server(io.Discard, "localhost:0")
+	assert.Nil(t, err)
+	var out syncBuffer
+	done := make(chan error)
+	go func() { done <- TranslateTCP4Server(io.Discard, emitter.NewDeviceOutput(&out), ilu, m, nil, srv) }()
+
+	const clients, perClient = 12, 100
+	runClients(t, srv.Addr().String(), clients, perClient, func(dev int) { // wait until the server got the first half
+		waitWritten(t, &out, fmt.Sprintf("dev %d seq %d\n", dev, perClient/2-1))
+	})
+	for dev := 0; dev < clients; dev++ {
+		waitWritten(t, &out, fmt.Sprintf("dev %d seq %d\n", dev, perClient-1))
+	}
+	assert.Nil(t, srv.Close())
+	assert.Nil(t, <-done)
+
+	seqs := make(map[int]int)
+	for _, line := range strings.Split(strings.TrimSpace(out.String()), "\n") {
+		tag, s, found := strings.Cut(line, ": ")
+		if !assert.True(t, found, line) {
+			continue
+		}
+		var dev, seq int
+		_, err := fmt.Sscanf(strings.TrimSpace(s), "dev %d seq %d", &dev, &seq)
+		if !assert.Nil(t, err, line) {
+			continue
+		}
+		if dev%10 == 9 {
+			assert.True(t, strings.HasPrefix(tag, "127.0.0.1:"), line)
+		} else {
+			assert.Equal(t, fmt.Sprintf("dev%02d", dev), tag)
+		}
+		assert.Equal(t, seqs[dev], seq, line)
+		seqs[dev] = seq + 1
+	}
+	for dev := 0; dev < clients; dev++ {
+		assert.Equal(t, perClient, seqs[dev], dev)
+	}
+	assert.False(t, strings.Contains(out.String(), "CYCLE"))
+}
+
+// BenchmarkTCP4Server measures the aggregate decoding throughput of 32 parallel clients.
+func BenchmarkTCP4Server(b *testing.B) {
+	ilu, m := setupTestLog(b)
+	const clients = 32
+	perClient := b.N/clients + 1
+	srv, err := receiver.NewTCP4Server(io.Discard, "localhost:0")
+	assert.Nil(b, err)
+	done := make(chan error)
+	b.ResetTimer()
+	go func() { done <- TranslateTCP4Server(io.Discard, emitter.NewDeviceOutput(io.Discard), ilu, m, nil, srv) }()
+	runClients(b, srv.Addr().String(), clients, perClient, nil)
+	time.Sleep(20 * time.Millisecond)
+	assert.Nil(b, srv.Close())
+	assert.Nil(b, <-done)
+	b.ReportMetric(float64(clients*perClient)/b.Elapsed().Seconds(), "trices/s")
+}
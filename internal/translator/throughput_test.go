@@ -0,0 +1,394 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package translator
+
+import (
+	"bytes"
+	"fmt"
+	"io"
+	"math/bits"
+	"strconv"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/rokath/trice/internal/decoder"
+	"github.com/rokath/trice/internal/emitter"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/profile"
+	"github.com/rokath/trice/internal/receiver"
+	"github.com/rokath/trice/internal/trexDecoder"
+	"github.com/rokath/trice/internal/trexGenerator"
+	"github.com/rokath/trice/pkg/cipher"
+	"github.com/spf13/afero"
+	"github.com/tj/assert"
+)
+
+// streamVariant is one framing, pack mode and encryption combination of the generated streams.
+type streamVariant struct {
+	name string
+	o    trexGenerator.Options
+}
+
+// streamVariants are all combinations the TREX decoder supports. Framing NONE is possible only without encryption and multi pack mode.
+func streamVariants() (v []streamVariant) {
+	for _, framing := range []string{"COBS", "TCOBS"} {
+		for _, multiPack := range []int{1, 8} {
+			for _, xtea := range []bool{false, true} {
+				name := framing + "/single"
+				if multiPack > 1 {
+					name = framing + "/multi"
+				}
+				if xtea {
+					name += "/xtea"
+				}
+				v = append(v, streamVariant{name, trexGenerator.Options{Framing: framing, MultiPack: multiPack, XTEA: xtea, Doubled16BitID: xtea}})
+			}
+		}
+	}
+	return append(v, streamVariant{"NONE/single", trexGenerator.Options{Framing: "NONE", Doubled16BitID: true}})
+}
+
+// stampSizes are the stamp options of the generated streams. With "auto" the trice names select the stamp size.
+var stampSizes = []string{"auto", "0", "16", "32"}
+
+// paramMix selects the trices by their value bit width and sets the maximum string and buffer parameter size.
+type paramMix struct {
+	name       string
+	widths     []int // widths are the selected value bit widths. Strings are always selected.
+	stringSize int
+}
+
+// paramMixes go from small to large parameters. The mixed one uses all trices.
+var paramMixes = []paramMix{
+	{"small", []int{8, 16}, 8},
+	{"mixed", []int{8, 16, 32, 64}, 24},
+	{"large", []int{32, 64}, 120},
+}
+
+// shape returns v with the stamp size and parameter mix applied together with the selected trices of lut.
+func (m paramMix) shape(lut id.TriceIDLookUp, v streamVariant, stamps string) (id.TriceIDLookUp, streamVariant) {
+	sel := make(id.TriceIDLookUp)
+	for tid, tf := range lut {
+		t := strings.TrimPrefix(strings.ToUpper(tf.Type), "TRICE")
+		i := strings.IndexFunc(t, func(r rune) bool { return r < '0' || '9' < r })
+		if i < 0 {
+			i = len(t)
+		}
+		width, _ := strconv.Atoi(id.DefaultTriceBitWidth)
+		if i > 0 {
+			width, _ = strconv.Atoi(t[:i])
+		}
+		if rest := strings.TrimPrefix(t[i:], "_"); strings.HasPrefix(rest, "S") || strings.HasPrefix(rest, "N") {
+			sel[tid] = tf
+			continue
+		}
+		for _, w := range m.widths {
+			if w == width {
+				sel[tid] = tf
+			}
+		}
+	}
+	v.name += "/stamp" + stamps + "/" + m.name
+	v.o.Stamps, v.o.StringSize = stamps, m.stringSize
+	return sel, v
+}
+
+// streamPackage is the position of one generated package.
+type streamPackage struct {
+	end    int // end is the stream offset after the package.
+	trices int // trices is the count of trices in the package.
+	lines  int // lines is the count of output lines completed by the package trices.
+}
+
+// generatedStream is a generated binary logfile together with its package positions.
+type generatedStream struct {
+	fn       string
+	size     int
+	trices   int
+	lines    int
+	packages []streamPackage
+}
+
+// setupStream sets the log options for v and writes a generated stream of at least size bytes with the trices of lut into fn.
+func setupStream(t testing.TB, fSys *afero.Afero, fn string, lut id.TriceIDLookUp, v streamVariant, size int) (s generatedStream) {
+	framing, doubled, password := decoder.PackageFraming, trexDecoder.Doubled16BitID, cipher.Password
+	decoder.PackageFraming = v.o.Framing
+	trexDecoder.Doubled16BitID = v.o.Doubled16BitID
+	cipher.Password = ""
+	if v.o.XTEA {
+		cipher.Password = "MySecret"
+	}
+	assert.Nil(t, cipher.SetUp(io.Discard))
+	t.Cleanup(func() {
+		decoder.PackageFraming, trexDecoder.Doubled16BitID, cipher.Password = framing, doubled, password
+		assert.Nil(t, cipher.SetUp(io.Discard))
+	})
+	o := v.o
+	o.Distribution, o.Seed = "zipf", 1
+	if o.StringSize == 0 {
+		o.StringSize = 24
+	}
+	g, err := trexGenerator.New(lut, o)
+	assert.Nil(t, err)
+	b := make([]byte, 0, size+1024)
+	for len(b) < size {
+		var trices, lines int
+		b, trices, lines = g.Append(b)
+		s.packages = append(s.packages, streamPackage{len(b), trices, lines})
+		s.trices += trices
+		s.lines += lines
+	}
+	assert.Nil(t, fSys.WriteFile(fn, b, 0644))
+	s.fn, s.size = fn, len(b)
+	return
+}
+
+// loadTestTil returns the ID list of the target code tests, which contains all trice types.
+// Buffer trices without underscore, like TRice8B, are removed, because the TREX decoder does not know them.
+func loadTestTil(t testing.TB) (id.TriceIDLookUp, *sync.RWMutex) {
+	_, m := setupTestLog(t)
+	lut := id.NewLut(io.Discard, &afero.Afero{Fs: afero.NewOsFs()}, "../../_test/testdata/til.json")
+	for tid, tf := range lut {
+		if strings.HasSuffix(tf.Type, "B") && !strings.HasSuffix(tf.Type, "_B") {
+			delete(lut, tid)
+		}
+	}
+	return lut, m
+}
+
+// timedReader records the time, when the input bytes are read, and ends after the input is exhausted.
+type timedReader struct {
+	io.ReadWriteCloser
+	offset int
+	reads  []timedRead
+	eof    bool
+	idle   int // idle counts the Ended calls after the input end.
+}
+
+// timedRead is the end offset of a read together with its time.
+type timedRead struct {
+	end int
+	at  time.Time
+}
+
+func (p *timedReader) Read(b []byte) (n int, err error) {
+	n, err = p.ReadWriteCloser.Read(b)
+	if n > 0 {
+		p.offset += n
+		p.reads = append(p.reads, timedRead{p.offset, time.Now()})
+	} else if err == io.EOF {
+		p.eof = true
+	}
+	return
+}
+
+// Ended reports the input end, when the decoder gave several times no output after the input end,
+// because packages like padding zeroes give no output.
+func (p *timedReader) Ended() bool {
+	if !p.eof {
+		return false
+	}
+	p.idle++
+	return p.idle > sessionIdleReads
+}
+
+// latencySink is the discard output, which measures the latency of each trice from reading its package until writing its line.
+type latencySink struct {
+	r        *timedReader
+	packages []streamPackage
+	next     int // next is the index of the first package without written line.
+	before   int // before is the line count of the packages before next.
+	seen     int // seen is the count of written lines.
+	read     int // read is the index of the first read, which could contain the end of the next package.
+	h        *latencyHistogram
+}
+
+func (p *latencySink) Write(b []byte) (int, error) {
+	for k := bytes.Count(b, []byte{'\n'}); k > 0; k-- {
+		p.seen++
+		now := time.Now()
+		for p.next < len(p.packages) && p.before < p.seen { // Trices without line end are written together with the next line.
+			pkg := p.packages[p.next]
+			for p.r.reads[p.read].end < pkg.end {
+				p.read++
+			}
+			p.h.add(now.Sub(p.r.reads[p.read].at), pkg.trices)
+			p.before += pkg.lines
+			p.next++
+		}
+	}
+	return len(b), nil
+}
+
+// latencyHistogram counts durations in logarithmic buckets with 8 sub-buckets for each power of 2.
+type latencyHistogram [64 * 8]int
+
+// add counts d n times.
+func (h *latencyHistogram) add(d time.Duration, n int) {
+	ns := uint64(d)
+	if ns < 16 {
+		h[ns] += n
+		return
+	}
+	e := bits.Len64(ns) - 4 // ns>>e is 8...15
+	h[e*8+int(ns>>e)] += n
+}
+
+// quantile returns the upper bucket limit of the q quantile.
+func (h *latencyHistogram) quantile(q float64) time.Duration {
+	var total, sum int
+	for _, n := range h {
+		total += n
+	}
+	for i, n := range h {
+		if sum += n; n > 0 && float64(sum) >= q*float64(total) {
+			if i < 16 {
+				return time.Duration(i + 1)
+			}
+			e := i/8 - 1
+			return time.Duration((i%8 + 9) << e)
+		}
+	}
+	return 0
+}
+
+// decodeStream decodes s through the receiver, translator and emitter into sink and returns the count of written lines.
+func decodeStream(t testing.TB, fSys *afero.Afero, s generatedStream, lut id.TriceIDLookUp, m *sync.RWMutex, sink io.Writer, h *latencyHistogram) (lines int) {
+	rwc, err := receiver.NewReadWriteCloser(io.Discard, fSys, false, "FILEBUFFER", s.fn)
+	assert.Nil(t, err)
+	r := &timedReader{ReadWriteCloser: rwc, reads: make([]timedRead, 0, s.size/decoder.DefaultSize+16)}
+	defer r.Close()
+	ls := &latencySink{r: r, packages: s.packages, h: h}
+	var w io.Writer = ls
+	if sink != nil {
+		w = io.MultiWriter(ls, sink)
+	}
+	assert.Equal(t, io.EOF, Translate(io.Discard, emitter.New(w), lut, m, nil, r))
+	return ls.seen
+}
+
+// TestGeneratedStreams checks, that the generated streams of all variants decode without errors into the expected lines.
+func TestGeneratedStreams(t *testing.T) {
+	lut, m := loadTestTil(t)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	for _, v := range streamVariants() {
+		s := setupStream(t, fSys, "trice.bin", lut, v, 64<<10)
+		var out bytes.Buffer
+		var h latencyHistogram
+		lines := decodeStream(t, fSys, s, lut, m, &out, &h)
+		assert.True(t, lines == s.lines || lines == s.lines+1, v.name, lines, s.lines) // A last line without line end gets one.
+		// Hints follow the decoder error messages.
+		for _, bad := range []string{"Hints", "CYCLE:\a", "unknown ID", "inconsistent"} {
+			assert.False(t, strings.Contains(out.String(), bad), v.name, bad)
+		}
+		assert.True(t, h.quantile(1) > 0, v.name)
+	}
+}
+
+// TestGeneratedStreamShapes checks, that the streams of all stamp sizes and parameter mixes decode without errors into the expected lines.
+func TestGeneratedStreamShapes(t *testing.T) {
+	all, m := loadTestTil(t)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	for _, v := range []streamVariant{streamVariants()[2], streamVariants()[len(streamVariants())-1]} { // COBS/multi and NONE/single
+		for _, stamps := range stampSizes {
+			for _, mix := range paramMixes {
+				lut, v := mix.shape(all, v, stamps)
+				s := setupStream(t, fSys, "trice.bin", lut, v, 16<<10)
+				var out bytes.Buffer
+				var h latencyHistogram
+				lines := decodeStream(t, fSys, s, lut, m, &out, &h)
+				assert.True(t, lines == s.lines || lines == s.lines+1, v.name, lines, s.lines)
+				for _, bad := range []string{"Hints", "CYCLE:\a", "unknown ID", "inconsistent"} {
+					assert.False(t, strings.Contains(out.String(), bad), v.name, bad)
+				}
+			}
+		}
+	}
+}
+
+// startStages starts the stage counting for one test or benchmark.
+func startStages(t testing.TB, fSys *afero.Afero) {
+	profile.Stages = "exit"
+	assert.Nil(t, profile.Start(io.Discard, fSys))
+	t.Cleanup(func() {
+		profile.Stop()
+		profile.Stages = "off"
+	})
+}
+
+// TestStageCounting checks, that the stage counters see all packages and trices of a generated stream.
+func TestStageCounting(t *testing.T) {
+	lut, m := loadTestTil(t)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	s := setupStream(t, fSys, "trice.bin", lut, streamVariants()[2], 64<<10) // COBS/multi
+	startStages(t, fSys)
+	var h latencyHistogram
+	decodeStream(t, fSys, s, lut, m, nil, &h)
+	var out bytes.Buffer
+	profile.Summary(&out, time.Second)
+	assert.True(t, strings.Contains(out.String(), fmt.Sprintf("\ndeframe  %12d packages %12d ", len(s.packages), s.size)), out.String())
+	assert.True(t, strings.Contains(out.String(), fmt.Sprintf("\nformat   %12d trices ", s.trices)), out.String())
+}
+
+// BenchmarkDecoderThroughput pushes generated streams of -captureMB size for all framing, pack mode, encryption, stamp size
+// and parameter mix variants through the receiver, translator and emitter into a discard sink. The trices are from the target
+// code test til.json with a zipf distribution. Besides MB/s and the allocations per stream it reports the decoded trices/s and
+// the 99th percentile of the per trice latency from reading its package until writing its line.
+// Use for example -bench 'DecoderThroughput/COBS/multi/stampauto/' to select a part of the variants.
+func BenchmarkDecoderThroughput(b *testing.B) {
+	if testing.Short() {
+		b.Skip("big capture")
+	}
+	all, m := loadTestTil(b)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	for _, variant := range streamVariants() {
+		for _, stamps := range stampSizes {
+			for _, mix := range paramMixes {
+				lut, v := mix.shape(all, variant, stamps)
+				b.Run(v.name, func(b *testing.B) {
+					s := setupStream(b, fSys, "trice.bin", lut, v, *captureMB<<20)
+					var h latencyHistogram
+					b.SetBytes(int64(s.size))
+					b.ReportAllocs()
+					b.ResetTimer()
+					for i := 0; i < b.N; i++ {
+						decodeStream(b, fSys, s, lut, m, nil, &h)
+					}
+					b.StopTimer()
+					b.ReportMetric(float64(s.trices)*float64(b.N)/b.Elapsed().Seconds(), "trices/s")
+					b.ReportMetric(float64(h.quantile(0.99).Nanoseconds()), "p99-ns/trice")
+				})
+			}
+		}
+	}
+}
+
+// BenchmarkStageCounting compares the COBS multi pack throughput without and with the stage counting of "trice log -stages".
+func BenchmarkStageCounting(b *testing.B) {
+	lut, m := loadTestTil(b)
+	fSys := &afero.Afero{Fs: afero.NewMemMapFs()}
+	for _, stages := range []bool{false, true} {
+		stages := stages
+		name := "off"
+		if stages {
+			name = "on"
+		}
+		b.Run(name, func(b *testing.B) {
+			s := setupStream(b, fSys, "trice.bin", lut, streamVariants()[2], *captureMB<<20) // COBS/multi
+			if stages {
+				startStages(b, fSys)
+			}
+			var h latencyHistogram
+			b.SetBytes(int64(s.size))
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				decodeStream(b, fSys, s, lut, m, nil, &h)
+			}
+			b.StopTimer()
+			b.ReportMetric(float64(s.trices)*float64(b.N)/b.Elapsed().Seconds(), "trices/s")
+		})
+	}
+}
@@ -1,9 +1,11 @@
 package translator
 
 import (
+	"errors"
 	"fmt"
 	"io"
 	"log"
+	"net"
 	"os"
 	"os/signal"
 	"strings"
@@ -17,6 +19,7 @@ import (
 	"github.com/rokath/trice/internal/emitter"
 	"github.com/rokath/trice/internal/id"
 	"github.com/rokath/trice/internal/keybcmd"
+	"github.com/rokath/trice/internal/profile"
 	"github.com/rokath/trice/internal/receiver"
 	"github.com/rokath/trice/internal/trexDecoder"
 	"github.com/rokath/trice/pkg/msg"
@@ -32,6 +35,10 @@ var (
 	TriceEndianness string
 
 	Verbose bool
+
+	// ReconnectGrace is the time a reconnecting TCP4SERVER client waits for the end of its previous connection,
+	// to continue with the same decoder state.
+	ReconnectGrace = time.Second
 )
 
 // Translate performs the trice log task.
@@ -40,12 +47,188 @@ var (
 // Each read returns the amount of bytes for one trice. rc is called on every
 // Translate returns true on io.EOF or false on hard read error or sigterm.
 func Translate(w io.Writer, sw *emitter.TriceLineComposer, lut id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUpLI, rwc io.ReadWriteCloser) error {
+	dec := newDecoder(w, lut, m, li, rwc)
+	if emitter.DisplayRemote {
+		keybcmd.ReadInput(rwc)
+	} else {
+		done := make(chan struct{})
+		defer close(done)
+		go handleSIGTERM(w, rwc, done)
+	}
+	setTargetStampDefaults()
+	setHostClock(sw, rwc)
+	return decodeAndComposeLoop(w, sw, dec, li, receiver.Port, endedFunc(rwc), matchFunc(rwc))
+}
+
+// Device is one of several trice sources translated in parallel.
+type Device struct {
+	Port  string                     // Port is the receiver device name, like "COM3" or "FILE".
+	Label string                     // Label is the unique device name inside the output lines and the metrics.
+	RWC   io.ReadWriteCloser         // RWC delivers the device bytes.
+	SW    *emitter.TriceLineComposer // SW is the device specific output.
+}
+
+// TranslateDevices performs the trice log task for several devices in parallel.
+//
+// Each device gets its own decoder instance. The id look-up tables are shared.
+// TranslateDevices returns io.EOF, when all devices reached the end of their predefined buffers.
+// Otherwise it returns the first other error.
+func TranslateDevices(w io.Writer, lut id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUpLI, devices []Device) error {
+	decs := make([]decoder.Decoder, len(devices))
+	rcs := make(multiCloser, len(devices))
+	for i, d := range devices {
+		decs[i] = newDecoder(w, lut, m, li, d.RWC)
+		decs[i].SetDevice(d.Label)
+		rcs[i] = d.RWC
+	}
+	done := make(chan struct{})
+	defer close(done)
+	go handleSIGTERM(w, rcs, done)
+	setTargetStampDefaults()
+	errs := make(chan error, len(devices))
+	for i, d := range devices {
+		go func(d Device, dec decoder.Decoder) {
+			setHostClock(d.SW, d.RWC)
+			errs <- decodeAndComposeLoop(w, d.SW, dec, li, d.Port, endedFunc(d.RWC), matchFunc(d.RWC))
+		}(d, decs[i])
+	}
+	var err error
+	for range devices {
+		if e := <-errs; e != io.EOF && err == nil {
+			err = e
+		}
+	}
+	if err == nil {
+		err = io.EOF
+	}
+	return err
+}
+
+// TranslateTCP4Server performs the trice log task for all clients of srv until srv is closed.
+//
+// Each client gets its own decoder instance. The id look-up tables are shared. The client output lines are tagged with the
+// announced device name or the remote address. The decoder state of an announced device is kept over reconnects,
+// so the cycle counter check continues. TranslateTCP4Server returns nil, after srv was closed and all clients ended.
+func TranslateTCP4Server(w io.Writer, out *emitter.DeviceOutput, lut id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUpLI, srv *receiver.TCP4Server) error {
+	done := make(chan struct{})
+	defer close(done)
+	go handleSIGTERM(w, srv, done)
+	setTargetStampDefaults()
+	var (
+		wg       sync.WaitGroup
+		mu       sync.Mutex
+		sessions = make(map[string]*clientSession) // sessions holds the state of announced devices.
+	)
+	for {
+		c, err := srv.Accept()
+		if err != nil {
+			wg.Wait()
+			if errors.Is(err, net.ErrClosed) {
+				return nil
+			}
+			return err
+		}
+		wg.Add(1)
+		go func(c *receiver.TCP4ServerConn) {
+			defer wg.Done()
+			defer func() { msg.OnErr(c.Close()) }()
+			name := c.Name()
+			mu.Lock()
+			s, ok := sessions[name]
+			if ok && s.active { // a reconnect can be faster than the disconnect detection
+				mu.Unlock()
+				select {
+				case <-s.done:
+				case <-time.After(ReconnectGrace):
+				}
+				mu.Lock()
+			}
+			if !ok || s.active { // new device or the name is already in use
+				s = &clientSession{sw: out.New(name), dec: newDecoder(w, lut, m, li, c)}
+				s.dec.SetDevice(name)
+				if !ok {
+					sessions[name] = s
+				}
+			} else { // reconnected device, the cut off package of the old connection is dropped
+				s.dec.Reset(c)
+			}
+			s.active = true
+			s.done = make(chan struct{})
+			done := s.done
+			mu.Unlock()
+			msg.OnErr(func() error {
+				e := decodeAndComposeLoop(w, s.sw, s.dec, li, receiver.Port, c.Ended, nil)
+				if e == io.EOF {
+					return nil
+				}
+				return e
+			}())
+			mu.Lock()
+			s.active = false
+			close(done)
+			mu.Unlock()
+			if Verbose {
+				fmt.Fprintln(w, name, "disconnected")
+			}
+		}(c)
+	}
+}
+
+// clientSession is the decoding state of a TCP4SERVER client.
+type clientSession struct {
+	sw     *emitter.TriceLineComposer
+	dec    decoder.Decoder
+	active bool          // active is true, while a connection uses the session.
+	done   chan struct{} // done is closed, when the connection using the session ended.
+}
+
+// endedFunc returns the Ended method of the r source or nil, if it cannot end.
+func endedFunc(r io.Reader) func() bool {
+	if e, ok := receiver.Source(r).(receiver.Ender); ok {
+		return e.Ended
+	}
+	return nil
+}
+
+// matchFunc returns the MatchTrice method of the r source or nil, if it delivers only wanted trices.
+func matchFunc(r io.Reader) func(id uint16, stamp uint64, stampSize int) bool {
+	if m, ok := receiver.Source(r).(receiver.TriceMatcher); ok {
+		return m.MatchTrice
+	}
+	return nil
+}
+
+// setHostClock lets sw use the original reception time of the r source for the host timestamps, if it knows them.
+func setHostClock(sw *emitter.TriceLineComposer, r io.Reader) {
+	if h, ok := receiver.Source(r).(receiver.HostTimer); ok {
+		sw.SetClock(func() time.Time {
+			if t, ok := h.HostTime(); ok {
+				return t
+			}
+			return time.Now()
+		})
+	}
+}
+
+// multiCloser closes all its elements.
+type multiCloser []io.Closer
+
+func (p multiCloser) Close() (err error) {
+	for _, c := range p {
+		if e := c.Close(); e != nil && err == nil {
+			err = e
+		}
+	}
+	return
+}
+
+// newDecoder returns a decoder according Encoding and TriceEndianness reading from rwc.
+func newDecoder(w io.Writer, lut id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUpLI, rwc io.ReadWriteCloser) (dec decoder.Decoder) {
 	//var dec Decoder //io.Reader
 	if Verbose {
 		fmt.Fprintln(w, "Encoding is", Encoding)
 	}
 	var endian bool
-	var dec decoder.Decoder
 	switch TriceEndianness {
 	case "littleEndian":
 		endian = decoder.LittleEndian
@@ -71,41 +254,33 @@ func Translate(w io.Writer, sw *emitter.TriceLineComposer, lut id.TriceIDLookUp,
 	default:
 		log.Fatalf(fmt.Sprintln("unknown encoding ", Encoding))
 	}
-	if emitter.DisplayRemote {
-		keybcmd.ReadInput(rwc)
-	} else {
-		go handleSIGTERM(w, rwc)
-	}
-	return decodeAndComposeLoop(w, sw, dec, lut, li)
+	return
 }
 
-// handleSIGTERM is called on CTRL-C shutdown.
-func handleSIGTERM(w io.Writer, rc io.ReadCloser) {
-	// prepare CTRL-C shutdown reaction
+// handleSIGTERM is the CTRL-C shutdown reaction. It closes rc, writes the pending output and ends the program.
+// It stops listening for the signals and returns, when done is closed, so repeated translations do not pile up handlers.
+func handleSIGTERM(w io.Writer, rc io.Closer, done <-chan struct{}) {
 	sigs := make(chan os.Signal, 1)
 	signal.Notify(sigs, syscall.SIGINT, syscall.SIGTERM)
-	ticker := time.NewTicker(50 * time.Millisecond)
-	for {
-		select {
-		case sig := <-sigs: // wait for a signal
-			if Verbose {
-				fmt.Fprintln(w, "####################################", sig, "####################################")
-			}
-			emitter.PrintColorChannelEvents(w)
-			msg.FatalOnErr(rc.Close())
-			os.Exit(0) // end
-		case <-ticker.C:
+	defer signal.Stop(sigs)
+	select {
+	case sig := <-sigs: // wait for a signal
+		if Verbose {
+			fmt.Fprintln(w, "####################################", sig, "####################################")
 		}
+		emitter.PrintColorChannelEvents(w)
+		msg.FatalOnErr(rc.Close())
+		emitter.CloseFanOuts() // write the queued output
+		profile.Stop()         // write the profiles and the stage summary
+		os.Exit(0)             // end
+	case <-done:
 	}
 }
 
 const DefaultTargetStamp0 = "time:            "
 
-// decodeAndComposeLoop does not return.
-func decodeAndComposeLoop(w io.Writer, sw *emitter.TriceLineComposer, dec decoder.Decoder, lut id.TriceIDLookUp, li id.TriceIDLookUpLI) error {
-	b := make([]byte, decoder.DefaultSize) // intermediate trice string buffer
-	bufferReadStartTime := time.Now()
-	sleepCounter := 0
+// setTargetStampDefaults sets the not passed target stamp format strings according to decoder.TargetStamp.
+func setTargetStampDefaults() {
 	if decoder.TargetStamp == "" || decoder.TargetStamp == "off" || decoder.TargetStamp == "none" {
 		if !decoder.ShowTargetStamp0Passed {
 			decoder.TargetStamp0 = ""
@@ -139,23 +314,50 @@ func decodeAndComposeLoop(w io.Writer, sw *emitter.TriceLineComposer, dec decode
 			decoder.TargetStamp32 = "us"
 		}
 	}
+}
+
+// predefinedBuffer returns true for ports delivering a predefined buffer, which has no end detection.
+func predefinedBuffer(port string) bool {
+	switch port {
+	case "FILEBUFFER", "TCP4BUFFER", "HEX", "DUMP", "DEC", "BUFFER":
+		return true
+	}
+	return false
+}
+
+// decodeAndComposeLoop does not return for not predefined buffer ports.
+// If ended is not nil, decodeAndComposeLoop returns io.EOF, when ended reports the input end and all data are processed.
+// If match is not nil, only trices it matches are written.
+func decodeAndComposeLoop(w io.Writer, sw *emitter.TriceLineComposer, dec decoder.Decoder, li id.TriceIDLookUpLI, port string, ended func() bool, match func(id uint16, stamp uint64, stampSize int) bool) error {
+	b := make([]byte, decoder.DefaultSize) // intermediate trice string buffer
+	bufferReadStartTime := time.Now()
+	sleepCounter := 0
 	for {
+		readStart := profile.Now()
 		n, err := dec.Read(b) // Code to measure, dec.Read can return n=0 in some cases and then wait.
+		if n > 0 {
+			profile.Decode.Done(readStart, 1, n)
+		} else {
+			profile.Decode.Done(readStart, 0, 0)
+		}
 
 		if err != io.EOF && err != nil {
 			log.Fatal(err)
 		}
 
 		if n == 0 {
-			if (receiver.Port == "FILEBUFFER" ||
-				receiver.Port == "TCP4BUFFER" ||
-				receiver.Port == "HEX" ||
-				receiver.Port == "DUMP" ||
-				receiver.Port == "DEC" ||
-				receiver.Port == "BUFFER") /*&& err == io.EOF*/ && time.Since(bufferReadStartTime) > 100*time.Millisecond { // do not wait if a predefined buffer
+			if ended != nil && ended() {
 				if len(sw.Line) > 0 {
 					_, _ = sw.Write([]byte(`\n`)) // add newline as line end to display any started line
 				}
+				sw.Flush()
+				return io.EOF
+			}
+			if ended == nil && predefinedBuffer(port) /*&& err == io.EOF*/ && time.Since(bufferReadStartTime) > 100*time.Millisecond { // do not wait if a predefined buffer
+				if len(sw.Line) > 0 {
+					_, _ = sw.Write([]byte(`\n`)) // add newline as line end to display any started line
+				}
+				sw.Flush()
 				msg.OnErr(err)
 				return io.EOF
 			}
@@ -176,15 +378,25 @@ func decodeAndComposeLoop(w io.Writer, sw *emitter.TriceLineComposer, dec decode
 
 		// Filtering is done here to suppress the loc, timestamp and id display as well for the filtered items.
 		n = emitter.BanOrPickFilter(b[:n]) // todo: b can contain several trices - handle that!
+		if match != nil {
+			if stamp, stampSize := dec.TargetStamp(); !match(uint16(dec.LastID()), stamp, stampSize) {
+				n = 0
+			}
+		}
+
+		if n == 0 {
+			filteredTrices.Add(1)
+		}
 
 		if n > 0 { // s.th. to write out
+			writtenTrices.Add(1)
 			var logLineStart bool // logLineStart is a helper flag for log line start detection
 			if len(sw.Line) == 0 {
 				logLineStart = true
 			}
 
 			if logLineStart && id.LIFnJSON != "off" && id.LIFnJSON != "none" {
-				s := locationInformation(decoder.LastTriceID, li)
+				s := locationInformation(dec.LastID(), li)
 				_, err := sw.Write([]byte(s))
 				msg.OnErr(err)
 			}
@@ -204,38 +416,39 @@ func decodeAndComposeLoop(w io.Writer, sw *emitter.TriceLineComposer, dec decode
 
 			var s string
 			if logLineStart {
-				switch decoder.TargetTimestampSize {
+				stamp, stampSize := dec.TargetStamp()
+				switch stampSize {
 				case 4:
 					switch decoder.TargetStamp32 {
 					case "ms", "hh:mm:ss,ms":
-						ms := decoder.TargetTimestamp % 1000
-						sec := (decoder.TargetTimestamp - ms) / 1000 % 60
-						min := (decoder.TargetTimestamp - ms - 1000*sec) / 60000 % 60
-						hour := (decoder.TargetTimestamp - ms - 1000*sec - 60000*min) / 3600000
+						ms := stamp % 1000
+						sec := (stamp - ms) / 1000 % 60
+						min := (stamp - ms - 1000*sec) / 60000 % 60
+						hour := (stamp - ms - 1000*sec - 60000*min) / 3600000
 						s = fmt.Sprintf("time:%2d:%02d:%02d,%03d", hour, min, sec, ms)
 					case "us", "µs", "ssss,ms_µs":
-						us := decoder.TargetTimestamp % 1000
-						ms := (decoder.TargetTimestamp - us) / 1000 % 1000
-						sd := (decoder.TargetTimestamp - 1000*ms) / 1000000
+						us := stamp % 1000
+						ms := (stamp - us) / 1000 % 1000
+						sd := (stamp - 1000*ms) / 1000000
 						s = fmt.Sprintf("time:%4d,%03d_%03d", sd, ms, us)
 					case "":
 					default:
-						s = fmt.Sprintf(decoder.TargetStamp32, decoder.TargetTimestamp)
+						s = fmt.Sprintf(decoder.TargetStamp32, stamp)
 					}
 
 				case 2:
 					switch decoder.TargetStamp16 {
 					case "ms", "s,ms":
-						ms := decoder.TargetTimestamp % 1000
-						sec := (decoder.TargetTimestamp - ms) / 1000
+						ms := stamp % 1000
+						sec := (stamp - ms) / 1000
 						s = fmt.Sprintf("time:      %2d,%03d", sec, ms)
 					case "us", "µs", "ms_µs":
-						us := decoder.TargetTimestamp % 1000
-						ms := (decoder.TargetTimestamp - us) / 1000 % 1000
+						us := stamp % 1000
+						ms := (stamp - us) / 1000 % 1000
 						s = fmt.Sprintf("time:      %2d_%03d", ms, us)
 					case "":
 					default:
-						s = fmt.Sprintf(decoder.TargetStamp16, decoder.TargetTimestamp)
+						s = fmt.Sprintf(decoder.TargetStamp16, stamp)
 					}
 
 				case 0:
@@ -250,7 +463,7 @@ func decodeAndComposeLoop(w io.Writer, sw *emitter.TriceLineComposer, dec decode
 			}
 			// write ID only if enabled and line start.
 			if logLineStart && decoder.ShowID != "" {
-				s := fmt.Sprintf(decoder.ShowID, decoder.LastTriceID)
+				s := fmt.Sprintf(decoder.ShowID, dec.LastID())
 				_, err := sw.Write([]byte(s))
 				msg.OnErr(err)
 				_, err = sw.Write([]byte("default: ")) // add space as separator
@@ -258,6 +471,7 @@ func decodeAndComposeLoop(w io.Writer, sw *emitter.TriceLineComposer, dec decode
 			}
 			_, err := sw.Write(b[:n])
 			msg.OnErr(err)
+			profile.Compose.Done(start, 1, n)
 		}
 
 		duration := time.Since(start).Milliseconds()
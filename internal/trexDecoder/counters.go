@@ -0,0 +1,34 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package trexDecoder
+
+import (
+	"sync/atomic"
+
+	"github.com/rokath/trice/internal/id"
+)
+
+// IDCounter counts the decoded trices of one ID.
+type IDCounter struct {
+	Trices atomic.Uint64 // Trices is the count of decoded trices.
+	Bytes  atomic.Uint64 // Bytes is the count of trice bytes including stamp, but without framing.
+}
+
+// Counters are the counters of all TREX decoders. They are updated atomically, because several devices can log in parallel.
+var Counters struct {
+	Bytes         atomic.Uint64 // Bytes is the count of received bytes.
+	Packages      atomic.Uint64 // Packages is the count of deframed COBS or TCOBS packages.
+	FramingErrors atomic.Uint64 // FramingErrors counts inconsistent COBS or TCOBS packages and resync steps without framing.
+	CycleGaps     atomic.Uint64 // CycleGaps counts cycle counter mismatches, which mean lost trices.
+	UnknownIDs    atomic.Uint64 // UnknownIDs counts trices with an ID not inside the ID list.
+	DecodeErrors  atomic.Uint64 // DecodeErrors counts packages, which do not fit the trice sizes.
+	IDs           [1 << 14]IDCounter
+}
+
+// countTrice counts a decoded trice of size bytes.
+func countTrice(tid id.TriceID, size int) {
+	c := &Counters.IDs[tid&0x3FFF]
+	c.Trices.Add(1)
+	c.Bytes.Add(uint64(size))
+}
@@ -0,0 +1,116 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package trexDecoder
+
+import (
+	"encoding/binary"
+	"fmt"
+	"sort"
+	"strings"
+	"sync"
+)
+
+// healthStrg is the format string of the target health record emitted by TriceLogHealth.
+const healthStrg = `diag:health %u\n`
+
+// HealthFields are the names of the target health record values in the order of the target enum TriceHealthField.
+var HealthFields = []string{
+	"sequence",
+	"flags",
+	"singleDepthMax",
+	"singleSize",
+	"offsetDepthMax",
+	"offsetSize",
+	"deferredDepthMax",
+	"deferredSize",
+	"directOverflows",
+	"deferredOverflows",
+	"truncations",
+	"errors",
+	"rttDepthMax",
+	"rttSize",
+}
+
+// healthRecord is the last received target health record of one device.
+type healthRecord struct {
+	records uint64
+	values  []uint32
+}
+
+// health holds the last received target health record of each device. The key is the device label, "" for a single device.
+var health struct {
+	sync.Mutex
+	devices map[string]*healthRecord
+}
+
+// Health returns the count of received target health records of device and a copy of its last one.
+func Health(device string) (records uint64, values []uint32) {
+	health.Lock()
+	defer health.Unlock()
+	h, ok := health.devices[device]
+	if !ok {
+		return 0, nil
+	}
+	return h.records, append([]uint32(nil), h.values...)
+}
+
+// HealthDevices returns the sorted labels of the devices, which sent target health records.
+func HealthDevices() []string {
+	health.Lock()
+	defer health.Unlock()
+	devices := make([]string, 0, len(health.devices))
+	for d := range health.devices {
+		devices = append(devices, d)
+	}
+	sort.Strings(devices)
+	return devices
+}
+
+// healthField returns value i of h or 0, if an older target sends less values.
+func healthField(h []uint32, i int) uint32 {
+	if i < len(h) {
+		return h[i]
+	}
+	return 0
+}
+
+// healthSummary renders the target health record h as one line.
+func healthSummary(h []uint32) string {
+	var s strings.Builder
+	fmt.Fprintf(&s, "seq=%d single=%d/%d offset=%d/%d deferred=%d/%d directOverflows=%d deferredOverflows=%d truncations=%d errors=%d rtt=%d/%d",
+		healthField(h, 0), healthField(h, 2), healthField(h, 3), healthField(h, 4), healthField(h, 5), healthField(h, 6), healthField(h, 7),
+		healthField(h, 8), healthField(h, 9), healthField(h, 10), healthField(h, 11), healthField(h, 12), healthField(h, 13))
+	for i := len(HealthFields); i < len(h); i++ { // values of a newer target
+		fmt.Fprintf(&s, " field%d=%d", i, h[i])
+	}
+	if healthField(h, 1)&1 != 0 {
+		s.WriteString(" reset")
+	}
+	return s.String()
+}
+
+// health32B renders a target health record trice as summary line and keeps it for the metrics, if the format string is healthStrg.
+func (p *trexDec) health32B(b []byte) (n int, ok bool) {
+	if p.Trice.Strg != healthStrg {
+		return 0, false
+	}
+	s := p.B[:p.ParamSpace]
+	h := make([]uint32, len(s)/4)
+	for i := range h {
+		h[i] = binary.LittleEndian.Uint32(s[4*i:])
+	}
+	health.Lock()
+	if health.devices == nil {
+		health.devices = make(map[string]*healthRecord)
+	}
+	r, ok := health.devices[p.Device]
+	if !ok {
+		r = new(healthRecord)
+		health.devices[p.Device] = r
+	}
+	r.records++
+	r.values = h
+	health.Unlock()
+	return copy(b, "diag:health "+healthSummary(h)+"\n"), true
+}
@@ -0,0 +1,43 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package trexDecoder
+
+import (
+	"testing"
+
+	"github.com/tj/assert"
+)
+
+// TestHealthSummary checks the rendering of target health records from older, equal and newer targets.
+func TestHealthSummary(t *testing.T) {
+	h := []uint32{7, 1, 48, 104, 4, 16, 240, 512, 0, 2, 1, 0, 0, 0}
+	assert.Equal(t, len(HealthFields), len(h))
+	assert.Equal(t, "seq=7 single=48/104 offset=4/16 deferred=240/512 directOverflows=0 deferredOverflows=2 truncations=1 errors=0 rtt=0/0 reset", healthSummary(h))
+	assert.Equal(t, "seq=7 single=48/104 offset=0/0 deferred=0/0 directOverflows=0 deferredOverflows=0 truncations=0 errors=0 rtt=0/0 reset", healthSummary(h[:4:4]))
+	h[1] = 0
+	assert.Equal(t, "seq=7 single=48/104 offset=4/16 deferred=240/512 directOverflows=0 deferredOverflows=2 truncations=1 errors=0 rtt=0/0 field14=9", healthSummary(append(h, 9)))
+}
+
+// TestHealthDevices checks, that the health records of several devices are kept apart.
+func TestHealthDevices(t *testing.T) {
+	record := func(device string, seq byte) {
+		p := &trexDec{}
+		p.Device = device
+		p.Trice.Strg = healthStrg
+		p.B = []byte{seq, 0, 0, 0, 0, 0, 0, 0}
+		p.ParamSpace = len(p.B)
+		_, ok := p.health32B(make([]byte, 1000))
+		assert.True(t, ok)
+	}
+	record("tcp:a", 1)
+	record("tcp:b", 5)
+	record("tcp:a", 2)
+	n, h := Health("tcp:a")
+	assert.Equal(t, uint64(2), n)
+	assert.Equal(t, []uint32{2, 0}, h)
+	n, h = Health("tcp:b")
+	assert.Equal(t, uint64(1), n)
+	assert.Equal(t, []uint32{5, 0}, h)
+	assert.Equal(t, []string{"tcp:a", "tcp:b"}, HealthDevices())
+}
@@ -0,0 +1,93 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package trexDecoder
+
+import (
+	"encoding/binary"
+	"fmt"
+	"strings"
+)
+
+// timingStrgs are the format strings of the TRICE_TIMING cycle histograms emitted by TriceLogTiming.
+// Only these get rendered as histogram, so user trice16B with a similar format string stay untouched.
+var timingStrgs = map[string]bool{
+	`timing:TRICE cycles %u\n`:            true,
+	`timing:critical section cycles %u\n`: true,
+	`timing:direct output cycles %u\n`:    true,
+	`timing:TriceTransfer cycles %u\n`:    true,
+}
+
+// timingBars are the sparkline characters from empty to full.
+var timingBars = []rune(" ▁▂▃▄▅▆▇█")
+
+// timingBound returns the cycle limit of log2 histogram bucket k, where the last bucket is open.
+// Bucket 0 counts 0-1 cycles, bucket k counts 2^k to 2^(k+1)-1 cycles.
+func timingBound(k, buckets int) string {
+	if k == buckets-1 {
+		return fmt.Sprint(">=", 1<<k)
+	}
+	return fmt.Sprint("<", 1<<(k+1))
+}
+
+// timingHistogram renders the log2 cycle histogram h as count, percentiles and a sparkline over the used bucket range.
+func timingHistogram(h []uint16) string {
+	var n, first, last, most int
+	first = -1
+	for k, c := range h {
+		n += int(c)
+		if c == 0 {
+			continue
+		}
+		if first < 0 {
+			first = k
+		}
+		last = k
+		if int(c) > most {
+			most = int(c)
+		}
+	}
+	if n == 0 {
+		return "n=0"
+	}
+	percentile := func(p int) string {
+		rank := (p*n + 99) / 100
+		var sum int
+		for k, c := range h {
+			sum += int(c)
+			if sum >= rank {
+				return timingBound(k, len(h))
+			}
+		}
+		return timingBound(last, len(h))
+	}
+	var s strings.Builder
+	fmt.Fprintf(&s, "n=%d p50%s p90%s p99%s max%s ", n, percentile(50), percentile(90), percentile(99), timingBound(last, len(h)))
+	lo := 0
+	if first > 0 {
+		lo = 1 << first
+	}
+	if last == len(h)-1 {
+		fmt.Fprintf(&s, "%d..:", lo)
+	} else {
+		fmt.Fprintf(&s, "%d..%d:", lo, 1<<(last+1)-1)
+	}
+	for _, c := range h[first : last+1] {
+		s.WriteRune(timingBars[(int(c)*(len(timingBars)-1)+most-1)/most])
+	}
+	return s.String()
+}
+
+// timing16B renders a TRICE_TIMING cycle histogram trice, if the format string is one of timingStrgs.
+func (p *trexDec) timing16B(b []byte) (n int, ok bool) {
+	if !timingStrgs[p.Trice.Strg] {
+		return 0, false
+	}
+	s := p.B[:p.ParamSpace]
+	h := make([]uint16, len(s)/2)
+	for i := range h {
+		h[i] = binary.LittleEndian.Uint16(s[2*i:])
+	}
+	name := strings.TrimSuffix(p.Trice.Strg, ` %u\n`)
+	return copy(b, name+" "+timingHistogram(h)+"\n"), true
+}
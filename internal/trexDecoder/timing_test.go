@@ -0,0 +1,41 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package trexDecoder
+
+import (
+	"testing"
+
+	"github.com/tj/assert"
+)
+
+// TestTimingHistogram checks the rendering of TRICE_TIMING cycle histograms.
+func TestTimingHistogram(t *testing.T) {
+	h := make([]uint16, 20)
+	assert.Equal(t, "n=0", timingHistogram(h))
+
+	h[8] = 10
+	assert.Equal(t, "n=10 p50<512 p90<512 p99<512 max<512 256..511:█", timingHistogram(h))
+
+	h[0], h[5], h[8], h[10] = 1, 80, 16, 3
+	assert.Equal(t, "n=100 p50<64 p90<512 p99<2048 max<2048 0..2047:▁    █  ▂ ▁", timingHistogram(h))
+
+	h = make([]uint16, 20)
+	h[19] = 0xFFFF
+	assert.Equal(t, "n=65535 p50>=524288 p90>=524288 p99>=524288 max>=524288 524288..:█", timingHistogram(h))
+}
+
+// TestTiming16B checks, that only the TRICE_TIMING format strings are rendered as histogram.
+func TestTiming16B(t *testing.T) {
+	p := &trexDec{}
+	p.B = []byte{0, 0, 2, 0, 0, 0}
+	p.ParamSpace = len(p.B)
+	b := make([]byte, 1000)
+	p.Trice.Strg = `timing:TriceTransfer cycles %u\n`
+	n, ok := p.timing16B(b)
+	assert.True(t, ok)
+	assert.Equal(t, "timing:TriceTransfer cycles n=2 p50<4 p90<4 p99<4 max<4 2..3:█\n", string(b[:n]))
+	p.Trice.Strg = `adc cycles %u\n`
+	_, ok = p.timing16B(b)
+	assert.False(t, ok)
+}
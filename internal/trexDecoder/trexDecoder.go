@@ -19,6 +19,8 @@ import (
 	"github.com/rokath/trice/internal/decoder"
 	"github.com/rokath/trice/internal/emitter"
 	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/internal/profile"
+	"github.com/rokath/trice/internal/receiver"
 	"github.com/rokath/trice/pkg/cipher"
 )
 
@@ -82,6 +84,7 @@ func init() {
 type trexDec struct {
 	decoder.DecoderData
 	cycle          uint8  // cycle date: c0...bf
+	initialCycle   bool   // initialCycle is a helper for the cycle counter automatic.
 	pFmt           string // modified trice format string: %u -> %d
 	u              []int  // 1: modified format string positions:  %u -> %d, 2: float (%f)
 	packageFraming int
@@ -97,6 +100,7 @@ func New(w io.Writer, lut id.TriceIDLookUp, m *sync.RWMutex, li id.TriceIDLookUp
 
 	p := &trexDec{}
 	p.cycle = 0xc0 // start value
+	p.initialCycle = true
 	p.W = w
 	p.In = in
 	p.IBuf = make([]byte, 0, decoder.DefaultSize)     // len 0
@@ -135,6 +139,7 @@ func (p *trexDec) nextData() {
 	if err != nil && err != io.EOF {        // some serious error
 		log.Fatal("ERROR:internal reader error\a", err) // exit
 	}
+	Counters.Bytes.Add(uint64(m))
 }
 
 // nextPackage reads with an inner reader a TCOBSv1 encoded byte stream.
@@ -155,6 +160,13 @@ func (p *trexDec) nextPackage() {
 		if err != nil && err != io.EOF {              // some serious error
 			log.Fatal("ERROR:internal reader error\a", err) // exit
 		}
+		Counters.Bytes.Add(uint64(m))
+		if s, ok := receiver.Source(p.In).(receiver.CycleSyncer); ok && m > 0 {
+			if cycle, gap := s.CycleSync(); gap { // The input skipped data, like an index query, so expect its cycle.
+				p.cycle = cycle
+				p.initialCycle = false
+			}
+		}
 		index = bytes.IndexByte(p.IBuf, 0) // find terminating 0
 		if index == -1 {                   // p.IBuf has no complete COBS data, so leave
 			// Even err could be io.EOF, some valid data possibly in p.iBUf.
@@ -171,6 +183,7 @@ func (p *trexDec) nextPackage() {
 		decoder.Dump(p.W, p.IBuf[:index+1])
 	}
 
+	start, frameSize := profile.Now(), index+1
 	frame := p.IBuf[:index]
 
 	switch p.packageFraming {
@@ -180,6 +193,7 @@ func (p *trexDec) nextPackage() {
 		n, e := cobs.Decode(p.B, frame) // if index is 0, an empty buffer is decoded
 		p.IBuf = p.IBuf[index+1:]       // step forward (next package data in p.IBuf now, if any)
 		if e != nil {
+			Counters.FramingErrors.Add(1)
 			if decoder.Verbose {
 				fmt.Println("\ainconsistent COBS buffer!") // show also terminating 0
 			}
@@ -192,6 +206,7 @@ func (p *trexDec) nextPackage() {
 		n, e := tcobs.Decode(p.B, frame) // if index is 0, an empty buffer is decoded
 		// from merging: p.IBuf = p.IBuf[index+1:]        // step forward (next package data in p.IBuf now, if any)
 		if e != nil {
+			Counters.FramingErrors.Add(1)
 			fmt.Println("\ainconsistent TCOBSv1 buffer!")
 
 			// remove 3 lines if they exist
@@ -253,6 +268,11 @@ func (p *trexDec) nextPackage() {
 			decoder.Dump(p.W, p.B)
 		}
 	}
+	Counters.Packages.Add(1)
+	if x, ok := p.Exporter.(decoder.PackageExporter); ok {
+		x.ExportPackage(frameSize)
+	}
+	profile.Deframe.Done(start, 1, frameSize)
 }
 
 func isZero(bytes []byte) bool {
@@ -330,13 +350,13 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 
 	triceType := int(tyId >> decoder.IDBits) // most significant bit are the triceType
 	triceID := id.TriceID(0x3FFF & tyId)     // 14 least significant bits are the ID
-	decoder.LastTriceID = triceID            // used for showID
+	p.LastTriceID = triceID                  // used for showID
 
 	switch triceType {
 	case typeS0: // no timestamp
-		decoder.TargetTimestampSize = 0
+		p.TargetTimestampSize = 0
 	case typeS2: // 16-bit stamp
-		decoder.TargetTimestampSize = 2
+		p.TargetTimestampSize = 2
 		if Doubled16BitID { // p.packageFraming == packageFramingNone || cipher.Password != "" {
 			if len(p.B) < 2 {
 				return // wait for more data
@@ -346,7 +366,7 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 			p.B = p.B[tyIdSize:] // When target encoding is done, it removes the double 16-bit ID at the 16-bit timestamp trices.
 		}
 	case typeS4: // 32-bit stamp
-		decoder.TargetTimestampSize = 4
+		p.TargetTimestampSize = 4
 	case typeX0: // extended trice type X0
 		if p.packageFraming == packageFramingNone {
 			// typeX0 is not supported (yet)
@@ -361,23 +381,23 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 		p.B = p.removeZeroHiByte(packed)
 	}
 
-	if packageSize < tyIdSize+decoder.TargetTimestampSize+ncSize { // for non typeEX trices
+	if packageSize < tyIdSize+p.TargetTimestampSize+ncSize { // for non typeEX trices
 		return // not enough data
 	}
 
 	// try to interpret
 	if triceType == typeS0 {
-		decoder.TargetTimestamp = 0
+		p.TargetTimestamp = 0
 	} else if triceType == typeS2 { // 16-bit stamp
-		decoder.TargetTimestamp = uint64(p.ReadU16(p.B))
+		p.TargetTimestamp = uint64(p.ReadU16(p.B))
 	} else if triceType == typeS4 { // 32-bit stamp
-		decoder.TargetTimestamp = uint64(p.ReadU32(p.B))
+		p.TargetTimestamp = uint64(p.ReadU32(p.B))
 		//} else if triceType == typeS8 { // 64-bit stamp
-		//	decoder.TargetTimestamp = uint64(p.ReadU64(p.B))
+		//	p.TargetTimestamp = uint64(p.ReadU64(p.B))
 	} else {
 		log.Fatal("triceType ", triceType, " not implemented (hint: IDBits value?)")
 	}
-	p.B = p.B[decoder.TargetTimestampSize:]
+	p.B = p.B[p.TargetTimestampSize:]
 
 	if len(p.B) < 2 {
 		return // wait for more data
@@ -396,9 +416,10 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 		p.ParamSpace = int(nc >> 8) // high byte is 7 bit number of bytes for data count excluding timestamp
 	}
 
-	p.TriceSize = tyIdSize + decoder.TargetTimestampSize + ncSize + p.ParamSpace
+	p.TriceSize = tyIdSize + p.TargetTimestampSize + ncSize + p.ParamSpace
 	if p.TriceSize > packageSize { //  '>' for multiple trices in one package (case TriceOutMultiPackMode), todo: discuss all possible variants
 		if p.packageFraming == packageFramingNone {
+			Counters.FramingErrors.Add(1)
 			if decoder.Verbose {
 				n += copy(b[n:], fmt.Sprintln("wrn:\adiscarding first byte", p.B0[0], "from", hex.Dump(p.B0)))
 			}
@@ -406,39 +427,44 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 			p.B = p.B0
 			return
 		}
+		Counters.DecodeErrors.Add(1)
 		if decoder.Verbose {
 			n += copy(b[n:], fmt.Sprintln("ERROR:\apackage size", packageSize, "is <", p.TriceSize, " - ignoring package:"))
 			n += copy(b[n:], fmt.Sprintln(hex.Dump(p.B)))
-			n += copy(b[n:], fmt.Sprintln("tyIdSize=", tyIdSize, "tsSize=", decoder.TargetTimestampSize, "ncSize=", ncSize, "ParamSpae=", p.ParamSpace))
+			n += copy(b[n:], fmt.Sprintln("tyIdSize=", tyIdSize, "tsSize=", p.TargetTimestampSize, "ncSize=", ncSize, "ParamSpae=", p.ParamSpace))
 			n += copy(b[n:], fmt.Sprintln(decoder.Hints))
 		}
 		p.B = p.B[len(p.B):] // discard buffer
 	}
 
 	// cycle counter automatic & check
-	if cycle == 0xc0 && p.cycle != 0xc0 && decoder.InitialCycle { // with cycle counter and seems to be a target reset
+	if cycle == 0xc0 && p.cycle != 0xc0 && p.initialCycle { // with cycle counter and seems to be a target reset
 		n += copy(b[n:], fmt.Sprintln("warning:\a   Target Reset?   "))
 		p.cycle = cycle + 1 // adjust cycle
-		decoder.InitialCycle = false
+		p.initialCycle = false
 	}
-	if cycle == 0xc0 && p.cycle != 0xc0 && !decoder.InitialCycle { // with cycle counter and seems to be a target reset
+	if cycle == 0xc0 && p.cycle != 0xc0 && !p.initialCycle { // with cycle counter and seems to be a target reset
 		//n += copy(b[n:], fmt.Sprintln("info:   Target Reset?   ")) // todo: This line is ok with cycle counter but not without cycle counter
 		p.cycle = cycle + 1 // adjust cycle
 	}
-	if cycle == 0xc0 && p.cycle == 0xc0 && decoder.InitialCycle { // with or without cycle counter and seems to be a target reset
+	if cycle == 0xc0 && p.cycle == 0xc0 && p.initialCycle { // with or without cycle counter and seems to be a target reset
 		//n += copy(b[n:], fmt.Sprintln("warning:   Restart?   "))
 		p.cycle = cycle + 1 // adjust cycle
-		decoder.InitialCycle = false
+		p.initialCycle = false
 	}
-	if cycle == 0xc0 && p.cycle == 0xc0 && !decoder.InitialCycle { // with or without cycle counter and seems to be a normal case
+	if cycle == 0xc0 && p.cycle == 0xc0 && !p.initialCycle { // with or without cycle counter and seems to be a normal case
 		p.cycle = cycle + 1 // adjust cycle
 	}
 	if cycle != 0xc0 { // with cycle counter and s.th. lost
 		if cycle != p.cycle { // no cycle check for 0xc0 to avoid messages on every target reset and when no cycle counter is active
-			n += copy(b[n:], fmt.Sprint("CYCLE:\a", cycle, "!=", p.cycle, " # ", emitter.ColorChannelEvents("CYCLE")+1, " # "))
+			Counters.CycleGaps.Add(1)
+			n += copy(b[n:], fmt.Sprint("CYCLE:\a", cycle, "!=", p.cycle, " # ", emitter.ColorChannelEvents(p.Device, "CYCLE")+1, " # "))
+			if x, ok := p.Exporter.(decoder.GapExporter); ok {
+				x.ExportGap()
+			}
 			p.cycle = cycle // adjust cycle
 		}
-		decoder.InitialCycle = false
+		p.initialCycle = false
 		p.cycle++
 	}
 
@@ -451,12 +477,14 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 	p.LutMutex.RUnlock()
 	if !ok {
 		if p.packageFraming == packageFramingNone {
+			Counters.FramingErrors.Add(1)
 			if decoder.Verbose {
 				n += copy(b[n:], fmt.Sprintln("wrn:\adiscarding first byte", p.B0[0], "from", hex.Dump(p.B0)))
 			}
 			p.B0 = p.B0[1:] // discard first byte and try again
 			p.B = p.B0
 		} else {
+			Counters.UnknownIDs.Add(1)
 			n += copy(b[n:], fmt.Sprintln("WARNING:\aunknown ID ", triceID, "- ignoring trice ending with", hex.Dump(p.B)))
 			n += copy(b[n:], fmt.Sprintln(decoder.Hints))
 			p.B = p.B[:0] // discard all
@@ -464,7 +492,17 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 		return
 	}
 
-	n += p.sprintTrice(b[n:]) // use param info
+	if len(p.B) >= p.ParamSpace {
+		countTrice(triceID, p.TriceSize)
+	}
+	if p.Exporter == nil {
+		start := profile.Now()
+		m := p.sprintTrice(b[n:]) // use param info
+		profile.Format.Done(start, 1, m)
+		n += m
+	} else if len(p.B) >= p.ParamSpace {
+		p.Exporter.Export(triceID, p.TargetTimestamp, p.TargetTimestampSize, p.B[:p.ParamSpace])
+	}
 	if len(p.B) < p.ParamSpace {
 		if p.packageFraming == packageFramingNone {
 			if decoder.Verbose {
@@ -473,6 +511,7 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 			p.B0 = p.B0[1:] // discard first byte and try again
 			p.B = p.B0
 		} else {
+			Counters.DecodeErrors.Add(1)
 			n += copy(b[n:], fmt.Sprintln("ERROR:ignoring data garbage", hex.Dump(p.B)))
 			n += copy(b[n:], fmt.Sprintln(decoder.Hints))
 			p.B = p.B[:0] // discard all
@@ -498,8 +537,16 @@ func (p *trexDec) Read(b []byte) (n int, err error) {
 func (p *trexDec) sprintTrice(b []byte) (n int) {
 	p.pFmt, p.u = decoder.UReplaceN(p.Trice.Strg)
 
+	switch { // A span trice has only a name and no format string.
+	case strings.HasSuffix(p.Trice.Type, "SpanEnter"):
+		p.pFmt, p.u = "trace:>"+p.Trice.Strg+`\n`, nil
+	case strings.HasSuffix(p.Trice.Type, "SpanExit"):
+		p.pFmt, p.u = "trace:<"+p.Trice.Strg+`\n`, nil
+	}
 	p.Trice.Type = strings.TrimSuffix(p.Trice.Type, "AssertTrue")
 	p.Trice.Type = strings.TrimSuffix(p.Trice.Type, "AssertFalse")
+	p.Trice.Type = strings.TrimSuffix(p.Trice.Type, "SpanEnter")
+	p.Trice.Type = strings.TrimSuffix(p.Trice.Type, "SpanExit")
 	triceType := p.Trice.Type
 	// need to reconstruct full TRICE info, if not exist in type string
 	for _, name := range []string{"TRICE", "TRice", "Trice", "trice"} {
@@ -555,18 +602,18 @@ func (p *trexDec) sprintTrice(b []byte) (n int) {
 		ignoreSpecialCase:
 			ss := strings.Split(p.pFmt, `\n`)
 			if len(ss) >= 3 { // at least one "\n" before "\n" line end
-				if decoder.NewlineIndent == -1 { // auto sense
-					decoder.NewlineIndent = 12 + 1 // todo: strings.SplitN & len(decoder.TargetStamp0) // 12
+				spaces := decoder.NewlineIndent
+				if spaces == -1 { // auto sense, local to avoid a shared write, when several decoders run in parallel
+					spaces = 12 + 1 // todo: strings.SplitN & len(decoder.TargetStamp0) // 12
 					if !(id.LIFnJSON == "off" || id.LIFnJSON == "none") {
-						decoder.NewlineIndent += 28 /* todo: length(decoder.LocationInformationFormatString), see https://stackoverflow.com/questions/32987215/find-numbers-in-string-using-golang-regexp*/
+						spaces += 28 /* todo: length(decoder.LocationInformationFormatString), see https://stackoverflow.com/questions/32987215/find-numbers-in-string-using-golang-regexp*/
 						// todo: split channel info with format specifiers too, example: ["msg:%d\nsignal:%x %u\n", p0, p1, p2] -> ["msg:%d\n", p0] && ["signal:%x %u\n", p1, p2]
 					}
 					if decoder.ShowID != "" {
-						decoder.NewlineIndent += 5 // todo: automatic
+						spaces += 5 // todo: automatic
 					}
 				}
 				skip := `\n`
-				spaces := decoder.NewlineIndent
 				for spaces > 0 {
 					skip += " "
 					spaces--
@@ -726,6 +773,9 @@ func (p *trexDec) trice16B(b []byte, _ int, _ int) (n int) {
 	if decoder.DebugOut {
 		fmt.Fprintln(p.W, p.B)
 	}
+	if n, ok := p.timing16B(b); ok {
+		return n
+	}
 	s := p.B[:p.ParamSpace]
 
 	before, after, found := strings.Cut(p.Trice.Strg, ":")
@@ -752,6 +802,9 @@ func (p *trexDec) trice32B(b []byte, _ int, _ int) (n int) {
 	if decoder.DebugOut {
 		fmt.Fprintln(p.W, p.B)
 	}
+	if n, ok := p.health32B(b); ok {
+		return n
+	}
 	s := p.B[:p.ParamSpace]
 
 	before, after, found := strings.Cut(p.Trice.Strg, ":")
@@ -863,7 +916,7 @@ func (p *trexDec) unSignedOrSignedOut(b []byte, bitwidth, count int) int {
 	if len(p.u) != count {
 		return copy(b, fmt.Sprintln("ERROR: Invalid format specifier count inside", p.Trice.Type, p.Trice.Strg))
 	}
-	v := make([]interface{}, 32768) // theoretical 2^15 bytes could arrive
+	v := make([]interface{}, len(p.u)) // one value per format specifier
 	switch bitwidth {
 	case 8:
 		for i, f := range p.u {
@@ -12,6 +12,7 @@ import (
 	"sync"
 	"testing"
 
+	cobs "github.com/rokath/cobs/go"
 	"github.com/rokath/trice/internal/decoder"
 	"github.com/rokath/trice/internal/id"
 	"github.com/tj/assert"
@@ -53,7 +54,7 @@ func doTableTest(t *testing.T, out io.Writer, f decoder.New, endianness bool, te
 				break
 			}
 			if decoder.ShowID != "" && lineStart {
-				act += fmt.Sprintf(decoder.ShowID, decoder.LastTriceID)
+				act += fmt.Sprintf(decoder.ShowID, dec.LastID())
 			}
 			act += fmt.Sprint(string(buf[:n]))
 			lineStart = false
@@ -77,3 +78,39 @@ func TestTREX(t *testing.T) {
 	doTableTest(t, &out, New, decoder.LittleEndian, tt)
 	assert.Equal(t, "", out.String())
 }
+
+// gapRecorder is a decoder.GapExporter recording the exported trice IDs and the gaps.
+type gapRecorder struct {
+	events []string
+}
+
+func (p *gapRecorder) Export(tid id.TriceID, _ uint64, _ int, _ []byte) {
+	p.events = append(p.events, fmt.Sprint(tid))
+}
+
+func (p *gapRecorder) ExportGap() {
+	p.events = append(p.events, "gap")
+}
+
+// TestExportGap checks, that a cycle counter gap is passed to the exporter before the first trice after the gap.
+func TestExportGap(t *testing.T) {
+	defer func(framing string) { decoder.PackageFraming = framing }(decoder.PackageFraming)
+	decoder.PackageFraming = "COBS"
+	ilu := id.TriceIDLookUp{3713: {Type: "TRICE16", Strg: "select = %d\\n"}}
+	ilu.AddFmtCount(io.Discard)
+	var in []byte
+	frame := make([]byte, 32)
+	for _, cycle := range []byte{0xc0, 0xc1, 0xc5, 0xc6} { // 0xc2...0xc4 are lost
+		//               idLo  idHi  tsLo  tsHi  cycle  count vLo   vHi
+		n := cobs.Encode(frame, []byte{0x81, 0x8e, 0x09, 0x23, cycle, 0x02, 0xb8, 0x01})
+		in = append(append(in, frame[:n]...), 0)
+	}
+	dec := New(io.Discard, ilu, new(sync.RWMutex), nil, bytes.NewReader(in), decoder.LittleEndian)
+	x := &gapRecorder{}
+	dec.(interface{ SetExporter(decoder.Exporter) }).SetExporter(x)
+	buf := make([]byte, decoder.DefaultSize)
+	for i := 0; i < 10; i++ {
+		_, _ = dec.Read(buf)
+	}
+	assert.Equal(t, []string{"3713", "3713", "gap", "3713", "3713"}, x.events)
+}
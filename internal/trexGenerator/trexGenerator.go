@@ -0,0 +1,337 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+// Package trexGenerator produces binary trice streams like target code in TREX encoding does.
+//
+// The trices are taken from an ID list, usually a til.json, and get random parameter values. The ID distribution,
+// the size of the string and buffer parameters, the stamp sizes, the package framing, the multi pack mode and
+// the XTEA encryption are selectable. The streams are meant for decoder tests and benchmarks without target hardware.
+package trexGenerator
+
+import (
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"math/rand"
+	"sort"
+	"strconv"
+	"strings"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/rokath/trice/internal/decoder"
+	"github.com/rokath/trice/internal/id"
+	"github.com/rokath/trice/pkg/cipher"
+)
+
+// Options are the generator settings. The zero value produces uniformly distributed COBS framed single trice packages.
+type Options struct {
+	Distribution   string  // Distribution is "uniform" (default) or "zipf", where a few IDs occur most of the time.
+	ZipfS          float64 // ZipfS is the zipf exponent > 1, 1.1 if not set. Bigger values concentrate more on the first IDs.
+	StringSize     int     // StringSize is the maximum byte count of string and buffer parameters. Each trice gets a random size.
+	Stamps         string  // Stamps is "auto" (default), "0", "16" or "32". With "auto" the trice names select the stamp size.
+	Framing        string  // Framing is "COBS" (default), "TCOBS" or "NONE".
+	MultiPack      int     // MultiPack is the maximum trice count per package. Values below 2 mean single pack mode.
+	XTEA           bool    // XTEA encrypts the packages with the cipher set by cipher.SetUp.
+	Doubled16BitID bool    // Doubled16BitID transmits the ID twice in 16-bit stamped trices, what framing NONE needs.
+	NoCycle        bool    // NoCycle transmits 0xc0 instead of a cycle counter.
+	BigEndian      bool    // BigEndian writes the trice data in big endian order.
+	Seed           int64   // Seed initializes the random values, so equal options give equal streams.
+}
+
+// Parameter kinds
+const (
+	kindValues   = iota // count values with bitWidth each
+	kindString          // TRICE_S or TRICE_N string
+	kindBuffer          // TRICE_B buffer with bitWidth elements
+	kindFunction        // TRICE_F function call with bitWidth parameters, displayed as own line
+)
+
+// triceInfo is the wire layout of one ID.
+type triceInfo struct {
+	id        id.TriceID
+	stampBits int // stampBits is 0, 16 or 32.
+	kind      int
+	bitWidth  int
+	count     int // count is the values count for kindValues.
+	lines     int // lines is the count of output lines completed by the trice.
+}
+
+// Generator produces trice packages. It is not safe for concurrent use.
+type Generator struct {
+	o      Options
+	order  binary.AppendByteOrder
+	trices []triceInfo
+	rnd    *rand.Rand
+	zipf   *rand.Zipf
+	cycle  uint8
+	stamp  uint32
+	pkg    []byte // pkg holds the unframed package data.
+	frame  []byte // frame holds the framed package.
+}
+
+// New returns a Generator for the trices in lut. IDs with types, which the target code cannot produce in TREX encoding,
+// like trices with more than 12 values, are not used. New returns an error, when no ID remains or the options are invalid.
+func New(lut id.TriceIDLookUp, o Options) (*Generator, error) {
+	p := &Generator{o: o, order: binary.LittleEndian, cycle: 0xc0}
+	if o.BigEndian {
+		p.order = binary.BigEndian
+	}
+	switch p.o.Framing = strings.ToUpper(o.Framing); p.o.Framing {
+	case "":
+		p.o.Framing = "COBS"
+	case "COBS", "TCOBS":
+	case "TCOBSV1":
+		p.o.Framing = "TCOBS"
+	case "NONE":
+		if o.XTEA || o.MultiPack > 1 {
+			return nil, errors.New("framing NONE allows neither XTEA nor multi pack mode")
+		}
+		if !o.Doubled16BitID {
+			return nil, errors.New("framing NONE needs doubled 16-bit IDs")
+		}
+	default:
+		return nil, fmt.Errorf("unknown framing %q", o.Framing)
+	}
+	ids := make([]id.TriceID, 0, len(lut))
+	for tid := range lut {
+		ids = append(ids, tid)
+	}
+	sort.Slice(ids, func(i, j int) bool { return ids[i] < ids[j] })
+	for _, tid := range ids {
+		ti, err := newTriceInfo(tid, lut[tid], p.o.Stamps)
+		if err != nil {
+			continue
+		}
+		p.trices = append(p.trices, ti)
+	}
+	if len(p.trices) == 0 {
+		return nil, errors.New("no usable trice ID")
+	}
+	p.rnd = rand.New(rand.NewSource(o.Seed))
+	p.rnd.Shuffle(len(p.trices), func(i, j int) { p.trices[i], p.trices[j] = p.trices[j], p.trices[i] }) // random IDs are frequent with zipf
+	switch o.Distribution {
+	case "", "uniform":
+	case "zipf":
+		s := o.ZipfS
+		if s == 0 {
+			s = 1.1
+		}
+		if s <= 1 {
+			return nil, fmt.Errorf("zipf exponent %g is not > 1", s)
+		}
+		p.zipf = rand.NewZipf(p.rnd, s, 1, uint64(len(p.trices)-1))
+	default:
+		return nil, fmt.Errorf("unknown distribution %q", o.Distribution)
+	}
+	return p, nil
+}
+
+// newTriceInfo returns the wire layout of the trice tf with ID tid.
+// Examples for tf.Type: trice, Trice8, TRice16_2, TRICE_S, TRICE_N, TRICE8_B, TRICE32_F, trice8B.
+func newTriceInfo(tid id.TriceID, tf id.TriceFmt, stamps string) (ti triceInfo, err error) {
+	ti.id = tid
+	ti.lines = strings.Count(tf.Strg, `\n`)
+	switch stamps {
+	case "", "auto":
+		switch {
+		case strings.HasPrefix(tf.Type, "trice"):
+			ti.stampBits = 0
+		case strings.HasPrefix(tf.Type, "Trice"):
+			ti.stampBits = 16
+		default: // TRice and TRICE, which gets its stamp size from the ID macro in the target code
+			ti.stampBits = 32
+		}
+	case "0", "16", "32":
+		ti.stampBits, _ = strconv.Atoi(stamps)
+	default:
+		return ti, fmt.Errorf("unknown stamps %q", stamps)
+	}
+	t := strings.ToUpper(tf.Type)
+	if !strings.HasPrefix(t, "TRICE") || strings.Contains(t, "ASSERT") {
+		return ti, fmt.Errorf("unsupported type %s", tf.Type)
+	}
+	t = t[len("TRICE"):]
+	i := strings.IndexFunc(t, func(r rune) bool { return r < '0' || '9' < r })
+	if i < 0 {
+		i = len(t)
+	}
+	ti.bitWidth, _ = strconv.Atoi(id.DefaultTriceBitWidth)
+	if i > 0 {
+		ti.bitWidth, _ = strconv.Atoi(t[:i])
+	}
+	switch rest := strings.TrimPrefix(t[i:], "_"); {
+	case rest == "":
+		_, u := decoder.UReplaceN(tf.Strg)
+		ti.count = len(u)
+	case rest == "S" || rest == "N" || rest == "S_1" || rest == "N_1":
+		ti.kind, ti.bitWidth = kindString, 8
+	case rest == "B" || rest == "F" || rest == "B_1" || rest == "F_1":
+		ti.kind = kindBuffer
+		if rest[0] == 'F' {
+			ti.kind = kindFunction
+			ti.lines++
+		}
+		if i == 0 {
+			ti.bitWidth = 8
+		}
+	default:
+		if ti.count, err = strconv.Atoi(rest); err != nil {
+			return ti, fmt.Errorf("unsupported type %s", tf.Type)
+		}
+	}
+	if ti.bitWidth != 8 && ti.bitWidth != 16 && ti.bitWidth != 32 && ti.bitWidth != 64 || ti.count > 12 {
+		return ti, fmt.Errorf("unsupported type %s", tf.Type)
+	}
+	return
+}
+
+// Append appends the next framed package to b and returns the result together with the count of trices in the
+// package and the count of output lines they complete.
+func (p *Generator) Append(b []byte) (_ []byte, trices, lines int) {
+	trices = 1
+	if p.o.MultiPack > 1 {
+		trices += p.rnd.Intn(p.o.MultiPack)
+	}
+	p.pkg = p.pkg[:0]
+	for i := 0; i < trices; i++ {
+		ti := &p.trices[p.next()]
+		p.appendTrice(ti)
+		lines += ti.lines
+	}
+	if p.o.Framing == "NONE" {
+		return append(b, p.pkg...), trices, lines
+	}
+	if p.o.XTEA {
+		for len(p.pkg)%8 != 0 {
+			p.pkg = append(p.pkg, 0)
+		}
+		for i := 0; i < len(p.pkg); i += 8 {
+			copy(p.pkg[i:], cipher.Encrypt8(p.pkg[i:i+8]))
+		}
+	}
+	if p.o.Framing == "COBS" {
+		if cap(p.frame) < len(p.pkg)+len(p.pkg)/254+2 {
+			p.frame = make([]byte, 2*len(p.pkg)+2)
+		}
+		n := cobs.Encode(p.frame[:cap(p.frame)], p.pkg)
+		b = append(b, p.frame[:n]...)
+	} else {
+		b = tcobsAppend(b, p.pkg)
+	}
+	return append(b, 0), trices, lines
+}
+
+// next returns the index of the next trice.
+func (p *Generator) next() int {
+	if p.zipf != nil {
+		return int(p.zipf.Uint64())
+	}
+	return p.rnd.Intn(len(p.trices))
+}
+
+// appendTrice appends one trice with random parameters to p.pkg like the target code macros do.
+func (p *Generator) appendTrice(ti *triceInfo) {
+	o := p.order
+	p.stamp += uint32(p.rnd.Intn(1000))
+	switch ti.stampBits {
+	case 0:
+		p.pkg = o.AppendUint16(p.pkg, 1<<14|uint16(ti.id))
+	case 16:
+		p.pkg = o.AppendUint16(p.pkg, 2<<14|uint16(ti.id))
+		if p.o.Doubled16BitID {
+			p.pkg = o.AppendUint16(p.pkg, 2<<14|uint16(ti.id))
+		}
+		p.pkg = o.AppendUint16(p.pkg, uint16(p.stamp))
+	case 32:
+		p.pkg = o.AppendUint32(o.AppendUint16(p.pkg, 3<<14|uint16(ti.id)), p.stamp)
+	}
+	var size int
+	switch ti.kind {
+	case kindValues:
+		size = ti.count * ti.bitWidth >> 3
+	case kindString:
+		size = p.rnd.Intn(p.o.StringSize + 1)
+	case kindBuffer, kindFunction:
+		size = p.rnd.Intn(p.o.StringSize/(ti.bitWidth>>3)+1) * ti.bitWidth >> 3
+	}
+	cycle := p.cycle
+	if p.o.NoCycle {
+		cycle = 0xc0
+	} else {
+		p.cycle++
+	}
+	if size > 127 {
+		p.pkg = o.AppendUint16(p.pkg, 0x8000|uint16(size)) // The cycle is not transmitted.
+	} else {
+		p.pkg = o.AppendUint16(p.pkg, uint16(size)<<8|uint16(cycle))
+	}
+	switch ti.kind {
+	case kindString:
+		for i := 0; i < size; i++ {
+			p.pkg = append(p.pkg, byte('a'+p.rnd.Intn(26)))
+		}
+	default:
+		for i := 0; i < size; i += ti.bitWidth >> 3 {
+			v := p.rnd.Uint64()
+			switch ti.bitWidth {
+			case 8:
+				p.pkg = append(p.pkg, byte(v))
+			case 16:
+				p.pkg = o.AppendUint16(p.pkg, uint16(v))
+			case 32:
+				p.pkg = o.AppendUint32(p.pkg, uint32(v))
+			case 64:
+				p.pkg = o.AppendUint64(p.pkg, v)
+			}
+		}
+	}
+	if p.o.Framing == "NONE" {
+		for len(p.pkg)%4 != 0 { // The target code pads the parameters to full 32-bit words.
+			p.pkg = append(p.pkg, 0)
+		}
+	}
+}
+
+// tcobsAppend appends the TCOBSv1 encoding of src to b. Only the noop, zero and 0xFF sigils are used,
+// so the result is a valid TCOBSv1 frame, but can be a bit longer than the target code encoding with repeat sigils.
+func tcobsAppend(b, src []byte) []byte {
+	const (
+		n  = 0xA0 // noop sigil byte
+		z1 = 0x20 // 1-zero sigil byte
+		f2 = 0xC0 // 2-FF sigil byte
+	)
+	zeroSigils := [...]byte{z1, 0x40, 0x60} // 1, 2 and 3 zeroes
+	ffSigils := [...]byte{f2, 0xE0, 0x80}   // 2, 3 and 4 0xFF bytes
+	literals := 0                           // literals is the count of bytes since the last sigil.
+	for i := 0; i < len(src); {
+		run := func(v byte, max int) (k int) { // run returns the count of v bytes starting at i.
+			for k < max && i+k < len(src) && src[i+k] == v {
+				k++
+			}
+			return
+		}
+		if k := run(0, 3); k > 0 {
+			b = append(b, zeroSigils[k-1]|byte(literals))
+			literals = 0
+			i += k
+			continue
+		}
+		if k := run(0xFF, 4); k > 1 {
+			b = append(b, ffSigils[k-2]|byte(literals))
+			literals = 0
+			i += k
+			continue
+		}
+		if literals == 31 { // maximum sigil offset
+			b = append(b, n|31)
+			literals = 0
+		}
+		b = append(b, src[i])
+		literals++
+		i++
+	}
+	if literals > 0 {
+		b = append(b, n|byte(literals))
+	}
+	return b
+}
@@ -0,0 +1,90 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package trexGenerator
+
+import (
+	"bytes"
+	"math/rand"
+	"testing"
+
+	cobs "github.com/rokath/cobs/go"
+	"github.com/rokath/tcobs/v1"
+	"github.com/rokath/trice/internal/id"
+	"github.com/tj/assert"
+)
+
+// TestTCOBSRoundTrip checks, that the TCOBS encoding decodes back and contains no zeroes.
+func TestTCOBSRoundTrip(t *testing.T) {
+	rnd := rand.New(rand.NewSource(1))
+	for i := 0; i < 1000; i++ {
+		src := make([]byte, rnd.Intn(200))
+		for k := range src {
+			switch rnd.Intn(4) {
+			case 0:
+				src[k] = 0
+			case 1:
+				src[k] = 0xFF
+			default:
+				src[k] = byte(rnd.Intn(256))
+			}
+		}
+		enc := tcobsAppend(nil, src)
+		assert.Equal(t, -1, bytes.IndexByte(enc, 0), enc)
+		d := make([]byte, 512)
+		n, err := tcobs.Decode(d, enc)
+		assert.Nil(t, err)
+		assert.Equal(t, src, d[len(d)-n:])
+	}
+}
+
+// TestAppend checks the package layout of single and multi pack mode.
+func TestAppend(t *testing.T) {
+	lut := id.TriceIDLookUp{
+		100: {Type: "TRice16", Strg: "msg:%d %d\\n"},
+		101: {Type: "trice_S", Strg: "%s"},
+		102: {Type: "TRICE_ASSERTTRUE", Strg: "not usable"},
+	}
+	g, err := New(lut, Options{Stamps: "16", StringSize: 4})
+	assert.Nil(t, err)
+	assert.Equal(t, 2, len(g.trices))
+	d := make([]byte, 64)
+	for i := 0; i < 100; i++ {
+		b, trices, lines := g.Append(nil)
+		assert.Equal(t, 1, trices)
+		assert.Equal(t, byte(0), b[len(b)-1])
+		n, err := cobs.Decode(d, b[:len(b)-1])
+		assert.Nil(t, err)
+		pkg := d[:n]
+		assert.Equal(t, uint16(2), uint16(pkg[1]>>6), "16-bit stamp")
+		switch pkg[0] {
+		case 100:
+			assert.Equal(t, 1, lines)
+			assert.Equal(t, []byte{0xc0 + byte(i), 4}, pkg[4:6], "cycle and count")
+			assert.Equal(t, 10, len(pkg))
+		case 101:
+			assert.Equal(t, 0, lines)
+			assert.True(t, pkg[5] <= 4)
+			assert.Equal(t, 6+int(pkg[5]), len(pkg))
+		}
+	}
+
+	g, err = New(lut, Options{MultiPack: 4, Framing: "tcobs"})
+	assert.Nil(t, err)
+	var trices int
+	for i := 0; i < 100; i++ {
+		var n int
+		_, n, _ = g.Append(nil)
+		assert.True(t, 1 <= n && n <= 4)
+		trices += n
+	}
+	assert.True(t, trices > 150)
+
+	_, err = New(lut, Options{Framing: "NONE"})
+	assert.NotNil(t, err, "no doubled IDs")
+	g, err = New(lut, Options{Framing: "NONE", Doubled16BitID: true, Stamps: "16", StringSize: 3})
+	assert.Nil(t, err)
+	b, _, _ := g.Append(nil)
+	assert.Equal(t, 0, len(b)%4)
+	assert.Equal(t, b[:2], b[2:4], "doubled ID")
+}
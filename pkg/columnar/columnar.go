@@ -0,0 +1,175 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+// Package columnar writes and reads decoded numeric trice parameters in a columnar binary layout.
+//
+// A columnar file starts with the Magic line, followed by the little endian uint32 length of the JSON encoded Schema
+// and the schema itself. Then chunks follow. Each chunk starts with the little endian uint16 trice ID and uint32 row count.
+// Then all values of the stamp column and afterwards all values of each parameter column follow, column by column.
+// All values are little endian with the column type size. A trice ID has one column group and usually several chunks.
+package columnar
+
+import (
+	"encoding/binary"
+	"fmt"
+	"math"
+	"strconv"
+)
+
+// Magic is the first line of each columnar file.
+const Magic = "TRICE-COLUMNS-1\n"
+
+// ChunkRows is the maximum row count of a chunk.
+const ChunkRows = 4096
+
+// chunkHeaderSize is the byte count of the trice ID and the row count in front of each chunk.
+const chunkHeaderSize = 6
+
+// Type is a column value type: "u8", "u16", "u32", "u64" for unsigned, "i8" ... "i64" for signed,
+// "f32", "f64" for float and "b8" ... "b64" for bool values with the target bit width.
+type Type string
+
+// Size returns the byte count of a t value or 0 for an invalid type.
+func (t Type) Size() int {
+	if len(t) < 2 {
+		return 0
+	}
+	switch t[0] {
+	case 'u', 'i', 'b', 'f':
+	default:
+		return 0
+	}
+	bits, err := strconv.Atoi(string(t[1:]))
+	if err != nil {
+		return 0
+	}
+	switch {
+	case t[0] == 'f' && (bits == 32 || bits == 64):
+	case t[0] != 'f' && (bits == 8 || bits == 16 || bits == 32 || bits == 64):
+	default:
+		return 0
+	}
+	return bits >> 3
+}
+
+// Column describes a parameter column.
+type Column struct {
+	Name string `json:"name"` // Name is the column name, like "p0".
+	Type Type   `json:"type"`
+}
+
+// Group describes the columns of one trice ID.
+type Group struct {
+	ID      uint16   `json:"id"`
+	Type    string   `json:"type"`            // Type is the trice type as found in til.json, like "TRice16".
+	Format  string   `json:"fmt"`             // Format is the trice format string as found in til.json.
+	Stamp   Type     `json:"stamp,omitempty"` // Stamp is the stamp column type "u16" or "u32" or empty without stamps.
+	Columns []Column `json:"columns"`
+}
+
+// RowSize returns the parameter byte count of one row, excluding the stamp.
+func (g *Group) RowSize() (n int) {
+	for _, c := range g.Columns {
+		n += c.Type.Size()
+	}
+	return
+}
+
+// Schema describes all column groups of a columnar file.
+type Schema struct {
+	Groups []Group `json:"groups"`
+}
+
+// check returns an error, if s contains invalid types or duplicate IDs.
+func (s *Schema) check() error {
+	ids := make(map[uint16]bool, len(s.Groups))
+	for _, g := range s.Groups {
+		if ids[g.ID] {
+			return fmt.Errorf("duplicate column group for ID %d", g.ID)
+		}
+		ids[g.ID] = true
+		if g.Stamp != "" && g.Stamp != "u16" && g.Stamp != "u32" {
+			return fmt.Errorf("invalid stamp type %q for ID %d", g.Stamp, g.ID)
+		}
+		for _, c := range g.Columns {
+			if c.Type.Size() == 0 {
+				return fmt.Errorf("invalid type %q of column %s for ID %d", c.Type, c.Name, g.ID)
+			}
+		}
+	}
+	return nil
+}
+
+// Chunk holds rows of one column group.
+type Chunk struct {
+	Group  *Group
+	Rows   int
+	stamps []byte
+	cols   [][]byte
+}
+
+// Column returns the raw little endian values of column col.
+func (c *Chunk) Column(col int) []byte {
+	return c.cols[col]
+}
+
+// Stamp returns the target stamp of row or 0 without stamps.
+func (c *Chunk) Stamp(row int) uint64 {
+	switch c.Group.Stamp {
+	case "u16":
+		return uint64(binary.LittleEndian.Uint16(c.stamps[2*row:]))
+	case "u32":
+		return uint64(binary.LittleEndian.Uint32(c.stamps[4*row:]))
+	}
+	return 0
+}
+
+// Uint returns the value of column col in row as raw unsigned value.
+func (c *Chunk) Uint(col, row int) uint64 {
+	b := c.cols[col]
+	switch c.Group.Columns[col].Type.Size() {
+	case 1:
+		return uint64(b[row])
+	case 2:
+		return uint64(binary.LittleEndian.Uint16(b[2*row:]))
+	case 4:
+		return uint64(binary.LittleEndian.Uint32(b[4*row:]))
+	}
+	return binary.LittleEndian.Uint64(b[8*row:])
+}
+
+// Int returns the value of column col in row sign extended.
+func (c *Chunk) Int(col, row int) int64 {
+	v := c.Uint(col, row)
+	shift := 64 - 8*c.Group.Columns[col].Type.Size()
+	return int64(v<<shift) >> shift
+}
+
+// Value returns the value of column col in row as uint8 ... uint64, int8 ... int64, float32, float64 or bool.
+func (c *Chunk) Value(col, row int) any {
+	t := c.Group.Columns[col].Type
+	v := c.Uint(col, row)
+	switch t {
+	case "u8":
+		return uint8(v)
+	case "u16":
+		return uint16(v)
+	case "u32":
+		return uint32(v)
+	case "u64":
+		return v
+	case "i8":
+		return int8(v)
+	case "i16":
+		return int16(v)
+	case "i32":
+		return int32(v)
+	case "i64":
+		return int64(v)
+	case "f32":
+		return math.Float32frombits(uint32(v))
+	case "f64":
+		return math.Float64frombits(v)
+	}
+	return v != 0 // bool
+}
@@ -0,0 +1,95 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package columnar
+
+import (
+	"bytes"
+	"encoding/binary"
+	"math"
+	"testing"
+
+	"github.com/tj/assert"
+)
+
+func testSchema() Schema {
+	return Schema{Groups: []Group{
+		{ID: 10, Type: "TRice8", Format: "msg:%d %u\n", Stamp: "u32", Columns: []Column{{"p0", "i8"}, {"p1", "u8"}}},
+		{ID: 11, Type: "Trice32", Format: "msg:%f %t\n", Stamp: "u16", Columns: []Column{{"p0", "f32"}, {"p1", "b32"}}},
+		{ID: 12, Type: "trice64", Format: "msg:%d %g\n", Columns: []Column{{"p0", "i64"}, {"p1", "f64"}}},
+		{ID: 13, Type: "trice", Format: "msg:tick\n"},
+	}}
+}
+
+// TestRoundTrip writes more rows than fit into a chunk and reads them back.
+func TestRoundTrip(t *testing.T) {
+	var buf bytes.Buffer
+	w, err := NewWriter(&buf, testSchema())
+	assert.Nil(t, err)
+	rows := 2*ChunkRows + 100
+	for i := 0; i < rows; i++ {
+		assert.Nil(t, w.Append(10, uint64(i*10), []byte{byte(-i), byte(i)}))
+		v := binary.LittleEndian.AppendUint32(nil, math.Float32bits(float32(i)/4))
+		assert.Nil(t, w.Append(11, uint64(i), binary.LittleEndian.AppendUint32(v, uint32(i&1))))
+		if i%3 == 0 {
+			v := binary.LittleEndian.AppendUint64(nil, uint64(-int64(i)*1e12))
+			assert.Nil(t, w.Append(12, 0, binary.LittleEndian.AppendUint64(v, math.Float64bits(float64(i)/3))))
+			assert.Nil(t, w.Append(13, 0, nil))
+		}
+	}
+	assert.Nil(t, w.Flush())
+	assert.Error(t, w.Append(99, 0, nil))
+	assert.Error(t, w.Append(10, 0, []byte{1}))
+
+	s, all, err := ReadAll(&buf)
+	assert.Nil(t, err)
+	assert.Equal(t, testSchema(), s)
+	assert.Equal(t, rows, all[10].Rows)
+	assert.Equal(t, rows, all[11].Rows)
+	assert.Equal(t, (rows+2)/3, all[12].Rows)
+	assert.Equal(t, (rows+2)/3, all[13].Rows)
+	for i := 0; i < rows; i++ {
+		assert.Equal(t, uint64(i*10), all[10].Stamp(i))
+		assert.Equal(t, int8(-i), all[10].Value(0, i))
+		assert.Equal(t, int64(int8(-i)), all[10].Int(0, i))
+		assert.Equal(t, uint8(i), all[10].Value(1, i))
+		assert.Equal(t, uint64(uint16(i)), all[11].Stamp(i))
+		assert.Equal(t, float32(i)/4, all[11].Value(0, i))
+		assert.Equal(t, i&1 == 1, all[11].Value(1, i))
+	}
+	for r := 0; r < all[12].Rows; r++ {
+		assert.Equal(t, uint64(0), all[12].Stamp(r))
+		assert.Equal(t, -int64(3*r)*1e12, all[12].Value(0, r))
+		assert.Equal(t, float64(3*r)/3, all[12].Value(1, r))
+	}
+}
+
+func TestChunkLayout(t *testing.T) {
+	var buf bytes.Buffer
+	w, err := NewWriter(&buf, Schema{Groups: []Group{{ID: 7, Stamp: "u16", Columns: []Column{{"a", "u16"}, {"b", "u8"}}}}})
+	assert.Nil(t, err)
+	assert.Nil(t, w.Append(7, 0x1122, []byte{1, 2, 3}))
+	assert.Nil(t, w.Append(7, 0x3344, []byte{4, 5, 6}))
+	assert.Nil(t, w.Flush())
+	b := buf.Bytes()
+	size := binary.LittleEndian.Uint32(b[len(Magic):])
+	chunk := b[len(Magic)+4+int(size):]
+	assert.Equal(t, []byte{7, 0, 2, 0, 0, 0, 0x22, 0x11, 0x44, 0x33, 1, 2, 4, 5, 3, 6}, chunk)
+}
+
+func TestReaderErrors(t *testing.T) {
+	_, err := NewReader(bytes.NewReader([]byte("TRICE-INDEX-1\n")))
+	assert.Error(t, err)
+	_, err = NewWriter(&bytes.Buffer{}, Schema{Groups: []Group{{ID: 1, Columns: []Column{{"p0", "f16"}}}}})
+	assert.Error(t, err)
+	_, err = NewWriter(&bytes.Buffer{}, Schema{Groups: []Group{{ID: 1}, {ID: 1}}})
+	assert.Error(t, err)
+
+	var buf bytes.Buffer
+	w, err := NewWriter(&buf, testSchema())
+	assert.Nil(t, err)
+	assert.Nil(t, w.Append(10, 1, []byte{1, 2}))
+	assert.Nil(t, w.Flush())
+	_, _, err = ReadAll(bytes.NewReader(buf.Bytes()[:buf.Len()-1]))
+	assert.Error(t, err, "truncated")
+}
@@ -0,0 +1,118 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package columnar
+
+import (
+	"bufio"
+	"encoding/binary"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+)
+
+// maxSchemaSize limits the schema length to detect garbage early.
+const maxSchemaSize = 64 << 20
+
+// Reader reads the chunks of a columnar file.
+type Reader struct {
+	Schema Schema // Schema is the schema of the file.
+	r      *bufio.Reader
+	groups map[uint16]*Group
+}
+
+// NewReader reads the header from r and returns a Reader for the chunks following it.
+func NewReader(r io.Reader) (*Reader, error) {
+	p := &Reader{r: bufio.NewReaderSize(r, 256*1024)}
+	head := make([]byte, len(Magic)+4)
+	if _, err := io.ReadFull(p.r, head); err != nil || string(head[:len(Magic)]) != Magic {
+		return nil, errors.New("no columnar trice file")
+	}
+	size := binary.LittleEndian.Uint32(head[len(Magic):])
+	if size > maxSchemaSize {
+		return nil, fmt.Errorf("invalid schema size %d", size)
+	}
+	js := make([]byte, size)
+	if _, err := io.ReadFull(p.r, js); err != nil {
+		return nil, err
+	}
+	if err := json.Unmarshal(js, &p.Schema); err != nil {
+		return nil, err
+	}
+	if err := p.Schema.check(); err != nil {
+		return nil, err
+	}
+	p.groups = make(map[uint16]*Group, len(p.Schema.Groups))
+	for i := range p.Schema.Groups {
+		p.groups[p.Schema.Groups[i].ID] = &p.Schema.Groups[i]
+	}
+	return p, nil
+}
+
+// Next returns the next chunk or io.EOF at the file end.
+func (p *Reader) Next() (*Chunk, error) {
+	var h [chunkHeaderSize]byte
+	if _, err := io.ReadFull(p.r, h[:]); err != nil {
+		if err == io.ErrUnexpectedEOF {
+			err = errors.New("truncated chunk header")
+		}
+		return nil, err
+	}
+	id := binary.LittleEndian.Uint16(h[0:])
+	g, ok := p.groups[id]
+	if !ok {
+		return nil, fmt.Errorf("chunk with unknown ID %d", id)
+	}
+	c := &Chunk{Group: g, Rows: int(binary.LittleEndian.Uint32(h[2:])), cols: make([][]byte, len(g.Columns))}
+	if c.Rows > ChunkRows {
+		return nil, fmt.Errorf("chunk of ID %d with %d rows", id, c.Rows)
+	}
+	b := make([]byte, c.Rows*(g.Stamp.size()+g.RowSize()))
+	if _, err := io.ReadFull(p.r, b); err != nil {
+		return nil, fmt.Errorf("truncated chunk of ID %d", id)
+	}
+	n := c.Rows * g.Stamp.size()
+	c.stamps, b = b[:n:n], b[n:] // capped, so ReadAll can append
+	for i, col := range g.Columns {
+		n = c.Rows * col.Type.Size()
+		c.cols[i], b = b[:n:n], b[n:]
+	}
+	return c, nil
+}
+
+// ReadAll reads all chunks from r and returns the schema and the concatenated rows of each ID.
+func ReadAll(r io.Reader) (Schema, map[uint16]*Chunk, error) {
+	p, err := NewReader(r)
+	if err != nil {
+		return Schema{}, nil, err
+	}
+	all := make(map[uint16]*Chunk)
+	for {
+		c, err := p.Next()
+		if err == io.EOF {
+			return p.Schema, all, nil
+		}
+		if err != nil {
+			return p.Schema, all, err
+		}
+		a, ok := all[c.Group.ID]
+		if !ok {
+			all[c.Group.ID] = c
+			continue
+		}
+		a.Rows += c.Rows
+		a.stamps = append(a.stamps, c.stamps...)
+		for i := range a.cols {
+			a.cols[i] = append(a.cols[i], c.cols[i]...)
+		}
+	}
+}
+
+// size returns the byte count of a stamp type, which is 0 for no stamps.
+func (t Type) size() int {
+	if t == "" {
+		return 0
+	}
+	return t.Size()
+}
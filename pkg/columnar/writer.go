@@ -0,0 +1,115 @@
+// Copyright 2020 Thomas.Hoehenleitner [at] seerose.net
+// Use of this source code is governed by a license that can be found in the LICENSE file.
+
+package columnar
+
+import (
+	"bufio"
+	"encoding/binary"
+	"encoding/json"
+	"fmt"
+	"io"
+)
+
+// groupBuffer collects the rows of one column group until a chunk is full.
+type groupBuffer struct {
+	g      *Group
+	rows   int
+	stamps []byte
+	cols   [][]byte
+	sizes  []int
+}
+
+// Writer writes rows into a columnar file.
+type Writer struct {
+	w      *bufio.Writer
+	groups map[uint16]*groupBuffer
+	order  []*groupBuffer // order is the schema order for a deterministic flush.
+	err    error
+}
+
+// NewWriter writes the header with schema s into w and returns a Writer for the s column groups.
+func NewWriter(w io.Writer, s Schema) (*Writer, error) {
+	if err := s.check(); err != nil {
+		return nil, err
+	}
+	js, err := json.Marshal(s)
+	if err != nil {
+		return nil, err
+	}
+	p := &Writer{w: bufio.NewWriterSize(w, 256*1024), groups: make(map[uint16]*groupBuffer, len(s.Groups))}
+	for i := range s.Groups {
+		g := &s.Groups[i]
+		gb := &groupBuffer{g: g, cols: make([][]byte, len(g.Columns)), sizes: make([]int, len(g.Columns))}
+		for j, c := range g.Columns {
+			gb.sizes[j] = c.Type.Size()
+		}
+		p.groups[g.ID] = gb
+		p.order = append(p.order, gb)
+	}
+	p.w.WriteString(Magic)
+	p.w.Write(binary.LittleEndian.AppendUint32(nil, uint32(len(js))))
+	_, p.err = p.w.Write(js)
+	return p, p.err
+}
+
+// Append adds a row to the column group of id. values are the little endian parameter values in column order.
+// stamp is ignored for a group without stamp column.
+func (p *Writer) Append(id uint16, stamp uint64, values []byte) error {
+	if p.err != nil {
+		return p.err
+	}
+	gb, ok := p.groups[id]
+	if !ok {
+		return fmt.Errorf("no column group for ID %d", id)
+	}
+	switch gb.g.Stamp {
+	case "u16":
+		gb.stamps = binary.LittleEndian.AppendUint16(gb.stamps, uint16(stamp))
+	case "u32":
+		gb.stamps = binary.LittleEndian.AppendUint32(gb.stamps, uint32(stamp))
+	}
+	for i, size := range gb.sizes {
+		if len(values) < size {
+			return fmt.Errorf("ID %d row has only %d of %d value bytes", id, len(values), gb.g.RowSize())
+		}
+		gb.cols[i] = append(gb.cols[i], values[:size]...)
+		values = values[size:]
+	}
+	gb.rows++
+	if gb.rows == ChunkRows {
+		p.flushGroup(gb)
+	}
+	return p.err
+}
+
+// flushGroup writes the collected rows of gb as chunk.
+func (p *Writer) flushGroup(gb *groupBuffer) {
+	if gb.rows == 0 || p.err != nil {
+		return
+	}
+	var h [chunkHeaderSize]byte
+	binary.LittleEndian.PutUint16(h[0:], gb.g.ID)
+	binary.LittleEndian.PutUint32(h[2:], uint32(gb.rows))
+	p.w.Write(h[:])
+	p.w.Write(gb.stamps)
+	for _, c := range gb.cols {
+		_, p.err = p.w.Write(c)
+	}
+	gb.rows = 0
+	gb.stamps = gb.stamps[:0]
+	for i := range gb.cols {
+		gb.cols[i] = gb.cols[i][:0]
+	}
+}
+
+// Flush writes all collected rows as chunks.
+func (p *Writer) Flush() error {
+	for _, gb := range p.order {
+		p.flushGroup(gb)
+	}
+	if p.err == nil {
+		p.err = p.w.Flush()
+	}
+	return p.err
+}
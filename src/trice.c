@@ -2,6 +2,7 @@
 //! \author Thomas.Hoehenleitner [at] seerose.net
 //! ///////////////////////////////////////////////////////////////////////////
 
+#define TRICE_ID_GATE_NO_FUNCTIONS //!< The trice functions are defined here and get no ID gate macros.
 #include "trice.h"
 #include "cobs.h"
 #include "tcobs.h"
@@ -232,6 +233,24 @@ unsigned TriceDeferredOverflowCount = 0;
 
 #endif
 
+#if TRICE_TIMING == 1
+
+//! TriceTimingHistogram holds the log2 cycle histograms of the TriceTimingPath code paths. The counts saturate at 0xFFFF.
+uint16_t TriceTimingHistogram[TriceTimingPaths][TRICE_TIMING_BUCKETS] = {0};
+
+//! TriceTimingAdd counts cycles into the histogram of path.
+void TriceTimingAdd(int path, uint32_t cycles) {
+	int bucket = 0;
+	while ((cycles >>= 1) && bucket < TRICE_TIMING_BUCKETS - 1) {
+		bucket++;
+	}
+	if (TriceTimingHistogram[path][bucket] < 0xFFFF) {
+		TriceTimingHistogram[path][bucket]++;
+	}
+}
+
+#endif // #if TRICE_TIMING == 1
+
 //! TriceInit needs to run before the first trice macro is executed.
 //! Not neseecary for all configurations.
 void TriceInit(void) {
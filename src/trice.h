@@ -140,6 +140,21 @@ extern "C" {
 #define TRice64(tid, fmt, ...) TRICE_CONCAT2(TRice64_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(tid, fmt, ##__VA_ARGS__)
 // clang-format on
 
+// Function profiling: TriceSpanEnter and TriceSpanExit mark the begin and the end of a function or code section. Their only
+// argument after the ID is the span name, which needs to be identical in both, like the function name at the function start
+// and before each return. The name is, like a format string, only inside the ID list. A span trice has no values, so it costs
+// as much as a Trice0.
+// "trice spans" pairs them to a Chrome Trace Event / Perfetto JSON file. The 16-bit stamps of the Trice variants are unwrapped
+// on the host, what needs at least one trice per 16-bit stamp period. For longer spans use the TRice variants.
+// clang-format off
+#define triceSpanEnter trice //!< span begin without stamp
+#define TriceSpanEnter Trice //!< span begin with 16-bit stamp
+#define TRiceSpanEnter TRice //!< span begin with 32-bit stamp
+#define triceSpanExit  trice //!< span end without stamp
+#define TriceSpanExit  Trice //!< span end with 16-bit stamp
+#define TRiceSpanExit  TRice //!< span end with 32-bit stamp
+// clang-format on
+
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -271,6 +286,77 @@ extern unsigned TriceDeferredOverflowCount;
 
 #endif // #else // #if (TRICE_DIAGNOSTICS == 1)
 
+#if (TRICE_HEALTH_PERIOD > 0) && (TRICE_DIAGNOSTICS == 1)
+
+//! TRICE_HEALTH_TICK is executed inside TriceTransfer and emits a health record on each TRICE_HEALTH_PERIOD-th call.
+#define TRICE_HEALTH_TICK()                              \
+	do {                                                 \
+		static unsigned triceHealthCalls = 0;            \
+		if (++triceHealthCalls >= TRICE_HEALTH_PERIOD) { \
+			triceHealthCalls = 0;                        \
+			TriceLogHealth(TRICE_HEALTH_RESET);          \
+		}                                                \
+	} while (0)
+
+#else // #if (TRICE_HEALTH_PERIOD > 0) && (TRICE_DIAGNOSTICS == 1)
+
+#define TRICE_HEALTH_TICK()
+
+#endif // #else // #if (TRICE_HEALTH_PERIOD > 0) && (TRICE_DIAGNOSTICS == 1)
+
+#if TRICE_TIMING == 1
+
+#ifndef TRICE_TIMING_CYCLES
+#error TRICE_TIMING needs a 32-bit cycle counter TRICE_TIMING_CYCLES inside triceConfig.h.
+#endif
+
+//! TRICE_TIMING_BUCKETS is the histogram size. Bucket 0 counts 0-1 cycles, bucket k counts 2^k to 2^(k+1)-1 cycles and the last bucket all longer durations.
+#define TRICE_TIMING_BUCKETS 20
+
+//! TriceTimingPath enumerates the measured code paths.
+enum TriceTimingPath {
+	TriceTimingMacro,    //!< TriceTimingMacro is a whole TRICE macro including the direct output.
+	TriceTimingCritical, //!< TriceTimingCritical is the TRICE_ENTER_CRITICAL_SECTION execution.
+	TriceTimingDirect,   //!< TriceTimingDirect is the direct output encoding and writing.
+	TriceTimingTransfer, //!< TriceTimingTransfer is a TriceTransfer call transferring data.
+	TriceTimingPaths
+};
+
+extern uint16_t TriceTimingHistogram[TriceTimingPaths][TRICE_TIMING_BUCKETS];
+void TriceTimingAdd(int path, uint32_t cycles);
+
+//! TRICE_TIMING_START reads the cycle counter into the new variable name.
+#define TRICE_TIMING_START(name) uint32_t name = TRICE_TIMING_CYCLES;
+
+//! TRICE_TIMING_STOP accounts the cycles since TRICE_TIMING_START(name) for path.
+#define TRICE_TIMING_STOP(path, name) TriceTimingAdd(path, TRICE_TIMING_CYCLES - name);
+
+//! TRICE_TIMED_ENTER_CRITICAL_SECTION is TRICE_ENTER_CRITICAL_SECTION with a start and an entered time stamp.
+#define TRICE_TIMED_ENTER_CRITICAL_SECTION               \
+	{                                                    \
+		uint32_t triceTimingStart = TRICE_TIMING_CYCLES; \
+		TRICE_ENTER_CRITICAL_SECTION                     \
+		uint32_t triceTimingEntered = TRICE_TIMING_CYCLES;
+
+//! TRICE_TIMED_LEAVE_CRITICAL_SECTION accounts the critical section entry and the whole TRICE macro before leaving the critical section.
+#define TRICE_TIMED_LEAVE_CRITICAL_SECTION                                          \
+	{                                                                               \
+		uint32_t triceTimingExit = TRICE_TIMING_CYCLES;                             \
+		TriceTimingAdd(TriceTimingCritical, triceTimingEntered - triceTimingStart); \
+		TriceTimingAdd(TriceTimingMacro, triceTimingExit - triceTimingStart);       \
+	}                                                                               \
+	TRICE_LEAVE_CRITICAL_SECTION                                                    \
+	}
+
+#else // #if TRICE_TIMING == 1
+
+#define TRICE_TIMING_START(name)
+#define TRICE_TIMING_STOP(path, name)
+#define TRICE_TIMED_ENTER_CRITICAL_SECTION TRICE_ENTER_CRITICAL_SECTION
+#define TRICE_TIMED_LEAVE_CRITICAL_SECTION TRICE_LEAVE_CRITICAL_SECTION
+
+#endif // #else // #if TRICE_TIMING == 1
+
 #if (TRICE_BUFFER == TRICE_RING_BUFFER) || (TRICE_BUFFER == TRICE_DOUBLE_BUFFER)
 
 extern uint32_t* TriceBufferWritePosition;
@@ -439,7 +525,7 @@ extern uint32_t* TriceBufferWritePosition;
 
 		//! TRICE_ENTER is the start of TRICE macro.
 		#define TRICE_ENTER                                                                                           \
-			TRICE_ENTER_CRITICAL_SECTION {                                                                            \
+			TRICE_TIMED_ENTER_CRITICAL_SECTION {                                                                      \
 				{                                                                                                     \
 					uint32_t triceSingleBuffer[TRICE_BUFFER_SIZE >> 2];                                               \
 					uint32_t* const triceSingleBufferStartWritePosition = &triceSingleBuffer[TRICE_DATA_OFFSET >> 2]; \
@@ -450,9 +536,9 @@ extern uint32_t* TriceBufferWritePosition;
 	#if TRICE_BUFFER == TRICE_STATIC_BUFFER
 
 		//! TRICE_ENTER is the start of TRICE macro.
-		#define TRICE_ENTER                \
-			TRICE_ENTER_CRITICAL_SECTION { \
-				{                          \
+		#define TRICE_ENTER                      \
+			TRICE_TIMED_ENTER_CRITICAL_SECTION { \
+				{                                \
 					uint32_t* TriceBufferWritePosition = triceSingleBufferStartWritePosition;
 
 	#endif // #if TRICE_BUFFER == TRICE_STATIC_BUFFER
@@ -462,17 +548,17 @@ extern uint32_t* TriceBufferWritePosition;
 		#if TRICE_PROTECT == 1
 
 			//! TRICE_ENTER is the start of TRICE macro.
-			#define TRICE_ENTER                \
-				TRICE_ENTER_CRITICAL_SECTION { \
-					if (TriceEnoughSpace()) {  \
+			#define TRICE_ENTER                      \
+				TRICE_TIMED_ENTER_CRITICAL_SECTION { \
+					if (TriceEnoughSpace()) {        \
 						uint32_t* const triceSingleBufferStartWritePosition = TriceBufferWritePosition;
 
 		#else //  #if TRICE_PROTECT == 1
 
 			//! TRICE_ENTER is the start of TRICE macro.
-			#define TRICE_ENTER                \
-				TRICE_ENTER_CRITICAL_SECTION { \
-					{                          \
+			#define TRICE_ENTER                      \
+				TRICE_TIMED_ENTER_CRITICAL_SECTION { \
+					{                                \
 						uint32_t* const triceSingleBufferStartWritePosition = TriceBufferWritePosition;
 
 		#endif // #else //  #if TRICE_PROTECT == 1
@@ -484,17 +570,17 @@ extern uint32_t* TriceBufferWritePosition;
 		#if TRICE_PROTECT == 1
 
 			//! TRICE_ENTER is the start of TRICE macro.
-			#define TRICE_ENTER                \
-				TRICE_ENTER_CRITICAL_SECTION { \
-					if (TriceEnoughSpace()) {  \
+			#define TRICE_ENTER                      \
+				TRICE_TIMED_ENTER_CRITICAL_SECTION { \
+					if (TriceEnoughSpace()) {        \
 						TRICE_DIAGNOSTICS_SINGLE_BUFFER_KEEP_START
 
 		#else //  #if TRICE_PROTECT == 1
 
 			//! TRICE_ENTER is the start of TRICE macro.
-			#define TRICE_ENTER                \
-				TRICE_ENTER_CRITICAL_SECTION { \
-					{                          \
+			#define TRICE_ENTER                      \
+				TRICE_TIMED_ENTER_CRITICAL_SECTION { \
+					{                                \
 						TRICE_DIAGNOSTICS_SINGLE_BUFFER_KEEP_START
 
 		#endif // #else //  #if TRICE_PROTECT == 1
@@ -507,7 +593,7 @@ extern uint32_t* TriceBufferWritePosition;
 
 			//! TRICE_ENTER is the start of TRICE macro.
 			#define TRICE_ENTER                                                                                                                                                     \
-				TRICE_ENTER_CRITICAL_SECTION {                                                                                                                                      \
+				TRICE_TIMED_ENTER_CRITICAL_SECTION {                                                                                                                                \
 					if (TriceEnoughSpace()) {                                                                                                                                       \
 						/* The TriceBufferWritePosition stays unchanged, when there is enough space for the next trice at the current write position.*/                             \
 						/* Because the the size of the next trice message is unknown here, the biggest value is assumed, that is TRICE_BUFFER_SIZE bytes. */                        \
@@ -522,7 +608,7 @@ extern uint32_t* TriceBufferWritePosition;
 
 			//! TRICE_ENTER is the start of TRICE macro.
 			#define TRICE_ENTER                                                                                                                                                     \
-				TRICE_ENTER_CRITICAL_SECTION {                                                                                                                                      \
+				TRICE_TIMED_ENTER_CRITICAL_SECTION {                                                                                                                                \
 					{                                                                                                                                                               \
 						/* The TriceBufferWritePosition stays unchanged, when there is enough space for the next trice at the current write position.*/                             \
 						/* Because the the size of the next trice message is unknown here, the biggest value is assumed, that is TRICE_BUFFER_SIZE bytes. */                        \
@@ -543,7 +629,7 @@ extern uint32_t* TriceBufferWritePosition;
 
 			//! TRICE_ENTER is the start of TRICE macro.
 			#define TRICE_ENTER                                                                                                                                                     \
-				TRICE_ENTER_CRITICAL_SECTION {                                                                                                                                      \
+				TRICE_TIMED_ENTER_CRITICAL_SECTION {                                                                                                                                \
 					if (TriceEnoughSpace()) {                                                                                                                                       \
 						TriceBufferWritePosition = (TriceBufferWritePosition + (TRICE_BUFFER_SIZE >> 2)) <= triceRingBufferLimit ? TriceBufferWritePosition : TriceRingBufferStart; \
 						/*TriceBufferWritePosition += (TRICE_DATA_OFFSET>>2);*/ /* space for in buffer encoding */                                                                  \
@@ -554,7 +640,7 @@ extern uint32_t* TriceBufferWritePosition;
 
 			//! TRICE_ENTER is the start of TRICE macro.
 			#define TRICE_ENTER                                                                                                                                                     \
-				TRICE_ENTER_CRITICAL_SECTION {                                                                                                                                      \
+				TRICE_TIMED_ENTER_CRITICAL_SECTION {                                                                                                                                \
 					{                                                                                                                                                               \
 						TriceBufferWritePosition = (TriceBufferWritePosition + (TRICE_BUFFER_SIZE >> 2)) <= triceRingBufferLimit ? TriceBufferWritePosition : TriceRingBufferStart; \
 						/*TriceBufferWritePosition += (TRICE_DATA_OFFSET>>2);*/ /* space for in buffer encoding */                                                                  \
@@ -577,10 +663,12 @@ extern uint32_t* TriceBufferWritePosition;
 			/* The last written uint32_t trice value can contain 1 to 3 padding bytes. */                            \
 			unsigned wordCount = TriceBufferWritePosition - triceSingleBufferStartWritePosition;                     \
 			TRICE_DIAGNOSTICS_SINGLE_BUFFER_USING_WORD_COUNT                                                         \
+			TRICE_TIMING_START(triceTimingDirect)                                                                    \
 			TriceNonBlockingDirectWrite(triceSingleBufferStartWritePosition, wordCount);                             \
+			TRICE_TIMING_STOP(TriceTimingDirect, triceTimingDirect)                                                  \
 			}                                                                                                        \
 			}                                                                                                        \
-			TRICE_LEAVE_CRITICAL_SECTION
+			TRICE_TIMED_LEAVE_CRITICAL_SECTION
 
 	#else // #if TRICE_DIRECT_OUTPUT == 1
 
@@ -589,7 +677,7 @@ extern uint32_t* TriceBufferWritePosition;
 			TRICE_DIAGNOSTICS_SINGLE_BUFFER \
 			}                               \
 			}                               \
-			TRICE_LEAVE_CRITICAL_SECTION
+			TRICE_TIMED_LEAVE_CRITICAL_SECTION
 
 	#endif // #else  //#if TRICE_DIRECT_OUTPUT == 1
 
@@ -828,6 +916,12 @@ typedef void (*Write32AuxiliaryFn_t)(const uint32_t* enc, unsigned count);
 extern Write32AuxiliaryFn_t UserNonBlockingDirectWrite32AuxiliaryFn;
 extern Write32AuxiliaryFn_t UserNonBlockingDeferredWrite32AuxiliaryFn;
 
+#if TRICE_ID_STRIP == 1
+
+#include "triceIdGate.h"
+
+#endif
+
 /**/
 /**/
 /***************************************************************************************************/
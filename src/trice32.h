@@ -62,8 +62,6 @@
 
 #endif // #if TRICE_DEFAULT_PARAMETER_BIT_WIDTH == 32
 
-#define TRICE32(tid, fmt, ...) TRICE_CONCAT2(TRICE32_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(tid, fmt, ##__VA_ARGS__)
-
 //! TRICE32_B expects inside pFmt only one format specifier, which is used n times by using pFmt n times.
 //!  It is usable for showing n 32-bit values.
 #define TRICE32_B(id, pFmt, buf, n)    \
@@ -62,8 +62,6 @@
 
 #endif // #if TRICE_DEFAULT_PARAMETER_BIT_WIDTH == 64
 
-#define TRICE64(tid, fmt, ...) TRICE_CONCAT2(TRICE64_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(tid, fmt, ##__VA_ARGS__)
-
 //! TRICE64_B expects inside pFmt only one format specifier, which is used n times by using pFmt n times.
 //!  It is usable for showing n 64-bit values.
 #define TRICE64_B(id, pFmt, buf, n)    \
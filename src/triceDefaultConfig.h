@@ -21,6 +21,12 @@ extern "C" {
 // When defined in the project settings, it influences the whole trice code generation.
 #define TRICE_OFF 0
 #endif
+#ifndef TRICE_ID_STRIP
+// TRICE_ID_STRIP is set to 1 by the header generated with "trice insert -stripHeader", when included in triceConfig.h.
+// Then all trice macros and trice function calls with IDs disabled there compile to nothing, see triceIdGate.h.
+#define TRICE_ID_STRIP 0
+#endif
+
 // #define TRICE_DO_EXPAND(VAL)  VAL ## 1
 // #define TRICE_EXPAND(VAL)     TRICE_DO_EXPAND(VAL) //!<  https://stackoverflow.com/questions/3781520/how-to-test-if-preprocessor-symbol-is-defined-but-has-no-value
 // #if (TRICE_EXPAND(TRICE_OFF) == 1)
@@ -293,6 +299,24 @@ extern "C" {
 #define TRICE_DIAGNOSTICS 1
 #endif
 
+#ifndef TRICE_HEALTH_PERIOD
+//! TRICE_HEALTH_PERIOD > 0 lets TriceTransfer call TriceLogHealth on each TRICE_HEALTH_PERIOD-th call. It needs TRICE_DIAGNOSTICS == 1.
+//! The health record contains all diagnostics values. TriceLogHealth is inside ./src/triceHealth.c.
+#define TRICE_HEALTH_PERIOD 0
+#endif
+
+#ifndef TRICE_HEALTH_RESET
+//! TRICE_HEALTH_RESET == 1 resets the diagnostics max values and counters after each periodic health record.
+#define TRICE_HEALTH_RESET 0
+#endif
+
+#ifndef TRICE_TIMING
+//! TRICE_TIMING == 1 is an instrumentation build measuring the TRICE macros, their critical section entry, the direct output and TriceTransfer.
+//! The durations accumulate in log2 histograms, which TriceLogTiming emits. TRICE_TIMING_CYCLES needs to be defined then.
+//! \li #define TRICE_TIMING_CYCLES DWT->CYCCNT - a free running 32-bit cycle counter, here for Cortex-M3 and above.
+#define TRICE_TIMING 0
+#endif
+
 #ifndef TRICE_DIRECT_SEGGER_RTT_8BIT_WRITE
 //! TRICE_DIRECT_SEGGER_RTT_8BIT_WRITE==1 uses standard RTT transfer by using function SEGGER_RTT_WriteNoLock and needs ((TRICE_DIRECT_OUTPUT == 1).
 //! - This setting results in unframed RTT trice packages and requires the `-packageFraming none` switch for the appropriate trice tool instance.
@@ -345,7 +369,7 @@ extern "C" {
 #ifndef TRICE_CYCLE_COUNTER
 //! TRICE_CYCLE_COUNTER adds a cycle counter to each trice message.
 //! If 0, do not add cycle counter. The TRICE macros are a bit faster. Lost TRICEs are not detectable by the trice tool. The cycle counter byte ist statically 0xC0.
-//! If 1, add an 8-bit cycle counter. The TRICE macros are a bit slower. Lost TRICEs are detectable by the trice tool. The cycle counter byte changes (recommended).
+//! If 1, add an 8-bit cycle counter. The TRICE macros are a bit slower. Lost TRICEs, also the ones dropped on a full deferred buffer, are detectable by the trice tool. The cycle counter byte changes (recommended).
 #define TRICE_CYCLE_COUNTER 1
 #endif
 
@@ -45,6 +45,9 @@ int TriceEnoughSpace(void) {
 	} else {
 #if TRICE_DIAGNOSTICS == 1
 		TriceDeferredOverflowCount++;
+#endif
+#if TRICE_CYCLE_COUNTER == 1
+		TriceCycle++; // The host sees the dropped trice as cycle counter gap.
 #endif
 		return 0;
 	}
@@ -81,9 +84,11 @@ unsigned TriceHalfBufferDepthMax = 0;
 //! TriceTransfer, if possible, swaps the double buffer and initiates a write.
 //! It is the responsibility of the app to call this function once every 10-100 milliseconds.
 void TriceTransfer(void) {
+	TRICE_HEALTH_TICK();
 	if (0 == TriceOutDepth()) { // transmission done for slowest output channel, so a swap is possible.
 		uint32_t* readBuf;
 		size_t tLen32;
+		TRICE_TIMING_START(triceTimingTransfer)
 		TRICE_ENTER_CRITICAL_SECTION
 		tLen32 = TriceBufferWritePosition - TriceBufferWritePositionStart;
 		if (tLen32) { // Some Trice data are available.
@@ -93,6 +98,7 @@ void TriceTransfer(void) {
 		TRICE_LEAVE_CRITICAL_SECTION
 		if (tLen32) {
 			TriceOut(readBuf, tLen32 << 2);
+			TRICE_TIMING_STOP(TriceTimingTransfer, triceTimingTransfer)
 		}
 	}
 }
@@ -0,0 +1,78 @@
+//! \file triceHealth.c
+//! \author Thomas.Hoehenleitner [at] seerose.net
+//! //////////////////////////////////////////////////////////////////////////
+#include "trice.h"
+
+#if TRICE_DIAGNOSTICS == 1 && TRICE_OFF == 0
+
+//! TriceHealthField enumerates the 32-bit values of the health record. The trice tool knows this order.
+enum TriceHealthField {
+	TriceHealthSequence,          //!< TriceHealthSequence counts the health records, starting with 0 after reset.
+	TriceHealthFlags,             //!< TriceHealthFlags bit 0 is set, when the diagnostics values were reset after the snapshot.
+	TriceHealthSingleDepthMax,    //!< TriceHealthSingleDepthMax is the max single trice size including TRICE_DATA_OFFSET.
+	TriceHealthSingleSize,        //!< TriceHealthSingleSize is TRICE_BUFFER_SIZE.
+	TriceHealthOffsetDepthMax,    //!< TriceHealthOffsetDepthMax is TriceDataOffsetDepthMax.
+	TriceHealthOffsetSize,        //!< TriceHealthOffsetSize is TRICE_DATA_OFFSET.
+	TriceHealthDeferredDepthMax,  //!< TriceHealthDeferredDepthMax is the max half buffer or ring buffer depth.
+	TriceHealthDeferredSize,      //!< TriceHealthDeferredSize is the half buffer or ring buffer size, 0 without deferred output.
+	TriceHealthDirectOverflows,   //!< TriceHealthDirectOverflows is TriceDirectOverflowCount.
+	TriceHealthDeferredOverflows, //!< TriceHealthDeferredOverflows is TriceDeferredOverflowCount.
+	TriceHealthTruncations,       //!< TriceHealthTruncations is TriceDynBufTruncateCount.
+	TriceHealthErrors,            //!< TriceHealthErrors is TriceErrorCount.
+	TriceHealthRttDepthMax,       //!< TriceHealthRttDepthMax is RTT0_writeDepthMax.
+	TriceHealthRttSize,           //!< TriceHealthRttSize is BUFFER_SIZE_UP, 0 without SEGGER RTT.
+	TriceHealthFields
+};
+
+//! TriceLogHealth emits all diagnostics values as one record. With reset != 0, the max values and counters restart afterwards.
+//! The snapshot is taken inside a critical section, so no count gets lost between snapshot and reset.
+void TriceLogHealth(int reset) {
+	static uint32_t sequence = 0;
+	uint32_t h[TriceHealthFields] = {0};
+	TRICE_ENTER_CRITICAL_SECTION
+	h[TriceHealthSequence] = sequence++;
+	h[TriceHealthFlags] = reset ? 1 : 0;
+	h[TriceHealthSingleDepthMax] = TRICE_DATA_OFFSET + (TriceSingleMaxWordCount << 2);
+	h[TriceHealthSingleSize] = TRICE_BUFFER_SIZE;
+	h[TriceHealthOffsetDepthMax] = TriceDataOffsetDepthMax;
+	h[TriceHealthOffsetSize] = TRICE_DATA_OFFSET;
+#if TRICE_BUFFER == TRICE_DOUBLE_BUFFER
+	h[TriceHealthDeferredDepthMax] = TriceHalfBufferDepthMax;
+	h[TriceHealthDeferredSize] = TRICE_DEFERRED_BUFFER_SIZE / 2;
+#elif TRICE_BUFFER == TRICE_RING_BUFFER
+	h[TriceHealthDeferredDepthMax] = TriceRingBufferDepthMax;
+	h[TriceHealthDeferredSize] = TRICE_DEFERRED_BUFFER_SIZE;
+#endif
+#if TRICE_PROTECT == 1
+	h[TriceHealthDirectOverflows] = TriceDirectOverflowCount;
+	h[TriceHealthDeferredOverflows] = TriceDeferredOverflowCount;
+#endif
+	h[TriceHealthTruncations] = TriceDynBufTruncateCount;
+	h[TriceHealthErrors] = TriceErrorCount;
+#ifdef SEGGER_RTT
+	h[TriceHealthRttDepthMax] = RTT0_writeDepthMax;
+	h[TriceHealthRttSize] = BUFFER_SIZE_UP;
+#endif
+	if (reset) {
+		TriceSingleMaxWordCount = 0;
+		TriceDataOffsetDepthMax = 0;
+#if TRICE_BUFFER == TRICE_DOUBLE_BUFFER
+		TriceHalfBufferDepthMax = 0;
+#elif TRICE_BUFFER == TRICE_RING_BUFFER
+		TriceRingBufferDepthMax = 0;
+#endif
+#if TRICE_PROTECT == 1
+		TriceDirectOverflowCount = 0;
+		TriceDeferredOverflowCount = 0;
+#endif
+		TriceDynBufTruncateCount = 0;
+		TriceErrorCount = 0;
+#ifdef SEGGER_RTT
+		RTT0_writeDepthMax = 0;
+#endif
+	}
+	TRICE_LEAVE_CRITICAL_SECTION
+	trice32B(iD(16365), "diag:health %u\n", h, TriceHealthFields);
+}
+
+#endif // #if TRICE_DIAGNOSTICS == 1 && TRICE_OFF == 0
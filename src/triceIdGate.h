@@ -0,0 +1,574 @@
+/*! \file triceIdGate.h
+\author thomas.hoehenleitner [at] seerose.net
+*******************************************************************************/
+
+// Per ID compile time stripping: A file generated with "trice insert -stripHeader triceStrip.h -stripChannels dbg:diag"
+// defines TRICE_ID_STRIP to 1 and TRICE_ID_ENABLE_n to 0 or 1 for each ID n. When included by triceConfig.h, trice.h
+// includes this file at its end. It redefines all trice macros, so that a disabled ID compiles to nothing. That are the
+// variadic macros, the fixed parameter count macros like TRice8_2, the TRICE_S, TRICE_N and TRICE_B macros and the
+// trice functions like triceS. IDs without TRICE_ID_ENABLE_n stay enabled.
+// The macros paste the unexpanded ID macro, like iD(123), to TRICE_ID_ENABLE_OF_, so the ID argument must start with
+// iD, id, Id, ID or a number. In the "trice clean" state without IDs the stripping is inactive.
+// The gated trice macros are generated from trice.h, trice8.h ... trice64.h and triceOn.h, because a trice macro cannot
+// be removed from inside its TRICE_ENTER ... TRICE_LEAVE body. TestIDGate in internal/id fails, when they differ.
+
+//! TRICE_ID_ENABLE_OF_iD maps iD(n) to the ID specific enable macro TRICE_ID_ENABLE_n.
+#define TRICE_ID_ENABLE_OF_iD(n) TRICE_ID_ENABLE_##n
+#define TRICE_ID_ENABLE_OF_id(n) TRICE_ID_ENABLE_##n //!< legacy ID macro
+#define TRICE_ID_ENABLE_OF_Id(n) TRICE_ID_ENABLE_##n //!< legacy ID macro
+#define TRICE_ID_ENABLE_OF_ID(n) TRICE_ID_ENABLE_##n //!< legacy ID macro
+
+//! TRICE_ID_ON marks an already expanded ID of a trice, which passed its gate. The variadic macros use it to call the gated
+//! fixed parameter count macros, which cannot paste an expanded ID anymore.
+#define TRICE_ID_ON(...) __VA_ARGS__
+#define TRICE_ID_ENABLE_OF_TRICE_ID_ON(...) 1 //!< An ID, which passed its gate, is enabled.
+
+//! TRICE_ID_PROBE_0 is the only existing TRICE_ID_PROBE_ macro and shifts the arguments of TRICE_ID_SECOND.
+#define TRICE_ID_PROBE_0 ~, 1
+
+//! TRICE_ID_SECOND evaluates to its 2nd argument (helper macro).
+#define TRICE_ID_SECOND(a, b, ...) b
+
+//! TRICE_ID_SECOND_ expands its arguments before TRICE_ID_SECOND splits them (helper macro).
+#define TRICE_ID_SECOND_(...) TRICE_ID_SECOND(__VA_ARGS__)
+
+//! TRICE_ID_DISABLED evaluates to 1, if enable expands to 0, otherwise to 0. An undefined enable macro is not 0.
+#define TRICE_ID_DISABLED(enable) TRICE_ID_SECOND_(TRICE_CONCAT2(TRICE_ID_PROBE_, enable), 0, ~)
+
+//! TRICE_ID_GATE evaluates to a macro, which passes or removes the following parenthesized trice code.
+#define TRICE_ID_GATE(enable) TRICE_CONCAT2(TRICE_ID_GATE_, TRICE_ID_DISABLED(enable))
+#define TRICE_ID_GATE_0(...) __VA_ARGS__ //!< enabled ID: keep trice code
+#define TRICE_ID_GATE_1(...) ((void)0)   //!< disabled ID: no trice code
+
+// clang-format off
+// Code generated from trice.h, trice8.h ... trice64.h and triceOn.h by "go test ./internal/id -run TestIDGate -updateGate". DO NOT EDIT.
+
+// trice.h
+#undef TRICE
+#define TRICE(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRICE_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef trice
+#define trice(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(trice_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef Trice
+#define Trice(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(Trice_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRice
+#define TRice(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRice_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRICE8
+#define TRICE8(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRICE8_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef trice8
+#define trice8(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(trice8_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef Trice8
+#define Trice8(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(Trice8_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRice8
+#define TRice8(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRice8_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRICE16
+#define TRICE16(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRICE16_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef trice16
+#define trice16(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(trice16_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef Trice16
+#define Trice16(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(Trice16_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRice16
+#define TRice16(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRice16_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRICE32
+#define TRICE32(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRICE32_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef trice32
+#define trice32(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(trice32_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef Trice32
+#define Trice32(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(Trice32_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRice32
+#define TRice32(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRice32_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRICE64
+#define TRICE64(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRICE64_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef trice64
+#define trice64(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(trice64_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef Trice64
+#define Trice64(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(Trice64_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRice64
+#define TRice64(tid, fmt, ...) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_CONCAT2(TRice64_, TRICE_COUNT_ARGUMENTS(__VA_ARGS__))(TRICE_ID_ON(tid), fmt, ##__VA_ARGS__))
+#undef TRICE_N
+#define TRICE_N(tid, pFmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(do { TRICE_UNUSED(pFmt); uint32_t limit = TRICE_SINGLE_MAX_SIZE - 12; uint32_t len_ = n; if (len_ > limit) { TRICE_DYN_BUF_TRUNCATE_COUNT_INCREMENT(); len_ = limit; } TRICE_ENTER tid; if (len_ <= 127) { TRICE_CNTC(len_); } else { TRICE_LCNT(len_); } TRICE_PUT_BUFFER(buf, len_); TRICE_LEAVE } while (0))
+#undef TRICE_S
+#define TRICE_S(tid, pFmt, runtimeGeneratedString) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(do { uint32_t ssiz = strlen(runtimeGeneratedString); TRICE_N(TRICE_ID_ON(tid), pFmt, runtimeGeneratedString, ssiz); } while (0))
+#undef TRICE0
+#define TRICE0(tid, pFmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(0); TRICE_LEAVE)
+
+// trice8.h
+#undef TRICE8_0
+#define TRICE8_0(tid, pFmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(0); TRICE_LEAVE)
+#undef TRICE8_1
+#define TRICE8_1(tid, pFmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(1); TRICE_PUT8_1(v0) TRICE_LEAVE)
+#undef TRICE8_2
+#define TRICE8_2(tid, pFmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(2); TRICE_PUT8_2(v0, v1); TRICE_LEAVE)
+#undef TRICE8_3
+#define TRICE8_3(tid, pFmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(3); TRICE_PUT8_3(v0, v1, v2); TRICE_LEAVE)
+#undef TRICE8_4
+#define TRICE8_4(tid, pFmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(4); TRICE_PUT8_4(v0, v1, v2, v3); TRICE_LEAVE)
+#undef TRICE8_5
+#define TRICE8_5(tid, pFmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(5); TRICE_PUT8_5(v0, v1, v2, v3, v4); TRICE_LEAVE)
+#undef TRICE8_6
+#define TRICE8_6(tid, pFmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(6); TRICE_PUT8_6(v0, v1, v2, v3, v4, v5); TRICE_LEAVE)
+#undef TRICE8_7
+#define TRICE8_7(tid, pFmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(7); TRICE_PUT8_7(v0, v1, v2, v3, v4, v5, v6); TRICE_LEAVE)
+#undef TRICE8_8
+#define TRICE8_8(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(8); TRICE_PUT8_8(v0, v1, v2, v3, v4, v5, v6, v7); TRICE_LEAVE)
+#undef TRICE8_9
+#define TRICE8_9(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(9); TRICE_PUT8_9(v0, v1, v2, v3, v4, v5, v6, v7, v8); TRICE_LEAVE)
+#undef TRICE8_10
+#define TRICE8_10(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(10); TRICE_PUT8_10(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9); TRICE_LEAVE)
+#undef TRICE8_11
+#define TRICE8_11(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(11); TRICE_PUT8_11(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10); TRICE_LEAVE)
+#undef TRICE8_12
+#define TRICE8_12(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(12); TRICE_PUT8_12(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_LEAVE)
+
+// trice16.h
+#undef TRICE16_B
+#define TRICE16_B(tid, pFmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(do { TRICE_N(TRICE_ID_ON(tid), pFmt, buf, 2 * n); } while (0))
+#undef TRICE16_0
+#define TRICE16_0(tid, pFmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(0); TRICE_LEAVE)
+#undef TRICE16_1
+#define TRICE16_1(tid, pFmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(2); TRICE_PUT16_1(v0) TRICE_LEAVE)
+#undef TRICE16_2
+#define TRICE16_2(tid, pFmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(4); TRICE_PUT16_2(v0, v1); TRICE_LEAVE)
+#undef TRICE16_3
+#define TRICE16_3(tid, pFmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(6); TRICE_PUT16_3(v0, v1, v2); TRICE_LEAVE)
+#undef TRICE16_4
+#define TRICE16_4(tid, pFmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(8); TRICE_PUT16_4(v0, v1, v2, v3); TRICE_LEAVE)
+#undef TRICE16_5
+#define TRICE16_5(tid, pFmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(10); TRICE_PUT16_5(v0, v1, v2, v3, v4); TRICE_LEAVE)
+#undef TRICE16_6
+#define TRICE16_6(tid, pFmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(12); TRICE_PUT16_6(v0, v1, v2, v3, v4, v5); TRICE_LEAVE)
+#undef TRICE16_7
+#define TRICE16_7(tid, pFmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(14); TRICE_PUT16_7(v0, v1, v2, v3, v4, v5, v6); TRICE_LEAVE)
+#undef TRICE16_8
+#define TRICE16_8(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(16); TRICE_PUT16_8(v0, v1, v2, v3, v4, v5, v6, v7); TRICE_LEAVE)
+#undef TRICE16_9
+#define TRICE16_9(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(18); TRICE_PUT16_9(v0, v1, v2, v3, v4, v5, v6, v7, v8); TRICE_LEAVE)
+#undef TRICE16_10
+#define TRICE16_10(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(20); TRICE_PUT16_10(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9); TRICE_LEAVE)
+#undef TRICE16_11
+#define TRICE16_11(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(22); TRICE_PUT16_11(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10); TRICE_LEAVE)
+#undef TRICE16_12
+#define TRICE16_12(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(24); TRICE_PUT16_12(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_LEAVE)
+
+// trice32.h
+#undef TRICE32_B
+#define TRICE32_B(tid, pFmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(do { TRICE_N(TRICE_ID_ON(tid), pFmt, buf, 4 * n); } while (0))
+#undef TRICE32_0
+#define TRICE32_0(tid, pFmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(0); TRICE_LEAVE)
+#undef TRICE32_1
+#define TRICE32_1(tid, pFmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(4); TRICE_PUT32_1(v0) TRICE_LEAVE)
+#undef TRICE32_2
+#define TRICE32_2(tid, pFmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(8); TRICE_PUT32_2(v0, v1); TRICE_LEAVE)
+#undef TRICE32_3
+#define TRICE32_3(tid, pFmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(12); TRICE_PUT32_3(v0, v1, v2); TRICE_LEAVE)
+#undef TRICE32_4
+#define TRICE32_4(tid, pFmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(16); TRICE_PUT32_4(v0, v1, v2, v3); TRICE_LEAVE)
+#undef TRICE32_5
+#define TRICE32_5(tid, pFmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(20); TRICE_PUT32_5(v0, v1, v2, v3, v4); TRICE_LEAVE)
+#undef TRICE32_6
+#define TRICE32_6(tid, pFmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(24); TRICE_PUT32_6(v0, v1, v2, v3, v4, v5); TRICE_LEAVE)
+#undef TRICE32_7
+#define TRICE32_7(tid, pFmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(28); TRICE_PUT32_7(v0, v1, v2, v3, v4, v5, v6); TRICE_LEAVE)
+#undef TRICE32_8
+#define TRICE32_8(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(32); TRICE_PUT32_8(v0, v1, v2, v3, v4, v5, v6, v7); TRICE_LEAVE)
+#undef TRICE32_9
+#define TRICE32_9(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(36); TRICE_PUT32_9(v0, v1, v2, v3, v4, v5, v6, v7, v8); TRICE_LEAVE)
+#undef TRICE32_10
+#define TRICE32_10(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(40); TRICE_PUT32_10(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9); TRICE_LEAVE)
+#undef TRICE32_11
+#define TRICE32_11(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(44); TRICE_PUT32_11(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10); TRICE_LEAVE)
+#undef TRICE32_12
+#define TRICE32_12(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(48); TRICE_PUT32_12(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_LEAVE)
+
+// trice64.h
+#undef TRICE64_B
+#define TRICE64_B(tid, pFmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(do { TRICE_N(TRICE_ID_ON(tid), pFmt, buf, 8 * n); } while (0))
+#undef TRICE64_0
+#define TRICE64_0(tid, pFmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(0); TRICE_LEAVE)
+#undef TRICE64_1
+#define TRICE64_1(tid, pFmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(8); TRICE_PUT64_1(v0) TRICE_LEAVE)
+#undef TRICE64_2
+#define TRICE64_2(tid, pFmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(16); TRICE_PUT64_2(v0, v1); TRICE_LEAVE)
+#undef TRICE64_3
+#define TRICE64_3(tid, pFmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(24); TRICE_PUT64_3(v0, v1, v2); TRICE_LEAVE)
+#undef TRICE64_4
+#define TRICE64_4(tid, pFmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(32); TRICE_PUT64_4(v0, v1, v2, v3); TRICE_LEAVE)
+#undef TRICE64_5
+#define TRICE64_5(tid, pFmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(40); TRICE_PUT64_5(v0, v1, v2, v3, v4); TRICE_LEAVE)
+#undef TRICE64_6
+#define TRICE64_6(tid, pFmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(48); TRICE_PUT64_6(v0, v1, v2, v3, v4, v5); TRICE_LEAVE)
+#undef TRICE64_7
+#define TRICE64_7(tid, pFmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(56); TRICE_PUT64_7(v0, v1, v2, v3, v4, v5, v6); TRICE_LEAVE)
+#undef TRICE64_8
+#define TRICE64_8(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(64); TRICE_PUT64_8(v0, v1, v2, v3, v4, v5, v6, v7); TRICE_LEAVE)
+#undef TRICE64_9
+#define TRICE64_9(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(72); TRICE_PUT64_9(v0, v1, v2, v3, v4, v5, v6, v7, v8); TRICE_LEAVE)
+#undef TRICE64_10
+#define TRICE64_10(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(80); TRICE_PUT64_10(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9); TRICE_LEAVE)
+#undef TRICE64_11
+#define TRICE64_11(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(88); TRICE_PUT64_11(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10); TRICE_LEAVE)
+#undef TRICE64_12
+#define TRICE64_12(tid, pFmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRICE_ENTER tid; TRICE_CNTC(96); TRICE_PUT64_12(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_LEAVE)
+
+// triceOn.h
+#undef trice8_0
+#define trice8_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_0(tid))
+#undef trice8_1
+#define trice8_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_1(tid, (uint8_t)(v0)))
+#undef trice8_2
+#define trice8_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_2(tid, (uint8_t)(v0), (uint8_t)(v1)))
+#undef trice8_3
+#define trice8_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_3(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2)))
+#undef trice8_4
+#define trice8_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_4(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3)))
+#undef trice8_5
+#define trice8_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_5(tid, (uint8_t)v0, (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4)))
+#undef trice8_6
+#define trice8_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_6(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5)))
+#undef trice8_7
+#define trice8_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_7(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6)))
+#undef trice8_8
+#define trice8_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_8(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7)))
+#undef trice8_9
+#define trice8_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_9(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8)))
+#undef trice8_10
+#define trice8_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_10(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9)))
+#undef trice8_11
+#define trice8_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_11(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9), (uint8_t)(v10)))
+#undef trice8_12
+#define trice8_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8fn_12(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9), (uint8_t)(v10), (uint8_t)(v11)))
+#undef Trice8_0
+#define Trice8_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_0(tid))
+#undef Trice8_1
+#define Trice8_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_1(tid, (uint8_t)(v0)))
+#undef Trice8_2
+#define Trice8_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_2(tid, (uint8_t)(v0), (uint8_t)(v1)))
+#undef Trice8_3
+#define Trice8_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_3(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2)))
+#undef Trice8_4
+#define Trice8_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_4(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3)))
+#undef Trice8_5
+#define Trice8_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_5(tid, (uint8_t)v0, (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4)))
+#undef Trice8_6
+#define Trice8_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_6(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5)))
+#undef Trice8_7
+#define Trice8_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_7(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6)))
+#undef Trice8_8
+#define Trice8_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_8(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7)))
+#undef Trice8_9
+#define Trice8_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_9(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8)))
+#undef Trice8_10
+#define Trice8_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_10(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9)))
+#undef Trice8_11
+#define Trice8_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_11(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9), (uint8_t)(v10)))
+#undef Trice8_12
+#define Trice8_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8fn_12(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9), (uint8_t)(v10), (uint8_t)(v11)))
+#undef TRice8_0
+#define TRice8_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_0(tid))
+#undef TRice8_1
+#define TRice8_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_1(tid, (uint8_t)(v0)))
+#undef TRice8_2
+#define TRice8_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_2(tid, (uint8_t)(v0), (uint8_t)(v1)))
+#undef TRice8_3
+#define TRice8_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_3(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2)))
+#undef TRice8_4
+#define TRice8_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_4(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3)))
+#undef TRice8_5
+#define TRice8_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_5(tid, (uint8_t)v0, (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4)))
+#undef TRice8_6
+#define TRice8_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_6(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5)))
+#undef TRice8_7
+#define TRice8_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_7(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6)))
+#undef TRice8_8
+#define TRice8_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_8(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7)))
+#undef TRice8_9
+#define TRice8_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_9(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8)))
+#undef TRice8_10
+#define TRice8_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_10(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9)))
+#undef TRice8_11
+#define TRice8_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_11(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9), (uint8_t)(v10)))
+#undef TRice8_12
+#define TRice8_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8fn_12(tid, (uint8_t)(v0), (uint8_t)(v1), (uint8_t)(v2), (uint8_t)(v3), (uint8_t)(v4), (uint8_t)(v5), (uint8_t)(v6), (uint8_t)(v7), (uint8_t)(v8), (uint8_t)(v9), (uint8_t)(v10), (uint8_t)(v11)))
+#undef trice16_0
+#define trice16_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_0(tid))
+#undef trice16_1
+#define trice16_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_1(tid, (uint16_t)(v0)))
+#undef trice16_2
+#define trice16_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_2(tid, (uint16_t)(v0), (uint16_t)(v1)))
+#undef trice16_3
+#define trice16_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_3(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2)))
+#undef trice16_4
+#define trice16_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_4(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3)))
+#undef trice16_5
+#define trice16_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_5(tid, (uint16_t)v0, (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4)))
+#undef trice16_6
+#define trice16_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_6(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5)))
+#undef trice16_7
+#define trice16_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_7(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6)))
+#undef trice16_8
+#define trice16_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_8(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7)))
+#undef trice16_9
+#define trice16_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_9(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8)))
+#undef trice16_10
+#define trice16_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_10(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9)))
+#undef trice16_11
+#define trice16_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_11(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9), (uint16_t)(v10)))
+#undef trice16_12
+#define trice16_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16fn_12(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9), (uint16_t)(v10), (uint16_t)(v11)))
+#undef Trice16_0
+#define Trice16_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_0(tid))
+#undef Trice16_1
+#define Trice16_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_1(tid, (uint16_t)(v0)))
+#undef Trice16_2
+#define Trice16_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_2(tid, (uint16_t)(v0), (uint16_t)(v1)))
+#undef Trice16_3
+#define Trice16_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_3(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2)))
+#undef Trice16_4
+#define Trice16_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_4(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3)))
+#undef Trice16_5
+#define Trice16_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_5(tid, (uint16_t)v0, (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4)))
+#undef Trice16_6
+#define Trice16_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_6(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5)))
+#undef Trice16_7
+#define Trice16_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_7(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6)))
+#undef Trice16_8
+#define Trice16_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_8(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7)))
+#undef Trice16_9
+#define Trice16_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_9(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8)))
+#undef Trice16_10
+#define Trice16_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_10(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9)))
+#undef Trice16_11
+#define Trice16_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_11(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9), (uint16_t)(v10)))
+#undef Trice16_12
+#define Trice16_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16fn_12(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9), (uint16_t)(v10), (uint16_t)(v11)))
+#undef TRice16_0
+#define TRice16_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_0(tid))
+#undef TRice16_1
+#define TRice16_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_1(tid, (uint16_t)(v0)))
+#undef TRice16_2
+#define TRice16_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_2(tid, (uint16_t)(v0), (uint16_t)(v1)))
+#undef TRice16_3
+#define TRice16_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_3(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2)))
+#undef TRice16_4
+#define TRice16_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_4(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3)))
+#undef TRice16_5
+#define TRice16_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_5(tid, (uint16_t)v0, (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4)))
+#undef TRice16_6
+#define TRice16_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_6(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5)))
+#undef TRice16_7
+#define TRice16_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_7(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6)))
+#undef TRice16_8
+#define TRice16_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_8(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7)))
+#undef TRice16_9
+#define TRice16_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_9(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8)))
+#undef TRice16_10
+#define TRice16_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_10(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9)))
+#undef TRice16_11
+#define TRice16_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_11(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9), (uint16_t)(v10)))
+#undef TRice16_12
+#define TRice16_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16fn_12(tid, (uint16_t)(v0), (uint16_t)(v1), (uint16_t)(v2), (uint16_t)(v3), (uint16_t)(v4), (uint16_t)(v5), (uint16_t)(v6), (uint16_t)(v7), (uint16_t)(v8), (uint16_t)(v9), (uint16_t)(v10), (uint16_t)(v11)))
+#undef trice32_0
+#define trice32_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_0(tid))
+#undef trice32_1
+#define trice32_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_1(tid, (uint32_t)(v0)))
+#undef trice32_2
+#define trice32_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_2(tid, (uint32_t)(v0), (uint32_t)(v1)))
+#undef trice32_3
+#define trice32_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_3(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2)))
+#undef trice32_4
+#define trice32_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_4(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3)))
+#undef trice32_5
+#define trice32_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_5(tid, (uint32_t)v0, (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4)))
+#undef trice32_6
+#define trice32_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_6(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5)))
+#undef trice32_7
+#define trice32_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_7(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6)))
+#undef trice32_8
+#define trice32_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_8(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7)))
+#undef trice32_9
+#define trice32_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_9(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8)))
+#undef trice32_10
+#define trice32_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_10(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9)))
+#undef trice32_11
+#define trice32_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_11(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9), (uint32_t)(v10)))
+#undef trice32_12
+#define trice32_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32fn_12(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9), (uint32_t)(v10), (uint32_t)(v11)))
+#undef Trice32_0
+#define Trice32_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_0(tid))
+#undef Trice32_1
+#define Trice32_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_1(tid, (uint32_t)(v0)))
+#undef Trice32_2
+#define Trice32_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_2(tid, (uint32_t)(v0), (uint32_t)(v1)))
+#undef Trice32_3
+#define Trice32_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_3(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2)))
+#undef Trice32_4
+#define Trice32_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_4(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3)))
+#undef Trice32_5
+#define Trice32_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_5(tid, (uint32_t)v0, (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4)))
+#undef Trice32_6
+#define Trice32_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_6(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5)))
+#undef Trice32_7
+#define Trice32_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_7(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6)))
+#undef Trice32_8
+#define Trice32_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_8(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7)))
+#undef Trice32_9
+#define Trice32_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_9(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8)))
+#undef Trice32_10
+#define Trice32_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_10(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9)))
+#undef Trice32_11
+#define Trice32_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_11(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9), (uint32_t)(v10)))
+#undef Trice32_12
+#define Trice32_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32fn_12(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9), (uint32_t)(v10), (uint32_t)(v11)))
+#undef TRice32_0
+#define TRice32_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_0(tid))
+#undef TRice32_1
+#define TRice32_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_1(tid, (uint32_t)(v0)))
+#undef TRice32_2
+#define TRice32_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_2(tid, (uint32_t)(v0), (uint32_t)(v1)))
+#undef TRice32_3
+#define TRice32_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_3(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2)))
+#undef TRice32_4
+#define TRice32_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_4(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3)))
+#undef TRice32_5
+#define TRice32_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_5(tid, (uint32_t)v0, (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4)))
+#undef TRice32_6
+#define TRice32_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_6(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5)))
+#undef TRice32_7
+#define TRice32_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_7(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6)))
+#undef TRice32_8
+#define TRice32_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_8(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7)))
+#undef TRice32_9
+#define TRice32_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_9(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8)))
+#undef TRice32_10
+#define TRice32_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_10(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9)))
+#undef TRice32_11
+#define TRice32_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_11(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9), (uint32_t)(v10)))
+#undef TRice32_12
+#define TRice32_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32fn_12(tid, (uint32_t)(v0), (uint32_t)(v1), (uint32_t)(v2), (uint32_t)(v3), (uint32_t)(v4), (uint32_t)(v5), (uint32_t)(v6), (uint32_t)(v7), (uint32_t)(v8), (uint32_t)(v9), (uint32_t)(v10), (uint32_t)(v11)))
+#undef trice64_0
+#define trice64_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_0(tid))
+#undef trice64_1
+#define trice64_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_1(tid, (uint64_t)(v0)))
+#undef trice64_2
+#define trice64_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_2(tid, (uint64_t)(v0), (uint64_t)(v1)))
+#undef trice64_3
+#define trice64_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_3(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2)))
+#undef trice64_4
+#define trice64_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_4(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3)))
+#undef trice64_5
+#define trice64_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_5(tid, (uint64_t)v0, (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4)))
+#undef trice64_6
+#define trice64_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_6(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5)))
+#undef trice64_7
+#define trice64_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_7(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6)))
+#undef trice64_8
+#define trice64_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_8(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7)))
+#undef trice64_9
+#define trice64_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_9(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8)))
+#undef trice64_10
+#define trice64_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_10(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9)))
+#undef trice64_11
+#define trice64_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_11(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9), (uint64_t)(v10)))
+#undef trice64_12
+#define trice64_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64fn_12(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9), (uint64_t)(v10), (uint64_t)(v11)))
+#undef Trice64_0
+#define Trice64_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_0(tid))
+#undef Trice64_1
+#define Trice64_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_1(tid, (uint64_t)(v0)))
+#undef Trice64_2
+#define Trice64_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_2(tid, (uint64_t)(v0), (uint64_t)(v1)))
+#undef Trice64_3
+#define Trice64_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_3(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2)))
+#undef Trice64_4
+#define Trice64_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_4(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3)))
+#undef Trice64_5
+#define Trice64_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_5(tid, (uint64_t)v0, (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4)))
+#undef Trice64_6
+#define Trice64_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_6(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5)))
+#undef Trice64_7
+#define Trice64_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_7(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6)))
+#undef Trice64_8
+#define Trice64_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_8(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7)))
+#undef Trice64_9
+#define Trice64_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_9(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8)))
+#undef Trice64_10
+#define Trice64_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_10(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9)))
+#undef Trice64_11
+#define Trice64_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_11(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9), (uint64_t)(v10)))
+#undef Trice64_12
+#define Trice64_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64fn_12(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9), (uint64_t)(v10), (uint64_t)(v11)))
+#undef TRice64_0
+#define TRice64_0(tid, fmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_0(tid))
+#undef TRice64_1
+#define TRice64_1(tid, fmt, v0) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_1(tid, (uint64_t)(v0)))
+#undef TRice64_2
+#define TRice64_2(tid, fmt, v0, v1) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_2(tid, (uint64_t)(v0), (uint64_t)(v1)))
+#undef TRice64_3
+#define TRice64_3(tid, fmt, v0, v1, v2) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_3(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2)))
+#undef TRice64_4
+#define TRice64_4(tid, fmt, v0, v1, v2, v3) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_4(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3)))
+#undef TRice64_5
+#define TRice64_5(tid, fmt, v0, v1, v2, v3, v4) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_5(tid, (uint64_t)v0, (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4)))
+#undef TRice64_6
+#define TRice64_6(tid, fmt, v0, v1, v2, v3, v4, v5) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_6(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5)))
+#undef TRice64_7
+#define TRice64_7(tid, fmt, v0, v1, v2, v3, v4, v5, v6) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_7(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6)))
+#undef TRice64_8
+#define TRice64_8(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_8(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7)))
+#undef TRice64_9
+#define TRice64_9(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_9(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8)))
+#undef TRice64_10
+#define TRice64_10(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_10(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9)))
+#undef TRice64_11
+#define TRice64_11(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_11(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9), (uint64_t)(v10)))
+#undef TRice64_12
+#define TRice64_12(tid, fmt, v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64fn_12(tid, (uint64_t)(v0), (uint64_t)(v1), (uint64_t)(v2), (uint64_t)(v3), (uint64_t)(v4), (uint64_t)(v5), (uint64_t)(v6), (uint64_t)(v7), (uint64_t)(v8), (uint64_t)(v9), (uint64_t)(v10), (uint64_t)(v11)))
+
+// End of generated code.
+// clang-format on
+
+#ifndef TRICE_ID_GATE_NO_FUNCTIONS // trice.c defines the trice functions.
+
+// The trice functions get a function like macro with the same name. Inside its own expansion the name is the function.
+// clang-format off
+#define trice0(tid, pFmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice0(tid, pFmt))
+#define Trice0(tid, pFmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice0(tid, pFmt))
+#define TRice0(tid, pFmt) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice0(tid, pFmt))
+#define triceS(tid, fmt, s) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(triceS(tid, fmt, s))
+#define TriceS(tid, fmt, s) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TriceS(tid, fmt, s))
+#define TRiceS(tid, fmt, s) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRiceS(tid, fmt, s))
+#define triceN(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(triceN(tid, fmt, buf, n))
+#define TriceN(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TriceN(tid, fmt, buf, n))
+#define TRiceN(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRiceN(tid, fmt, buf, n))
+#define trice8B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8B(tid, fmt, buf, n))
+#define Trice8B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8B(tid, fmt, buf, n))
+#define TRice8B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8B(tid, fmt, buf, n))
+#define trice16B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16B(tid, fmt, buf, n))
+#define Trice16B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16B(tid, fmt, buf, n))
+#define TRice16B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16B(tid, fmt, buf, n))
+#define trice32B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32B(tid, fmt, buf, n))
+#define Trice32B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32B(tid, fmt, buf, n))
+#define TRice32B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32B(tid, fmt, buf, n))
+#define trice64B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64B(tid, fmt, buf, n))
+#define Trice64B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64B(tid, fmt, buf, n))
+#define TRice64B(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64B(tid, fmt, buf, n))
+#define trice8F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice8F(tid, fmt, buf, n))
+#define Trice8F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice8F(tid, fmt, buf, n))
+#define TRice8F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice8F(tid, fmt, buf, n))
+#define trice16F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice16F(tid, fmt, buf, n))
+#define Trice16F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice16F(tid, fmt, buf, n))
+#define TRice16F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice16F(tid, fmt, buf, n))
+#define trice32F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice32F(tid, fmt, buf, n))
+#define Trice32F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice32F(tid, fmt, buf, n))
+#define TRice32F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice32F(tid, fmt, buf, n))
+#define trice64F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(trice64F(tid, fmt, buf, n))
+#define Trice64F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(Trice64F(tid, fmt, buf, n))
+#define TRice64F(tid, fmt, buf, n) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRice64F(tid, fmt, buf, n))
+#define triceAssertTrue(tid, msg, flag) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(triceAssertTrue(tid, msg, flag))
+#define TriceAssertTrue(tid, msg, flag) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TriceAssertTrue(tid, msg, flag))
+#define TRiceAssertTrue(tid, msg, flag) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRiceAssertTrue(tid, msg, flag))
+#define triceAssertFalse(tid, msg, flag) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(triceAssertFalse(tid, msg, flag))
+#define TriceAssertFalse(tid, msg, flag) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TriceAssertFalse(tid, msg, flag))
+#define TRiceAssertFalse(tid, msg, flag) TRICE_ID_GATE(TRICE_ID_ENABLE_OF_##tid)(TRiceAssertFalse(tid, msg, flag))
+// clang-format on
+
+#endif // #ifndef TRICE_ID_GATE_NO_FUNCTIONS
@@ -16,6 +16,8 @@
 #define TriceNonBlockingDeferredWrite32Auxiliary(enc, count) TRICE_UNUSED(enc) TRICE_UNUSED(encLen)
 #define TriceInit()
 #define TriceLogDiagnosticData()
+#define TriceLogTiming()
+#define TriceLogHealth(reset)
 #define TriceLogSeggerDiagnostics()
 #define TriceNonBlockingDeferredWrite8(ticeID, enc, encLen) TRICE_UNUSED(ticeID) TRICE_UNUSED(enc) TRICE_UNUSED(encLen)
 #define TriceTransfer()
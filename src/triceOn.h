@@ -17,6 +17,8 @@ void TriceNonBlockingDirectWrite32Auxiliary(const uint32_t* enc, unsigned count)
 void TriceNonBlockingDeferredWrite32Auxiliary(const uint32_t* enc, unsigned count);
 void TriceInit(void);
 void TriceLogDiagnosticData(void);
+void TriceLogTiming(void);
+void TriceLogHealth(int reset);
 void TriceLogSeggerDiagnostics(void);
 void TriceNonBlockingDeferredWrite8(int ticeID, const uint8_t* enc, size_t encLen);
 void TriceTransfer(void);
@@ -91,6 +91,9 @@ int TriceEnoughSpace(void) {
 	} else {
 #if TRICE_DIAGNOSTICS == 1
 		TriceDeferredOverflowCount++;
+#endif
+#if TRICE_CYCLE_COUNTER == 1
+		TriceCycle++; // The host sees the dropped trice as cycle counter gap.
 #endif
 		return 0;
 	}
@@ -122,6 +125,7 @@ static uint32_t* triceNextRingBufferRead(int lastWordCount) {
 
 //! TriceTransfer needs to be called cyclically to read out the Ring Buffer.
 void TriceTransfer(void) {
+	TRICE_HEALTH_TICK();
 	if (SingleTricesRingCount == 0) { // no data
 		return;
 	}
@@ -130,12 +134,14 @@ void TriceTransfer(void) {
 		return;
 	}
 #endif
+	TRICE_TIMING_START(triceTimingTransfer)
 	TRICE_ENTER_CRITICAL_SECTION
 	SingleTricesRingCount--;
 	TRICE_LEAVE_CRITICAL_SECTION
 	static int lastWordCount = 0;
 	uint32_t* addr = triceNextRingBufferRead(lastWordCount);
 	lastWordCount = TriceSingleDeferredOut(addr);
+	TRICE_TIMING_STOP(TriceTimingTransfer, triceTimingTransfer)
 }
 
 //! TriceIDAndBuffer evaluates a trice message and returns the ID for routing.